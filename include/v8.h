@@ -18,6 +18,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -1951,6 +1952,12 @@ class V8_EXPORT Value : public Data {
    */
   bool IsProxy() const;
 
+  /**
+   * Returns true if this value is a WebAssembly.Module.
+   * This is an experimental feature.
+   */
+  bool IsWebAssemblyCompiledModule() const;
+
 
   V8_WARN_UNUSED_RESULT MaybeLocal<Boolean> ToBoolean(
       Local<Context> context) const;
@@ -3459,6 +3466,57 @@ class V8_EXPORT Proxy : public Object {
 };
 
 
+/**
+ * An instance of the built-in WebAssembly.Module constructor.
+ * This API is experimental and may change significantly.
+ */
+class V8_EXPORT WasmCompiledModule : public Object {
+ public:
+  /**
+   * Compiles a module while its bytes are still being received, e.g. from the
+   * network. V8 calls |source|->GetMoreData() on the calling thread until it
+   * returns 0, and compiles the function bodies received so far on
+   * background threads while GetMoreData() blocks.
+   *
+   * |expected_size| is the size of the module if known beforehand (e.g. from
+   * a Content-Length header), or 0. Function bodies are only compiled from
+   * the stream while it does not exceed |expected_size|, the rest is compiled
+   * once the stream ends. Throws an exception if the module is invalid.
+   */
+  static MaybeLocal<WasmCompiledModule> CompileStreamed(
+      Local<Context> context, ScriptCompiler::ExternalSourceStream* source,
+      size_t expected_size);
+
+  typedef std::pair<std::unique_ptr<const uint8_t[]>, size_t> SerializedModule;
+  // A buffer that is owned by the caller.
+  typedef std::pair<const uint8_t*, size_t> CallerOwnedBuffer;
+
+  /**
+   * Serializes the compiled code of the module, so that a later run can pass
+   * it to Deserialize() instead of compiling the module again. The module
+   * bytes are not part of the result and have to be kept by the embedder.
+   */
+  SerializedModule Serialize();
+
+  /**
+   * Creates a module from the result of Serialize() and the bytes of the
+   * module it was compiled from, without compiling any code. Returns an empty
+   * handle if the data does not fit, e.g. because it was produced by another
+   * V8 version, for other CPU features or flags, or from other module bytes.
+   * The embedder should then compile |wire_bytes| instead.
+   */
+  static MaybeLocal<WasmCompiledModule> Deserialize(
+      Local<Context> context, const CallerOwnedBuffer& serialized_module,
+      const CallerOwnedBuffer& wire_bytes);
+
+  V8_INLINE static WasmCompiledModule* Cast(Value* obj);
+
+ private:
+  WasmCompiledModule();
+  static void CheckCast(Value* obj);
+};
+
+
 #ifndef V8_ARRAY_BUFFER_INTERNAL_FIELD_COUNT
 // The number of required internal fields can be defined by embedder.
 #define V8_ARRAY_BUFFER_INTERNAL_FIELD_COUNT 2
@@ -5326,6 +5384,29 @@ class V8_EXPORT HeapCodeStatistics {
   friend class Isolate;
 };
 
+/**
+ * A source position at which optimized code deoptimized, as collected with
+ * --track-deopt-sites.
+ */
+class V8_EXPORT DeoptimizationSiteStatistics {
+ public:
+  DeoptimizationSiteStatistics();
+  int script_id() { return script_id_; }
+  int position() { return position_; }
+  const char* reason() { return reason_; }
+  int count() { return count_; }
+  bool feedback_generalized() { return feedback_generalized_; }
+
+ private:
+  int script_id_;
+  int position_;
+  const char* reason_;
+  int count_;
+  bool feedback_generalized_;
+
+  friend class Isolate;
+};
+
 class RetainedObjectInfo;
 
 
@@ -5901,6 +5982,18 @@ class V8_EXPORT Isolate {
    */
   bool GetHeapCodeAndMetadataStatistics(HeapCodeStatistics* object_statistics);
 
+  /**
+   * Get statistics about the sites at which optimized code deoptimized.
+   * Sites are only tracked with --track-deopt-sites.
+   *
+   * \param sites Caller allocated buffer to fill in with the most frequently
+   *   hit sites, the most frequent one first.
+   * \param sites_limit The number of entries in the buffer.
+   * \returns the number of entries filled in.
+   */
+  size_t GetDeoptimizationSiteStatistics(DeoptimizationSiteStatistics* sites,
+                                         size_t sites_limit);
+
   /**
    * Get a call stack sample from the isolate.
    * \param state Execution state.
@@ -6288,6 +6381,25 @@ class V8_EXPORT Isolate {
    */
   void SetRAILMode(RAILMode rail_mode);
 
+  /**
+   * Serializes a summary of the type feedback collected so far, keyed by
+   * script source and function position. Feeding it to
+   * SetTypeFeedbackProfile in a later run with the same scripts lets hot
+   * functions skip part of their warm-up. Only feedback that is meaningful
+   * across processes is kept. The caller owns the returned data.
+   * This is an experimental feature.
+   */
+  ScriptCompiler::CachedData* SerializeTypeFeedback();
+
+  /**
+   * Installs type feedback produced by SerializeTypeFeedback; it is applied
+   * to functions as their feedback is allocated. Returns false and leaves
+   * any previously installed profile in place if the data is malformed or
+   * was produced by a different version of V8. Passing NULL clears it.
+   * This is an experimental feature.
+   */
+  bool SetTypeFeedbackProfile(const uint8_t* data, int length);
+
   /**
    * Allows the host application to provide the address of a function that is
    * notified each time code is added, moved or removed.
@@ -8560,6 +8672,14 @@ Proxy* Proxy::Cast(v8::Value* value) {
 }
 
 
+WasmCompiledModule* WasmCompiledModule::Cast(v8::Value* value) {
+#ifdef V8_ENABLE_CHECKS
+  CheckCast(value);
+#endif
+  return static_cast<WasmCompiledModule*>(value);
+}
+
+
 Promise::Resolver* Promise::Resolver::Cast(v8::Value* value) {
 #ifdef V8_ENABLE_CHECKS
   CheckCast(value);
@@ -60,15 +60,20 @@
 #include "src/runtime-profiler.h"
 #include "src/runtime/runtime.h"
 #include "src/simulator.h"
+#include "src/snapshot/code-serializer.h"
 #include "src/snapshot/natives.h"
 #include "src/snapshot/snapshot.h"
 #include "src/startup-data-util.h"
 #include "src/tracing/trace-event.h"
+#include "src/type-feedback-profile.h"
 #include "src/unicode-inl.h"
 #include "src/v8.h"
 #include "src/v8threads.h"
 #include "src/version.h"
 #include "src/vm-state-inl.h"
+#include "src/wasm/module-decoder.h"
+#include "src/wasm/wasm-module.h"
+#include "src/wasm/wasm-result.h"
 
 namespace v8 {
 
@@ -2979,6 +2984,18 @@ bool Value::IsNumber() const {
 
 bool Value::IsProxy() const { return Utils::OpenHandle(this)->IsJSProxy(); }
 
+bool Value::IsWebAssemblyCompiledModule() const {
+  i::Handle<i::Object> obj = Utils::OpenHandle(this);
+  if (!obj->IsJSObject()) return false;
+  // Compare against the WebAssembly.Module constructor of the context that
+  // created the object, which need not be the current context.
+  i::Object* constructor = i::JSObject::cast(*obj)->map()->GetConstructor();
+  if (!constructor->IsJSFunction()) return false;
+  i::JSFunction* function = i::JSFunction::cast(constructor);
+  return function->native_context()->get(
+             i::Context::WASM_MODULE_CONSTRUCTOR_INDEX) == function;
+}
+
 
 #define VALUE_IS_SPECIFIC_TYPE(Type, Class)                            \
   bool Value::Is##Type() const {                                       \
@@ -3327,6 +3344,13 @@ void v8::Proxy::CheckCast(Value* that) {
 }
 
 
+void v8::WasmCompiledModule::CheckCast(Value* that) {
+  Utils::ApiCheck(that->IsWebAssemblyCompiledModule(),
+                  "v8::WasmCompiledModule::Cast",
+                  "Could not convert to wasm compiled module");
+}
+
+
 void v8::ArrayBuffer::CheckCast(Value* that) {
   i::Handle<i::Object> obj = Utils::OpenHandle(that);
   Utils::ApiCheck(
@@ -5591,6 +5615,13 @@ HeapObjectStatistics::HeapObjectStatistics()
 HeapCodeStatistics::HeapCodeStatistics()
     : code_and_metadata_size_(0), bytecode_and_metadata_size_(0) {}
 
+DeoptimizationSiteStatistics::DeoptimizationSiteStatistics()
+    : script_id_(0),
+      position_(0),
+      reason_(nullptr),
+      count_(0),
+      feedback_generalized_(false) {}
+
 bool v8::V8::InitializeICU(const char* icu_data_file) {
   return i::InitializeICU(icu_data_file);
 }
@@ -6834,6 +6865,123 @@ MaybeLocal<Proxy> Proxy::New(Local<Context> context, Local<Object> local_target,
   RETURN_ESCAPED(result);
 }
 
+MaybeLocal<WasmCompiledModule> WasmCompiledModule::CompileStreamed(
+    Local<Context> context, ScriptCompiler::ExternalSourceStream* source,
+    size_t expected_size) {
+  PREPARE_FOR_EXECUTION(context, WasmCompiledModule, CompileStreamed,
+                        WasmCompiledModule);
+  i::MaybeHandle<i::JSObject> maybe_module_obj;
+  {
+    i::wasm::ErrorThrower thrower(isolate,
+                                  "WasmCompiledModule::CompileStreamed()");
+    i::Handle<i::Context> native_context = Utils::OpenHandle(*context);
+    if (!native_context->get(i::Context::WASM_MODULE_CONSTRUCTOR_INDEX)
+             ->IsJSFunction()) {
+      thrower.Error("WebAssembly is not enabled");
+    } else {
+      i::Zone zone(isolate->allocator());
+      i::wasm::StreamingCompilation compilation(isolate, &thrower);
+      i::wasm::ModuleStreamDecoder decoder(
+          isolate, &zone, expected_size, i::wasm::kWasmOrigin, &compilation);
+      const uint8_t* data = nullptr;
+      while (size_t length = source->GetMoreData(&data)) {
+        decoder.OnBytesReceived(data, length);
+        delete[] data;
+        data = nullptr;
+      }
+      i::wasm::ModuleResult result = decoder.Finish(false);
+      std::unique_ptr<const i::wasm::WasmModule> module(result.val);
+      i::MaybeHandle<i::FixedArray> compiled_module;
+      if (result.failed()) {
+        thrower.Failed("", result);
+      } else {
+        compiled_module = compilation.Finish(module.get());
+      }
+      // The compilation refers to the buffer of the decoder.
+      compilation.Cancel();
+      if (!compiled_module.is_null()) {
+        // Keep the bytes as the source of the module object, as
+        // WebAssembly.compile() does with its buffer argument.
+        size_t size = module->module_end - module->module_start;
+        i::Handle<i::JSArrayBuffer> bytes =
+            isolate->factory()->NewJSArrayBuffer();
+        if (i::JSArrayBuffer::SetupAllocatingData(bytes, isolate, size,
+                                                  false)) {
+          memcpy(bytes->backing_store(), module->module_start, size);
+          maybe_module_obj = i::wasm::CreateModuleObject(
+              isolate, compiled_module.ToHandleChecked(), bytes);
+        } else {
+          thrower.Error("Out of memory");
+        }
+      }
+    }
+    if (thrower.error()) isolate->Throw(*thrower.Reify());
+  }
+  has_pending_exception = maybe_module_obj.is_null();
+  RETURN_ON_FAILED_EXECUTION(WasmCompiledModule);
+  Local<Object> module_obj =
+      Utils::ToLocal(maybe_module_obj.ToHandleChecked());
+  RETURN_ESCAPED(Local<WasmCompiledModule>::Cast(module_obj));
+}
+
+WasmCompiledModule::SerializedModule WasmCompiledModule::Serialize() {
+  i::Handle<i::JSObject> obj =
+      i::Handle<i::JSObject>::cast(Utils::OpenHandle(this));
+  i::Isolate* isolate = obj->GetIsolate();
+  i::Handle<i::FixedArray> compiled_module(
+      i::FixedArray::cast(obj->GetInternalField(0)), isolate);
+  std::unique_ptr<i::ScriptData> script_data(
+      i::WasmCompiledModuleSerializer::SerializeWasmModule(isolate,
+                                                           compiled_module));
+  script_data->ReleaseDataOwnership();
+  size_t size = static_cast<size_t>(script_data->length());
+  return {std::unique_ptr<const uint8_t[]>(script_data->data()), size};
+}
+
+MaybeLocal<WasmCompiledModule> WasmCompiledModule::Deserialize(
+    Local<Context> context, const CallerOwnedBuffer& serialized_module,
+    const CallerOwnedBuffer& wire_bytes) {
+  PREPARE_FOR_EXECUTION(context, WasmCompiledModule, Deserialize,
+                        WasmCompiledModule);
+  i::Handle<i::Context> native_context = Utils::OpenHandle(*context);
+  if (!native_context->get(i::Context::WASM_MODULE_CONSTRUCTOR_INDEX)
+           ->IsJSFunction() ||
+      serialized_module.second > static_cast<size_t>(i::kMaxInt) ||
+      wire_bytes.second > static_cast<size_t>(i::kMaxInt)) {
+    return MaybeLocal<WasmCompiledModule>();
+  }
+  // The module bytes are the source the serialized code is checked against.
+  i::Handle<i::String> module_bytes;
+  has_pending_exception =
+      !isolate->factory()
+           ->NewStringFromOneByte(
+               i::Vector<const uint8_t>(
+                   wire_bytes.first, static_cast<int>(wire_bytes.second)),
+               i::TENURED)
+           .ToHandle(&module_bytes);
+  RETURN_ON_FAILED_EXECUTION(WasmCompiledModule);
+  // The constructor of {ScriptData} copies the data if it is not aligned.
+  i::ScriptData script_data(serialized_module.first,
+                            static_cast<int>(serialized_module.second));
+  i::Handle<i::FixedArray> compiled_module;
+  if (!i::WasmCompiledModuleSerializer::DeserializeWasmModule(
+           isolate, &script_data, module_bytes)
+           .ToHandle(&compiled_module)) {
+    return MaybeLocal<WasmCompiledModule>();
+  }
+  // Keep a copy of the bytes as the source of the module object, as
+  // CompileStreamed() does.
+  i::Handle<i::JSArrayBuffer> bytes = isolate->factory()->NewJSArrayBuffer();
+  if (!i::JSArrayBuffer::SetupAllocatingData(bytes, isolate,
+                                             wire_bytes.second, false)) {
+    return MaybeLocal<WasmCompiledModule>();
+  }
+  memcpy(bytes->backing_store(), wire_bytes.first, wire_bytes.second);
+  Local<Object> module_obj = Utils::ToLocal(
+      i::wasm::CreateModuleObject(isolate, compiled_module, bytes));
+  RETURN_ESCAPED(Local<WasmCompiledModule>::Cast(module_obj));
+}
+
 // static
 v8::ArrayBuffer::Allocator* v8::ArrayBuffer::Allocator::NewDefaultAllocator() {
   return new ArrayBufferAllocator();
@@ -7654,6 +7802,24 @@ bool Isolate::GetHeapCodeAndMetadataStatistics(
   return true;
 }
 
+size_t Isolate::GetDeoptimizationSiteStatistics(
+    DeoptimizationSiteStatistics* sites, size_t sites_limit) {
+  if (!sites) return 0;
+
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  size_t filled = 0;
+  for (const i::DeoptimizationSiteStats::Site* site :
+       isolate->deoptimizer_data()->site_stats()->TopSites(sites_limit)) {
+    DeoptimizationSiteStatistics* entry = &sites[filled++];
+    entry->script_id_ = site->script_id;
+    entry->position_ = site->position;
+    entry->reason_ = i::DeoptimizeReasonToString(site->reason);
+    entry->count_ = site->count;
+    entry->feedback_generalized_ = site->generalized;
+  }
+  return filled;
+}
+
 void Isolate::GetStackSample(const RegisterState& state, void** frames,
                              size_t frames_limit, SampleInfo* sample_info) {
 #if defined(USE_SIMULATOR)
@@ -7883,6 +8049,30 @@ void Isolate::SetRAILMode(RAILMode rail_mode) {
   return isolate->SetRAILMode(rail_mode);
 }
 
+ScriptCompiler::CachedData* Isolate::SerializeTypeFeedback() {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  std::vector<uint8_t> data;
+  i::TypeFeedbackProfile::Serialize(isolate, &data);
+  uint8_t* buffer = i::NewArray<uint8_t>(data.size());
+  i::MemCopy(buffer, data.data(), data.size());
+  return new ScriptCompiler::CachedData(
+      buffer, static_cast<int>(data.size()),
+      ScriptCompiler::CachedData::BufferOwned);
+}
+
+bool Isolate::SetTypeFeedbackProfile(const uint8_t* data, int length) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  if (data == NULL) {
+    isolate->SetTypeFeedbackProfile(nullptr);
+    return true;
+  }
+  i::TypeFeedbackProfile* profile =
+      i::TypeFeedbackProfile::Deserialize(isolate, data, length);
+  if (profile == nullptr) return false;
+  isolate->SetTypeFeedbackProfile(profile);
+  return true;
+}
+
 void Isolate::SetJitCodeEventHandler(JitCodeEventOptions options,
                                      JitCodeEventHandler event_handler) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
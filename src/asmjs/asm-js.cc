@@ -34,7 +34,7 @@ namespace internal {
 namespace {
 i::MaybeHandle<i::FixedArray> CompileModule(
     i::Isolate* isolate, const byte* start, const byte* end,
-    ErrorThrower* thrower,
+    ErrorThrower* thrower, bool will_serialize,
     internal::wasm::ModuleOrigin origin = i::wasm::kWasmOrigin) {
   // Decode but avoid a redundant pass over function bodies for verification.
   // Verification will happen during compilation.
@@ -48,7 +48,8 @@ i::MaybeHandle<i::FixedArray> CompileModule(
   } else if (result.failed()) {
     thrower->Failed("", result);
   } else {
-    compiled_module = result.val->CompileFunctions(isolate, thrower);
+    compiled_module =
+        result.val->CompileFunctions(isolate, thrower, will_serialize);
   }
 
   if (result.val) delete result.val;
@@ -57,7 +58,8 @@ i::MaybeHandle<i::FixedArray> CompileModule(
 
 }  // namespace
 
-MaybeHandle<FixedArray> AsmJs::ConvertAsmToWasm(ParseInfo* info) {
+MaybeHandle<FixedArray> AsmJs::ConvertAsmToWasm(ParseInfo* info,
+                                                bool will_serialize) {
   ErrorThrower thrower(info->isolate(), "Asm.js -> WebAssembly conversion");
   wasm::AsmTyper typer(info->isolate(), info->zone(), *(info->script()),
                        info->literal());
@@ -73,7 +75,7 @@ MaybeHandle<FixedArray> AsmJs::ConvertAsmToWasm(ParseInfo* info) {
 
   i::MaybeHandle<i::FixedArray> compiled =
       CompileModule(info->isolate(), module->begin(), module->end(), &thrower,
-                    internal::wasm::kAsmJsOrigin);
+                    will_serialize, internal::wasm::kAsmJsOrigin);
   DCHECK(!compiled.is_null());
 
   Handle<FixedArray> result = info->isolate()->factory()->NewFixedArray(2);
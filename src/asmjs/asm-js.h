@@ -19,7 +19,8 @@ namespace internal {
 // Interface to compile and instantiate for asmjs.
 class AsmJs {
  public:
-  static MaybeHandle<FixedArray> ConvertAsmToWasm(i::ParseInfo* info);
+  static MaybeHandle<FixedArray> ConvertAsmToWasm(i::ParseInfo* info,
+                                                  bool will_serialize);
   static MaybeHandle<Object> InstantiateAsmWasm(i::Isolate* isolate,
                                                 Handle<FixedArray> wasm_data,
                                                 Handle<JSArrayBuffer> memory,
@@ -1913,12 +1913,15 @@ int ConstantPoolBuilder::Emit(Assembler* assm) {
 
 void Assembler::RecordDeoptReason(DeoptimizeReason reason, int raw_position,
                                   int id) {
-  if (FLAG_trace_deopt || isolate()->is_profiling()) {
-    EnsureSpace ensure_space(this);
-    RecordRelocInfo(RelocInfo::DEOPT_POSITION, raw_position);
+  EnsureSpace ensure_space(this);
+  bool const record_details = FLAG_trace_deopt || isolate()->is_profiling();
+  if (record_details) RecordRelocInfo(RelocInfo::DEOPT_POSITION, raw_position);
+  // The deoptimization site statistics use the reason to decide whether the
+  // feedback at a site should be generalized.
+  if (record_details || FLAG_track_deopt_sites) {
     RecordRelocInfo(RelocInfo::DEOPT_REASON, static_cast<int>(reason));
-    RecordRelocInfo(RelocInfo::DEOPT_ID, id);
   }
+  if (record_details) RecordRelocInfo(RelocInfo::DEOPT_ID, id);
 }
 
 
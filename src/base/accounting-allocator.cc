@@ -10,11 +10,37 @@
 #include <malloc.h>  // NOLINT
 #endif
 
+#include "src/base/bits.h"
+
+#ifdef V8_USE_ADDRESS_SANITIZER
+#include <sanitizer/asan_interface.h>
+#else
+#define ASAN_POISON_MEMORY_REGION(start, size) \
+  do {                                         \
+    USE(start);                                \
+    USE(size);                                 \
+  } while (false)
+
+#define ASAN_UNPOISON_MEMORY_REGION(start, size) \
+  do {                                           \
+    USE(start);                                  \
+    USE(size);                                   \
+  } while (false)
+#endif  // V8_USE_ADDRESS_SANITIZER
+
 namespace v8 {
 namespace base {
 
+AccountingAllocator::AccountingAllocator()
+    : max_pool_size_(kDefaultMaxPoolSize) {
+  for (size_t i = 0; i < kNumberBuckets; ++i) buckets_[i] = nullptr;
+}
+
+AccountingAllocator::~AccountingAllocator() { ClearPool(); }
+
 void* AccountingAllocator::Allocate(size_t bytes) {
-  void* memory = malloc(bytes);
+  void* memory = GetFromPool(bytes);
+  if (memory == nullptr) memory = malloc(bytes);
   if (memory) {
     AtomicWord current =
         NoBarrier_AtomicIncrement(&current_memory_usage_, bytes);
@@ -27,11 +53,22 @@ void* AccountingAllocator::Allocate(size_t bytes) {
 }
 
 void AccountingAllocator::Free(void* memory, size_t bytes) {
-  free(memory);
+  if (!AddToPool(memory, bytes)) free(memory);
   NoBarrier_AtomicIncrement(&current_memory_usage_,
                             -static_cast<AtomicWord>(bytes));
 }
 
+void AccountingAllocator::ConfigureSegmentPool(size_t max_pool_size) {
+  LockGuard<Mutex> guard(&pool_mutex_);
+  max_pool_size_ = max_pool_size;
+  ShrinkPoolLocked(max_pool_size);
+}
+
+void AccountingAllocator::ClearPool() {
+  LockGuard<Mutex> guard(&pool_mutex_);
+  ShrinkPoolLocked(0);
+}
+
 size_t AccountingAllocator::GetCurrentMemoryUsage() const {
   return NoBarrier_Load(&current_memory_usage_);
 }
@@ -40,5 +77,73 @@ size_t AccountingAllocator::GetMaxMemoryUsage() const {
   return NoBarrier_Load(&max_memory_usage_);
 }
 
+size_t AccountingAllocator::GetCurrentPoolSize() const {
+  return NoBarrier_Load(&current_pool_size_);
+}
+
+// static
+int AccountingAllocator::GetBucket(size_t bytes) {
+  if (bytes < (static_cast<size_t>(1) << kMinSegmentSizePower) ||
+      bytes > (static_cast<size_t>(1) << kMaxSegmentSizePower) ||
+      !bits::IsPowerOfTwo32(static_cast<uint32_t>(bytes))) {
+    return -1;
+  }
+  return static_cast<int>(
+      bits::CountTrailingZeros32(static_cast<uint32_t>(bytes)) -
+      kMinSegmentSizePower);
+}
+
+void* AccountingAllocator::GetFromPool(size_t bytes) {
+  int bucket = GetBucket(bytes);
+  if (bucket < 0) return nullptr;
+  LockGuard<Mutex> guard(&pool_mutex_);
+  PooledBlock* block = buckets_[bucket];
+  if (block == nullptr) return nullptr;
+  ASAN_UNPOISON_MEMORY_REGION(block, bytes);
+  buckets_[bucket] = block->next;
+  NoBarrier_AtomicIncrement(&current_pool_size_,
+                            -static_cast<AtomicWord>(bytes));
+  return block;
+}
+
+bool AccountingAllocator::AddToPool(void* memory, size_t bytes) {
+  int bucket = GetBucket(bytes);
+  if (bucket < 0) return false;
+  LockGuard<Mutex> guard(&pool_mutex_);
+  if (NoBarrier_Load(&current_pool_size_) + bytes > max_pool_size_) {
+    return false;
+  }
+  PooledBlock* block = reinterpret_cast<PooledBlock*>(memory);
+  block->next = buckets_[bucket];
+  buckets_[bucket] = block;
+  // Accesses through stale pointers into a pooled block are use-after-free
+  // bugs, even though the block is not returned to malloc.
+  ASAN_POISON_MEMORY_REGION(block, bytes);
+  NoBarrier_AtomicIncrement(&current_pool_size_, bytes);
+  return true;
+}
+
+void AccountingAllocator::ShrinkPoolLocked(size_t max_pool_size) {
+  // Release the largest blocks first, they are the cheapest to re-create
+  // relative to their size.
+  for (int bucket = static_cast<int>(kNumberBuckets) - 1;
+       bucket >= 0 &&
+       static_cast<size_t>(NoBarrier_Load(&current_pool_size_)) >
+           max_pool_size;
+       --bucket) {
+    size_t bytes = static_cast<size_t>(1) << (kMinSegmentSizePower + bucket);
+    while (buckets_[bucket] != nullptr &&
+           static_cast<size_t>(NoBarrier_Load(&current_pool_size_)) >
+               max_pool_size) {
+      PooledBlock* block = buckets_[bucket];
+      ASAN_UNPOISON_MEMORY_REGION(block, bytes);
+      buckets_[bucket] = block->next;
+      free(block);
+      NoBarrier_AtomicIncrement(&current_pool_size_,
+                                -static_cast<AtomicWord>(bytes));
+    }
+  }
+}
+
 }  // namespace base
 }  // namespace v8
@@ -7,25 +7,63 @@
 
 #include "src/base/atomicops.h"
 #include "src/base/macros.h"
+#include "src/base/platform/mutex.h"
 
 namespace v8 {
 namespace base {
 
 class AccountingAllocator {
  public:
-  AccountingAllocator() = default;
-  virtual ~AccountingAllocator() = default;
+  // Freed blocks whose size is a power of two in the range
+  // [2^kMinSegmentSizePower, 2^kMaxSegmentSizePower] are kept in a pool
+  // and handed out again by later allocations of the same size, which saves
+  // malloc traffic for the zone segments of short-lived compile jobs.
+  static const size_t kMinSegmentSizePower = 13;  // 8 KB
+  static const size_t kMaxSegmentSizePower = 20;  // 1 MB
+  static const size_t kNumberBuckets =
+      1 + kMaxSegmentSizePower - kMinSegmentSizePower;
+  static const size_t kDefaultMaxPoolSize = 8 * 1024 * 1024;
+
+  AccountingAllocator();
+  virtual ~AccountingAllocator();
 
   // Returns nullptr on failed allocation.
   virtual void* Allocate(size_t bytes);
   virtual void Free(void* memory, size_t bytes);
 
+  // Bounds the number of bytes kept in the pool. A size of 0 disables
+  // pooling. Cached blocks exceeding the new bound are released.
+  void ConfigureSegmentPool(size_t max_pool_size);
+  // Returns all pooled blocks to the system, e.g. under memory pressure.
+  void ClearPool();
+
   size_t GetCurrentMemoryUsage() const;
   size_t GetMaxMemoryUsage() const;
+  size_t GetCurrentPoolSize() const;
 
  private:
+  // Pooled blocks are chained through their first word.
+  struct PooledBlock {
+    PooledBlock* next;
+  };
+
+  // Returns the bucket for blocks of |bytes| or -1 if they are not pooled.
+  static int GetBucket(size_t bytes);
+
+  void* GetFromPool(size_t bytes);
+  bool AddToPool(void* memory, size_t bytes);
+  // Frees pooled blocks until at most |max_pool_size| bytes remain. The
+  // caller must hold pool_mutex_.
+  void ShrinkPoolLocked(size_t max_pool_size);
+
   AtomicWord current_memory_usage_ = 0;
   AtomicWord max_memory_usage_ = 0;
+  AtomicWord current_pool_size_ = 0;
+
+  // Protects the buckets and max_pool_size_.
+  Mutex pool_mutex_;
+  PooledBlock* buckets_[kNumberBuckets];
+  size_t max_pool_size_;
 
   DISALLOW_COPY_AND_ASSIGN(AccountingAllocator);
 };
@@ -3446,6 +3446,23 @@ void Genesis::InstallExperimentalBuiltinFunctionIds() {
       InstallBuiltinFunctionId(holder, builtin.fun_name, builtin.id);
     }
   }
+
+  if (FLAG_harmony_simd) {
+    struct BuiltinFunctionIds {
+      const char* holder_expr;
+      const char* fun_name;
+      BuiltinFunctionId id;
+    };
+
+    const BuiltinFunctionIds simd_builtins[] = {
+        SIMD_FUNCTIONS_WITH_ID_LIST(INSTALL_BUILTIN_ID)};
+
+    for (const BuiltinFunctionIds& builtin : simd_builtins) {
+      Handle<JSObject> holder =
+          ResolveBuiltinIdHolder(native_context(), builtin.holder_expr);
+      InstallBuiltinFunctionId(holder, builtin.fun_name, builtin.id);
+    }
+  }
 }
 
 
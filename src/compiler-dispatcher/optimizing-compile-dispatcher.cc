@@ -16,7 +16,7 @@ namespace internal {
 namespace {
 
 void DisposeCompilationJob(CompilationJob* job, bool restore_function_code) {
-  if (restore_function_code) {
+  if (restore_function_code && !job->info()->closure().is_null()) {
     Handle<JSFunction> function = job->info()->closure();
     function->ReplaceCode(function->shared()->code());
     // TODO(mvstanton): We can't call ensureliterals here due to allocation,
@@ -165,6 +165,12 @@ void OptimizingCompileDispatcher::Stop() {
   }
 }
 
+void OptimizingCompileDispatcher::AwaitCompileTasks() {
+  if (FLAG_block_concurrent_recompilation) Unblock();
+  base::LockGuard<base::Mutex> lock_guard(&ref_count_mutex_);
+  while (ref_count_ > 0) ref_count_zero_.Wait(&ref_count_mutex_);
+}
+
 void OptimizingCompileDispatcher::InstallOptimizedFunctions() {
   HandleScope handle_scope(isolate_);
 
@@ -177,6 +183,15 @@ void OptimizingCompileDispatcher::InstallOptimizedFunctions() {
       output_queue_.pop();
     }
     CompilationInfo* info = job->info();
+    if (info->closure().is_null()) {
+      // Jobs without a closure, like the tier-up of wasm functions, install
+      // their code themselves when generating it.
+      if (job->last_status() == CompilationJob::SUCCEEDED) {
+        USE(job->GenerateCode());
+      }
+      DisposeCompilationJob(job, false);
+      continue;
+    }
     Handle<JSFunction> function(*info->closure());
     if (function->IsOptimized()) {
       if (FLAG_trace_concurrent_recompilation) {
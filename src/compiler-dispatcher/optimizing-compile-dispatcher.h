@@ -41,6 +41,9 @@ class OptimizingCompileDispatcher {
   void Flush();
   void QueueForOptimization(CompilationJob* job);
   void Unblock();
+  // Waits until all queued jobs have been compiled. Their code is installed
+  // by the next call to {InstallOptimizedFunctions}.
+  void AwaitCompileTasks();
   void InstallOptimizedFunctions();
 
   inline bool IsQueueAvailable() {
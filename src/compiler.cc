@@ -478,7 +478,8 @@ bool GenerateUnoptimizedCode(CompilationInfo* info) {
   EnsureFeedbackMetadata(info);
   if (FLAG_validate_asm && info->scope()->asm_module()) {
     MaybeHandle<FixedArray> wasm_data;
-    wasm_data = AsmJs::ConvertAsmToWasm(info->parse_info());
+    wasm_data =
+        AsmJs::ConvertAsmToWasm(info->parse_info(), info->will_serialize());
     if (!wasm_data.is_null()) {
       info->shared_info()->set_asm_wasm_data(*wasm_data.ToHandleChecked());
       info->SetCode(info->isolate()->builtins()->InstantiateAsmJs());
@@ -1779,6 +1780,11 @@ Handle<SharedFunctionInfo> Compiler::GetSharedFunctionInfo(
   // Consider compiling eagerly when targeting the code cache.
   lazy &= !(FLAG_serialize_eager && info.will_serialize());
 
+  // Compile asm.js modules eagerly when targeting the code cache, so that
+  // their translation to wasm is cached along with the script.
+  lazy &= !(FLAG_validate_asm && info.will_serialize() &&
+            literal->scope()->asm_module());
+
   // Consider compiling eagerly when compiling bytecode for Ignition.
   lazy &=
       !(FLAG_ignition && FLAG_ignition_eager && !isolate->serializer_enabled());
@@ -1907,6 +1913,7 @@ void Compiler::FinalizeCompilationJob(CompilationJob* raw_job) {
 
 void Compiler::PostInstantiation(Handle<JSFunction> function,
                                  PretenureFlag pretenure) {
+  Isolate* isolate = function->GetIsolate();
   Handle<SharedFunctionInfo> shared(function->shared());
 
   if (FLAG_always_opt && shared->allows_lazy_compilation()) {
@@ -1926,8 +1933,19 @@ void Compiler::PostInstantiation(Handle<JSFunction> function,
     DCHECK(shared->is_compiled());
     function->set_literals(cached.literals);
   } else if (shared->is_compiled()) {
-    // TODO(mvstanton): pass pretenure flag to EnsureLiterals.
-    JSFunction::EnsureLiterals(function);
+    if (FLAG_lazy_feedback_vectors && !shared->is_toplevel() &&
+        function->code() == shared->code()) {
+      // Many closures are never called, so leave the literals empty and let
+      // the first call go through CompileLazy, which installs the shared
+      // code together with the literals (see Compiler::Compile). This is the
+      // same state closures created by FastNewClosureStub start out in.
+      function->set_code_no_write_barrier(
+          isolate->builtins()->builtin(Builtins::kCompileLazy));
+      // No write barrier required, since the builtin is part of the root set.
+    } else {
+      // TODO(mvstanton): pass pretenure flag to EnsureLiterals.
+      JSFunction::EnsureLiterals(function);
+    }
   }
 }
 
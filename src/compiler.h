@@ -163,6 +163,7 @@ class CompilationInfo final {
     kOptimizeFromBytecode = 1 << 17,
     kTypeFeedbackEnabled = 1 << 18,
     kAccessorInliningEnabled = 1 << 19,
+    kFastCompilation = 1 << 20,
   };
 
   CompilationInfo(ParseInfo* parse_info, Handle<JSFunction> closure);
@@ -311,6 +312,15 @@ class CompilationInfo final {
     return GetFlag(kOptimizeFromBytecode);
   }
 
+  // Trades code quality for compile time in the backend, for code that is
+  // replaced by better code once it turns out to be hot. The pipeline then
+  // schedules without node splitting, selects instructions without
+  // scheduling them, allocates registers in the fast mode (no splintering,
+  // no move optimization) and skips jump threading.
+  void MarkAsFastCompilation() { SetFlag(kFastCompilation); }
+
+  bool is_fast_compilation() const { return GetFlag(kFastCompilation); }
+
   bool GeneratePreagedPrologue() const {
     // Generate a pre-aged prologue if we are optimizing for size, which
     // will make code flushing more aggressive. Only apply to Code::FUNCTION,
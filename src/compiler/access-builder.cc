@@ -34,6 +34,17 @@ FieldAccess AccessBuilder::ForHeapNumberValue() {
   return access;
 }
 
+// static
+FieldAccess AccessBuilder::ForSimd128Value() {
+  FieldAccess access = {kTaggedBase,
+                        Simd128Value::kValueOffset,
+                        MaybeHandle<Name>(),
+                        TypeCache::Get().kSimd128,
+                        MachineType::Simd128(),
+                        kNoWriteBarrier};
+  return access;
+}
+
 
 // static
 FieldAccess AccessBuilder::ForJSObjectProperties() {
@@ -25,6 +25,9 @@ class AccessBuilder final : public AllStatic {
   // Provides access to HeapNumber::value() field.
   static FieldAccess ForHeapNumberValue();
 
+  // Provides access to the 128-bit payload of a Simd128Value.
+  static FieldAccess ForSimd128Value();
+
   // Provides access to JSObject::properties() field.
   static FieldAccess ForJSObjectProperties();
 
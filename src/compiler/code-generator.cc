@@ -10,6 +10,7 @@
 #include "src/compiler/linkage.h"
 #include "src/compiler/pipeline.h"
 #include "src/frames-inl.h"
+#include "src/wasm/wasm-trap-handler.h"
 
 namespace v8 {
 namespace internal {
@@ -56,10 +57,12 @@ CodeGenerator::CodeGenerator(Frame* frame, Linkage* linkage,
       ools_(nullptr),
       osr_pc_offset_(-1),
       source_position_table_builder_(info->isolate(), code->zone(),
-                                     info->SourcePositionRecordingMode()) {
+                                     info->SourcePositionRecordingMode()),
+      result_(kSuccess) {
   for (int i = 0; i < code->InstructionBlockCount(); ++i) {
     new (&labels_[i]) Label;
   }
+  if (info->will_serialize()) masm_.enable_serializer();
   CreateFrameAccessState(frame);
 }
 
@@ -68,7 +71,7 @@ void CodeGenerator::CreateFrameAccessState(Frame* frame) {
   frame_access_state_ = new (code()->zone()) FrameAccessState(frame);
 }
 
-Handle<Code> CodeGenerator::GenerateCode() {
+void CodeGenerator::AssembleCode() {
   CompilationInfo* info = this->info();
 
   // Open a frame scope to indicate that there is a frame on the stack.  The
@@ -160,14 +163,13 @@ Handle<Code> CodeGenerator::GenerateCode() {
         }
       }
 
-      CodeGenResult result;
       if (FLAG_enable_embedded_constant_pool && !block->needs_frame()) {
         ConstantPoolUnavailableScope constant_pool_unavailable(masm());
-        result = AssembleBlock(block);
+        result_ = AssembleBlock(block);
       } else {
-        result = AssembleBlock(block);
+        result_ = AssembleBlock(block);
       }
-      if (result != kSuccess) return Handle<Code>();
+      if (result_ != kSuccess) return;
       unwinding_info_writer_.EndInstructionBlock(block);
     }
   }
@@ -210,6 +212,11 @@ Handle<Code> CodeGenerator::GenerateCode() {
   safepoints()->Emit(masm(), frame()->GetTotalFrameSlotCount());
 
   unwinding_info_writer_.Finish(masm()->pc_offset());
+}
+
+Handle<Code> CodeGenerator::FinalizeCode() {
+  if (result_ != kSuccess) return Handle<Code>();
+  CompilationInfo* info = this->info();
 
   Handle<Code> result = v8::internal::CodeGenerator::MakeCodeEpilogue(
       masm(), unwinding_info_writer_.eh_frame_writer(), info, Handle<Object>());
@@ -234,6 +241,7 @@ Handle<Code> CodeGenerator::GenerateCode() {
                               handlers_[i].catch_prediction);
     }
     result->set_handler_table(*table);
+    wasm::RegisterProtectedInstructions(*result);
   }
 
   PopulateDeoptimizationData(result);
@@ -280,6 +288,13 @@ void CodeGenerator::RecordSafepoint(ReferenceMap* references,
   }
 }
 
+void CodeGenerator::AddProtectedInstruction(int pc_offset, Label* landing) {
+  // Wasm frames never consult their handler table when unwinding, so the
+  // landing pads of protected instructions are recorded there for the trap
+  // handler to find.
+  handlers_.push_back({HandlerTable::UNCAUGHT, landing, pc_offset});
+}
+
 bool CodeGenerator::IsMaterializableFromFrame(Handle<HeapObject> object,
                                               int* slot_return) {
   if (linkage()->GetIncomingDescriptor()->IsJSFunctionCall()) {
@@ -837,6 +852,8 @@ void CodeGenerator::AddTranslationForOperand(Translation* translation,
   } else if (op->IsFPStackSlot()) {
     if (type.representation() == MachineRepresentation::kFloat64) {
       translation->StoreDoubleStackSlot(LocationOperand::cast(op)->index());
+    } else if (type.representation() == MachineRepresentation::kSimd128) {
+      translation->StoreSimd128StackSlot(LocationOperand::cast(op)->index());
     } else {
       DCHECK_EQ(MachineRepresentation::kFloat32, type.representation());
       translation->StoreFloatStackSlot(LocationOperand::cast(op)->index());
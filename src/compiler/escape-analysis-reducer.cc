@@ -6,6 +6,7 @@
 
 #include "src/compiler/all-nodes.h"
 #include "src/compiler/js-graph.h"
+#include "src/compiler/node-matchers.h"
 #include "src/counters.h"
 
 namespace v8 {
@@ -52,6 +53,12 @@ Reduction EscapeAnalysisReducer::Reduce(Node* node) {
       return ReduceReferenceEqual(node);
     case IrOpcode::kObjectIsSmi:
       return ReduceObjectIsSmi(node);
+    case IrOpcode::kObjectIsCallable:
+    case IrOpcode::kObjectIsNumber:
+    case IrOpcode::kObjectIsReceiver:
+    case IrOpcode::kObjectIsString:
+    case IrOpcode::kObjectIsUndetectable:
+      return ReduceObjectIsMapCheck(node);
     // FrameStates and Value nodes are preprocessed here,
     // and visited via ReduceFrameStateUses from their user nodes.
     case IrOpcode::kFrameState:
@@ -183,7 +190,7 @@ Reduction EscapeAnalysisReducer::ReduceReferenceEqual(Node* node) {
         escape_analysis()->CompareVirtualObjects(left, right)) {
       ReplaceWithValue(node, jsgraph()->TrueConstant());
       TRACE("Replaced ref eq #%d with true\n", node->id());
-      Replace(jsgraph()->TrueConstant());
+      return Replace(jsgraph()->TrueConstant());
     }
     // Right-hand side is not a virtual object, or a different one.
     ReplaceWithValue(node, jsgraph()->FalseConstant());
@@ -211,6 +218,46 @@ Reduction EscapeAnalysisReducer::ReduceObjectIsSmi(Node* node) {
 }
 
 
+Reduction EscapeAnalysisReducer::ReduceObjectIsMapCheck(Node* node) {
+  Node* input = NodeProperties::GetValueInput(node, 0);
+  if (!escape_analysis()->IsVirtual(input)) return NoChange();
+  // The escape status analysis only keeps the {input} virtual if its map
+  // is known, and the instance type and the bits tested here never change
+  // during the lifetime of an object.
+  Node* map_node = escape_analysis()->GetVirtualObjectMap(input);
+  if (map_node == nullptr) return NoChange();
+  HeapObjectMatcher m(map_node);
+  if (!m.HasValue() || !m.Value()->IsMap()) return NoChange();
+  Handle<Map> map = Handle<Map>::cast(m.Value());
+  bool result;
+  switch (node->opcode()) {
+    case IrOpcode::kObjectIsCallable:
+      result = map->is_callable() && !map->is_undetectable();
+      break;
+    case IrOpcode::kObjectIsNumber:
+      result = map->instance_type() == HEAP_NUMBER_TYPE;
+      break;
+    case IrOpcode::kObjectIsReceiver:
+      result = map->IsJSReceiverMap();
+      break;
+    case IrOpcode::kObjectIsString:
+      result = map->instance_type() < FIRST_NONSTRING_TYPE;
+      break;
+    case IrOpcode::kObjectIsUndetectable:
+      result = map->is_undetectable();
+      break;
+    default:
+      UNREACHABLE();
+      return NoChange();
+  }
+  Node* value = jsgraph()->BooleanConstant(result);
+  ReplaceWithValue(node, value);
+  TRACE("Replaced %s #%d with %s\n", node->op()->mnemonic(), node->id(),
+        result ? "true" : "false");
+  return Replace(value);
+}
+
+
 Reduction EscapeAnalysisReducer::ReduceFrameStateUses(Node* node) {
   DCHECK_GE(node->op()->EffectInputCount(), 1);
   if (node->id() < static_cast<NodeId>(fully_reduced_.length())) {
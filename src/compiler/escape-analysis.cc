@@ -61,6 +61,7 @@ class EscapeStatusAnalysis : public ZoneObject {
   bool IsVirtual(Node* node);
   bool IsEscaped(Node* node);
   bool IsAllocation(Node* node);
+  bool HasKnownMap(Node* node);
 
   bool IsInQueue(NodeId id);
   void SetInQueue(NodeId id, bool on_stack);
@@ -585,6 +586,13 @@ bool EscapeStatusAnalysis::IsAllocation(Node* node) {
          node->opcode() == IrOpcode::kFinishRegion;
 }
 
+bool EscapeStatusAnalysis::HasKnownMap(Node* node) {
+  Node* map = object_analysis_->GetVirtualObjectMap(node);
+  if (map == nullptr) return false;
+  HeapObjectMatcher m(map);
+  return m.HasValue() && m.Value()->IsMap();
+}
+
 bool EscapeStatusAnalysis::SetEscaped(Node* node) {
   bool changed = !(status_[node->id()] & kEscaped);
   status_[node->id()] |= kEscaped | kTracked;
@@ -792,13 +800,21 @@ bool EscapeStatusAnalysis::CheckUsesForEscape(Node* uses, Node* rep,
           return true;
         }
         break;
-      case IrOpcode::kSelect:
-      // TODO(mstarzinger): The following list of operators will eventually be
-      // handled by the EscapeAnalysisReducer (similar to ObjectIsSmi).
       case IrOpcode::kObjectIsCallable:
       case IrOpcode::kObjectIsNumber:
+      case IrOpcode::kObjectIsReceiver:
       case IrOpcode::kObjectIsString:
       case IrOpcode::kObjectIsUndetectable:
+        // These are folded by the EscapeAnalysisReducer based on the map of
+        // the virtual object, which has to be known for that.
+        if (!HasKnownMap(rep) && SetEscaped(rep)) {
+          TRACE("Setting #%d (%s) to escaped because of use by #%d (%s)\n",
+                rep->id(), rep->op()->mnemonic(), use->id(),
+                use->op()->mnemonic());
+          return true;
+        }
+        break;
+      case IrOpcode::kSelect:
         if (SetEscaped(rep)) {
           TRACE("Setting #%d (%s) to escaped because of use by #%d (%s)\n",
                 rep->id(), rep->op()->mnemonic(), use->id(),
@@ -1345,6 +1361,32 @@ int OffsetForElementAccess(Node* node, int index) {
 
 }  // namespace
 
+bool EscapeAnalysis::GetConstantElementIndex(Node* node, int* index) {
+  Node* index_node = NodeProperties::GetValueInput(node, 1);
+  if (index_node->opcode() == IrOpcode::kCheckBounds) {
+    // A bounds check of a constant index against a length that is known
+    // (e.g. from a virtual JSArray or arguments object) can be resolved
+    // statically, as long as it doesn't fail.
+    Node* length_node =
+        ResolveReplacement(NodeProperties::GetValueInput(index_node, 1));
+    NumberMatcher length(length_node);
+    NumberMatcher value(NodeProperties::GetValueInput(index_node, 0));
+    if (!length.HasValue() || !value.HasValue() ||
+        !(value.Value() < length.Value())) {
+      return false;
+    }
+    index_node = NodeProperties::GetValueInput(index_node, 0);
+  }
+  DCHECK(index_node->opcode() != IrOpcode::kInt32Constant &&
+         index_node->opcode() != IrOpcode::kInt64Constant &&
+         index_node->opcode() != IrOpcode::kFloat32Constant &&
+         index_node->opcode() != IrOpcode::kFloat64Constant);
+  NumberMatcher m(index_node);
+  if (!m.HasValue() || m.Value() < 0 || m.Value() > kMaxInt) return false;
+  *index = static_cast<int>(m.Value());
+  return *index == m.Value();
+}
+
 void EscapeAnalysis::ProcessLoadFromPhi(int offset, Node* from, Node* load,
                                         VirtualState* state) {
   TRACE("Load #%d from phi #%d", load->id(), from->id());
@@ -1411,16 +1453,11 @@ void EscapeAnalysis::ProcessLoadElement(Node* node) {
   ForwardVirtualState(node);
   Node* from = ResolveReplacement(NodeProperties::GetValueInput(node, 0));
   VirtualState* state = virtual_states_[node->id()];
-  Node* index_node = node->InputAt(1);
-  NumberMatcher index(index_node);
-  DCHECK(index_node->opcode() != IrOpcode::kInt32Constant &&
-         index_node->opcode() != IrOpcode::kInt64Constant &&
-         index_node->opcode() != IrOpcode::kFloat32Constant &&
-         index_node->opcode() != IrOpcode::kFloat64Constant);
-  if (index.HasValue()) {
+  int index;
+  if (GetConstantElementIndex(node, &index)) {
     if (VirtualObject* object = GetVirtualObject(state, from)) {
       if (!object->IsTracked()) return;
-      int offset = OffsetForElementAccess(node, index.Value());
+      int offset = OffsetForElementAccess(node, index);
       if (static_cast<size_t>(offset) >= object->field_count()) return;
       Node* value = object->GetField(offset);
       if (value) {
@@ -1429,7 +1466,7 @@ void EscapeAnalysis::ProcessLoadElement(Node* node) {
       // Record that the load has this alias.
       UpdateReplacement(state, node, value);
     } else if (from->opcode() == IrOpcode::kPhi) {
-      int offset = OffsetForElementAccess(node, index.Value());
+      int offset = OffsetForElementAccess(node, index);
       ProcessLoadFromPhi(offset, from, node, state);
     } else {
       UpdateReplacement(state, node, nullptr);
@@ -1440,8 +1477,8 @@ void EscapeAnalysis::ProcessLoadElement(Node* node) {
       TRACE(
           "Setting #%d (%s) to escaped because load element #%d from non-const "
           "index #%d (%s)\n",
-          from->id(), from->op()->mnemonic(), node->id(), index_node->id(),
-          index_node->op()->mnemonic());
+          from->id(), from->op()->mnemonic(), node->id(),
+          node->InputAt(1)->id(), node->InputAt(1)->op()->mnemonic());
     }
   }
 }
@@ -1476,17 +1513,12 @@ void EscapeAnalysis::ProcessStoreElement(Node* node) {
   DCHECK_EQ(node->opcode(), IrOpcode::kStoreElement);
   ForwardVirtualState(node);
   Node* to = ResolveReplacement(NodeProperties::GetValueInput(node, 0));
-  Node* index_node = node->InputAt(1);
-  NumberMatcher index(index_node);
-  DCHECK(index_node->opcode() != IrOpcode::kInt32Constant &&
-         index_node->opcode() != IrOpcode::kInt64Constant &&
-         index_node->opcode() != IrOpcode::kFloat32Constant &&
-         index_node->opcode() != IrOpcode::kFloat64Constant);
   VirtualState* state = virtual_states_[node->id()];
-  if (index.HasValue()) {
+  int index;
+  if (GetConstantElementIndex(node, &index)) {
     if (VirtualObject* object = GetVirtualObject(state, to)) {
       if (!object->IsTracked()) return;
-      int offset = OffsetForElementAccess(node, index.Value());
+      int offset = OffsetForElementAccess(node, index);
       if (static_cast<size_t>(offset) >= object->field_count()) return;
       Node* val = ResolveReplacement(NodeProperties::GetValueInput(node, 2));
       if (object->GetField(offset) != val) {
@@ -1500,8 +1532,8 @@ void EscapeAnalysis::ProcessStoreElement(Node* node) {
       TRACE(
           "Setting #%d (%s) to escaped because store element #%d to non-const "
           "index #%d (%s)\n",
-          to->id(), to->op()->mnemonic(), node->id(), index_node->id(),
-          index_node->op()->mnemonic());
+          to->id(), to->op()->mnemonic(), node->id(), node->InputAt(1)->id(),
+          node->InputAt(1)->op()->mnemonic());
     }
     if (VirtualObject* object = GetVirtualObject(state, to)) {
       if (!object->IsTracked()) return;
@@ -1595,6 +1627,22 @@ VirtualObject* EscapeAnalysis::GetVirtualObject(VirtualState* state,
   return state->VirtualObjectFromAlias(alias);
 }
 
+Node* EscapeAnalysis::GetVirtualObjectMap(Node* node) {
+  if (node->opcode() != IrOpcode::kFinishRegion) return nullptr;
+  if (node->id() >= virtual_states_.size()) return nullptr;
+  VirtualState* state = virtual_states_[node->id()];
+  if (state == nullptr) return nullptr;
+  if (VirtualObject* object = GetVirtualObject(state, node)) {
+    int const offset = HeapObject::kMapOffset / kPointerSize;
+    if (!object->IsTracked() ||
+        static_cast<size_t>(offset) >= object->field_count()) {
+      return nullptr;
+    }
+    return object->GetField(offset);
+  }
+  return nullptr;
+}
+
 bool EscapeAnalysis::ExistsVirtualAllocate() {
   for (size_t id = 0; id < status_analysis_->GetAliasMap().size(); ++id) {
     Alias alias = status_analysis_->GetAlias(static_cast<NodeId>(id));
@@ -33,6 +33,9 @@ class EscapeAnalysis {
   bool CompareVirtualObjects(Node* left, Node* right);
   Node* GetOrCreateObjectState(Node* effect, Node* node);
   bool ExistsVirtualAllocate();
+  // Returns the map stored into the allocation {node} by the end of its
+  // allocation region, or nullptr if it is not known.
+  Node* GetVirtualObjectMap(Node* node);
 
  private:
   void RunObjectAnalysis();
@@ -49,6 +52,7 @@ class EscapeAnalysis {
   bool ProcessEffectPhi(Node* node);
   void ProcessLoadFromPhi(int offset, Node* from, Node* node,
                           VirtualState* states);
+  bool GetConstantElementIndex(Node* node, int* index);
 
   void ForwardVirtualState(Node* node);
   VirtualState* CopyForModificationAt(VirtualState* state, Node* node);
@@ -392,6 +392,20 @@ class OutOfLineRecordWrite final : public OutOfLineCode {
     __ add(esp, Immediate(kDoubleSize));                                      \
   } while (false)
 
+// Applies {bin_inst} to the value in memory and the input in a cmpxchg loop,
+// which leaves the previous value in eax.
+#define ASSEMBLE_ATOMIC_BINOP(bin_inst)                 \
+  do {                                                  \
+    Label binop;                                        \
+    __ bind(&binop);                                    \
+    __ mov(eax, i.MemoryOperand(1));                    \
+    __ mov(i.TempRegister(0), eax);                     \
+    __ bin_inst(i.TempRegister(0), i.InputRegister(0)); \
+    __ lock();                                          \
+    __ cmpxchg(i.MemoryOperand(1), i.TempRegister(0));  \
+    __ j(not_equal, &binop);                            \
+  } while (false)
+
 void CodeGenerator::AssembleDeconstructFrame() {
   __ mov(esp, ebp);
   __ pop(ebp);
@@ -1480,6 +1494,28 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
       __ xchg(i.InputRegister(index), operand);
       break;
     }
+    case kIA32AtomicXchg:
+      __ xchg(i.InputRegister(0), i.MemoryOperand(1));
+      break;
+    case kIA32AtomicCmpxchg:
+      __ lock();
+      __ cmpxchg(i.MemoryOperand(2), i.InputRegister(1));
+      break;
+    case kIA32AtomicAdd:
+      ASSEMBLE_ATOMIC_BINOP(add);
+      break;
+    case kIA32AtomicSub:
+      ASSEMBLE_ATOMIC_BINOP(sub);
+      break;
+    case kIA32AtomicAnd:
+      ASSEMBLE_ATOMIC_BINOP(and_);
+      break;
+    case kIA32AtomicOr:
+      ASSEMBLE_ATOMIC_BINOP(or_);
+      break;
+    case kIA32AtomicXor:
+      ASSEMBLE_ATOMIC_BINOP(xor_);
+      break;
     case kCheckedLoadInt8:
       ASSEMBLE_CHECKED_LOAD_INTEGER(movsx_b);
       break;
@@ -111,7 +111,14 @@ namespace compiler {
   V(IA32StackCheck)                \
   V(IA32Xchgb)                     \
   V(IA32Xchgw)                     \
-  V(IA32Xchgl)
+  V(IA32Xchgl)                     \
+  V(IA32AtomicXchg)                \
+  V(IA32AtomicCmpxchg)             \
+  V(IA32AtomicAdd)                 \
+  V(IA32AtomicSub)                 \
+  V(IA32AtomicAnd)                 \
+  V(IA32AtomicOr)                  \
+  V(IA32AtomicXor)
 
 // Addressing modes represent the "shape" of inputs to an instruction.
 // Many instructions support multiple addressing modes. Addressing modes
@@ -125,6 +125,13 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kIA32Xchgb:
     case kIA32Xchgw:
     case kIA32Xchgl:
+    case kIA32AtomicXchg:
+    case kIA32AtomicCmpxchg:
+    case kIA32AtomicAdd:
+    case kIA32AtomicSub:
+    case kIA32AtomicAnd:
+    case kIA32AtomicOr:
+    case kIA32AtomicXor:
       return kIsLoadOperation | kHasSideEffect;
 
 #define CASE(Name) case k##Name:
@@ -349,6 +349,10 @@ void InstructionSelector::VisitUnalignedLoad(Node* node) { UNREACHABLE(); }
 // Architecture supports unaligned access, therefore VisitStore is used instead
 void InstructionSelector::VisitUnalignedStore(Node* node) { UNREACHABLE(); }
 
+void InstructionSelector::VisitProtectedLoad(Node* node) { UNIMPLEMENTED(); }
+
+void InstructionSelector::VisitProtectedStore(Node* node) { UNIMPLEMENTED(); }
+
 void InstructionSelector::VisitCheckedLoad(Node* node) {
   CheckedLoadRepresentation load_rep = CheckedLoadRepresentationOf(node->op());
   IA32OperandGenerator g(this);
@@ -1678,6 +1682,82 @@ void InstructionSelector::VisitAtomicStore(Node* node) {
   Emit(code, 0, nullptr, input_count, inputs);
 }
 
+namespace {
+
+// Shared routine for the atomic operations on [base + index], which take
+// their value inputs before the memory operand.
+void VisitAtomicRMW(InstructionSelector* selector, Node* node,
+                    ArchOpcode opcode) {
+  IA32OperandGenerator g(selector);
+  Node* base = node->InputAt(0);
+  Node* index = node->InputAt(1);
+  Node* value = node->InputAt(2);
+  AddressingMode addressing_mode;
+  InstructionOperand inputs[4];
+  size_t input_count = 0;
+  InstructionOperand outputs[1];
+  InstructionOperand temps[1];
+  size_t temp_count = 0;
+  switch (opcode) {
+    case kIA32AtomicXchg:
+      inputs[input_count++] = g.UseRegister(value);
+      outputs[0] = g.DefineSameAsFirst(node);
+      break;
+    case kIA32AtomicCmpxchg:
+      inputs[input_count++] = g.UseFixed(value, eax);
+      inputs[input_count++] = g.UseUniqueRegister(node->InputAt(3));
+      outputs[0] = g.DefineAsFixed(node, eax);
+      break;
+    default:
+      // The cmpxchg loop keeps the previous value in eax.
+      inputs[input_count++] = g.UseUniqueRegister(value);
+      outputs[0] = g.DefineAsFixed(node, eax);
+      temps[temp_count++] = g.TempRegister();
+      break;
+  }
+  inputs[input_count++] = g.UseUniqueRegister(base);
+  if (g.CanBeImmediate(index)) {
+    inputs[input_count++] = g.UseImmediate(index);
+    addressing_mode = kMode_MRI;
+  } else {
+    inputs[input_count++] = g.UseUniqueRegister(index);
+    addressing_mode = kMode_MR1;
+  }
+  InstructionCode code = opcode | AddressingModeField::encode(addressing_mode);
+  selector->Emit(code, arraysize(outputs), outputs, input_count, inputs,
+                 temp_count, temps);
+}
+
+}  // namespace
+
+void InstructionSelector::VisitWord32AtomicExchange(Node* node) {
+  VisitAtomicRMW(this, node, kIA32AtomicXchg);
+}
+
+void InstructionSelector::VisitWord32AtomicCompareExchange(Node* node) {
+  VisitAtomicRMW(this, node, kIA32AtomicCmpxchg);
+}
+
+void InstructionSelector::VisitWord32AtomicAdd(Node* node) {
+  VisitAtomicRMW(this, node, kIA32AtomicAdd);
+}
+
+void InstructionSelector::VisitWord32AtomicSub(Node* node) {
+  VisitAtomicRMW(this, node, kIA32AtomicSub);
+}
+
+void InstructionSelector::VisitWord32AtomicAnd(Node* node) {
+  VisitAtomicRMW(this, node, kIA32AtomicAnd);
+}
+
+void InstructionSelector::VisitWord32AtomicOr(Node* node) {
+  VisitAtomicRMW(this, node, kIA32AtomicOr);
+}
+
+void InstructionSelector::VisitWord32AtomicXor(Node* node) {
+  VisitAtomicRMW(this, node, kIA32AtomicXor);
+}
+
 // static
 MachineOperatorBuilder::Flags
 InstructionSelector::SupportedMachineOperatorFlags() {
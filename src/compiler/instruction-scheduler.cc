@@ -161,6 +161,12 @@ void InstructionScheduler::AddInstruction(Instruction* instr) {
       if (last_side_effect_instr_ != nullptr) {
         last_side_effect_instr_->AddSuccessor(new_node);
       }
+    }
+
+    // Deoptimization checks can also read memory (e.g. a compare against a
+    // memory operand), so they are recorded independently of the above to
+    // make sure that no later instruction is hoisted above them.
+    if (instr->IsDeoptimizeCall()) {
       last_deopt_ = new_node;
     }
 
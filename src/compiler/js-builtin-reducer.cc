@@ -6,9 +6,11 @@
 
 #include "src/compiler/access-builder.h"
 #include "src/compiler/js-graph.h"
+#include "src/compiler/machine-operator.h"
 #include "src/compiler/node-matchers.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/simplified-operator.h"
+#include "src/macro-assembler.h"
 #include "src/objects-inl.h"
 #include "src/type-cache.h"
 #include "src/types.h"
@@ -742,6 +744,52 @@ Reduction JSBuiltinReducer::ReduceArrayBufferViewAccessor(
   return NoChange();
 }
 
+// SIMD.Float32x4.add(a, b), SIMD.Int32x4.sub(a, b), etc.
+Reduction JSBuiltinReducer::ReduceSimd128Binop(Node* node, Handle<Map> map,
+                                               const Operator* op) {
+  JSCallReduction r(node);
+  if (CpuFeatures::SupportsSimd128() && r.GetJSCallArity() == 2) {
+    Node* effect = NodeProperties::GetEffectInput(node);
+    Node* control = NodeProperties::GetControlInput(node);
+
+    // Operate on the unboxed 128-bit values and box the result. Escape
+    // analysis removes the boxes that only feed into other SIMD operations.
+    Node* left = BuildSimd128Unbox(r.left(), map, &effect, control);
+    Node* right = BuildSimd128Unbox(r.right(), map, &effect, control);
+    Node* value = graph()->NewNode(op, left, right);
+    value = BuildSimd128Box(value, map, &effect, control);
+
+    ReplaceWithValue(node, value, effect, control);
+    return Replace(value);
+  }
+  return NoChange();
+}
+
+// SIMD.Float32x4.extractLane(a, lane), SIMD.Int32x4.extractLane(a, lane)
+Reduction JSBuiltinReducer::ReduceSimd128ExtractLane(Node* node,
+                                                     Handle<Map> map,
+                                                     const Operator* op) {
+  JSCallReduction r(node);
+  if (CpuFeatures::SupportsSimd128() && r.GetJSCallArity() == 2) {
+    // The instruction selector only handles constant lanes.
+    NumberMatcher mlane(r.right());
+    if (!mlane.IsInRange(0.0, 3.0) ||
+        mlane.Value() != static_cast<int32_t>(mlane.Value())) {
+      return NoChange();
+    }
+    Node* effect = NodeProperties::GetEffectInput(node);
+    Node* control = NodeProperties::GetControlInput(node);
+
+    Node* input = BuildSimd128Unbox(r.left(), map, &effect, control);
+    Node* lane = jsgraph()->Int32Constant(static_cast<int32_t>(mlane.Value()));
+    Node* value = graph()->NewNode(op, input, lane);
+
+    ReplaceWithValue(node, value, effect, control);
+    return Replace(value);
+  }
+  return NoChange();
+}
+
 Reduction JSBuiltinReducer::Reduce(Node* node) {
   Reduction reduction = NoChange();
   JSCallReduction r(node);
@@ -877,6 +925,30 @@ Reduction JSBuiltinReducer::Reduce(Node* node) {
     case kTypedArrayLength:
       return ReduceArrayBufferViewAccessor(
           node, JS_TYPED_ARRAY_TYPE, AccessBuilder::ForJSTypedArrayLength());
+    case kFloat32x4Add:
+      return ReduceSimd128Binop(node, factory()->float32x4_map(),
+                                machine()->Float32x4Add());
+    case kFloat32x4Sub:
+      return ReduceSimd128Binop(node, factory()->float32x4_map(),
+                                machine()->Float32x4Sub());
+    case kFloat32x4Mul:
+      return ReduceSimd128Binop(node, factory()->float32x4_map(),
+                                machine()->Float32x4Mul());
+    case kFloat32x4Div:
+      return ReduceSimd128Binop(node, factory()->float32x4_map(),
+                                machine()->Float32x4Div());
+    case kFloat32x4ExtractLane:
+      return ReduceSimd128ExtractLane(node, factory()->float32x4_map(),
+                                      machine()->Float32x4ExtractLane());
+    case kInt32x4Add:
+      return ReduceSimd128Binop(node, factory()->int32x4_map(),
+                                machine()->Int32x4Add());
+    case kInt32x4Sub:
+      return ReduceSimd128Binop(node, factory()->int32x4_map(),
+                                machine()->Int32x4Sub());
+    case kInt32x4ExtractLane:
+      return ReduceSimd128ExtractLane(node, factory()->int32x4_map(),
+                                      machine()->Int32x4ExtractLane());
     default:
       break;
   }
@@ -901,12 +973,47 @@ Node* JSBuiltinReducer::ToUint32(Node* input) {
   return graph()->NewNode(simplified()->NumberToUint32(), input);
 }
 
+Node* JSBuiltinReducer::BuildSimd128Unbox(Node* value, Handle<Map> map,
+                                          Node** effect, Node* control) {
+  // Values boxed by BuildSimd128Box below don't need to be checked again,
+  // which also keeps them free of uses that would make them escape.
+  if (!NodeProperties::GetType(value)->Is(Type::Class(map, graph()->zone()))) {
+    value = *effect = graph()->NewNode(simplified()->CheckTaggedPointer(),
+                                       value, *effect, control);
+    *effect = graph()->NewNode(simplified()->CheckMaps(1), value,
+                               jsgraph()->HeapConstant(map), *effect, control);
+  }
+  return *effect = graph()->NewNode(
+             simplified()->LoadField(AccessBuilder::ForSimd128Value()), value,
+             *effect, control);
+}
+
+Node* JSBuiltinReducer::BuildSimd128Box(Node* value, Handle<Map> map,
+                                        Node** effect, Node* control) {
+  *effect = graph()->NewNode(
+      common()->BeginRegion(RegionObservability::kNotObservable), *effect);
+  Node* box = *effect = graph()->NewNode(
+      simplified()->Allocate(NOT_TENURED),
+      jsgraph()->Constant(Simd128Value::kSize), *effect, control);
+  NodeProperties::SetType(box, Type::Class(map, graph()->zone()));
+  *effect = graph()->NewNode(simplified()->StoreField(AccessBuilder::ForMap()),
+                             box, jsgraph()->HeapConstant(map), *effect,
+                             control);
+  *effect = graph()->NewNode(
+      simplified()->StoreField(AccessBuilder::ForSimd128Value()), box, value,
+      *effect, control);
+  return *effect = graph()->NewNode(common()->FinishRegion(), box, *effect);
+}
+
 Graph* JSBuiltinReducer::graph() const { return jsgraph()->graph(); }
 
 
 Isolate* JSBuiltinReducer::isolate() const { return jsgraph()->isolate(); }
 
 
+Factory* JSBuiltinReducer::factory() const { return isolate()->factory(); }
+
+
 CommonOperatorBuilder* JSBuiltinReducer::common() const {
   return jsgraph()->common();
 }
@@ -916,6 +1023,11 @@ SimplifiedOperatorBuilder* JSBuiltinReducer::simplified() const {
   return jsgraph()->simplified();
 }
 
+
+MachineOperatorBuilder* JSBuiltinReducer::machine() const {
+  return jsgraph()->machine();
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -11,6 +11,7 @@ namespace v8 {
 namespace internal {
 
 // Forward declarations.
+class Factory;
 class TypeCache;
 
 namespace compiler {
@@ -19,6 +20,7 @@ namespace compiler {
 class CommonOperatorBuilder;
 struct FieldAccess;
 class JSGraph;
+class MachineOperatorBuilder;
 class SimplifiedOperatorBuilder;
 
 
@@ -70,15 +72,25 @@ class JSBuiltinReducer final : public AdvancedReducer {
   Reduction ReduceArrayBufferViewAccessor(Node* node,
                                           InstanceType instance_type,
                                           FieldAccess const& access);
+  Reduction ReduceSimd128Binop(Node* node, Handle<Map> map,
+                               const Operator* op);
+  Reduction ReduceSimd128ExtractLane(Node* node, Handle<Map> map,
+                                     const Operator* op);
 
   Node* ToNumber(Node* value);
   Node* ToUint32(Node* value);
+  Node* BuildSimd128Unbox(Node* value, Handle<Map> map, Node** effect,
+                          Node* control);
+  Node* BuildSimd128Box(Node* value, Handle<Map> map, Node** effect,
+                        Node* control);
 
   Graph* graph() const;
   JSGraph* jsgraph() const { return jsgraph_; }
   Isolate* isolate() const;
+  Factory* factory() const;
   CommonOperatorBuilder* common() const;
   SimplifiedOperatorBuilder* simplified() const;
+  MachineOperatorBuilder* machine() const;
 
   JSGraph* const jsgraph_;
   TypeCache const& type_cache_;
@@ -5,13 +5,86 @@
 #include "src/compiler/js-inlining-heuristic.h"
 
 #include "src/compiler.h"
+#include "src/compiler/common-operator.h"
+#include "src/compiler/js-graph.h"
 #include "src/compiler/node-matchers.h"
+#include "src/compiler/simplified-operator.h"
 #include "src/objects-inl.h"
 
 namespace v8 {
 namespace internal {
 namespace compiler {
 
+namespace {
+
+// Collects the distinct {JSFunction} constants that {node} can evaluate to,
+// either because {node} is such a constant itself or because it is a {Phi}
+// with constant inputs. Sets {needs_fallback} if some input of the {Phi}
+// is not a known function. Returns zero if {node} cannot be handled.
+int CollectFunctions(Node* node, Handle<JSFunction>* functions,
+                     int functions_size, bool* needs_fallback) {
+  DCHECK_NE(0, functions_size);
+  *needs_fallback = false;
+  HeapObjectMatcher m(node);
+  if (m.HasValue() && m.Value()->IsJSFunction()) {
+    functions[0] = Handle<JSFunction>::cast(m.Value());
+    return 1;
+  }
+  if (node->opcode() == IrOpcode::kPhi) {
+    int num_functions = 0;
+    int const value_input_count = node->op()->ValueInputCount();
+    for (int n = 0; n < value_input_count; ++n) {
+      HeapObjectMatcher m(node->InputAt(n));
+      if (!m.HasValue() || !m.Value()->IsJSFunction()) {
+        *needs_fallback = true;
+        continue;
+      }
+      Handle<JSFunction> function = Handle<JSFunction>::cast(m.Value());
+      bool seen = false;
+      for (int i = 0; i < num_functions; ++i) {
+        if (functions[i].is_identical_to(function)) seen = true;
+      }
+      if (seen) continue;
+      if (num_functions == functions_size) return 0;
+      functions[num_functions++] = function;
+    }
+    return num_functions;
+  }
+  return 0;
+}
+
+// Functions marked with %SetForceInlineFlag bypass the heuristic, but only as
+// long as they stay within the size limit for a single inlining. Otherwise
+// one forced builtin with a large loop body would grow every caller.
+bool CanForceInlineFunction(Handle<JSFunction> function) {
+  if (!function->shared()->force_inline()) return false;
+  return function->shared()->ast_node_count() <= FLAG_max_inlined_nodes;
+}
+
+bool CanInlineFunction(Handle<JSFunction> function) {
+  // Built-in functions are handled by the JSBuiltinReducer.
+  if (function->shared()->HasBuiltinFunctionId()) return false;
+
+  // Don't inline builtins.
+  if (function->shared()->IsBuiltin()) return false;
+
+  // Quick check on source code length to avoid parsing large candidate.
+  if (function->shared()->SourceSize() > FLAG_max_inlined_source_size) {
+    return false;
+  }
+
+  // Quick check on the size of the AST to avoid parsing large candidate.
+  if (function->shared()->ast_node_count() > FLAG_max_inlined_nodes) {
+    return false;
+  }
+
+  // Avoid inlining across the boundary of asm.js code.
+  if (function->shared()->asm_function()) return false;
+  return true;
+}
+
+}  // namespace
+
 Reduction JSInliningHeuristic::Reduce(Node* node) {
   if (!IrOpcode::IsInlineeOpcode(node->opcode())) return NoChange();
 
@@ -19,15 +92,28 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   if (seen_.find(node->id()) != seen_.end()) return NoChange();
   seen_.insert(node->id());
 
+  // Check if the {node} is an appropriate candidate for inlining.
   Node* callee = node->InputAt(0);
-  HeapObjectMatcher match(callee);
-  if (!match.HasValue() || !match.Value()->IsJSFunction()) return NoChange();
-  Handle<JSFunction> function = Handle<JSFunction>::cast(match.Value());
+  Candidate candidate;
+  candidate.node = node;
+  candidate.num_functions =
+      CollectFunctions(callee, candidate.functions, kMaxCallPolymorphism,
+                       &candidate.needs_fallback);
+  if (candidate.num_functions == 0) return NoChange();
+  if ((candidate.num_functions > 1 || candidate.needs_fallback) &&
+      !FLAG_polymorphic_inlining) {
+    return NoChange();
+  }
 
   // Functions marked with %SetForceInlineFlag are immediately inlined.
-  if (function->shared()->force_inline()) {
-    return inliner_.ReduceJSCall(node, function);
+  bool force_inline = true;
+  for (int i = 0; i < candidate.num_functions; ++i) {
+    candidate.can_inline_function[i] = true;
+    if (!CanForceInlineFunction(candidate.functions[i])) {
+      force_inline = false;
+    }
   }
+  if (force_inline) return InlineCandidate(candidate);
 
   // Handling of special inlining modes right away:
   //  - For restricted inlining: stop all handling at this point.
@@ -36,7 +122,7 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
     case kRestrictedInlining:
       return NoChange();
     case kStressInlining:
-      return inliner_.ReduceJSCall(node, function);
+      return InlineCandidate(candidate);
     case kGeneralInlining:
       break;
   }
@@ -45,25 +131,16 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   // Everything below this line is part of the inlining heuristic.
   // ---------------------------------------------------------------------------
 
-  // Built-in functions are handled by the JSBuiltinReducer.
-  if (function->shared()->HasBuiltinFunctionId()) return NoChange();
-
-  // Don't inline builtins.
-  if (function->shared()->IsBuiltin()) return NoChange();
-
-  // Quick check on source code length to avoid parsing large candidate.
-  if (function->shared()->SourceSize() > FLAG_max_inlined_source_size) {
-    return NoChange();
-  }
-
-  // Quick check on the size of the AST to avoid parsing large candidate.
-  if (function->shared()->ast_node_count() > FLAG_max_inlined_nodes) {
-    return NoChange();
+  bool can_inline = false;
+  for (int i = 0; i < candidate.num_functions; ++i) {
+    candidate.can_inline_function[i] =
+        CanInlineFunction(candidate.functions[i]);
+    if (candidate.can_inline_function[i]) can_inline = true;
   }
+  if (!can_inline) return NoChange();
 
-  // Avoid inlining within or across the boundary of asm.js code.
+  // Avoid inlining within the boundary of asm.js code.
   if (info_->shared_info()->asm_function()) return NoChange();
-  if (function->shared()->asm_function()) return NoChange();
 
   // Stop inlinining once the maximum allowed level is reached.
   int level = 0;
@@ -88,19 +165,20 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
       int const extra_index =
           p.feedback().vector()->GetIndex(p.feedback().slot()) + 1;
       Handle<Object> feedback_extra(p.feedback().vector()->get(extra_index),
-                                    function->GetIsolate());
+                                    info_->isolate());
       if (feedback_extra->IsSmi()) {
         calls = Handle<Smi>::cast(feedback_extra)->value();
       }
     }
   }
+  candidate.calls = calls;
 
   // ---------------------------------------------------------------------------
   // Everything above this line is part of the inlining heuristic.
   // ---------------------------------------------------------------------------
 
   // In the general case we remember the candidate for later.
-  candidates_.insert({function, node, calls});
+  candidates_.insert(candidate);
   return NoChange();
 }
 
@@ -120,13 +198,136 @@ void JSInliningHeuristic::Finalize() {
     candidates_.erase(i);
     // Make sure we don't try to inline dead candidate nodes.
     if (!candidate.node->IsDead()) {
-      Reduction r = inliner_.ReduceJSCall(candidate.node, candidate.function);
-      if (r.Changed()) {
-        cumulative_count_ += candidate.function->shared()->ast_node_count();
-        return;
-      }
+      Reduction r = InlineCandidate(candidate);
+      if (r.Changed()) return;
+    }
+  }
+}
+
+
+Reduction JSInliningHeuristic::InlineCandidate(Candidate const& candidate) {
+  int const num_calls = candidate.num_functions;
+  Node* const node = candidate.node;
+  if (num_calls == 1 && !candidate.needs_fallback) {
+    Handle<JSFunction> function = candidate.functions[0];
+    Reduction const reduction = inliner_.ReduceJSCall(node, function);
+    if (reduction.Changed()) {
+      cumulative_count_ += function->shared()->ast_node_count();
+    }
+    return reduction;
+  }
+
+  // Expand the JSCallFunction/JSCallConstruct node into a dispatch on the
+  // identity of the target first, with one cloned call per known target.
+  // If the target isn't guaranteed to be one of the known functions, the
+  // original (generic) call stays as the last case of the dispatch.
+  int const num_cases = num_calls + (candidate.needs_fallback ? 1 : 0);
+  Node* calls[kMaxCallPolymorphism + 2];
+  Node* if_successes[kMaxCallPolymorphism + 1];
+  Node* callee = NodeProperties::GetValueInput(node, 0);
+  Node* fallthrough_control = NodeProperties::GetControlInput(node);
+
+  // Find the IfSuccess and IfException projections of the call {node}.
+  Node* if_success = nullptr;
+  Node* if_exception = nullptr;
+  for (Edge edge : node->use_edges()) {
+    if (!NodeProperties::IsControlEdge(edge)) continue;
+    Node* const user = edge.from();
+    if (user->opcode() == IrOpcode::kIfSuccess) {
+      if_success = user;
+    } else if (user->opcode() == IrOpcode::kIfException) {
+      if_exception = user;
+    }
+  }
+
+  // Setup the inputs for the cloned call nodes.
+  int const input_count = node->InputCount();
+  int const new_target_index = node->op()->ValueInputCount() - 1;
+  Node** inputs = graph()->zone()->NewArray<Node*>(input_count);
+  for (int i = 0; i < input_count; ++i) {
+    inputs[i] = node->InputAt(i);
+  }
+  DCHECK_EQ(fallthrough_control, inputs[input_count - 1]);
+
+  // Create the appropriate control flow to dispatch to the cloned calls.
+  for (int i = 0; i < num_cases; ++i) {
+    Node* target = (i < num_calls)
+                       ? jsgraph()->HeapConstant(candidate.functions[i])
+                       : callee;
+    if (i != num_cases - 1) {
+      Node* check = graph()->NewNode(simplified()->ReferenceEqual(Type::Any()),
+                                     callee, target);
+      Node* branch =
+          graph()->NewNode(common()->Branch(), check, fallthrough_control);
+      fallthrough_control = graph()->NewNode(common()->IfFalse(), branch);
+      inputs[input_count - 1] = graph()->NewNode(common()->IfTrue(), branch);
+    } else {
+      inputs[input_count - 1] = fallthrough_control;
+    }
+
+    // The first input to the call is the actual target. For construct
+    // calls where the new target is the callee, update that as well.
+    inputs[0] = target;
+    if (node->opcode() == IrOpcode::kJSCallConstruct &&
+        node->InputAt(new_target_index) == callee) {
+      inputs[new_target_index] = target;
     }
+
+    calls[i] = graph()->NewNode(node->op(), input_count, inputs);
+    if_successes[i] = calls[i];
+    if (if_success != nullptr) {
+      if_successes[i] = graph()->NewNode(common()->IfSuccess(), calls[i]);
+    }
+
+    // Don't process the cloned calls again, in particular the generic one.
+    seen_.insert(calls[i]->id());
+  }
+
+  // Join the exceptional control flow of the cloned calls if necessary.
+  if (if_exception != nullptr) {
+    Node* if_exceptions[kMaxCallPolymorphism + 2];
+    for (int i = 0; i < num_cases; ++i) {
+      if_exceptions[i] =
+          graph()->NewNode(if_exception->op(), calls[i], calls[i]);
+    }
+    Node* exception_control = graph()->NewNode(common()->Merge(num_cases),
+                                               num_cases, if_exceptions);
+    if_exceptions[num_cases] = exception_control;
+    Node* exception_effect = graph()->NewNode(
+        common()->EffectPhi(num_cases), num_cases + 1, if_exceptions);
+    Node* exception_value = graph()->NewNode(
+        common()->Phi(MachineRepresentation::kTagged, num_cases),
+        num_cases + 1, if_exceptions);
+    ReplaceWithValue(if_exception, exception_value, exception_effect,
+                     exception_control);
   }
+
+  // Morph the call site into the dispatched call sites.
+  Node* control =
+      graph()->NewNode(common()->Merge(num_cases), num_cases, if_successes);
+  calls[num_cases] = control;
+  Node* effect = graph()->NewNode(common()->EffectPhi(num_cases),
+                                  num_cases + 1, calls);
+  Node* value = graph()->NewNode(
+      common()->Phi(MachineRepresentation::kTagged, num_cases), num_cases + 1,
+      calls);
+  ReplaceWithValue(node, value, effect, control);
+
+  // Inline the individual, cloned call sites within the inlining budget.
+  for (int i = 0; i < num_calls; ++i) {
+    Handle<JSFunction> function = candidate.functions[i];
+    if (!candidate.can_inline_function[i]) continue;
+    if (mode_ == kGeneralInlining && !CanForceInlineFunction(function) &&
+        cumulative_count_ > FLAG_max_inlined_nodes_cumulative) {
+      break;
+    }
+    Reduction const reduction = inliner_.ReduceJSCall(calls[i], function);
+    if (reduction.Changed()) {
+      cumulative_count_ += function->shared()->ast_node_count();
+    }
+  }
+
+  return Replace(value);
 }
 
 
@@ -142,14 +343,30 @@ bool JSInliningHeuristic::CandidateCompare::operator()(
 void JSInliningHeuristic::PrintCandidates() {
   PrintF("Candidates for inlining (size=%zu):\n", candidates_.size());
   for (const Candidate& candidate : candidates_) {
-    PrintF("  id:%d, calls:%d, size[source]:%d, size[ast]:%d / %s\n",
-           candidate.node->id(), candidate.calls,
-           candidate.function->shared()->SourceSize(),
-           candidate.function->shared()->ast_node_count(),
-           candidate.function->shared()->DebugName()->ToCString().get());
+    PrintF("  #%d:%s, calls:%d%s\n", candidate.node->id(),
+           candidate.node->op()->mnemonic(), candidate.calls,
+           candidate.needs_fallback ? ", fallback" : "");
+    for (int i = 0; i < candidate.num_functions; ++i) {
+      Handle<JSFunction> function = candidate.functions[i];
+      PrintF("  - %s, size[source]:%d, size[ast]:%d / %s\n",
+             candidate.can_inline_function[i] ? "+" : "-",
+             function->shared()->SourceSize(),
+             function->shared()->ast_node_count(),
+             function->shared()->DebugName()->ToCString().get());
+    }
   }
 }
 
+Graph* JSInliningHeuristic::graph() const { return jsgraph()->graph(); }
+
+CommonOperatorBuilder* JSInliningHeuristic::common() const {
+  return jsgraph()->common();
+}
+
+SimplifiedOperatorBuilder* JSInliningHeuristic::simplified() const {
+  return jsgraph()->simplified();
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
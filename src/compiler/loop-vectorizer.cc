@@ -0,0 +1,580 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-vectorizer.h"
+
+#include "src/compiler/common-operator.h"
+#include "src/compiler/graph.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node-matchers.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "src/conversions-inl.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+#define TRACE(...)                                  \
+  do {                                              \
+    if (FLAG_trace_turbo_loop) PrintF(__VA_ARGS__); \
+  } while (false)
+
+namespace {
+
+// The number of float32 lanes in a 128-bit vector.
+const int kLanes = kSimd128Size / kFloatSize;
+
+bool IsFloat32Access(Node* node) {
+  return ElementAccessOf(node->op()).machine_type.representation() ==
+         MachineRepresentation::kFloat32;
+}
+
+bool IsFloat64Binop(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kFloat64Add:
+    case IrOpcode::kFloat64Sub:
+    case IrOpcode::kFloat64Mul:
+    case IrOpcode::kFloat64Div:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsFloat32Binop(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kFloat32Add:
+    case IrOpcode::kFloat32Sub:
+    case IrOpcode::kFloat32Mul:
+    case IrOpcode::kFloat32Div:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Float64 constants that are float32 values can take part in float32
+// arithmetic without changing the result.
+bool IsFloat32Constant(Node* node) {
+  Float64Matcher m(node);
+  return m.HasValue() &&
+         bit_cast<uint64_t>(static_cast<double>(DoubleToFloat32(m.Value()))) ==
+             bit_cast<uint64_t>(m.Value());
+}
+
+}  // namespace
+
+LoopVectorizer::LoopVectorizer(JSGraph* jsgraph, Zone* temp_zone)
+    : jsgraph_(jsgraph),
+      temp_zone_(temp_zone),
+      loop_tree_(nullptr),
+      loop_(nullptr),
+      copies_(temp_zone),
+      vectors_(temp_zone) {}
+
+void LoopVectorizer::Run() {
+  loop_tree_ = LoopFinder::BuildLoopTree(graph(), temp_zone());
+  for (LoopTree::Loop* loop : loop_tree_->outer_loops()) {
+    VectorizeInnerLoops(loop);
+  }
+}
+
+void LoopVectorizer::VectorizeInnerLoops(LoopTree::Loop* loop) {
+  if (!loop->children().empty()) {
+    for (LoopTree::Loop* inner_loop : loop->children()) {
+      VectorizeInnerLoops(inner_loop);
+    }
+    return;
+  }
+  if (loop->TotalSize() > kMaxVectorizedNodes) return;
+  // Vectorizing only ever adds nodes that are not part of any loop in the
+  // {loop_tree_}, so the tree stays valid for the remaining loops.
+  Candidate candidate = {nullptr, nullptr, nullptr, nullptr,
+                         nullptr, nullptr, nullptr, NodeVector(temp_zone())};
+  if (Analyze(loop, &candidate)) Vectorize(&candidate);
+}
+
+// Matches loops of the shape
+//
+//   for (i = start; i < bound; i++) { <element-wise float32 statements> }
+//
+// where the induction variable is the only value carried around the loop and
+// the body contains nothing but float32 typed array element accesses indexed
+// by the induction variable, float arithmetic on the loaded values and the
+// stack check.
+bool LoopVectorizer::Analyze(LoopTree::Loop* loop, Candidate* candidate) {
+  loop_ = loop;
+  candidate->loop = loop;
+  Node* loop_node = candidate->loop_node = loop_tree_->GetLoopControl(loop);
+  if (loop_node->InputCount() != 2) return false;
+
+  for (Node* node : loop_tree_->HeaderNodes(loop)) {
+    if (node == loop_node) continue;
+    if (node->opcode() == IrOpcode::kEffectPhi) {
+      if (candidate->effect_phi != nullptr) return false;
+      candidate->effect_phi = node;
+    } else if (node->opcode() == IrOpcode::kPhi &&
+               PhiRepresentationOf(node->op()) ==
+                   MachineRepresentation::kWord32) {
+      if (candidate->induction != nullptr) return false;
+      candidate->induction = node;
+    } else {
+      return false;
+    }
+  }
+  Node* induction = candidate->induction;
+  if (induction == nullptr || candidate->effect_phi == nullptr) return false;
+
+  // The backedge value has to be {induction} + 1.
+  Node* increment = candidate->increment = induction->InputAt(1);
+  if (increment->opcode() != IrOpcode::kInt32Add) return false;
+  Int32BinopMatcher mincrement(increment);
+  if (mincrement.left().node() != induction || !mincrement.right().Is(1)) {
+    return false;
+  }
+  if (increment->UseCount() != 1) return false;
+
+  // The loop has to be left exactly when {induction} reaches the bound.
+  for (Node* use : loop_node->uses()) {
+    if (use->opcode() != IrOpcode::kBranch) continue;
+    if (candidate->branch != nullptr) return false;
+    candidate->branch = use;
+  }
+  Node* branch = candidate->branch;
+  if (branch == nullptr || branch->UseCount() != 2) return false;
+  Node* cond = branch->InputAt(0);
+  if (cond->opcode() != IrOpcode::kInt32LessThan &&
+      cond->opcode() != IrOpcode::kUint32LessThan) {
+    return false;
+  }
+  if (cond->InputAt(0) != induction || cond->UseCount() != 1) return false;
+  Node* bound = candidate->bound = cond->InputAt(1);
+  if (loop_tree_->Contains(loop, bound)) return false;
+  for (Node* use : branch->uses()) {
+    bool const in_loop = loop_tree_->Contains(loop, use);
+    if (use->opcode() == IrOpcode::kIfTrue ? !in_loop : in_loop) return false;
+  }
+
+  for (Node* node : loop_tree_->BodyNodes(loop)) {
+    if (!CheckBodyNode(candidate, node)) {
+      TRACE("Loop #%d not vectorized: #%d:%s\n", loop_node->id(), node->id(),
+            node->op()->mnemonic());
+      return false;
+    }
+  }
+  if (candidate->accesses.empty() || !CheckAliasing(candidate)) return false;
+
+  // Every stored value has to be computable lane-wise.
+  for (Node* access : candidate->accesses) {
+    if (access->opcode() == IrOpcode::kStoreElement &&
+        !IsVectorizable(access->InputAt(2))) {
+      TRACE("Loop #%d not vectorized: #%d:%s\n", loop_node->id(),
+            access->id(), access->op()->mnemonic());
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LoopVectorizer::CheckBodyNode(Candidate* candidate, Node* node) {
+  LoopTree::Loop* loop = candidate->loop;
+  for (Node* use : node->uses()) {
+    if (loop_tree_->Contains(loop, use)) continue;
+    if (node == candidate->branch && use->opcode() == IrOpcode::kIfFalse) {
+      continue;
+    }
+    return false;
+  }
+
+  // The induction variable and the loop exit test.
+  if (node == candidate->increment || node == candidate->branch ||
+      node == candidate->branch->InputAt(0)) {
+    return true;
+  }
+
+  switch (node->opcode()) {
+    // The stack check, see JSGenericLowering::LowerJSStackCheck.
+    case IrOpcode::kIfTrue:
+    case IrOpcode::kIfFalse:
+    case IrOpcode::kIfSuccess:
+    case IrOpcode::kMerge:
+    case IrOpcode::kEffectPhi:
+    case IrOpcode::kFrameState:
+    case IrOpcode::kStateValues:
+    case IrOpcode::kTypedStateValues:
+      return true;
+    case IrOpcode::kLoad:
+      return IsStackLimitLoad(node);
+    case IrOpcode::kCall:
+      return IsStackGuardCall(node);
+    case IrOpcode::kUint32LessThan:
+    case IrOpcode::kUint64LessThan:
+      return IsStackLimitLoad(node->InputAt(0)) &&
+             node->InputAt(1)->opcode() == IrOpcode::kLoadStackPointer;
+    case IrOpcode::kBranch: {
+      Node* check = node->InputAt(0);
+      return (check->opcode() == IrOpcode::kUint32LessThan ||
+              check->opcode() == IrOpcode::kUint64LessThan) &&
+             IsStackLimitLoad(check->InputAt(0));
+    }
+
+    // Element-wise accesses and arithmetic.
+    case IrOpcode::kLoadElement:
+    case IrOpcode::kStoreElement:
+      if (!IsFloat32Access(node) || node->InputAt(1) != candidate->induction ||
+          loop_tree_->Contains(loop, node->InputAt(0))) {
+        return false;
+      }
+      candidate->accesses.push_back(node);
+      if (node->opcode() == IrOpcode::kStoreElement) return true;
+      break;
+    case IrOpcode::kFloat32Add:
+    case IrOpcode::kFloat32Sub:
+    case IrOpcode::kFloat32Mul:
+    case IrOpcode::kFloat32Div:
+    case IrOpcode::kFloat64Add:
+    case IrOpcode::kFloat64Sub:
+    case IrOpcode::kFloat64Mul:
+    case IrOpcode::kFloat64Div:
+    case IrOpcode::kChangeFloat32ToFloat64:
+    case IrOpcode::kTruncateFloat64ToFloat32:
+      break;
+    default:
+      return false;
+  }
+
+  // Values computed per element may only flow into other element-wise
+  // operations, in particular they must not be observable in frame states.
+  for (Edge edge : node->use_edges()) {
+    if (!NodeProperties::IsValueEdge(edge)) continue;
+    Node* use = edge.from();
+    switch (use->opcode()) {
+      case IrOpcode::kStoreElement:
+        if (edge.index() != 2) return false;
+        break;
+      case IrOpcode::kFloat32Add:
+      case IrOpcode::kFloat32Sub:
+      case IrOpcode::kFloat32Mul:
+      case IrOpcode::kFloat32Div:
+      case IrOpcode::kFloat64Add:
+      case IrOpcode::kFloat64Sub:
+      case IrOpcode::kFloat64Mul:
+      case IrOpcode::kFloat64Div:
+      case IrOpcode::kChangeFloat32ToFloat64:
+      case IrOpcode::kTruncateFloat64ToFloat32:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+// A vector iteration performs the accesses of {kLanes} consecutive scalar
+// iterations at once. That is only correct if no two accesses, at least one
+// of them a store, touch the same element in different scalar iterations of
+// the same group, i.e. if their addresses are either equal or at least one
+// vector apart.
+bool LoopVectorizer::CheckAliasing(Candidate* candidate) {
+  NodeVector const& accesses = candidate->accesses;
+  for (size_t i = 0; i < accesses.size(); ++i) {
+    for (size_t j = i + 1; j < accesses.size(); ++j) {
+      Node* a = accesses[i];
+      Node* b = accesses[j];
+      if (a->opcode() == IrOpcode::kLoadElement &&
+          b->opcode() == IrOpcode::kLoadElement) {
+        continue;
+      }
+      ElementAccess const& access_a = ElementAccessOf(a->op());
+      ElementAccess const& access_b = ElementAccessOf(b->op());
+      int64_t delta = access_b.header_size - access_a.header_size;
+      Node* base_a = a->InputAt(0);
+      Node* base_b = b->InputAt(0);
+      if (base_a != base_b) {
+        IntPtrMatcher ma(base_a);
+        IntPtrMatcher mb(base_b);
+        if (ma.HasValue() && mb.HasValue()) {
+          delta += mb.Value() - ma.Value();
+        } else if (access_a.base_is_tagged == kTaggedBase &&
+                   access_b.base_is_tagged == kTaggedBase &&
+                   base_a->opcode() == IrOpcode::kHeapConstant &&
+                   base_b->opcode() == IrOpcode::kHeapConstant) {
+          // Distinct on-heap arrays never overlap.
+          continue;
+        } else {
+          return false;
+        }
+      }
+      if (delta != 0 && delta > -kSimd128Size && delta < kSimd128Size) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Returns true if the float32 {node} can be computed for {kLanes} consecutive
+// iterations at once.
+bool LoopVectorizer::IsVectorizable(Node* node) {
+  if (!loop_tree_->Contains(loop_, node)) return true;
+  switch (node->opcode()) {
+    case IrOpcode::kLoadElement:
+      return true;
+    case IrOpcode::kFloat32Add:
+    case IrOpcode::kFloat32Sub:
+    case IrOpcode::kFloat32Mul:
+    case IrOpcode::kFloat32Div:
+      return IsVectorizable(node->InputAt(0)) &&
+             IsVectorizable(node->InputAt(1));
+    case IrOpcode::kTruncateFloat64ToFloat32:
+      return IsWidenedFloat32(node->InputAt(0));
+    default:
+      return false;
+  }
+}
+
+// Returns true if the float64 {node} is a float32 value, or the result of a
+// single arithmetic operation on float32 values that is only ever rounded to
+// float32. Since double precision has more than twice the precision of single
+// precision, rounding the exact result to double and then to single gives the
+// same result as rounding it to single directly for +, -, * and /.
+bool LoopVectorizer::IsWidenedFloat32(Node* node) {
+  if (IsFloat32Constant(node)) return true;
+  if (node->opcode() == IrOpcode::kChangeFloat32ToFloat64) {
+    return IsVectorizable(node->InputAt(0));
+  }
+  if (!IsFloat64Binop(node) || !loop_tree_->Contains(loop_, node)) {
+    return false;
+  }
+  for (Node* use : node->uses()) {
+    if (use->opcode() != IrOpcode::kTruncateFloat64ToFloat32) return false;
+  }
+  for (Node* input : node->inputs()) {
+    if (IsFloat32Constant(input)) continue;
+    if (input->opcode() != IrOpcode::kChangeFloat32ToFloat64 ||
+        !IsVectorizable(input->InputAt(0))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LoopVectorizer::IsStackGuardCall(Node* node) {
+  ExternalReference const stack_guard(Runtime::kStackGuard,
+                                      jsgraph()->isolate());
+  for (Node* input : node->inputs()) {
+    if (ExternalReferenceMatcher(input).Is(stack_guard)) return true;
+  }
+  return false;
+}
+
+bool LoopVectorizer::IsStackLimitLoad(Node* node) {
+  return node->opcode() == IrOpcode::kLoad &&
+         ExternalReferenceMatcher(node->InputAt(0))
+             .Is(ExternalReference::address_of_stack_limit(
+                 jsgraph()->isolate()));
+}
+
+// Duplicates the loop in front of itself and turns the copy into the vector
+// loop:
+//
+//   i' = start;
+//   while (i' < bound && bound - i' >= kLanes) {
+//     <vector statements on elements i' .. i' + kLanes - 1>
+//     i' += kLanes;
+//   }
+//   for (i = i'; i < bound; i++) { <scalar statements> }
+void LoopVectorizer::Vectorize(Candidate* candidate) {
+  TRACE("Vectorizing loop #%d\n", candidate->loop_node->id());
+  copies_.clear();
+  vectors_.clear();
+
+  // Copy all the nodes first, then fix the inputs of the copies.
+  NodeVector inputs(temp_zone());
+  NodeRange nodes = loop_tree_->LoopNodes(candidate->loop);
+  for (Node* node : nodes) {
+    inputs.clear();
+    for (Node* input : node->inputs()) inputs.push_back(input);
+    Node* copy = graph()->NewNode(node->op(), node->InputCount(), &inputs[0]);
+    if (NodeProperties::IsTyped(node)) {
+      NodeProperties::SetType(copy, NodeProperties::GetType(node));
+    }
+    copies_[node] = copy;
+  }
+  for (Node* node : nodes) {
+    Node* copy = MapCopy(node);
+    for (int i = 0; i < copy->InputCount(); ++i) {
+      copy->ReplaceInput(i, MapCopy(node->InputAt(i)));
+    }
+  }
+
+  // Enter the scalar loop when the vector loop exits.
+  Node* vector_branch = MapCopy(candidate->branch);
+  Node* vector_exit = graph()->NewNode(common()->IfFalse(), vector_branch);
+  candidate->loop_node->ReplaceInput(0, vector_exit);
+  candidate->induction->ReplaceInput(0, MapCopy(candidate->induction));
+  candidate->effect_phi->ReplaceInput(0, MapCopy(candidate->effect_phi));
+
+  // Step the vector loop by {kLanes} for as long as that many iterations are
+  // left.
+  Node* vector_induction = MapCopy(candidate->induction);
+  MapCopy(candidate->increment)
+      ->ReplaceInput(1, jsgraph()->Int32Constant(kLanes));
+  Node* remaining = graph()->NewNode(machine()->Int32Sub(), candidate->bound,
+                                     vector_induction);
+  Node* enough = graph()->NewNode(machine()->Uint32LessThanOrEqual(),
+                                  jsgraph()->Int32Constant(kLanes), remaining);
+  vector_branch->ReplaceInput(
+      0, graph()->NewNode(machine()->Word32And(), vector_branch->InputAt(0),
+                          enough));
+
+  // Turn the accesses into vector loads and stores. The loads go first, the
+  // stored values are built from them.
+  for (Node* access : candidate->accesses) {
+    if (access->opcode() != IrOpcode::kLoadElement) continue;
+    Node* load = MapCopy(access);
+    load->ReplaceInput(
+        1, ElementIndex(ElementAccessOf(access->op()), vector_induction));
+    NodeProperties::RemoveType(load);
+    NodeProperties::ChangeOp(load, machine()->Load(MachineType::Simd128()));
+    vectors_[access] = load;
+  }
+  for (Node* access : candidate->accesses) {
+    if (access->opcode() != IrOpcode::kStoreElement) continue;
+    Node* store = MapCopy(access);
+    store->ReplaceInput(
+        1, ElementIndex(ElementAccessOf(access->op()), vector_induction));
+    store->ReplaceInput(2, VectorFor(access->InputAt(2)));
+    NodeProperties::ChangeOp(
+        store, machine()->Store(StoreRepresentation(
+                   MachineRepresentation::kSimd128, kNoWriteBarrier)));
+  }
+
+  // The scalar arithmetic in the vector loop is dead now.
+  for (Node* node : nodes) {
+    switch (node->opcode()) {
+      case IrOpcode::kFloat32Add:
+      case IrOpcode::kFloat32Sub:
+      case IrOpcode::kFloat32Mul:
+      case IrOpcode::kFloat32Div:
+      case IrOpcode::kFloat64Add:
+      case IrOpcode::kFloat64Sub:
+      case IrOpcode::kFloat64Mul:
+      case IrOpcode::kFloat64Div:
+      case IrOpcode::kChangeFloat32ToFloat64:
+      case IrOpcode::kTruncateFloat64ToFloat32:
+        MapCopy(node)->NullAllInputs();
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+Node* LoopVectorizer::VectorFor(Node* node) {
+  auto it = vectors_.find(node);
+  if (it != vectors_.end()) return it->second;
+  Node* vector;
+  if (!loop_tree_->Contains(loop_, node)) {
+    vector = Splat(node);
+  } else if (IsFloat32Binop(node)) {
+    const Operator* op;
+    switch (node->opcode()) {
+      case IrOpcode::kFloat32Add:
+        op = machine()->Float32x4Add();
+        break;
+      case IrOpcode::kFloat32Sub:
+        op = machine()->Float32x4Sub();
+        break;
+      case IrOpcode::kFloat32Mul:
+        op = machine()->Float32x4Mul();
+        break;
+      default:
+        op = machine()->Float32x4Div();
+        break;
+    }
+    vector = graph()->NewNode(op, VectorFor(node->InputAt(0)),
+                              VectorFor(node->InputAt(1)));
+  } else {
+    DCHECK_EQ(IrOpcode::kTruncateFloat64ToFloat32, node->opcode());
+    vector = WidenedVectorFor(node->InputAt(0));
+  }
+  vectors_[node] = vector;
+  return vector;
+}
+
+Node* LoopVectorizer::WidenedVectorFor(Node* node) {
+  Float64Matcher m(node);
+  if (m.HasValue()) {
+    return Splat(jsgraph()->Float32Constant(DoubleToFloat32(m.Value())));
+  }
+  if (node->opcode() == IrOpcode::kChangeFloat32ToFloat64) {
+    return VectorFor(node->InputAt(0));
+  }
+  const Operator* op;
+  switch (node->opcode()) {
+    case IrOpcode::kFloat64Add:
+      op = machine()->Float32x4Add();
+      break;
+    case IrOpcode::kFloat64Sub:
+      op = machine()->Float32x4Sub();
+      break;
+    case IrOpcode::kFloat64Mul:
+      op = machine()->Float32x4Mul();
+      break;
+    default:
+      DCHECK_EQ(IrOpcode::kFloat64Div, node->opcode());
+      op = machine()->Float32x4Div();
+      break;
+  }
+  return graph()->NewNode(op, WidenedVectorFor(node->InputAt(0)),
+                          WidenedVectorFor(node->InputAt(1)));
+}
+
+Node* LoopVectorizer::Splat(Node* value) {
+  return graph()->NewNode(machine()->CreateFloat32x4(), value, value, value,
+                          value);
+}
+
+// Computes the byte offset of element {key} like the MemoryOptimizer does
+// for the scalar accesses.
+Node* LoopVectorizer::ElementIndex(ElementAccess const& access, Node* key) {
+  Node* index = key;
+  if (machine()->Is64()) {
+    index = graph()->NewNode(machine()->ChangeUint32ToUint64(), index);
+  }
+  int const element_size_shift =
+      ElementSizeLog2Of(access.machine_type.representation());
+  index = graph()->NewNode(machine()->WordShl(), index,
+                           jsgraph()->IntPtrConstant(element_size_shift));
+  int const fixed_offset = access.header_size - access.tag();
+  if (fixed_offset) {
+    index = graph()->NewNode(machine()->IntAdd(), index,
+                             jsgraph()->IntPtrConstant(fixed_offset));
+  }
+  return index;
+}
+
+Node* LoopVectorizer::MapCopy(Node* node) {
+  auto it = copies_.find(node);
+  return it == copies_.end() ? node : it->second;
+}
+
+Graph* LoopVectorizer::graph() const { return jsgraph()->graph(); }
+
+CommonOperatorBuilder* LoopVectorizer::common() const {
+  return jsgraph()->common();
+}
+
+MachineOperatorBuilder* LoopVectorizer::machine() const {
+  return jsgraph()->machine();
+}
+
+#undef TRACE
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
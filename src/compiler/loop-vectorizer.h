@@ -0,0 +1,91 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_VECTORIZER_H_
+#define V8_COMPILER_LOOP_VECTORIZER_H_
+
+#include "src/compiler/loop-analysis.h"
+#include "src/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Forward declarations.
+class CommonOperatorBuilder;
+class JSGraph;
+class MachineOperatorBuilder;
+struct ElementAccess;
+
+// Vectorizes innermost loops that apply float32 arithmetic element-wise to
+// typed arrays, such as
+//
+//   for (var i = 0; i < n; i++) c[i] = a[i] * b[i];
+//
+// The loop is duplicated in front of itself. The copy processes four
+// elements per iteration with 128-bit SIMD operations as long as at least
+// four iterations remain; the original loop then runs the remaining
+// iterations as a scalar epilogue. The copy only accesses elements that the
+// scalar loop accesses as well, so the bounds of its accesses are covered by
+// the bounds the scalar accesses were proven to satisfy.
+//
+// The pass runs on the machine-level graph before the memory optimizer, i.e.
+// element accesses are still LoadElement and StoreElement nodes.
+class LoopVectorizer final {
+ public:
+  LoopVectorizer(JSGraph* jsgraph, Zone* temp_zone);
+
+  void Run();
+
+  // Loops with more nodes than this are not vectorized.
+  static const size_t kMaxVectorizedNodes = 200;
+
+ private:
+  // The parts of a loop that vectorization has to look at.
+  struct Candidate {
+    LoopTree::Loop* loop;
+    Node* loop_node;
+    Node* induction;  // The induction variable phi.
+    Node* increment;  // The Int32Add(induction, 1) on the backedge.
+    Node* effect_phi;
+    Node* branch;  // The loop exit test Branch(induction < bound).
+    Node* bound;
+    NodeVector accesses;  // The LoadElement and StoreElement nodes.
+  };
+
+  void VectorizeInnerLoops(LoopTree::Loop* loop);
+  bool Analyze(LoopTree::Loop* loop, Candidate* candidate);
+  bool CheckBodyNode(Candidate* candidate, Node* node);
+  bool CheckAliasing(Candidate* candidate);
+  bool IsVectorizable(Node* node);
+  bool IsWidenedFloat32(Node* node);
+  bool IsStackGuardCall(Node* node);
+  bool IsStackLimitLoad(Node* node);
+  void Vectorize(Candidate* candidate);
+
+  Node* VectorFor(Node* node);
+  Node* WidenedVectorFor(Node* node);
+  Node* Splat(Node* value);
+  Node* ElementIndex(ElementAccess const& access, Node* key);
+  Node* MapCopy(Node* node);
+
+  Graph* graph() const;
+  CommonOperatorBuilder* common() const;
+  MachineOperatorBuilder* machine() const;
+  JSGraph* jsgraph() const { return jsgraph_; }
+  Zone* temp_zone() const { return temp_zone_; }
+
+  JSGraph* const jsgraph_;
+  Zone* const temp_zone_;
+  LoopTree* loop_tree_;
+  LoopTree::Loop* loop_;  // The loop being analyzed or vectorized.
+  ZoneMap<Node*, Node*> copies_;
+  ZoneMap<Node*, Node*> vectors_;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_VECTORIZER_H_
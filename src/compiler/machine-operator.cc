@@ -68,6 +68,17 @@ CheckedStoreRepresentation CheckedStoreRepresentationOf(Operator const* op) {
   return OpParameter<CheckedStoreRepresentation>(op);
 }
 
+ProtectedLoadRepresentation ProtectedLoadRepresentationOf(Operator const* op) {
+  DCHECK_EQ(IrOpcode::kProtectedLoad, op->opcode());
+  return OpParameter<ProtectedLoadRepresentation>(op);
+}
+
+ProtectedStoreRepresentation ProtectedStoreRepresentationOf(
+    Operator const* op) {
+  DCHECK_EQ(IrOpcode::kProtectedStore, op->opcode());
+  return OpParameter<ProtectedStoreRepresentation>(op);
+}
+
 MachineRepresentation StackSlotRepresentationOf(Operator const* op) {
   DCHECK_EQ(IrOpcode::kStackSlot, op->opcode());
   return OpParameter<MachineRepresentation>(op);
@@ -453,6 +464,16 @@ MachineRepresentation AtomicStoreRepresentationOf(Operator const* op) {
   V(kWord16)                          \
   V(kWord32)
 
+// The read-modify-write operations return the previous value at the address.
+#define ATOMIC_RMW_OP_LIST(V)       \
+  V(Word32AtomicExchange, 3)        \
+  V(Word32AtomicCompareExchange, 4) \
+  V(Word32AtomicAdd, 3)             \
+  V(Word32AtomicSub, 3)             \
+  V(Word32AtomicAnd, 3)             \
+  V(Word32AtomicOr, 3)              \
+  V(Word32AtomicXor, 3)
+
 struct MachineOperatorGlobalCache {
 #define PURE(Name, properties, value_input_count, control_input_count,         \
              output_count)                                                     \
@@ -502,9 +523,19 @@ struct MachineOperatorGlobalCache {
               Operator::kNoDeopt | Operator::kNoThrow | Operator::kNoWrite,  \
               "CheckedLoad", 3, 1, 1, 1, 1, 0, MachineType::Type()) {}       \
   };                                                                         \
+  struct ProtectedLoad##Type##Operator final                                 \
+      : public Operator1<ProtectedLoadRepresentation> {                      \
+    ProtectedLoad##Type##Operator()                                          \
+        : Operator1<ProtectedLoadRepresentation>(                            \
+              IrOpcode::kProtectedLoad,                                      \
+              /* Not eliminatable, even unused loads must trap. */           \
+              Operator::kNoDeopt | Operator::kNoWrite, "ProtectedLoad", 4,   \
+              1, 1, 1, 1, 0, MachineType::Type()) {}                         \
+  };                                                                         \
   Load##Type##Operator kLoad##Type;                                          \
   UnalignedLoad##Type##Operator kUnalignedLoad##Type;                        \
-  CheckedLoad##Type##Operator kCheckedLoad##Type;
+  CheckedLoad##Type##Operator kCheckedLoad##Type;                            \
+  ProtectedLoad##Type##Operator kProtectedLoad##Type;
   MACHINE_TYPE_LIST(LOAD)
 #undef LOAD
 
@@ -569,13 +600,23 @@ struct MachineOperatorGlobalCache {
               "CheckedStore", 4, 1, 1, 0, 1, 0, MachineRepresentation::Type) { \
     }                                                                          \
   };                                                                           \
+  struct ProtectedStore##Type##Operator final                                  \
+      : public Operator1<ProtectedStoreRepresentation> {                       \
+    ProtectedStore##Type##Operator()                                           \
+        : Operator1<ProtectedStoreRepresentation>(                             \
+              IrOpcode::kProtectedStore,                                       \
+              Operator::kNoDeopt | Operator::kNoRead | Operator::kNoThrow,     \
+              "ProtectedStore", 5, 1, 1, 0, 1, 0,                              \
+              MachineRepresentation::Type) {}                                  \
+  };                                                                           \
   Store##Type##NoWriteBarrier##Operator kStore##Type##NoWriteBarrier;          \
   Store##Type##MapWriteBarrier##Operator kStore##Type##MapWriteBarrier;        \
   Store##Type##PointerWriteBarrier##Operator                                   \
       kStore##Type##PointerWriteBarrier;                                       \
   Store##Type##FullWriteBarrier##Operator kStore##Type##FullWriteBarrier;      \
   UnalignedStore##Type##Operator kUnalignedStore##Type;                        \
-  CheckedStore##Type##Operator kCheckedStore##Type;
+  CheckedStore##Type##Operator kCheckedStore##Type;                            \
+  ProtectedStore##Type##Operator kProtectedStore##Type;
   MACHINE_REPRESENTATION_LIST(STORE)
 #undef STORE
 
@@ -605,6 +646,17 @@ struct MachineOperatorGlobalCache {
   ATOMIC_REPRESENTATION_LIST(ATOMIC_STORE)
 #undef STORE
 
+#define ATOMIC_RMW(Name, value_input_count)                                 \
+  struct Name##Operator final : public Operator {                           \
+    Name##Operator()                                                        \
+        : Operator(IrOpcode::k##Name,                                       \
+                   Operator::kNoDeopt | Operator::kNoThrow, #Name,          \
+                   value_input_count, 1, 1, 1, 1, 0) {}                     \
+  };                                                                        \
+  Name##Operator k##Name;
+  ATOMIC_RMW_OP_LIST(ATOMIC_RMW)
+#undef ATOMIC_RMW
+
   struct DebugBreakOperator : public Operator {
     DebugBreakOperator()
         : Operator(IrOpcode::kDebugBreak, Operator::kNoThrow, "DebugBreak", 0,
@@ -765,6 +817,34 @@ const Operator* MachineOperatorBuilder::CheckedStore(
   return nullptr;
 }
 
+const Operator* MachineOperatorBuilder::ProtectedLoad(
+    ProtectedLoadRepresentation rep) {
+#define LOAD(Type)                       \
+  if (rep == MachineType::Type()) {      \
+    return &cache_.kProtectedLoad##Type; \
+  }
+  MACHINE_TYPE_LIST(LOAD)
+#undef LOAD
+  UNREACHABLE();
+  return nullptr;
+}
+
+const Operator* MachineOperatorBuilder::ProtectedStore(
+    ProtectedStoreRepresentation rep) {
+  switch (rep) {
+#define STORE(kRep)                 \
+  case MachineRepresentation::kRep: \
+    return &cache_.kProtectedStore##kRep;
+    MACHINE_REPRESENTATION_LIST(STORE)
+#undef STORE
+    case MachineRepresentation::kBit:
+    case MachineRepresentation::kNone:
+      break;
+  }
+  UNREACHABLE();
+  return nullptr;
+}
+
 const Operator* MachineOperatorBuilder::AtomicLoad(LoadRepresentation rep) {
 #define LOAD(Type)                    \
   if (rep == MachineType::Type()) {   \
@@ -787,6 +867,11 @@ const Operator* MachineOperatorBuilder::AtomicStore(MachineRepresentation rep) {
   return nullptr;
 }
 
+#define ATOMIC_RMW(Name, value_input_count) \
+  const Operator* MachineOperatorBuilder::Name() { return &cache_.k##Name; }
+ATOMIC_RMW_OP_LIST(ATOMIC_RMW)
+#undef ATOMIC_RMW
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -91,6 +91,16 @@ typedef MachineRepresentation CheckedStoreRepresentation;
 
 CheckedStoreRepresentation CheckedStoreRepresentationOf(Operator const*);
 
+// A ProtectedLoad needs a MachineType.
+typedef MachineType ProtectedLoadRepresentation;
+
+ProtectedLoadRepresentation ProtectedLoadRepresentationOf(Operator const*);
+
+// A ProtectedStore needs a MachineType.
+typedef MachineRepresentation ProtectedStoreRepresentation;
+
+ProtectedStoreRepresentation ProtectedStoreRepresentationOf(Operator const*);
+
 MachineRepresentation StackSlotRepresentationOf(Operator const* op);
 
 MachineRepresentation AtomicStoreRepresentationOf(Operator const* op);
@@ -640,10 +650,31 @@ class MachineOperatorBuilder final : public ZoneObject {
   // checked-store heap, index, length, value
   const Operator* CheckedStore(CheckedStoreRepresentation);
 
+  // protected-load [base + index], context, position
+  // The access is not bounds checked; a fault on it is turned into a wasm
+  // trap at |position| by the trap handler.
+  const Operator* ProtectedLoad(ProtectedLoadRepresentation rep);
+  // protected-store [base + index], value, context, position
+  const Operator* ProtectedStore(ProtectedStoreRepresentation rep);
+
   // atomic-load [base + index]
   const Operator* AtomicLoad(LoadRepresentation rep);
   // atomic-store [base + index], value
   const Operator* AtomicStore(MachineRepresentation rep);
+  // atomic-exchange [base + index], value
+  const Operator* Word32AtomicExchange();
+  // atomic-compare-exchange [base + index], old_value, new_value
+  const Operator* Word32AtomicCompareExchange();
+  // atomic-add [base + index], value
+  const Operator* Word32AtomicAdd();
+  // atomic-sub [base + index], value
+  const Operator* Word32AtomicSub();
+  // atomic-and [base + index], value
+  const Operator* Word32AtomicAnd();
+  // atomic-or [base + index], value
+  const Operator* Word32AtomicOr();
+  // atomic-xor [base + index], value
+  const Operator* Word32AtomicXor();
 
   // Target machine word-size assumed by this builder.
   bool Is32() const { return word() == MachineRepresentation::kWord32; }
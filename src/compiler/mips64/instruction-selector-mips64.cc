@@ -1454,6 +1454,10 @@ void InstructionSelector::VisitUnalignedStore(Node* node) {
   }
 }
 
+void InstructionSelector::VisitProtectedLoad(Node* node) { UNIMPLEMENTED(); }
+
+void InstructionSelector::VisitProtectedStore(Node* node) { UNIMPLEMENTED(); }
+
 void InstructionSelector::VisitCheckedLoad(Node* node) {
   CheckedLoadRepresentation load_rep = CheckedLoadRepresentationOf(node->op());
   Mips64OperandGenerator g(this);
@@ -46,6 +46,7 @@
 #include "src/compiler/loop-analysis.h"
 #include "src/compiler/loop-peeling.h"
 #include "src/compiler/loop-variable-optimizer.h"
+#include "src/compiler/loop-vectorizer.h"
 #include "src/compiler/machine-operator-reducer.h"
 #include "src/compiler/memory-optimizer.h"
 #include "src/compiler/move-optimizer.h"
@@ -211,6 +212,7 @@ class PipelineData {
   Zone* instruction_zone() const { return instruction_zone_; }
   InstructionSequence* sequence() const { return sequence_; }
   Frame* frame() const { return frame_; }
+  CodeGenerator* code_generator() const { return code_generator_; }
 
   Zone* register_allocation_zone() const { return register_allocation_zone_; }
   RegisterAllocationData* register_allocation_data() const {
@@ -247,6 +249,8 @@ class PipelineData {
 
   void DeleteInstructionZone() {
     if (instruction_zone_ == nullptr) return;
+    delete code_generator_;
+    code_generator_ = nullptr;
     instruction_zone_scope_.Destroy();
     instruction_zone_ = nullptr;
     sequence_ = nullptr;
@@ -284,12 +288,18 @@ class PipelineData {
     frame_ = new (instruction_zone()) Frame(fixed_frame_size);
   }
 
-  void InitializeRegisterAllocationData(const RegisterConfiguration* config,
-                                        CallDescriptor* descriptor) {
+  void InitializeCodeGenerator(Linkage* linkage) {
+    DCHECK_NULL(code_generator_);
+    code_generator_ = new CodeGenerator(frame(), linkage, sequence(), info());
+  }
+
+  void InitializeRegisterAllocationData(
+      const RegisterConfiguration* config, CallDescriptor* descriptor,
+      RegisterAllocationData::AllocationMode mode) {
     DCHECK(register_allocation_data_ == nullptr);
     register_allocation_data_ = new (register_allocation_zone())
         RegisterAllocationData(config, register_allocation_zone(), frame(),
-                               sequence(), debug_name_.get());
+                               sequence(), debug_name_.get(), mode);
   }
 
   void BeginPhaseKind(const char* phase_kind_name) {
@@ -337,6 +347,9 @@ class PipelineData {
   Zone* instruction_zone_;
   InstructionSequence* sequence_ = nullptr;
   Frame* frame_ = nullptr;
+  // Not allocated in the zone, but refers to objects in it. It is deleted
+  // together with the zone.
+  CodeGenerator* code_generator_ = nullptr;
 
   // All objects in the following group of fields are allocated in
   // register_allocation_zone_.  They are all set to nullptr when the zone is
@@ -385,11 +398,18 @@ class PipelineImpl final {
   // Perform the actual code generation and return handle to a code object.
   Handle<Code> GenerateCode(Linkage* linkage);
 
+  // The two steps of {GenerateCode}: AssembleCode emits the machine code into
+  // a buffer and does not need to run on the main thread; FinalizeCode then
+  // creates the code object on the main thread.
+  void AssembleCode(Linkage* linkage);
+  Handle<Code> FinalizeCode();
+
   bool ScheduleAndSelectInstructions(Linkage* linkage);
   void RunPrintAndVerify(const char* phase, bool untyped = false);
   Handle<Code> ScheduleAndGenerateCode(CallDescriptor* call_descriptor);
   void AllocateRegisters(const RegisterConfiguration* config,
                          CallDescriptor* descriptor, bool run_verifier);
+  RegisterAllocationData::AllocationMode SelectAllocationMode() const;
 
   CompilationInfo* info() const;
   Isolate* isolate() const;
@@ -669,10 +689,14 @@ class PipelineWasmCompilationJob final : public CompilationJob {
   Status GenerateCodeImpl() final;
 
  private:
+  // Returns true if assembling {sequence} calls code stubs.
+  static bool NeedsStubsToAssemble(InstructionSequence* sequence);
+
   ZonePool zone_pool_;
   PipelineData data_;
   PipelineImpl pipeline_;
   Linkage linkage_;
+  bool assembled_ = false;
 };
 
 PipelineWasmCompilationJob::Status
@@ -691,15 +715,52 @@ PipelineWasmCompilationJob::OptimizeGraphImpl() {
   pipeline_.RunPrintAndVerify("Machine", true);
 
   if (!pipeline_.ScheduleAndSelectInstructions(&linkage_)) return FAILED;
+  // Some instructions call code stubs (e.g. the DoubleToIStub behind the
+  // asm.js conversions), whose code is looked up in the stub cache or
+  // compiled on demand. That is only possible on the main thread, so such
+  // functions are assembled in {GenerateCodeImpl}.
+  if (!NeedsStubsToAssemble(data_.sequence())) {
+    // Assembling the machine code here leaves only the creation of the code
+    // object to the main thread. The heap constants of wasm code (context,
+    // code objects, function tables) are handles that were created on the
+    // main thread before the job started. The assembler records them by
+    // location and {FinalizeCode} reads them on the main thread. The only
+    // dereferences here are the Smi checks in {MacroAssembler::Move}, whose
+    // result does not change if the GC moves the object concurrently. Wasm
+    // call descriptors cannot use roots, so the code generator does not
+    // look up constants in the (lazily built) root index map either.
+    DCHECK_EQ(0, linkage_.GetIncomingDescriptor()->flags() &
+                     CallDescriptor::kCanUseRoots);
+    AllowHandleDereference allow_smi_checks;
+    pipeline_.AssembleCode(&linkage_);
+    assembled_ = true;
+  }
   return SUCCEEDED;
 }
 
 PipelineWasmCompilationJob::Status
 PipelineWasmCompilationJob::GenerateCodeImpl() {
-  pipeline_.GenerateCode(&linkage_);
+  if (!assembled_) pipeline_.AssembleCode(&linkage_);
+  pipeline_.FinalizeCode();
   return SUCCEEDED;
 }
 
+// static
+bool PipelineWasmCompilationJob::NeedsStubsToAssemble(
+    InstructionSequence* sequence) {
+  for (Instruction* instr : sequence->instructions()) {
+    switch (instr->arch_opcode()) {
+      case kArchTruncateDoubleToI:      // DoubleToIStub
+      case kArchStoreWithWriteBarrier:  // RecordWriteStub
+      case kIeee754Float64Pow:          // MathPowStub
+        return true;
+      default:
+        break;
+    }
+  }
+  return false;
+}
+
 template <typename Phase>
 void PipelineImpl::Run() {
   PipelineRunScope scope(this->data_, Phase::phase_name());
@@ -1027,6 +1088,21 @@ struct ControlFlowOptimizationPhase {
   }
 };
 
+struct LoopVectorizationPhase {
+  static const char* phase_name() { return "loop vectorization"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    // The loop finder requires the graph to be trimmed.
+    GraphTrimmer trimmer(temp_zone, data->graph());
+    NodeVector roots(temp_zone);
+    data->jsgraph()->GetCachedNodes(&roots);
+    trimmer.TrimGraph(roots.begin(), roots.end());
+
+    LoopVectorizer vectorizer(data->jsgraph(), temp_zone);
+    vectorizer.Run();
+  }
+};
+
 struct EffectControlLinearizationPhase {
   static const char* phase_name() { return "effect linearization"; }
 
@@ -1175,10 +1251,14 @@ struct ComputeSchedulePhase {
   static const char* phase_name() { return "scheduling"; }
 
   void Run(PipelineData* data, Zone* temp_zone) {
-    Schedule* schedule = Scheduler::ComputeSchedule(
-        temp_zone, data->graph(), data->info()->is_splitting_enabled()
-                                      ? Scheduler::kSplitNodes
-                                      : Scheduler::kNoFlags);
+    // Splitting nodes into deferred blocks only pays off for code that stays.
+    Scheduler::Flags flags = Scheduler::kNoFlags;
+    if (data->info()->is_splitting_enabled() &&
+        !data->info()->is_fast_compilation()) {
+      flags |= Scheduler::kSplitNodes;
+    }
+    Schedule* schedule =
+        Scheduler::ComputeSchedule(temp_zone, data->graph(), flags);
     if (FLAG_turbo_verify) ScheduleVerifier::Run(schedule);
     data->set_schedule(schedule);
   }
@@ -1189,12 +1269,19 @@ struct InstructionSelectionPhase {
   static const char* phase_name() { return "select instructions"; }
 
   void Run(PipelineData* data, Zone* temp_zone, Linkage* linkage) {
+    // Scheduling instructions does not pay off for code that is compiled fast.
+    InstructionSelector::EnableScheduling enable_scheduling =
+        FLAG_turbo_instruction_scheduling &&
+                !data->info()->is_fast_compilation()
+            ? InstructionSelector::kEnableScheduling
+            : InstructionSelector::kDisableScheduling;
     InstructionSelector selector(
         temp_zone, data->graph()->NodeCount(), linkage, data->sequence(),
         data->schedule(), data->source_positions(), data->frame(),
         data->info()->is_source_positions_enabled()
             ? InstructionSelector::kAllSourcePositions
-            : InstructionSelector::kCallSourcePositions);
+            : InstructionSelector::kCallSourcePositions,
+        InstructionSelector::SupportedFeatures(), enable_scheduling);
     selector.SelectInstructions();
   }
 };
@@ -1368,13 +1455,19 @@ struct JumpThreadingPhase {
 };
 
 
-struct GenerateCodePhase {
-  static const char* phase_name() { return "generate code"; }
+struct AssembleCodePhase {
+  static const char* phase_name() { return "assemble code"; }
 
-  void Run(PipelineData* data, Zone* temp_zone, Linkage* linkage) {
-    CodeGenerator generator(data->frame(), linkage, data->sequence(),
-                            data->info());
-    data->set_code(generator.GenerateCode());
+  void Run(PipelineData* data, Zone* temp_zone) {
+    data->code_generator()->AssembleCode();
+  }
+};
+
+struct FinalizeCodePhase {
+  static const char* phase_name() { return "finalize code"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    data->set_code(data->code_generator()->FinalizeCode());
   }
 };
 
@@ -1564,6 +1657,11 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
     RunPrintAndVerify("Control flow optimized", true);
   }
 
+  if (FLAG_turbo_loop_vectorization && CpuFeatures::SupportsSimd128()) {
+    Run<LoopVectorizationPhase>();
+    RunPrintAndVerify("Loops vectorized", true);
+  }
+
   // Optimize memory access and allocation operations.
   Run<MemoryOptimizationPhase>();
   // TODO(jarin, rossberg): Remove UNTYPED once machine typing works.
@@ -1728,7 +1826,12 @@ bool PipelineImpl::ScheduleAndSelectInstructions(Linkage* linkage) {
 
   data->DeleteGraphZone();
 
-  data->BeginPhaseKind("register allocation");
+  // Report the fast mode as a separate phase kind, so that --turbo-stats
+  // keeps its per-phase times apart from those of the regular allocator.
+  data->BeginPhaseKind(SelectAllocationMode() ==
+                               RegisterAllocationData::kFastAllocation
+                           ? "register allocation (fast)"
+                           : "register allocation");
 
   bool run_verifier = FLAG_turbo_verify_allocation;
 
@@ -1746,7 +1849,7 @@ bool PipelineImpl::ScheduleAndSelectInstructions(Linkage* linkage) {
   bool generate_frame_at_start =
       data_->sequence()->instruction_blocks().front()->must_construct_frame();
   // Optimimize jumps.
-  if (FLAG_turbo_jt) {
+  if (FLAG_turbo_jt && !info()->is_fast_compilation()) {
     Run<JumpThreadingPhase>(generate_frame_at_start);
   }
 
@@ -1756,12 +1859,24 @@ bool PipelineImpl::ScheduleAndSelectInstructions(Linkage* linkage) {
 }
 
 Handle<Code> PipelineImpl::GenerateCode(Linkage* linkage) {
+  AssembleCode(linkage);
+  return FinalizeCode();
+}
+
+void PipelineImpl::AssembleCode(Linkage* linkage) {
   PipelineData* data = this->data_;
 
   data->BeginPhaseKind("code generation");
 
   // Generate final machine code.
-  Run<GenerateCodePhase>(linkage);
+  data->InitializeCodeGenerator(linkage);
+  Run<AssembleCodePhase>();
+}
+
+Handle<Code> PipelineImpl::FinalizeCode() {
+  PipelineData* data = this->data_;
+
+  Run<FinalizeCodePhase>();
 
   Handle<Code> code = data->code();
   if (data->profiler_data()) {
@@ -1811,6 +1926,22 @@ Handle<Code> PipelineImpl::ScheduleAndGenerateCode(
   return GenerateCode(&linkage);
 }
 
+RegisterAllocationData::AllocationMode PipelineImpl::SelectAllocationMode()
+    const {
+  if (info()->is_fast_compilation()) {
+    return RegisterAllocationData::kFastAllocation;
+  }
+  // Linear scan and the range heuristics around it are super-linear in
+  // practice, so huge functions (e.g. generated asm.js code) get the cheaper
+  // fast mode, which skips the splintering and move optimization phases.
+  if (FLAG_turbo_fast_regalloc &&
+      data_->sequence()->instructions().size() >
+          static_cast<size_t>(FLAG_turbo_fast_regalloc_threshold)) {
+    return RegisterAllocationData::kFastAllocation;
+  }
+  return RegisterAllocationData::kNormalAllocation;
+}
+
 void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
                                      CallDescriptor* descriptor,
                                      bool run_verifier) {
@@ -1830,7 +1961,15 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
   data_->sequence()->ValidateDeferredBlockExitPaths();
 #endif
 
-  data->InitializeRegisterAllocationData(config, descriptor);
+  RegisterAllocationData::AllocationMode const mode = SelectAllocationMode();
+  if (FLAG_trace_alloc && mode == RegisterAllocationData::kFastAllocation) {
+    PrintF("Using fast register allocation for %d instructions\n",
+           data->sequence()->LastInstructionIndex() + 1);
+  }
+  data->InitializeRegisterAllocationData(config, descriptor, mode);
+  bool const preprocess_ranges =
+      FLAG_turbo_preprocess_ranges &&
+      mode != RegisterAllocationData::kFastAllocation;
   if (info()->is_osr()) {
     AllowHandleDereference allow_deref;
     OsrHelper osr_helper(info());
@@ -1852,14 +1991,14 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
               ->RangesDefinedInDeferredStayInDeferred());
   }
 
-  if (FLAG_turbo_preprocess_ranges) {
+  if (preprocess_ranges) {
     Run<SplinterLiveRangesPhase>();
   }
 
   Run<AllocateGeneralRegistersPhase<LinearScanAllocator>>();
   Run<AllocateFPRegistersPhase<LinearScanAllocator>>();
 
-  if (FLAG_turbo_preprocess_ranges) {
+  if (preprocess_ranges) {
     Run<MergeSplintersPhase>();
   }
 
@@ -1869,7 +2008,8 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
   Run<PopulateReferenceMapsPhase>();
   Run<ConnectRangesPhase>();
   Run<ResolveControlFlowPhase>();
-  if (FLAG_turbo_move_optimization) {
+  if (FLAG_turbo_move_optimization &&
+      mode != RegisterAllocationData::kFastAllocation) {
     Run<OptimizeMovesPhase>();
   }
 
@@ -1328,12 +1328,13 @@ void RegisterAllocationData::PhiMapValue::CommitAssignment(
 
 RegisterAllocationData::RegisterAllocationData(
     const RegisterConfiguration* config, Zone* zone, Frame* frame,
-    InstructionSequence* code, const char* debug_name)
+    InstructionSequence* code, const char* debug_name, AllocationMode mode)
     : allocation_zone_(zone),
       frame_(frame),
       code_(code),
       debug_name_(debug_name),
       config_(config),
+      allocation_mode_(mode),
       phi_map_(allocation_zone()),
       live_in_sets_(code->InstructionBlockCount(), nullptr, allocation_zone()),
       live_out_sets_(code->InstructionBlockCount(), nullptr, allocation_zone()),
@@ -2464,6 +2465,10 @@ LifetimePosition RegisterAllocator::FindOptimalSplitPos(LifetimePosition start,
   // We have no choice
   if (start_instr == end_instr) return end;
 
+  // The loop-aware search below walks the loop nest for every split; in fast
+  // mode we always split at the latest possible position.
+  if (data()->is_fast_allocation()) return end;
+
   const InstructionBlock* start_block = GetInstructionBlock(code(), start);
   const InstructionBlock* end_block = GetInstructionBlock(code(), end);
 
@@ -2496,6 +2501,7 @@ LifetimePosition RegisterAllocator::FindOptimalSplitPos(LifetimePosition start,
 
 LifetimePosition RegisterAllocator::FindOptimalSpillingPos(
     LiveRange* range, LifetimePosition pos) {
+  if (data()->is_fast_allocation()) return pos;
   const InstructionBlock* block = GetInstructionBlock(code(), pos.Start());
   const InstructionBlock* loop_header =
       block->IsLoopHeader() ? block : GetContainingLoop(code(), block);
@@ -2606,8 +2612,10 @@ void LinearScanAllocator::AllocateRegisters() {
     TRACE("Processing interval %d:%d start=%d\n", current->TopLevel()->vreg(),
           current->relative_id(), position.value());
 
-    if (current->IsTopLevel() && TryReuseSpillForPhi(current->TopLevel()))
+    if (!data()->is_fast_allocation() && current->IsTopLevel() &&
+        TryReuseSpillForPhi(current->TopLevel())) {
       continue;
+    }
 
     for (size_t i = 0; i < active_live_ranges().size(); ++i) {
       LiveRange* cur_active = active_live_ranges()[i];
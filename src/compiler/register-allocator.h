@@ -751,10 +751,16 @@ class RegisterAllocationData final : public ZoneObject {
   typedef ZoneVector<std::pair<TopLevelLiveRange*, int>>
       RangesWithPreassignedSlots;
 
+  // In fast mode the allocator skips the heuristics that search for better
+  // split and spill positions, trading code quality for compile time on very
+  // large functions.
+  enum AllocationMode { kNormalAllocation, kFastAllocation };
+
   RegisterAllocationData(const RegisterConfiguration* config,
                          Zone* allocation_zone, Frame* frame,
                          InstructionSequence* code,
-                         const char* debug_name = nullptr);
+                         const char* debug_name = nullptr,
+                         AllocationMode mode = kNormalAllocation);
 
   const ZoneVector<TopLevelLiveRange*>& live_ranges() const {
     return live_ranges_;
@@ -786,6 +792,10 @@ class RegisterAllocationData final : public ZoneObject {
   Frame* frame() const { return frame_; }
   const char* debug_name() const { return debug_name_; }
   const RegisterConfiguration* config() const { return config_; }
+  AllocationMode allocation_mode() const { return allocation_mode_; }
+  bool is_fast_allocation() const {
+    return allocation_mode_ == kFastAllocation;
+  }
 
   MachineRepresentation RepresentationFor(int virtual_register);
 
@@ -828,6 +838,7 @@ class RegisterAllocationData final : public ZoneObject {
   InstructionSequence* const code_;
   const char* const debug_name_;
   const RegisterConfiguration* const config_;
+  const AllocationMode allocation_mode_;
   PhiMap phi_map_;
   ZoneVector<BitVector*> live_in_sets_;
   ZoneVector<BitVector*> live_out_sets_;
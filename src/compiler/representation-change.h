@@ -129,6 +129,9 @@ class UseInfo {
   static UseInfo AnyTagged() {
     return UseInfo(MachineRepresentation::kTagged, Truncation::Any());
   }
+  static UseInfo Simd128() {
+    return UseInfo(MachineRepresentation::kSimd128, Truncation::Any());
+  }
 
   // Possibly deoptimizing conversions.
   static UseInfo CheckedSigned32AsWord32() {
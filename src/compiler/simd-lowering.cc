@@ -30,7 +30,7 @@ void SimdLowering::InitializeSignatures() {
                                                      kBinop);
   ConversionSignature::Builder ExtractLaneFloatBuilder(zone_, kReturnCount,
                                                        kBinop);
-  ConversionSignature::Builder DefaultBuilder(zone_, kReturnCount, kSimd8x16);
+  ConversionSignature::Builder DefaultBuilder(zone_, kReturnCount, kBinop);
 
   // Initialize Signatures for create functions
   for (int i = 0; i < kSimd32x4; i++) {
@@ -60,6 +60,17 @@ void SimdLowering::InitializeSignatures() {
   ExtractLaneIntBuilder.AddParam(Conversion::kInt32);
   ExtractLaneIntBuilder.AddReturn(Conversion::kInt32);
   SigExtractLaneInt = ExtractLaneIntBuilder.Build();
+
+  ExtractLaneFloatBuilder.AddParam(Conversion::kOpaque);
+  ExtractLaneFloatBuilder.AddParam(Conversion::kInt32);
+  ExtractLaneFloatBuilder.AddReturn(Conversion::kFloat32);
+  SigExtractLaneFloat = ExtractLaneFloatBuilder.Build();
+
+  // Initialize signature for the remaining binary operations.
+  DefaultBuilder.AddParam(Conversion::kOpaque);
+  DefaultBuilder.AddParam(Conversion::kOpaque);
+  DefaultBuilder.AddReturn(Conversion::kOpaque);
+  SigDefault = DefaultBuilder.Build();
 }
 
 Reduction SimdLowering::Reduce(Node* node) {
@@ -82,7 +82,8 @@ UseInfo TruncatingUseInfoFromRepresentation(MachineRepresentation rep) {
       return UseInfo::TruncatingWord32();
     case MachineRepresentation::kBit:
       return UseInfo::Bool();
-    case MachineRepresentation::kSimd128:  // Fall through.
+    case MachineRepresentation::kSimd128:
+      return UseInfo::Simd128();
     case MachineRepresentation::kNone:
       break;
   }
@@ -816,6 +817,20 @@ class RepresentationSelector {
     Type* type = TypeOf(node);
     if (type->Is(Type::None())) {
       return MachineRepresentation::kNone;
+    } else if (type->Is(type_cache_.kSimd128)) {
+      // Phis created by escape analysis for the payload of SIMD values keep
+      // the unboxed 128-bit representation.
+#ifdef DEBUG
+      // Check that all the inputs agree on being Simd128.
+      DCHECK_EQ(IrOpcode::kPhi, node->opcode());  // This only works for phis.
+      if (lower()) {
+        for (int i = 0; i < node->op()->ValueInputCount(); i++) {
+          DCHECK_EQ(MachineRepresentation::kSimd128,
+                    GetInfo(node->InputAt(i))->representation());
+        }
+      }
+#endif
+      return MachineRepresentation::kSimd128;
     } else if (type->Is(Type::Signed32()) || type->Is(Type::Unsigned32())) {
       return MachineRepresentation::kWord32;
     } else if (use.IsUsedAsWord32()) {
@@ -965,6 +980,45 @@ class RepresentationSelector {
     SetOutput(node, MachineRepresentation::kTagged);
   }
 
+  void VisitObjectState(Node* node) {
+    // Fields are materialized from tagged values, except for the unboxed
+    // payload of SIMD values, which the deoptimizer reads as raw bits. Only
+    // object states with such a payload need typed inputs.
+    bool has_simd128_fields = false;
+    for (int i = 0; i < node->InputCount(); i++) {
+      if (IsSimd128Payload(node->InputAt(i))) has_simd128_fields = true;
+    }
+    if (!has_simd128_fields) {
+      VisitInputs(node);
+      return SetOutput(node, MachineRepresentation::kTagged);
+    }
+
+    for (int i = 0; i < node->InputCount(); i++) {
+      ProcessInput(node, i, IsSimd128Payload(node->InputAt(i))
+                                ? UseInfo::Simd128()
+                                : UseInfo::AnyTagged());
+    }
+    if (lower()) {
+      Zone* zone = jsgraph_->zone();
+      ZoneVector<MachineType>* types =
+          new (zone->New(sizeof(ZoneVector<MachineType>)))
+              ZoneVector<MachineType>(node->InputCount(), zone);
+      for (int i = 0; i < node->InputCount(); i++) {
+        (*types)[i] = IsSimd128Payload(node->InputAt(i))
+                          ? MachineType::Simd128()
+                          : MachineType::AnyTagged();
+      }
+      NodeProperties::ChangeOp(node,
+                               jsgraph_->common()->TypedObjectState(types));
+    }
+    SetOutput(node, MachineRepresentation::kTagged);
+  }
+
+  bool IsSimd128Payload(Node* node) {
+    Type* type = TypeOf(node);
+    return !type->Is(Type::None()) && type->Is(type_cache_.kSimd128);
+  }
+
   const Operator* Int32Op(Node* node) {
     return changer_->Int32OperatorFor(node->opcode());
   }
@@ -2444,6 +2498,25 @@ class RepresentationSelector {
         return VisitLeaf(node, MachineType::PointerRepresentation());
       case IrOpcode::kStateValues:
         return VisitStateValues(node);
+      case IrOpcode::kObjectState:
+        return VisitObjectState(node);
+
+      // SIMD operations on the unboxed payload of Float32x4 and Int32x4
+      // values, see JSBuiltinReducer.
+      case IrOpcode::kFloat32x4Add:
+      case IrOpcode::kFloat32x4Sub:
+      case IrOpcode::kFloat32x4Mul:
+      case IrOpcode::kFloat32x4Div:
+      case IrOpcode::kInt32x4Add:
+      case IrOpcode::kInt32x4Sub:
+        return VisitBinop(node, UseInfo::Simd128(),
+                          MachineRepresentation::kSimd128);
+      case IrOpcode::kFloat32x4ExtractLane:
+        return VisitBinop(node, UseInfo::Simd128(), UseInfo::TruncatingWord32(),
+                          MachineRepresentation::kFloat32);
+      case IrOpcode::kInt32x4ExtractLane:
+        return VisitBinop(node, UseInfo::Simd128(), UseInfo::TruncatingWord32(),
+                          MachineRepresentation::kWord32);
 
       // The following opcodes are not produced before representation
       // inference runs, so we do not have any real test coverage.
@@ -875,6 +875,10 @@ Type* Typer::Visitor::TypeStateValues(Node* node) { return Type::Internal(); }
 
 Type* Typer::Visitor::TypeObjectState(Node* node) { return Type::Internal(); }
 
+Type* Typer::Visitor::TypeTypedObjectState(Node* node) {
+  return Type::Internal();
+}
+
 Type* Typer::Visitor::TypeTypedStateValues(Node* node) {
   return Type::Internal();
 }
@@ -2618,6 +2622,13 @@ Type* Typer::Visitor::TypeCheckedStore(Node* node) {
   return nullptr;
 }
 
+Type* Typer::Visitor::TypeProtectedLoad(Node* node) { return Type::Any(); }
+
+Type* Typer::Visitor::TypeProtectedStore(Node* node) {
+  UNREACHABLE();
+  return nullptr;
+}
+
 Type* Typer::Visitor::TypeAtomicLoad(Node* node) { return Type::Any(); }
 
 Type* Typer::Visitor::TypeAtomicStore(Node* node) {
@@ -2625,6 +2636,34 @@ Type* Typer::Visitor::TypeAtomicStore(Node* node) {
   return nullptr;
 }
 
+Type* Typer::Visitor::TypeWord32AtomicExchange(Node* node) {
+  return Type::Integral32();
+}
+
+Type* Typer::Visitor::TypeWord32AtomicCompareExchange(Node* node) {
+  return Type::Integral32();
+}
+
+Type* Typer::Visitor::TypeWord32AtomicAdd(Node* node) {
+  return Type::Integral32();
+}
+
+Type* Typer::Visitor::TypeWord32AtomicSub(Node* node) {
+  return Type::Integral32();
+}
+
+Type* Typer::Visitor::TypeWord32AtomicAnd(Node* node) {
+  return Type::Integral32();
+}
+
+Type* Typer::Visitor::TypeWord32AtomicOr(Node* node) {
+  return Type::Integral32();
+}
+
+Type* Typer::Visitor::TypeWord32AtomicXor(Node* node) {
+  return Type::Integral32();
+}
+
 Type* Typer::Visitor::TypeInt32PairAdd(Node* node) { return Type::Internal(); }
 
 Type* Typer::Visitor::TypeInt32PairSub(Node* node) { return Type::Internal(); }
@@ -2639,14 +2678,21 @@ Type* Typer::Visitor::TypeWord32PairSar(Node* node) { return Type::Internal(); }
 
 // SIMD type methods.
 
-#define SIMD_RETURN_SIMD(Name) \
-  Type* Typer::Visitor::Type##Name(Node* node) { return Type::Simd(); }
+#define SIMD_RETURN_SIMD(Name)                   \
+  Type* Typer::Visitor::Type##Name(Node* node) { \
+    return typer_->cache_.kSimd128;              \
+  }
 MACHINE_SIMD_RETURN_SIMD_OP_LIST(SIMD_RETURN_SIMD)
 MACHINE_SIMD_GENERIC_OP_LIST(SIMD_RETURN_SIMD)
 #undef SIMD_RETURN_SIMD
 
-#define SIMD_RETURN_NUM(Name) \
-  Type* Typer::Visitor::Type##Name(Node* node) { return Type::Number(); }
+// Integer lanes are extracted as sign-extended int32 values.
+#define SIMD_RETURN_NUM(Name)                                \
+  Type* Typer::Visitor::Type##Name(Node* node) {             \
+    return node->opcode() == IrOpcode::kFloat32x4ExtractLane \
+               ? Type::Number()                              \
+               : Type::Signed32();                           \
+  }
 MACHINE_SIMD_RETURN_NUM_OP_LIST(SIMD_RETURN_NUM)
 #undef SIMD_RETURN_NUM
 
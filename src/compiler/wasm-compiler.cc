@@ -37,6 +37,7 @@
 #include "src/wasm/ast-decoder.h"
 #include "src/wasm/wasm-module.h"
 #include "src/wasm/wasm-opcodes.h"
+#include "src/wasm/wasm-trap-handler.h"
 
 // TODO(titzer): pull WASM_64 up to a common header.
 #if !V8_TARGET_ARCH_32_BIT || V8_TARGET_ARCH_X64
@@ -975,6 +976,54 @@ Node* WasmGraphBuilder::Unreachable(wasm::WasmCodePosition position) {
   return nullptr;
 }
 
+void WasmGraphBuilder::TierUpCheck() {
+  if (tier_up_index_ < 0) return;
+  DCHECK_NOT_NULL(module_);
+  DCHECK(!module_->instance->tier_up_budgets.is_null());
+  MachineOperatorBuilder* m = jsgraph()->machine();
+  CommonOperatorBuilder* common = jsgraph()->common();
+
+  // The budgets are untagged int32 values, which need no write barrier.
+  Node* budgets = HeapConstant(module_->instance->tier_up_budgets);
+  Node* offset = jsgraph()->IntPtrConstant(
+      ByteArray::kHeaderSize - kHeapObjectTag + tier_up_index_ * kIntSize);
+  Node* load = graph()->NewNode(m->Load(MachineType::Int32()), budgets, offset,
+                                *effect_, *control_);
+  Node* budget =
+      graph()->NewNode(m->Int32Sub(), load, jsgraph()->Int32Constant(1));
+  Node* store = graph()->NewNode(
+      m->Store(StoreRepresentation(MachineRepresentation::kWord32,
+                                   kNoWriteBarrier)),
+      budgets, offset, budget, load, *control_);
+
+  Node* check = graph()->NewNode(m->Int32LessThan(), budget,
+                                 jsgraph()->Int32Constant(0));
+  Node* branch =
+      graph()->NewNode(common->Branch(BranchHint::kFalse), check, *control_);
+  Node* if_true = graph()->NewNode(common->IfTrue(), branch);
+  Node* if_false = graph()->NewNode(common->IfFalse(), branch);
+
+  Runtime::FunctionId function_id = Runtime::kWasmTierUp;
+  const Runtime::Function* function = Runtime::FunctionForId(function_id);
+  CallDescriptor* desc = Linkage::GetRuntimeCallDescriptor(
+      jsgraph()->zone(), function_id, function->nargs, Operator::kNoProperties,
+      CallDescriptor::kNoFlags);
+  Node* inputs[] = {
+      jsgraph()->CEntryStubConstant(function->result_size),  // C entry
+      jsgraph()->ExternalConstant(
+          ExternalReference(function_id, jsgraph()->isolate())),  // ref
+      jsgraph()->Int32Constant(function->nargs),                  // arity
+      HeapConstant(module_->instance->context),                   // context
+      store,
+      if_true};
+  Node* call = graph()->NewNode(common->Call(desc),
+                                static_cast<int>(arraysize(inputs)), inputs);
+
+  Node* merge = graph()->NewNode(common->Merge(2), call, if_false);
+  *effect_ = graph()->NewNode(common->EffectPhi(2), call, store, merge);
+  *control_ = merge;
+}
+
 Node* WasmGraphBuilder::MaskShiftCount32(Node* node) {
   static const int32_t kMask32 = 0x1f;
   if (!jsgraph()->machine()->Word32ShiftIsSafe()) {
@@ -1759,6 +1808,34 @@ Node* WasmGraphBuilder::BuildGrowMemory(Node* input) {
   return node;
 }
 
+Node* WasmGraphBuilder::BuildCallToRuntime(Runtime::FunctionId function_id,
+                                           Node** parameters,
+                                           int parameter_count) {
+  const Runtime::Function* function = Runtime::FunctionForId(function_id);
+  DCHECK_EQ(function->nargs, parameter_count);
+  CallDescriptor* desc = Linkage::GetRuntimeCallDescriptor(
+      jsgraph()->zone(), function_id, function->nargs, Operator::kNoProperties,
+      CallDescriptor::kNoFlags);
+  static const int kMaxParams = 3;
+  DCHECK_GE(kMaxParams, parameter_count);
+  Node* inputs[kMaxParams + 6];
+  int count = 0;
+  inputs[count++] = jsgraph()->CEntryStubConstant(function->result_size);
+  for (int i = 0; i < parameter_count; i++) {
+    inputs[count++] = parameters[i];
+  }
+  inputs[count++] = jsgraph()->ExternalConstant(
+      ExternalReference(function_id, jsgraph()->isolate()));  // ref
+  inputs[count++] = jsgraph()->Int32Constant(function->nargs);  // arity
+  inputs[count++] = HeapConstant(module_->instance->context);   // context
+  inputs[count++] = *effect_;
+  inputs[count++] = *control_;
+  Node* node = graph()->NewNode(jsgraph()->common()->Call(desc), count, inputs);
+  *effect_ = node;
+  *control_ = node;
+  return node;
+}
+
 Node* WasmGraphBuilder::BuildI32DivS(Node* left, Node* right,
                                      wasm::WasmCodePosition position) {
   MachineOperatorBuilder* m = jsgraph()->machine();
@@ -2099,33 +2176,33 @@ Node* WasmGraphBuilder::CallIndirect(uint32_t index, Node** args,
   }
   Node* table = FunctionTable(0);
 
-  // Load signature from the table and check.
-  // The table is a FixedArray; signatures are encoded as SMIs.
-  // [sig1, sig2, sig3, ...., code1, code2, code3 ...]
+  // The table is a FixedArray of (signature, code) pairs; signatures are
+  // encoded as SMIs holding the canonical signature index.
+  // [sig1, code1, sig2, code2, sig3, code3, ...]
   ElementAccess access = AccessBuilder::ForFixedArrayElement();
   const int fixed_offset = access.header_size - access.tag();
+  Node* entry = graph()->NewNode(
+      machine->Word32Shl(), key, Int32Constant(kPointerSizeLog2 + 1));
   {
+    // Compare the tagged signature directly, without untagging it.
     Node* load_sig = graph()->NewNode(
-        machine->Load(MachineType::AnyTagged()), table,
-        graph()->NewNode(machine->Int32Add(),
-                         graph()->NewNode(machine->Word32Shl(), key,
-                                          Int32Constant(kPointerSizeLog2)),
+        machine->Load(MachineType::Pointer()), table,
+        graph()->NewNode(machine->Int32Add(), entry,
                          Int32Constant(fixed_offset)),
         *effect_, *control_);
-    Node* sig_match =
-        graph()->NewNode(machine->Word32Equal(),
-                         BuildChangeSmiToInt32(load_sig), Int32Constant(index));
+    int32_t canonical_index = module_->GetCanonicalSignatureIndex(index);
+    Node* sig_match = graph()->NewNode(
+        machine->WordEqual(), load_sig,
+        jsgraph()->IntPtrConstant(
+            reinterpret_cast<intptr_t>(Smi::FromInt(canonical_index))));
     trap_->AddTrapIfFalse(wasm::kTrapFuncSigMismatch, sig_match, position);
   }
 
   // Load code object from the table.
-  uint32_t offset = fixed_offset + kPointerSize * table_size;
   Node* load_code = graph()->NewNode(
       machine->Load(MachineType::AnyTagged()), table,
-      graph()->NewNode(machine->Int32Add(),
-                       graph()->NewNode(machine->Word32Shl(), key,
-                                        Int32Constant(kPointerSizeLog2)),
-                       Uint32Constant(offset)),
+      graph()->NewNode(machine->Int32Add(), entry,
+                       Int32Constant(fixed_offset + kPointerSize)),
       *effect_, *control_);
 
   args[0] = load_code;
@@ -2194,7 +2271,7 @@ Node* WasmGraphBuilder::JITSingleFunction(Node* const base, Node* const length,
   inputs[2] = BuildChangeUint32ToSmi(length);
   inputs[3] = BuildChangeUint32ToSmi(index);
   inputs[4] = FunctionTable(0);
-  inputs[5] = Uint32Constant(sig_index);
+  inputs[5] = Uint32Constant(module_->GetCanonicalSignatureIndex(sig_index));
   inputs[6] = BuildChangeUint32ToSmi(Uint32Constant(return_count));
 
   // Pass in parameters and return types in to the runtime function
@@ -2799,6 +2876,59 @@ void WasmGraphBuilder::BuildWasmToJSWrapper(Handle<JSFunction> function,
   MergeControlToEnd(jsgraph(), ret);
 }
 
+void WasmGraphBuilder::BuildWasmLazyCompileStub(Handle<Context> context,
+                                                wasm::FunctionSig* sig) {
+  int param_count;
+  if (jsgraph()->machine()->Is64()) {
+    param_count = static_cast<int>(sig->parameter_count());
+  } else {
+    param_count = Int64Lowering::GetParameterCountAfterLowering(sig);
+  }
+  Node* start = Start(param_count + 1);
+  *control_ = start;
+  *effect_ = start;
+
+  // Have the runtime compile the function. It finds out which function this
+  // stub stands for from the deoptimization data of the stub.
+  Runtime::FunctionId function_id = Runtime::kWasmCompileLazy;
+  const Runtime::Function* function = Runtime::FunctionForId(function_id);
+  CallDescriptor* runtime_desc = Linkage::GetRuntimeCallDescriptor(
+      jsgraph()->zone(), function_id, function->nargs, Operator::kNoProperties,
+      CallDescriptor::kNoFlags);
+  Node* runtime_inputs[] = {
+      jsgraph()->CEntryStubConstant(function->result_size),  // C entry
+      jsgraph()->ExternalConstant(
+          ExternalReference(function_id, jsgraph()->isolate())),  // ref
+      jsgraph()->Int32Constant(function->nargs),                  // arity
+      HeapConstant(context),                                      // context
+      *effect_,
+      *control_};
+  Node* code = graph()->NewNode(jsgraph()->common()->Call(runtime_desc),
+                                static_cast<int>(arraysize(runtime_inputs)),
+                                runtime_inputs);
+
+  // Tail call the compiled code with the incoming parameters, which keeps the
+  // stub out of stack traces of the function.
+  CallDescriptor* desc =
+      wasm::ModuleEnv::GetWasmCallDescriptor(jsgraph()->zone(), sig);
+  if (jsgraph()->machine()->Is32()) {
+    desc = wasm::ModuleEnv::GetI32WasmCallDescriptor(jsgraph()->zone(), desc);
+  }
+  int count = param_count + 3;
+  Node** args = Buffer(count);
+  int pos = 0;
+  args[pos++] = code;
+  for (int i = 0; i < param_count; ++i) {
+    args[pos++] = graph()->NewNode(jsgraph()->common()->Parameter(i), start);
+  }
+  args[pos++] = code;
+  args[pos++] = code;
+  Node* call =
+      graph()->NewNode(jsgraph()->common()->TailCall(desc), count, args);
+
+  MergeControlToEnd(jsgraph(), call);
+}
+
 Node* WasmGraphBuilder::MemBuffer(uint32_t offset) {
   DCHECK(module_ && module_->instance);
   if (offset == 0) {
@@ -2910,7 +3040,7 @@ Node* WasmGraphBuilder::ChangeToRuntimeCall(Node* node,
       NodeProperties::SetType(ret, Type::Number());
       ret = BuildChangeTaggedToFloat64(ret);
       ret = jsgraph()->graph()->NewNode(
-          jsgraph()->machine()->TruncateInt64ToInt32(), ret);
+          jsgraph()->machine()->TruncateFloat64ToFloat32(), ret);
       break;
     case Conversion::kFloat64:
       ret = BuildChangeTaggedToFloat64(ret);
@@ -2983,19 +3113,44 @@ void WasmGraphBuilder::BoundsCheckMem(MachineType memtype, Node* index,
 }
 
 
+bool WasmGraphBuilder::UseTrapHandler() {
+  // The landing pads throw from the runtime and need a context to do so.
+  return module_ && module_->instance &&
+         !module_->instance->context.is_null() &&
+         module_->origin != wasm::kAsmJsOrigin && wasm::UseTrapHandler();
+}
+
+Node* WasmGraphBuilder::ProtectedMemIndex(Node* index) {
+  // The guard region only covers unsigned 32-bit indices, so the index must
+  // not be sign-extended or carry stale upper bits into the address.
+  DCHECK(jsgraph()->machine()->Is64());
+  return graph()->NewNode(jsgraph()->machine()->ChangeUint32ToUint64(),
+                          index);
+}
+
 Node* WasmGraphBuilder::LoadMem(wasm::LocalType type, MachineType memtype,
                                 Node* index, uint32_t offset,
                                 uint32_t alignment,
                                 wasm::WasmCodePosition position) {
   Node* load;
 
-  // WASM semantics throw on OOB. Introduce explicit bounds check.
-  BoundsCheckMem(memtype, index, offset, position);
+  // WASM semantics throw on OOB. Introduce explicit bounds check, unless the
+  // trap handler catches out-of-bounds accesses in the guard region.
+  bool use_trap_handler = UseTrapHandler();
+  if (!use_trap_handler) BoundsCheckMem(memtype, index, offset, position);
   bool aligned = static_cast<int>(alignment) >=
                  ElementSizeLog2Of(memtype.representation());
 
-  if (aligned ||
-      jsgraph()->machine()->UnalignedLoadSupported(memtype, alignment)) {
+  if (use_trap_handler) {
+    // The trap handler is only supported on platforms that allow unaligned
+    // accesses.
+    Node* context = HeapConstant(module_->instance->context);
+    Node* position_node = jsgraph()->Int32Constant(position);
+    load = graph()->NewNode(jsgraph()->machine()->ProtectedLoad(memtype),
+                            MemBuffer(offset), ProtectedMemIndex(index),
+                            context, position_node, *effect_, *control_);
+  } else if (aligned ||
+             jsgraph()->machine()->UnalignedLoadSupported(memtype, alignment)) {
     load = graph()->NewNode(jsgraph()->machine()->Load(memtype),
                             MemBuffer(offset), index, *effect_, *control_);
   } else {
@@ -3031,8 +3186,10 @@ Node* WasmGraphBuilder::StoreMem(MachineType memtype, Node* index,
                                  wasm::WasmCodePosition position) {
   Node* store;
 
-  // WASM semantics throw on OOB. Introduce explicit bounds check.
-  BoundsCheckMem(memtype, index, offset, position);
+  // WASM semantics throw on OOB. Introduce explicit bounds check, unless the
+  // trap handler catches out-of-bounds accesses in the guard region.
+  bool use_trap_handler = UseTrapHandler();
+  if (!use_trap_handler) BoundsCheckMem(memtype, index, offset, position);
   StoreRepresentation rep(memtype.representation(), kNoWriteBarrier);
 
   bool aligned = static_cast<int>(alignment) >=
@@ -3042,8 +3199,16 @@ Node* WasmGraphBuilder::StoreMem(MachineType memtype, Node* index,
   val = BuildChangeEndianness(val, memtype);
 #endif
 
-  if (aligned ||
-      jsgraph()->machine()->UnalignedStoreSupported(memtype, alignment)) {
+  if (use_trap_handler) {
+    Node* context = HeapConstant(module_->instance->context);
+    Node* position_node = jsgraph()->Int32Constant(position);
+    store = graph()->NewNode(
+        jsgraph()->machine()->ProtectedStore(memtype.representation()),
+        MemBuffer(offset), ProtectedMemIndex(index), val, context,
+        position_node, *effect_, *control_);
+  } else if (aligned ||
+             jsgraph()->machine()->UnalignedStoreSupported(memtype,
+                                                           alignment)) {
     StoreRepresentation rep(memtype.representation(), kNoWriteBarrier);
     store =
         graph()->NewNode(jsgraph()->machine()->Store(rep), MemBuffer(offset),
@@ -3115,20 +3280,122 @@ MachineOperatorBuilder* WasmGraphBuilder::simd() {
   return jsgraph()->machine();
 }
 
+bool WasmGraphBuilder::needs_simd_lowering() const {
+  return has_simd_ops_ &&
+         (!CpuFeatures::SupportsSimd128() || has_non_native_simd_ops_);
+}
+
+Node* WasmGraphBuilder::SimdLane(Node* lane) {
+  // Native lane accesses encode the lane index as an immediate, any other
+  // index is left to the range check of the runtime functions.
+  if (!Int32Matcher(lane).IsInRange(0, 3)) has_non_native_simd_ops_ = true;
+  return lane;
+}
+
 Node* WasmGraphBuilder::SimdOp(wasm::WasmOpcode opcode,
                                const NodeVector& inputs) {
   switch (opcode) {
     case wasm::kExprI32x4ExtractLane:
       return graph()->NewNode(simd()->Int32x4ExtractLane(), inputs[0],
-                              inputs[1]);
+                              SimdLane(inputs[1]));
     case wasm::kExprI32x4Splat:
       return graph()->NewNode(simd()->CreateInt32x4(), inputs[0], inputs[0],
                               inputs[0], inputs[0]);
+    case wasm::kExprI32x4Add:
+      return graph()->NewNode(simd()->Int32x4Add(), inputs[0], inputs[1]);
+    case wasm::kExprI32x4Sub:
+      return graph()->NewNode(simd()->Int32x4Sub(), inputs[0], inputs[1]);
+    case wasm::kExprI32x4Mul:
+      // The packed 32-bit multiplication needs SSE4.1.
+      if (!CpuFeatures::IsSupported(SSE4_1)) has_non_native_simd_ops_ = true;
+      return graph()->NewNode(simd()->Int32x4Mul(), inputs[0], inputs[1]);
+    case wasm::kExprF32x4ExtractLane:
+      return graph()->NewNode(simd()->Float32x4ExtractLane(), inputs[0],
+                              SimdLane(inputs[1]));
+    case wasm::kExprF32x4Splat:
+      return graph()->NewNode(simd()->CreateFloat32x4(), inputs[0], inputs[0],
+                              inputs[0], inputs[0]);
+    case wasm::kExprF32x4Add:
+      return graph()->NewNode(simd()->Float32x4Add(), inputs[0], inputs[1]);
+    case wasm::kExprF32x4Sub:
+      return graph()->NewNode(simd()->Float32x4Sub(), inputs[0], inputs[1]);
+    case wasm::kExprF32x4Mul:
+      return graph()->NewNode(simd()->Float32x4Mul(), inputs[0], inputs[1]);
+    case wasm::kExprF32x4Div:
+      return graph()->NewNode(simd()->Float32x4Div(), inputs[0], inputs[1]);
     default:
       return graph()->NewNode(UnsupportedOpcode(opcode), nullptr);
   }
 }
 
+Node* WasmGraphBuilder::AtomicOp(wasm::WasmOpcode opcode,
+                                 const NodeVector& inputs, uint32_t offset,
+                                 wasm::WasmCodePosition position) {
+  MachineOperatorBuilder* m = jsgraph()->machine();
+  // Atomic accesses are not covered by the trap handler and always check their
+  // bounds explicitly. They also trap unless they are naturally aligned.
+  Node* index = inputs[0];
+  BoundsCheckMem(MachineType::Uint32(), index, offset, position);
+  Node* address = index;
+  if (offset != 0) {
+    address = graph()->NewNode(m->Int32Add(), index,
+                               jsgraph()->Uint32Constant(offset));
+  }
+  Node* misaligned = graph()->NewNode(m->Word32And(), address,
+                                      jsgraph()->Int32Constant(3));
+  trap_->AddTrapIfTrue(wasm::kTrapUnalignedAccess, misaligned, position);
+
+  Node* node;
+  switch (opcode) {
+    case wasm::kExprI32AtomicWait: {
+      Node* parameters[] = {BuildChangeUint32ToSmi(address),
+                            BuildChangeInt32ToTagged(inputs[1]),
+                            BuildChangeFloat64ToTagged(inputs[2])};
+      node = BuildCallToRuntime(Runtime::kWasmAtomicWait, parameters,
+                                arraysize(parameters));
+      return BuildChangeSmiToInt32(node);
+    }
+    case wasm::kExprI32AtomicWake: {
+      Node* parameters[] = {BuildChangeUint32ToSmi(address),
+                            BuildChangeInt32ToTagged(inputs[1])};
+      node = BuildCallToRuntime(Runtime::kWasmAtomicWake, parameters,
+                                arraysize(parameters));
+      return BuildChangeSmiToInt32(node);
+    }
+    case wasm::kExprI32AtomicLoad:
+      node = graph()->NewNode(m->AtomicLoad(MachineType::Int32()),
+                              MemBuffer(offset), index, *effect_, *control_);
+      break;
+    case wasm::kExprI32AtomicStore:
+      node = graph()->NewNode(m->AtomicStore(MachineRepresentation::kWord32),
+                              MemBuffer(offset), index, inputs[1], *effect_,
+                              *control_);
+      *effect_ = node;
+      return inputs[1];
+#define ATOMIC_RMW_CASE(Name)                                           \
+  case wasm::kExprI32Atomic##Name:                                      \
+    node = graph()->NewNode(m->Word32Atomic##Name(), MemBuffer(offset), \
+                            index, inputs[1], *effect_, *control_);     \
+    break;
+      ATOMIC_RMW_CASE(Add)
+      ATOMIC_RMW_CASE(Sub)
+      ATOMIC_RMW_CASE(And)
+      ATOMIC_RMW_CASE(Or)
+      ATOMIC_RMW_CASE(Xor)
+      ATOMIC_RMW_CASE(Exchange)
+#undef ATOMIC_RMW_CASE
+    case wasm::kExprI32AtomicCompareExchange:
+      node = graph()->NewNode(m->Word32AtomicCompareExchange(),
+                              MemBuffer(offset), index, inputs[1], inputs[2],
+                              *effect_, *control_);
+      break;
+    default:
+      return graph()->NewNode(UnsupportedOpcode(opcode), nullptr);
+  }
+  *effect_ = node;
+  return node;
+}
+
 static void RecordFunctionCompilation(CodeEventListener::LogEventsAndTags tag,
                                       Isolate* isolate, Handle<Code> code,
                                       const char* message, uint32_t index,
@@ -3204,6 +3471,7 @@ Handle<Code> CompileJSToWasmWrapper(Isolate* isolate, wasm::ModuleEnv* module,
   }
 
   CompilationInfo info(func_name, isolate, &zone, flags);
+  if (module->will_serialize) info.PrepareForSerializing();
   Handle<Code> code = Pipeline::GenerateCodeForTesting(&info, incoming, &graph);
 #ifdef ENABLE_DISASSEMBLER
   if (FLAG_print_opt_code && !code.is_null()) {
@@ -3305,6 +3573,54 @@ Handle<Code> CompileWasmToJSWrapper(Isolate* isolate,
   return code;
 }
 
+Handle<Code> CompileWasmLazyCompileStub(Isolate* isolate,
+                                        Handle<Context> context,
+                                        wasm::FunctionSig* sig,
+                                        bool will_serialize) {
+  //----------------------------------------------------------------------------
+  // Create the Graph
+  //----------------------------------------------------------------------------
+  Zone zone(isolate->allocator());
+  Graph graph(&zone);
+  CommonOperatorBuilder common(&zone);
+  MachineOperatorBuilder machine(&zone);
+  JSGraph jsgraph(isolate, &graph, &common, nullptr, nullptr, &machine);
+
+  Node* control = nullptr;
+  Node* effect = nullptr;
+
+  WasmGraphBuilder builder(&zone, &jsgraph, sig);
+  builder.set_control_ptr(&control);
+  builder.set_effect_ptr(&effect);
+  builder.BuildWasmLazyCompileStub(context, sig);
+
+  //----------------------------------------------------------------------------
+  // Run the compilation pipeline.
+  //----------------------------------------------------------------------------
+  if (FLAG_trace_turbo_graph) {  // Simple textual RPO.
+    OFStream os(stdout);
+    os << "-- Graph after change lowering -- " << std::endl;
+    os << AsRPO(graph);
+  }
+
+  // The stub has the signature of the function it stands for.
+  CallDescriptor* incoming = wasm::ModuleEnv::GetWasmCallDescriptor(&zone, sig);
+  if (machine.Is32()) {
+    incoming = wasm::ModuleEnv::GetI32WasmCallDescriptor(&zone, incoming);
+  }
+  Code::Flags flags = Code::ComputeFlags(Code::WASM_FUNCTION);
+  CompilationInfo info(ArrayVector("wasm-lazy-compile"), isolate, &zone, flags);
+  if (will_serialize) info.PrepareForSerializing();
+  Handle<Code> code = Pipeline::GenerateCodeForTesting(&info, incoming, &graph);
+#ifdef ENABLE_DISASSEMBLER
+  if (FLAG_print_opt_code && !code.is_null()) {
+    OFStream os(stdout);
+    code->Disassemble("wasm-lazy-compile", os);
+  }
+#endif
+  return code;
+}
+
 SourcePositionTable* WasmCompilationUnit::BuildGraphForWasmFunction(
     double* decode_ms) {
   base::ElapsedTimer decode_timer;
@@ -3320,6 +3636,10 @@ SourcePositionTable* WasmCompilationUnit::BuildGraphForWasmFunction(
       new (jsgraph_->zone()) SourcePositionTable(graph);
   WasmGraphBuilder builder(jsgraph_->zone(), jsgraph_, function_->sig,
                            source_position_table);
+  if (module_env_->instance != nullptr &&
+      !module_env_->instance->tier_up_budgets.is_null()) {
+    builder.set_tier_up_index(function_->func_index);
+  }
   wasm::FunctionBody body = {
       module_env_, function_->sig, module_env_->module->module_start,
       module_env_->module->module_start + function_->code_start_offset,
@@ -3342,8 +3662,9 @@ SourcePositionTable* WasmCompilationUnit::BuildGraphForWasmFunction(
 
   int index = static_cast<int>(function_->func_index);
 
-  // Run lowering pass if SIMD ops are present in the function
-  if (builder.has_simd_ops()) {
+  // Run lowering pass if SIMD ops are present in the function and cannot be
+  // selected natively.
+  if (builder.needs_simd_lowering()) {
     SimdLowering simd(jsgraph_->zone(), &builder);
     GraphReducer graph_reducer(jsgraph_->zone(), graph);
     graph_reducer.AddReducer(&simd);
@@ -3395,6 +3716,14 @@ WasmCompilationUnit::WasmCompilationUnit(wasm::ErrorThrower* thrower,
       ok_(true) {
   // Create and cache this node in the main thread.
   jsgraph_->CEntryStubConstant(1);
+  // Code of asm.js modules going into the script code cache needs relocation
+  // info for all external references.
+  if (module_env->will_serialize) info_.PrepareForSerializing();
+  // Code that counts down a tier-up budget is replaced once it gets hot.
+  if (module_env->instance != nullptr &&
+      !module_env->instance->tier_up_budgets.is_null()) {
+    info_.MarkAsFastCompilation();
+  }
 }
 
 void WasmCompilationUnit::ExecuteCompilation() {
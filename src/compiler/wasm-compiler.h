@@ -48,6 +48,7 @@ class WasmCompilationUnit final {
 
   Zone* graph_zone() { return graph_zone_.get(); }
   int index() const { return index_; }
+  CompilationInfo* info() { return &info_; }
 
   void ExecuteCompilation();
   Handle<Code> FinishCompilation();
@@ -92,6 +93,14 @@ Handle<Code> CompileWasmToJSWrapper(Isolate* isolate,
 Handle<Code> CompileJSToWasmWrapper(Isolate* isolate, wasm::ModuleEnv* module,
                                     Handle<Code> wasm_code, uint32_t index);
 
+// Compiles a stub that stands for a not yet compiled wasm function of
+// signature {sig}. On its first call, the stub has the runtime compile the
+// function and then tail calls the compiled code with its own arguments.
+Handle<Code> CompileWasmLazyCompileStub(Isolate* isolate,
+                                        Handle<Context> context,
+                                        wasm::FunctionSig* sig,
+                                        bool will_serialize);
+
 // Abstracts details of building TurboFan graph nodes for WASM to separate
 // the WASM decoder from the internal details of TurboFan.
 class WasmTrapHelper;
@@ -151,6 +160,9 @@ class WasmGraphBuilder {
   Node* Return(unsigned count, Node** vals);
   Node* ReturnVoid();
   Node* Unreachable(wasm::WasmCodePosition position);
+  // Counts down the tier-up budget of the function, if it is compiled to be
+  // tiered up, and has the runtime recompile it when the budget runs out.
+  void TierUpCheck();
 
   Node* CallDirect(uint32_t index, Node** args,
                    wasm::WasmCodePosition position);
@@ -164,6 +176,8 @@ class WasmGraphBuilder {
   void BuildJSToWasmWrapper(Handle<Code> wasm_code, wasm::FunctionSig* sig);
   void BuildWasmToJSWrapper(Handle<JSFunction> function,
                             wasm::FunctionSig* sig);
+  void BuildWasmLazyCompileStub(Handle<Context> context,
+                                wasm::FunctionSig* sig);
 
   Node* ToJS(Node* node, Node* context, wasm::LocalType type);
   Node* FromJS(Node* node, Node* context, wasm::LocalType type);
@@ -192,6 +206,12 @@ class WasmGraphBuilder {
 
   void set_module(wasm::ModuleEnv* module) { this->module_ = module; }
 
+  // Makes {TierUpCheck} count down the budget of function {index} in the
+  // tier-up budgets of the instance.
+  void set_tier_up_index(uint32_t index) {
+    this->tier_up_index_ = static_cast<int>(index);
+  }
+
   void set_control_ptr(Node** control) { this->control_ = control; }
 
   void set_effect_ptr(Node** effect) { this->effect_ = effect; }
@@ -204,8 +224,15 @@ class WasmGraphBuilder {
 
   Node* SimdOp(wasm::WasmOpcode opcode, const NodeVector& inputs);
 
+  Node* AtomicOp(wasm::WasmOpcode opcode, const NodeVector& inputs,
+                 uint32_t offset, wasm::WasmCodePosition position);
+
   bool has_simd_ops() { return has_simd_ops_; }
 
+  // Returns true if the SIMD operations of this function have to be lowered
+  // to runtime calls, i.e. if the target cannot select all of them natively.
+  bool needs_simd_lowering() const;
+
  private:
   static const int kDefaultBufferSize = 16;
   friend class WasmTrapHelper;
@@ -228,6 +255,8 @@ class WasmGraphBuilder {
 
   compiler::SourcePositionTable* source_position_table_ = nullptr;
   bool has_simd_ops_ = false;
+  bool has_non_native_simd_ops_ = false;
+  int tier_up_index_ = -1;
 
   // Internal helper methods.
   JSGraph* jsgraph() { return jsgraph_; }
@@ -235,8 +264,14 @@ class WasmGraphBuilder {
 
   Node* String(const char* string);
   Node* MemBuffer(uint32_t offset);
+  Node* SimdLane(Node* lane);
   void BoundsCheckMem(MachineType memtype, Node* index, uint32_t offset,
                       wasm::WasmCodePosition position);
+  // Whether out-of-bounds memory accesses fault into the guard region of the
+  // memory and are turned into traps by the trap handler.
+  bool UseTrapHandler();
+  // Zero-extends a 32-bit memory index for a protected load or store.
+  Node* ProtectedMemIndex(Node* index);
 
   Node* BuildChangeEndianness(Node* node, MachineType type,
                               wasm::LocalType wasmtype = wasm::kAstStmt);
@@ -334,6 +369,8 @@ class WasmGraphBuilder {
   Node* BuildLoadHeapNumberValue(Node* value, Node* control);
   Node* BuildHeapNumberValueIndexConstant();
   Node* BuildGrowMemory(Node* input);
+  Node* BuildCallToRuntime(Runtime::FunctionId function_id, Node** parameters,
+                           int parameter_count);
 
   // Asm.js specific functionality.
   Node* BuildI32AsmjsSConvertF32(Node* input);
@@ -303,7 +303,8 @@ CallDescriptor* ModuleEnv::GetWasmCallDescriptor(Zone* zone,
       compiler::Operator::kNoProperties,  // properties
       kCalleeSaveRegisters,               // callee-saved registers
       kCalleeSaveFPRegisters,             // callee-saved fp regs
-      CallDescriptor::kUseNativeStack,    // flags
+      CallDescriptor::kUseNativeStack |   // flags
+          CallDescriptor::kSupportsTailCalls,
       "wasm-call");
 }
 
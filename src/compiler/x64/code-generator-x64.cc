@@ -9,6 +9,7 @@
 #include "src/compiler/gap-resolver.h"
 #include "src/compiler/node-matchers.h"
 #include "src/compiler/osr.h"
+#include "src/wasm/wasm-opcodes.h"
 #include "src/x64/assembler-x64.h"
 #include "src/x64/macro-assembler-x64.h"
 
@@ -245,6 +246,59 @@ class OutOfLineRecordWrite final : public OutOfLineCode {
   RecordWriteMode const mode_;
 };
 
+// Landing pad of a protected memory access. The wasm trap handler resumes
+// execution here when the access faults, and the out-of-bounds trap is thrown
+// from the runtime.
+class WasmOutOfLineTrap final : public OutOfLineCode {
+ public:
+  WasmOutOfLineTrap(CodeGenerator* gen, int pc, bool frame_elided,
+                    Handle<Object> context, int32_t position)
+      : OutOfLineCode(gen),
+        gen_(gen),
+        frame_elided_(frame_elided),
+        context_(context),
+        position_(position) {
+    gen->AddProtectedInstruction(pc, entry());
+  }
+
+  void Generate() final {
+    if (frame_elided_) {
+      __ EnterFrame(StackFrame::WASM);
+    }
+    int trap_reason =
+        wasm::WasmOpcodes::TrapReasonToMessageId(wasm::kTrapMemOutOfBounds);
+    __ Push(Smi::FromInt(trap_reason));
+    __ Push(Smi::FromInt(position_));
+    __ Move(rsi, context_);
+    __ CallRuntime(Runtime::kThrowWasmError);
+    Zone* zone = gen_->code()->zone();
+    ReferenceMap* reference_map = new (zone) ReferenceMap(zone);
+    gen_->RecordSafepoint(reference_map, Safepoint::kSimple, 0,
+                          Safepoint::kNoLazyDeopt);
+    // The runtime call never returns.
+    __ int3();
+  }
+
+ private:
+  CodeGenerator* const gen_;
+  bool const frame_elided_;
+  Handle<Object> const context_;
+  int32_t const position_;
+};
+
+void EmitOOLTrapIfNeeded(Zone* zone, CodeGenerator* codegen,
+                         Instruction* instr, X64OperandConverter* i, int pc) {
+  X64MemoryProtection protection =
+      static_cast<X64MemoryProtection>(MiscField::decode(instr->opcode()));
+  if (protection != kProtected) return;
+  // The context and the source position follow the regular inputs.
+  size_t const input_count = instr->InputCount();
+  Handle<Object> context = i->ToHeapObject(instr->InputAt(input_count - 2));
+  int32_t position = i->InputInt32(input_count - 1);
+  bool frame_elided = !codegen->frame_access_state()->has_frame();
+  new (zone) WasmOutOfLineTrap(codegen, pc, frame_elided, context, position);
+}
+
 }  // namespace
 
 
@@ -381,6 +435,30 @@ class OutOfLineRecordWrite final : public OutOfLineCode {
     }                                                                  \
   } while (0)
 
+#define ASSEMBLE_SIMD_BINOP(sse_instr, avx_instr)                            \
+  do {                                                                       \
+    XMMRegister dst = i.OutputSimd128Register();                             \
+    if (dst.is(i.InputSimd128Register(0))) {                                 \
+      __ sse_instr(dst, i.InputSimd128Register(1));                          \
+    } else {                                                                 \
+      CpuFeatureScope avx_scope(masm(), AVX);                                \
+      __ avx_instr(dst, i.InputSimd128Register(0),                           \
+                   i.InputSimd128Register(1));                               \
+    }                                                                        \
+  } while (0)
+
+// Uses the VEX encoding when AVX is available, which avoids the penalty of
+// mixing SSE and AVX instructions on some cores.
+#define ASSEMBLE_SIMD_SHUFFLE(dst, src, imm)  \
+  do {                                        \
+    if (CpuFeatures::IsSupported(AVX)) {      \
+      CpuFeatureScope avx_scope(masm(), AVX); \
+      __ vpshufd(dst, src, imm);              \
+    } else {                                  \
+      __ pshufd(dst, src, imm);               \
+    }                                         \
+  } while (0)
+
 #define ASSEMBLE_CHECKED_LOAD_FLOAT(asm_instr)                               \
   do {                                                                       \
     auto result = i.OutputDoubleRegister();                                  \
@@ -630,6 +708,20 @@ class OutOfLineRecordWrite final : public OutOfLineCode {
                      1);                                                      \
   } while (false)
 
+// Applies {bin_inst} to the value in memory and the input in a cmpxchg loop,
+// which leaves the previous value in rax.
+#define ASSEMBLE_ATOMIC_BINOP(bin_inst)                 \
+  do {                                                  \
+    Label binop;                                        \
+    __ bind(&binop);                                    \
+    __ movl(rax, i.MemoryOperand(1));                   \
+    __ movl(i.TempRegister(0), rax);                    \
+    __ bin_inst(i.TempRegister(0), i.InputRegister(0)); \
+    __ lock();                                          \
+    __ cmpxchgl(i.MemoryOperand(1), i.TempRegister(0)); \
+    __ j(not_equal, &binop);                            \
+  } while (false)
+
 void CodeGenerator::AssembleDeconstructFrame() {
   unwinding_info_writer_.MarkFrameDeconstructed(__ pc_offset());
   __ movq(rsp, rbp);
@@ -1730,14 +1822,17 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
       __ Subsd(i.InputDoubleRegister(0), kScratchDoubleReg);
       break;
     case kX64Movsxbl:
+      EmitOOLTrapIfNeeded(zone(), this, instr, &i, __ pc_offset());
       ASSEMBLE_MOVX(movsxbl);
       __ AssertZeroExtended(i.OutputRegister());
       break;
     case kX64Movzxbl:
+      EmitOOLTrapIfNeeded(zone(), this, instr, &i, __ pc_offset());
       ASSEMBLE_MOVX(movzxbl);
       __ AssertZeroExtended(i.OutputRegister());
       break;
     case kX64Movb: {
+      EmitOOLTrapIfNeeded(zone(), this, instr, &i, __ pc_offset());
       size_t index = 0;
       Operand operand = i.MemoryOperand(&index);
       if (HasImmediateInput(instr, index)) {
@@ -1748,14 +1843,17 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
       break;
     }
     case kX64Movsxwl:
+      EmitOOLTrapIfNeeded(zone(), this, instr, &i, __ pc_offset());
       ASSEMBLE_MOVX(movsxwl);
       __ AssertZeroExtended(i.OutputRegister());
       break;
     case kX64Movzxwl:
+      EmitOOLTrapIfNeeded(zone(), this, instr, &i, __ pc_offset());
       ASSEMBLE_MOVX(movzxwl);
       __ AssertZeroExtended(i.OutputRegister());
       break;
     case kX64Movw: {
+      EmitOOLTrapIfNeeded(zone(), this, instr, &i, __ pc_offset());
       size_t index = 0;
       Operand operand = i.MemoryOperand(&index);
       if (HasImmediateInput(instr, index)) {
@@ -1766,6 +1864,7 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
       break;
     }
     case kX64Movl:
+      EmitOOLTrapIfNeeded(zone(), this, instr, &i, __ pc_offset());
       if (instr->HasOutput()) {
         if (instr->addressing_mode() == kMode_None) {
           if (instr->InputAt(0)->IsRegister()) {
@@ -1791,6 +1890,7 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
       ASSEMBLE_MOVX(movsxlq);
       break;
     case kX64Movq:
+      EmitOOLTrapIfNeeded(zone(), this, instr, &i, __ pc_offset());
       if (instr->HasOutput()) {
         __ movq(i.OutputRegister(), i.MemoryOperand());
       } else {
@@ -1804,6 +1904,7 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
       }
       break;
     case kX64Movss:
+      EmitOOLTrapIfNeeded(zone(), this, instr, &i, __ pc_offset());
       if (instr->HasOutput()) {
         __ movss(i.OutputDoubleRegister(), i.MemoryOperand());
       } else {
@@ -1813,6 +1914,7 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
       }
       break;
     case kX64Movsd:
+      EmitOOLTrapIfNeeded(zone(), this, instr, &i, __ pc_offset());
       if (instr->HasOutput()) {
         __ Movsd(i.OutputDoubleRegister(), i.MemoryOperand());
       } else {
@@ -1821,6 +1923,26 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
         __ Movsd(operand, i.InputDoubleRegister(index));
       }
       break;
+    case kX64Movdqu: {
+      if (instr->HasOutput()) {
+        if (CpuFeatures::IsSupported(AVX)) {
+          CpuFeatureScope avx_scope(masm(), AVX);
+          __ vmovdqu(i.OutputSimd128Register(), i.MemoryOperand());
+        } else {
+          __ movdqu(i.OutputSimd128Register(), i.MemoryOperand());
+        }
+      } else {
+        size_t index = 0;
+        Operand operand = i.MemoryOperand(&index);
+        if (CpuFeatures::IsSupported(AVX)) {
+          CpuFeatureScope avx_scope(masm(), AVX);
+          __ vmovdqu(operand, i.InputSimd128Register(index));
+        } else {
+          __ movdqu(operand, i.InputSimd128Register(index));
+        }
+      }
+      break;
+    }
     case kX64BitcastFI:
       if (instr->InputAt(0)->IsFPStackSlot()) {
         __ movl(i.OutputRegister(), i.InputOperand(0));
@@ -1946,6 +2068,104 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
       __ xchgl(i.InputRegister(index), operand);
       break;
     }
+    case kX64AtomicXchgl:
+      __ xchgl(i.InputRegister(0), i.MemoryOperand(1));
+      break;
+    case kX64AtomicCmpxchgl:
+      __ lock();
+      __ cmpxchgl(i.MemoryOperand(2), i.InputRegister(1));
+      break;
+    case kX64AtomicAddl:
+      ASSEMBLE_ATOMIC_BINOP(addl);
+      break;
+    case kX64AtomicSubl:
+      ASSEMBLE_ATOMIC_BINOP(subl);
+      break;
+    case kX64AtomicAndl:
+      ASSEMBLE_ATOMIC_BINOP(andl);
+      break;
+    case kX64AtomicOrl:
+      ASSEMBLE_ATOMIC_BINOP(orl);
+      break;
+    case kX64AtomicXorl:
+      ASSEMBLE_ATOMIC_BINOP(xorl);
+      break;
+    case kX64Int32x4Create: {
+      XMMRegister dst = i.OutputSimd128Register();
+      XMMRegister tmp = i.ToDoubleRegister(instr->TempAt(0));
+      // Pack the lanes pairwise into {a, a, b, b} and {c, c, d, d} and pick
+      // the even elements of both.
+      __ Movd(dst, i.InputRegister(0));
+      __ Movd(tmp, i.InputRegister(1));
+      __ shufps(dst, tmp, 0x00);
+      __ Movd(tmp, i.InputRegister(2));
+      __ Movd(kScratchDoubleReg, i.InputRegister(3));
+      __ shufps(tmp, kScratchDoubleReg, 0x00);
+      __ shufps(dst, tmp, 0x88);
+      break;
+    }
+    case kX64Int32x4Splat: {
+      XMMRegister dst = i.OutputSimd128Register();
+      __ Movd(dst, i.InputRegister(0));
+      ASSEMBLE_SIMD_SHUFFLE(dst, dst, 0x00);
+      break;
+    }
+    case kX64Int32x4ExtractLane: {
+      int8_t lane = i.InputInt8(1);
+      if (lane == 0) {
+        __ Movd(i.OutputRegister(), i.InputSimd128Register(0));
+      } else {
+        ASSEMBLE_SIMD_SHUFFLE(kScratchDoubleReg, i.InputSimd128Register(0),
+                              lane);
+        __ Movd(i.OutputRegister(), kScratchDoubleReg);
+      }
+      break;
+    }
+    case kX64Int32x4Add:
+      ASSEMBLE_SIMD_BINOP(paddd, vpaddd);
+      break;
+    case kX64Int32x4Sub:
+      ASSEMBLE_SIMD_BINOP(psubd, vpsubd);
+      break;
+    case kX64Int32x4Mul: {
+      CpuFeatureScope sse_scope(masm(), SSE4_1);
+      ASSEMBLE_SIMD_BINOP(pmulld, vpmulld);
+      break;
+    }
+    case kX64Float32x4Create: {
+      XMMRegister dst = i.OutputSimd128Register();
+      XMMRegister tmp = i.ToDoubleRegister(instr->TempAt(0));
+      // Same pairwise packing as for kX64Int32x4Create.
+      __ Movaps(dst, i.InputDoubleRegister(0));
+      __ shufps(dst, i.InputDoubleRegister(1), 0x00);
+      __ Movaps(tmp, i.InputDoubleRegister(2));
+      __ shufps(tmp, i.InputDoubleRegister(3), 0x00);
+      __ shufps(dst, tmp, 0x88);
+      break;
+    }
+    case kX64Float32x4Splat: {
+      XMMRegister dst = i.OutputSimd128Register();
+      __ Movaps(dst, i.InputDoubleRegister(0));
+      __ shufps(dst, dst, 0x00);
+      break;
+    }
+    case kX64Float32x4ExtractLane:
+      // Only the low lane of the output is observable as a float32.
+      ASSEMBLE_SIMD_SHUFFLE(i.OutputDoubleRegister(),
+                            i.InputSimd128Register(0), i.InputInt8(1));
+      break;
+    case kX64Float32x4Add:
+      ASSEMBLE_SIMD_BINOP(addps, vaddps);
+      break;
+    case kX64Float32x4Sub:
+      ASSEMBLE_SIMD_BINOP(subps, vsubps);
+      break;
+    case kX64Float32x4Mul:
+      ASSEMBLE_SIMD_BINOP(mulps, vmulps);
+      break;
+    case kX64Float32x4Div:
+      ASSEMBLE_SIMD_BINOP(divps, vdivps);
+      break;
     case kCheckedLoadInt8:
       ASSEMBLE_CHECKED_LOAD_INTEGER(movsxbl);
       break;
@@ -126,6 +126,7 @@ namespace compiler {
   V(X64Movq)                       \
   V(X64Movsd)                      \
   V(X64Movss)                      \
+  V(X64Movdqu)                     \
   V(X64BitcastFI)                  \
   V(X64BitcastDL)                  \
   V(X64BitcastIF)                  \
@@ -139,7 +140,27 @@ namespace compiler {
   V(X64StackCheck)                 \
   V(X64Xchgb)                      \
   V(X64Xchgw)                      \
-  V(X64Xchgl)
+  V(X64Xchgl)                      \
+  V(X64AtomicXchgl)                \
+  V(X64AtomicCmpxchgl)             \
+  V(X64AtomicAddl)                 \
+  V(X64AtomicSubl)                 \
+  V(X64AtomicAndl)                 \
+  V(X64AtomicOrl)                  \
+  V(X64AtomicXorl)                 \
+  V(X64Int32x4Create)              \
+  V(X64Int32x4Splat)               \
+  V(X64Int32x4ExtractLane)         \
+  V(X64Int32x4Add)                 \
+  V(X64Int32x4Sub)                 \
+  V(X64Int32x4Mul)                 \
+  V(X64Float32x4Create)            \
+  V(X64Float32x4Splat)             \
+  V(X64Float32x4ExtractLane)       \
+  V(X64Float32x4Add)               \
+  V(X64Float32x4Sub)               \
+  V(X64Float32x4Mul)               \
+  V(X64Float32x4Div)
 
 // Addressing modes represent the "shape" of inputs to an instruction.
 // Many instructions support multiple addressing modes. Addressing modes
@@ -173,6 +194,10 @@ namespace compiler {
   V(M4I)  /* [      %r2*4 + K] */      \
   V(M8I)  /* [      %r2*8 + K] */
 
+// Memory accesses that are allowed to fault, because the wasm trap handler
+// turns the fault into a trap, carry kProtected in their MiscField.
+enum X64MemoryProtection { kUnprotected = 0, kProtected = 1 };
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -125,6 +125,19 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kX64Lea:
     case kX64Dec32:
     case kX64Inc32:
+    case kX64Int32x4Create:
+    case kX64Int32x4Splat:
+    case kX64Int32x4ExtractLane:
+    case kX64Int32x4Add:
+    case kX64Int32x4Sub:
+    case kX64Int32x4Mul:
+    case kX64Float32x4Create:
+    case kX64Float32x4Splat:
+    case kX64Float32x4ExtractLane:
+    case kX64Float32x4Add:
+    case kX64Float32x4Sub:
+    case kX64Float32x4Mul:
+    case kX64Float32x4Div:
       return (instr->addressing_mode() == kMode_None)
           ? kNoOpcodeFlags
           : kIsLoadOperation | kHasSideEffect;
@@ -154,6 +167,7 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kX64Movq:
     case kX64Movsd:
     case kX64Movss:
+    case kX64Movdqu:
       return instr->HasOutput() ? kIsLoadOperation : kHasSideEffect;
 
     case kX64StackCheck:
@@ -166,6 +180,13 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kX64Xchgb:
     case kX64Xchgw:
     case kX64Xchgl:
+    case kX64AtomicXchgl:
+    case kX64AtomicCmpxchgl:
+    case kX64AtomicAddl:
+    case kX64AtomicSubl:
+    case kX64AtomicAndl:
+    case kX64AtomicOrl:
+    case kX64AtomicXorl:
       return kIsLoadOperation | kHasSideEffect;
 
 #define CASE(Name) case k##Name:
@@ -181,8 +202,269 @@ int InstructionScheduler::GetTargetInstructionFlags(
 
 
 int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
-  // TODO(all): Add instruction cost modeling.
-  return 1;
+  // Basic latency modeling for x64 instructions. The numbers approximate the
+  // published latencies of recent Intel cores; a memory operand adds the
+  // L1 load-to-use latency on top of the operation itself.
+  int const memory = (instr->addressing_mode() != kMode_None) ? 4 : 0;
+  switch (instr->arch_opcode()) {
+    case kX64Add:
+    case kX64Add32:
+    case kX64And:
+    case kX64And32:
+    case kX64Cmp:
+    case kX64Cmp32:
+    case kX64Cmp16:
+    case kX64Cmp8:
+    case kX64Test:
+    case kX64Test32:
+    case kX64Test16:
+    case kX64Test8:
+    case kX64Or:
+    case kX64Or32:
+    case kX64Xor:
+    case kX64Xor32:
+    case kX64Sub:
+    case kX64Sub32:
+    case kX64Not:
+    case kX64Not32:
+    case kX64Neg:
+    case kX64Neg32:
+    case kX64Shl:
+    case kX64Shl32:
+    case kX64Shr:
+    case kX64Shr32:
+    case kX64Sar:
+    case kX64Sar32:
+    case kX64Ror:
+    case kX64Ror32:
+    case kX64Dec32:
+    case kX64Inc32:
+    case kX64Lea:
+    case kX64Lea32:
+      return memory + 1;
+
+    case kX64Imul:
+    case kX64Imul32:
+    case kX64Lzcnt:
+    case kX64Lzcnt32:
+    case kX64Tzcnt:
+    case kX64Tzcnt32:
+    case kX64Popcnt:
+    case kX64Popcnt32:
+      return memory + 3;
+
+    case kX64ImulHigh32:
+    case kX64UmulHigh32:
+      return memory + 4;
+
+    case kX64Idiv32:
+    case kX64Udiv32:
+      return memory + 26;
+
+    case kX64Idiv:
+    case kX64Udiv:
+      return memory + 40;
+
+    case kX64Movsxbl:
+    case kX64Movzxbl:
+    case kX64Movsxwl:
+    case kX64Movzxwl:
+    case kX64Movsxlq:
+    case kX64Movl:
+    case kX64Movq:
+      return instr->HasOutput() ? memory + 1 : 1;
+
+    case kX64Movsd:
+    case kX64Movss:
+    case kX64Movdqu:
+      return instr->HasOutput() ? 5 : 1;
+
+    case kX64Movb:
+    case kX64Movw:
+    case kX64Push:
+    case kX64Poke:
+      return 1;
+
+    case kX64StackCheck:
+      return 4;
+
+    case kX64Xchgb:
+    case kX64Xchgw:
+    case kX64Xchgl:
+    case kX64AtomicXchgl:
+    case kX64AtomicCmpxchgl:
+    case kX64AtomicAddl:
+    case kX64AtomicSubl:
+    case kX64AtomicAndl:
+    case kX64AtomicOrl:
+    case kX64AtomicXorl:
+      return 20;
+
+    case kX64BitcastFI:
+    case kX64BitcastDL:
+    case kX64BitcastIF:
+    case kX64BitcastLD:
+    case kSSEFloat64ExtractLowWord32:
+    case kSSEFloat64ExtractHighWord32:
+    case kSSEFloat64InsertLowWord32:
+    case kSSEFloat64InsertHighWord32:
+    case kSSEFloat64LoadLowWord32:
+      return memory + 2;
+
+    case kSSEFloat32Abs:
+    case kSSEFloat32Neg:
+    case kSSEFloat64Abs:
+    case kSSEFloat64Neg:
+    case kAVXFloat32Abs:
+    case kAVXFloat32Neg:
+    case kAVXFloat64Abs:
+    case kAVXFloat64Neg:
+      return memory + 1;
+
+    case kSSEFloat32Cmp:
+    case kSSEFloat64Cmp:
+    case kAVXFloat32Cmp:
+    case kAVXFloat64Cmp:
+      return memory + 2;
+
+    case kSSEFloat32Add:
+    case kSSEFloat32Sub:
+    case kSSEFloat64Add:
+    case kSSEFloat64Sub:
+    case kSSEFloat64Max:
+    case kSSEFloat64Min:
+    case kSSEFloat64SilenceNaN:
+    case kAVXFloat32Add:
+    case kAVXFloat32Sub:
+    case kAVXFloat64Add:
+    case kAVXFloat64Sub:
+      return memory + 3;
+
+    case kSSEFloat32Mul:
+    case kSSEFloat64Mul:
+    case kAVXFloat32Mul:
+    case kAVXFloat64Mul:
+      return memory + 5;
+
+    case kSSEFloat32Round:
+    case kSSEFloat64Round:
+    case kSSEFloat32ToFloat64:
+    case kSSEFloat64ToFloat32:
+    case kSSEInt32ToFloat32:
+    case kSSEInt32ToFloat64:
+    case kSSEInt64ToFloat32:
+    case kSSEInt64ToFloat64:
+    case kSSEUint32ToFloat32:
+    case kSSEUint32ToFloat64:
+    case kSSEFloat32ToInt32:
+    case kSSEFloat64ToInt32:
+    case kSSEFloat32ToInt64:
+    case kSSEFloat64ToInt64:
+      return memory + 6;
+
+    case kSSEFloat32ToUint32:
+    case kSSEFloat64ToUint32:
+    case kSSEFloat32ToUint64:
+    case kSSEFloat64ToUint64:
+    case kSSEUint64ToFloat32:
+    case kSSEUint64ToFloat64:
+      // These expand to a short sequence with a fixup for the upper range.
+      return memory + 10;
+
+    case kSSEFloat32Div:
+    case kAVXFloat32Div:
+      return memory + 11;
+
+    case kSSEFloat32Sqrt:
+      return memory + 13;
+
+    case kSSEFloat64Div:
+    case kAVXFloat64Div:
+      return memory + 15;
+
+    case kSSEFloat64Sqrt:
+      return memory + 18;
+
+    case kSSEFloat64Mod:
+      // Implemented with an x87 fprem loop.
+      return 50;
+
+    case kX64Int32x4Add:
+    case kX64Int32x4Sub:
+    case kX64Int32x4Splat:
+      return memory + 1;
+
+    case kX64Int32x4ExtractLane:
+    case kX64Float32x4ExtractLane:
+    case kX64Float32x4Splat:
+      return 2;
+
+    case kX64Int32x4Create:
+    case kX64Float32x4Create:
+      return 6;
+
+    case kX64Int32x4Mul:
+      // pmulld is two uops on most cores.
+      return memory + 10;
+
+    case kX64Float32x4Add:
+    case kX64Float32x4Sub:
+      return memory + 3;
+
+    case kX64Float32x4Mul:
+      return memory + 5;
+
+    case kX64Float32x4Div:
+      return memory + 11;
+
+    case kCheckedLoadInt8:
+    case kCheckedLoadUint8:
+    case kCheckedLoadInt16:
+    case kCheckedLoadUint16:
+    case kCheckedLoadWord32:
+    case kCheckedLoadWord64:
+      return 5;
+
+    case kCheckedLoadFloat32:
+    case kCheckedLoadFloat64:
+      return 6;
+
+    case kAtomicLoadInt8:
+    case kAtomicLoadUint8:
+    case kAtomicLoadInt16:
+    case kAtomicLoadUint16:
+    case kAtomicLoadWord32:
+      return 4;
+
+    case kArchTruncateDoubleToI:
+      return 6;
+
+    case kIeee754Float64Acos:
+    case kIeee754Float64Acosh:
+    case kIeee754Float64Asin:
+    case kIeee754Float64Asinh:
+    case kIeee754Float64Atan:
+    case kIeee754Float64Atanh:
+    case kIeee754Float64Atan2:
+    case kIeee754Float64Cbrt:
+    case kIeee754Float64Cos:
+    case kIeee754Float64Cosh:
+    case kIeee754Float64Exp:
+    case kIeee754Float64Expm1:
+    case kIeee754Float64Log:
+    case kIeee754Float64Log1p:
+    case kIeee754Float64Log10:
+    case kIeee754Float64Log2:
+    case kIeee754Float64Pow:
+    case kIeee754Float64Sin:
+    case kIeee754Float64Sinh:
+    case kIeee754Float64Tan:
+    case kIeee754Float64Tanh:
+      return 50;
+
+    default:
+      return 1;
+  }
 }
 
 }  // namespace compiler
@@ -141,16 +141,26 @@ class X64OperandGenerator final : public OperandGenerator {
     }
   }
 
+  // Protected wasm accesses always address memory as [base + index] with both
+  // in registers. The index is a zero-extended 32-bit value, and folding a
+  // constant index into the sign-extended disp32 would turn indices of 2^31
+  // and above into negative offsets in front of the guard region.
+  AddressingMode GetProtectedMemoryOperand(Node* operand,
+                                           InstructionOperand inputs[],
+                                           size_t* input_count) {
+    inputs[(*input_count)++] = UseRegister(operand->InputAt(0));
+    inputs[(*input_count)++] = UseRegister(operand->InputAt(1));
+    return kMode_MR1;
+  }
+
   bool CanBeBetterLeftOperand(Node* node) const {
     return !selector()->IsLive(node);
   }
 };
 
+namespace {
 
-void InstructionSelector::VisitLoad(Node* node) {
-  LoadRepresentation load_rep = LoadRepresentationOf(node->op());
-  X64OperandGenerator g(this);
-
+ArchOpcode GetLoadOpcode(LoadRepresentation load_rep) {
   ArchOpcode opcode = kArchNop;
   switch (load_rep.representation()) {
     case MachineRepresentation::kFloat32:
@@ -173,12 +183,56 @@ void InstructionSelector::VisitLoad(Node* node) {
     case MachineRepresentation::kWord64:
       opcode = kX64Movq;
       break;
-    case MachineRepresentation::kSimd128:  // Fall through.
+    case MachineRepresentation::kSimd128:
+      opcode = kX64Movdqu;
+      break;
     case MachineRepresentation::kNone:
       UNREACHABLE();
-      return;
+      break;
   }
+  return opcode;
+}
+
+ArchOpcode GetStoreOpcode(MachineRepresentation rep) {
+  ArchOpcode opcode = kArchNop;
+  switch (rep) {
+    case MachineRepresentation::kFloat32:
+      opcode = kX64Movss;
+      break;
+    case MachineRepresentation::kFloat64:
+      opcode = kX64Movsd;
+      break;
+    case MachineRepresentation::kBit:  // Fall through.
+    case MachineRepresentation::kWord8:
+      opcode = kX64Movb;
+      break;
+    case MachineRepresentation::kWord16:
+      opcode = kX64Movw;
+      break;
+    case MachineRepresentation::kWord32:
+      opcode = kX64Movl;
+      break;
+    case MachineRepresentation::kTagged:  // Fall through.
+    case MachineRepresentation::kWord64:
+      opcode = kX64Movq;
+      break;
+    case MachineRepresentation::kSimd128:
+      opcode = kX64Movdqu;
+      break;
+    case MachineRepresentation::kNone:
+      UNREACHABLE();
+      break;
+  }
+  return opcode;
+}
 
+}  // namespace
+
+void InstructionSelector::VisitLoad(Node* node) {
+  LoadRepresentation load_rep = LoadRepresentationOf(node->op());
+  X64OperandGenerator g(this);
+
+  ArchOpcode opcode = GetLoadOpcode(load_rep);
   InstructionOperand outputs[1];
   outputs[0] = g.DefineAsRegister(node);
   InstructionOperand inputs[3];
@@ -236,33 +290,7 @@ void InstructionSelector::VisitStore(Node* node) {
     code |= MiscField::encode(static_cast<int>(record_write_mode));
     Emit(code, 0, nullptr, input_count, inputs, temp_count, temps);
   } else {
-    ArchOpcode opcode = kArchNop;
-    switch (rep) {
-      case MachineRepresentation::kFloat32:
-        opcode = kX64Movss;
-        break;
-      case MachineRepresentation::kFloat64:
-        opcode = kX64Movsd;
-        break;
-      case MachineRepresentation::kBit:  // Fall through.
-      case MachineRepresentation::kWord8:
-        opcode = kX64Movb;
-        break;
-      case MachineRepresentation::kWord16:
-        opcode = kX64Movw;
-        break;
-      case MachineRepresentation::kWord32:
-        opcode = kX64Movl;
-        break;
-      case MachineRepresentation::kTagged:  // Fall through.
-      case MachineRepresentation::kWord64:
-        opcode = kX64Movq;
-        break;
-      case MachineRepresentation::kSimd128:  // Fall through.
-      case MachineRepresentation::kNone:
-        UNREACHABLE();
-        return;
-    }
+    ArchOpcode opcode = GetStoreOpcode(rep);
     InstructionOperand inputs[4];
     size_t input_count = 0;
     AddressingMode addressing_mode =
@@ -277,6 +305,49 @@ void InstructionSelector::VisitStore(Node* node) {
   }
 }
 
+void InstructionSelector::VisitProtectedLoad(Node* node) {
+  LoadRepresentation load_rep = ProtectedLoadRepresentationOf(node->op());
+  X64OperandGenerator g(this);
+  Node* const context = node->InputAt(2);
+  Node* const position = node->InputAt(3);
+
+  ArchOpcode opcode = GetLoadOpcode(load_rep);
+  InstructionOperand outputs[1];
+  outputs[0] = g.DefineAsRegister(node);
+  InstructionOperand inputs[5];
+  size_t input_count = 0;
+  AddressingMode mode =
+      g.GetProtectedMemoryOperand(node, inputs, &input_count);
+  inputs[input_count++] = g.UseImmediate(context);
+  inputs[input_count++] = g.UseImmediate(position);
+  InstructionCode code = opcode | AddressingModeField::encode(mode) |
+                         MiscField::encode(X64MemoryProtection::kProtected);
+  Emit(code, 1, outputs, input_count, inputs);
+}
+
+void InstructionSelector::VisitProtectedStore(Node* node) {
+  X64OperandGenerator g(this);
+  Node* const value = node->InputAt(2);
+  Node* const context = node->InputAt(3);
+  Node* const position = node->InputAt(4);
+
+  MachineRepresentation rep = ProtectedStoreRepresentationOf(node->op());
+  ArchOpcode opcode = GetStoreOpcode(rep);
+  InstructionOperand inputs[6];
+  size_t input_count = 0;
+  AddressingMode addressing_mode =
+      g.GetProtectedMemoryOperand(node, inputs, &input_count);
+  InstructionCode code = opcode | AddressingModeField::encode(addressing_mode) |
+                         MiscField::encode(X64MemoryProtection::kProtected);
+  InstructionOperand value_operand =
+      g.CanBeImmediate(value) ? g.UseImmediate(value) : g.UseRegister(value);
+  inputs[input_count++] = value_operand;
+  inputs[input_count++] = g.UseImmediate(context);
+  inputs[input_count++] = g.UseImmediate(position);
+  Emit(code, 0, static_cast<InstructionOperand*>(nullptr), input_count,
+       inputs);
+}
+
 // Architecture supports unaligned access, therefore VisitLoad is used instead
 void InstructionSelector::VisitUnalignedLoad(Node* node) { UNREACHABLE(); }
 
@@ -2160,6 +2231,178 @@ void InstructionSelector::VisitAtomicStore(Node* node) {
   Emit(code, 0, static_cast<InstructionOperand*>(nullptr), input_count, inputs);
 }
 
+namespace {
+
+// Shared routine for the atomic operations on [base + index], which take
+// their value inputs before the memory operand.
+void VisitAtomicRMW(InstructionSelector* selector, Node* node,
+                    ArchOpcode opcode) {
+  X64OperandGenerator g(selector);
+  Node* base = node->InputAt(0);
+  Node* index = node->InputAt(1);
+  Node* value = node->InputAt(2);
+  AddressingMode addressing_mode;
+  InstructionOperand inputs[4];
+  size_t input_count = 0;
+  InstructionOperand outputs[1];
+  InstructionOperand temps[1];
+  size_t temp_count = 0;
+  switch (opcode) {
+    case kX64AtomicXchgl:
+      inputs[input_count++] = g.UseRegister(value);
+      outputs[0] = g.DefineSameAsFirst(node);
+      break;
+    case kX64AtomicCmpxchgl:
+      inputs[input_count++] = g.UseFixed(value, rax);
+      inputs[input_count++] = g.UseUniqueRegister(node->InputAt(3));
+      outputs[0] = g.DefineAsFixed(node, rax);
+      break;
+    default:
+      // The cmpxchg loop keeps the previous value in rax.
+      inputs[input_count++] = g.UseUniqueRegister(value);
+      outputs[0] = g.DefineAsFixed(node, rax);
+      temps[temp_count++] = g.TempRegister();
+      break;
+  }
+  inputs[input_count++] = g.UseUniqueRegister(base);
+  if (g.CanBeImmediate(index)) {
+    inputs[input_count++] = g.UseImmediate(index);
+    addressing_mode = kMode_MRI;
+  } else {
+    inputs[input_count++] = g.UseUniqueRegister(index);
+    addressing_mode = kMode_MR1;
+  }
+  InstructionCode code = opcode | AddressingModeField::encode(addressing_mode);
+  selector->Emit(code, arraysize(outputs), outputs, input_count, inputs,
+                 temp_count, temps);
+}
+
+}  // namespace
+
+void InstructionSelector::VisitWord32AtomicExchange(Node* node) {
+  VisitAtomicRMW(this, node, kX64AtomicXchgl);
+}
+
+void InstructionSelector::VisitWord32AtomicCompareExchange(Node* node) {
+  VisitAtomicRMW(this, node, kX64AtomicCmpxchgl);
+}
+
+void InstructionSelector::VisitWord32AtomicAdd(Node* node) {
+  VisitAtomicRMW(this, node, kX64AtomicAddl);
+}
+
+void InstructionSelector::VisitWord32AtomicSub(Node* node) {
+  VisitAtomicRMW(this, node, kX64AtomicSubl);
+}
+
+void InstructionSelector::VisitWord32AtomicAnd(Node* node) {
+  VisitAtomicRMW(this, node, kX64AtomicAndl);
+}
+
+void InstructionSelector::VisitWord32AtomicOr(Node* node) {
+  VisitAtomicRMW(this, node, kX64AtomicOrl);
+}
+
+void InstructionSelector::VisitWord32AtomicXor(Node* node) {
+  VisitAtomicRMW(this, node, kX64AtomicXorl);
+}
+
+namespace {
+
+// Shared routine for the 4-lane constructors. All lanes set to the same value
+// are broadcast with a single shuffle, otherwise the lanes are packed pairwise
+// with the help of a temporary register.
+void VisitSimd128Create(InstructionSelector* selector, Node* node,
+                        ArchOpcode create_opcode, ArchOpcode splat_opcode) {
+  X64OperandGenerator g(selector);
+  Node* value = node->InputAt(0);
+  if (node->InputAt(1) == value && node->InputAt(2) == value &&
+      node->InputAt(3) == value) {
+    selector->Emit(splat_opcode, g.DefineAsRegister(node),
+                   g.UseRegister(value));
+    return;
+  }
+  InstructionOperand temps[] = {g.TempDoubleRegister()};
+  selector->Emit(create_opcode, g.DefineAsRegister(node),
+                 g.UseRegister(node->InputAt(0)),
+                 g.UseRegister(node->InputAt(1)),
+                 g.UseRegister(node->InputAt(2)),
+                 g.UseRegister(node->InputAt(3)), arraysize(temps), temps);
+}
+
+// Shared routine for lane extraction. Lane indices are required to be
+// constants in the range [0, 3], see WasmGraphBuilder::SimdOp.
+void VisitSimd128ExtractLane(InstructionSelector* selector, Node* node,
+                             ArchOpcode opcode) {
+  X64OperandGenerator g(selector);
+  Int32Matcher m(node->InputAt(1));
+  DCHECK(m.IsInRange(0, 3));
+  selector->Emit(opcode, g.DefineAsRegister(node),
+                 g.UseRegister(node->InputAt(0)), g.UseImmediate(m.node()));
+}
+
+// Shared routine for lanewise binary operations. The destructive SSE forms
+// require the output to be the same as the first input; with AVX the code
+// generator picks the non-destructive three-operand form instead.
+void VisitSimd128Binop(InstructionSelector* selector, Node* node,
+                       ArchOpcode opcode) {
+  X64OperandGenerator g(selector);
+  InstructionOperand operand0 = g.UseRegister(node->InputAt(0));
+  InstructionOperand operand1 = g.UseRegister(node->InputAt(1));
+  if (selector->IsSupported(AVX)) {
+    selector->Emit(opcode, g.DefineAsRegister(node), operand0, operand1);
+  } else {
+    selector->Emit(opcode, g.DefineSameAsFirst(node), operand0, operand1);
+  }
+}
+
+}  // namespace
+
+void InstructionSelector::VisitCreateInt32x4(Node* node) {
+  VisitSimd128Create(this, node, kX64Int32x4Create, kX64Int32x4Splat);
+}
+
+void InstructionSelector::VisitInt32x4ExtractLane(Node* node) {
+  VisitSimd128ExtractLane(this, node, kX64Int32x4ExtractLane);
+}
+
+void InstructionSelector::VisitInt32x4Add(Node* node) {
+  VisitSimd128Binop(this, node, kX64Int32x4Add);
+}
+
+void InstructionSelector::VisitInt32x4Sub(Node* node) {
+  VisitSimd128Binop(this, node, kX64Int32x4Sub);
+}
+
+void InstructionSelector::VisitInt32x4Mul(Node* node) {
+  DCHECK(IsSupported(SSE4_1));
+  VisitSimd128Binop(this, node, kX64Int32x4Mul);
+}
+
+void InstructionSelector::VisitCreateFloat32x4(Node* node) {
+  VisitSimd128Create(this, node, kX64Float32x4Create, kX64Float32x4Splat);
+}
+
+void InstructionSelector::VisitFloat32x4ExtractLane(Node* node) {
+  VisitSimd128ExtractLane(this, node, kX64Float32x4ExtractLane);
+}
+
+void InstructionSelector::VisitFloat32x4Add(Node* node) {
+  VisitSimd128Binop(this, node, kX64Float32x4Add);
+}
+
+void InstructionSelector::VisitFloat32x4Sub(Node* node) {
+  VisitSimd128Binop(this, node, kX64Float32x4Sub);
+}
+
+void InstructionSelector::VisitFloat32x4Mul(Node* node) {
+  VisitSimd128Binop(this, node, kX64Float32x4Mul);
+}
+
+void InstructionSelector::VisitFloat32x4Div(Node* node) {
+  VisitSimd128Binop(this, node, kX64Float32x4Div);
+}
+
 // static
 MachineOperatorBuilder::Flags
 InstructionSelector::SupportedMachineOperatorFlags() {
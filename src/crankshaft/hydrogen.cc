@@ -8270,8 +8270,9 @@ int HOptimizedGraphBuilder::InliningAstSize(Handle<JSFunction> target) {
   Handle<JSFunction> caller = current_info()->closure();
   Handle<SharedFunctionInfo> target_shared(target->shared());
 
-  // Always inline functions that force inlining.
-  if (target_shared->force_inline()) {
+  // Always inline functions that force inlining, unless they are too big.
+  if (target_shared->force_inline() &&
+      target_shared->ast_node_count() <= FLAG_max_inlined_nodes) {
     return 0;
   }
   if (target->shared()->IsBuiltin()) {
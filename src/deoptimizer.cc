@@ -4,6 +4,8 @@
 
 #include "src/deoptimizer.h"
 
+#include <algorithm>
+#include <iomanip>
 #include <memory>
 
 #include "src/accessors.h"
@@ -13,6 +15,7 @@
 #include "src/frames-inl.h"
 #include "src/full-codegen/full-codegen.h"
 #include "src/global-handles.h"
+#include "src/interpreter/bytecode-array-iterator.h"
 #include "src/interpreter/interpreter.h"
 #include "src/macro-assembler.h"
 #include "src/tracing/trace-event.h"
@@ -48,6 +51,64 @@ DeoptimizerData::~DeoptimizerData() {
 }
 
 
+DeoptimizationSiteStats::Site* DeoptimizationSiteStats::Record(
+    SharedFunctionInfo* shared, int position, DeoptimizeReason reason) {
+  int script_id = shared->script()->IsScript()
+                      ? Script::cast(shared->script())->id()
+                      : -1;
+  SiteKey key = {script_id, position, reason};
+  auto it = sites_.find(key);
+  if (it == sites_.end()) {
+    while (sites_.size() >= kMaxSites) Age();
+    std::unique_ptr<Site> site(new Site(script_id, position, reason,
+                                        shared->DebugName()->ToCString()));
+    it = sites_.insert(std::make_pair(key, std::move(site))).first;
+  }
+  Site* site = it->second.get();
+  site->count++;
+  return site;
+}
+
+
+void DeoptimizationSiteStats::Age() {
+  for (auto it = sites_.begin(); it != sites_.end();) {
+    Site* site = it->second.get();
+    site->count /= 2;
+    if (site->count == 0) {
+      it = sites_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+
+std::vector<const DeoptimizationSiteStats::Site*>
+DeoptimizationSiteStats::TopSites(size_t count) const {
+  std::vector<const Site*> result;
+  result.reserve(sites_.size());
+  for (auto& entry : sites_) result.push_back(entry.second.get());
+  std::sort(result.begin(), result.end(), [](const Site* a, const Site* b) {
+    if (a->count != b->count) return a->count > b->count;
+    if (a->script_id != b->script_id) return a->script_id < b->script_id;
+    return a->position < b->position;
+  });
+  if (result.size() > count) result.resize(count);
+  return result;
+}
+
+
+void DeoptimizationSiteStats::Print(std::ostream& os, size_t count) const {
+  os << "--- Deoptimization sites (" << sites_.size() << ") ---" << std::endl;
+  for (const Site* site : TopSites(count)) {
+    os << std::setw(6) << site->count << "  <" << site->function_name.get()
+       << "> script " << site->script_id << " @" << site->position << ": "
+       << site->reason << (site->generalized ? " (generalized)" : "")
+       << std::endl;
+  }
+}
+
+
 Code* Deoptimizer::FindDeoptimizingCode(Address addr) {
   if (function_->IsHeapObject()) {
     // Search all deoptimizing code in the native context of the function.
@@ -2485,6 +2546,11 @@ void Translation::StoreDoubleStackSlot(int index) {
   buffer_->Add(index, zone());
 }
 
+void Translation::StoreSimd128StackSlot(int index) {
+  buffer_->Add(SIMD128_STACK_SLOT, zone());
+  buffer_->Add(index, zone());
+}
+
 
 void Translation::StoreLiteral(int literal_id) {
   buffer_->Add(LITERAL, zone());
@@ -2527,6 +2593,7 @@ int Translation::NumberOfOperandsFor(Opcode opcode) {
     case BOOL_STACK_SLOT:
     case FLOAT_STACK_SLOT:
     case DOUBLE_STACK_SLOT:
+    case SIMD128_STACK_SLOT:
     case LITERAL:
     case COMPILED_STUB_FRAME:
     case TAIL_CALLER_FRAME:
@@ -2758,6 +2825,159 @@ Deoptimizer::DeoptInfo Deoptimizer::GetDeoptInfo(Code* code, Address pc) {
 }
 
 
+namespace {
+
+// Returns the feedback vector index of the inline cache used by the bytecode
+// at {offset}, or -1 if that bytecode has no inline cache.
+int FeedbackIndexAtBytecodeOffset(Handle<BytecodeArray> bytecode_array,
+                                  int offset) {
+  interpreter::BytecodeArrayIterator iterator(bytecode_array);
+  while (!iterator.done() && iterator.current_offset() < offset) {
+    iterator.Advance();
+  }
+  if (iterator.done() || iterator.current_offset() != offset) return -1;
+  interpreter::Bytecode bytecode = iterator.current_bytecode();
+  switch (bytecode) {
+    case interpreter::Bytecode::kLdaNamedProperty:
+    case interpreter::Bytecode::kLdrNamedProperty:
+    case interpreter::Bytecode::kLdaKeyedProperty:
+    case interpreter::Bytecode::kLdrKeyedProperty:
+    case interpreter::Bytecode::kStaNamedPropertySloppy:
+    case interpreter::Bytecode::kStaNamedPropertyStrict:
+    case interpreter::Bytecode::kStaKeyedPropertySloppy:
+    case interpreter::Bytecode::kStaKeyedPropertyStrict:
+    case interpreter::Bytecode::kCall:
+    case interpreter::Bytecode::kTailCall:
+      break;
+    default:
+      return -1;
+  }
+  // The feedback slot is the last index operand of these bytecodes.
+  for (int i = interpreter::Bytecodes::NumberOfOperands(bytecode) - 1; i >= 0;
+       --i) {
+    if (interpreter::Bytecodes::GetOperandType(bytecode, i) ==
+        interpreter::OperandType::kIdx) {
+      return static_cast<int>(iterator.GetIndexOperand(i));
+    }
+  }
+  return -1;
+}
+
+// Returns true if deoptimizations for {reason} mean that the inline cache
+// feedback at the site was too narrow, i.e. the receiver or target had a
+// shape the optimized code did not expect. Value checks, such as a failed
+// number or Smi representation check, a bounds check or an overflow, are
+// not fixed by generalizing the feedback.
+bool IsFeedbackShapeReason(DeoptimizeReason reason) {
+  switch (reason) {
+    case DeoptimizeReason::kInstanceMigrationFailed:
+    case DeoptimizeReason::kInsufficientTypeFeedbackForGenericNamedAccess:
+    case DeoptimizeReason::kInsufficientTypeFeedbackForGenericKeyedAccess:
+    case DeoptimizeReason::kNotAJavaScriptObject:
+    case DeoptimizeReason::kSmi:
+    case DeoptimizeReason::kUnknownMap:
+    case DeoptimizeReason::kUnknownMapInPolymorphicAccess:
+    case DeoptimizeReason::kUnknownMapInPolymorphicCall:
+    case DeoptimizeReason::kUnknownMapInPolymorphicElementAccess:
+    case DeoptimizeReason::kValueMismatch:
+    case DeoptimizeReason::kWrongInstanceType:
+    case DeoptimizeReason::kWrongMap:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Makes the inline cache feedback used by the bytecode that the interpreted
+// {frame} continues at megamorphic. Returns false if there is no such
+// feedback or it cannot be generalized.
+bool GeneralizeFeedbackAt(InterpretedFrame* frame) {
+  Isolate* isolate = frame->isolate();
+  HandleScope scope(isolate);
+  Handle<JSFunction> function(frame->function(), isolate);
+  Handle<BytecodeArray> bytecode_array(frame->GetBytecodeArray(), isolate);
+  int index =
+      FeedbackIndexAtBytecodeOffset(bytecode_array, frame->GetBytecodeOffset());
+  if (index < 0) return false;
+  Handle<TypeFeedbackVector> vector(function->feedback_vector(), isolate);
+  FeedbackVectorSlot slot = vector->ToSlot(index);
+  switch (vector->GetKind(slot)) {
+    case FeedbackVectorSlotKind::CALL_IC: {
+      CallICNexus nexus(vector, slot);
+      if (nexus.ic_state() == MEGAMORPHIC) return false;
+      nexus.ConfigureMegamorphic();
+      return true;
+    }
+    case FeedbackVectorSlotKind::LOAD_IC: {
+      LoadICNexus nexus(vector, slot);
+      if (nexus.ic_state() == MEGAMORPHIC) return false;
+      nexus.ConfigureMegamorphic();
+      return true;
+    }
+    case FeedbackVectorSlotKind::KEYED_LOAD_IC: {
+      KeyedLoadICNexus nexus(vector, slot);
+      if (nexus.ic_state() == MEGAMORPHIC) return false;
+      nexus.ConfigureMegamorphicKeyed(ELEMENT);
+      return true;
+    }
+    case FeedbackVectorSlotKind::STORE_IC: {
+      StoreICNexus nexus(vector, slot);
+      if (nexus.ic_state() == MEGAMORPHIC) return false;
+      nexus.ConfigureMegamorphic();
+      return true;
+    }
+    case FeedbackVectorSlotKind::KEYED_STORE_IC: {
+      KeyedStoreICNexus nexus(vector, slot);
+      if (nexus.ic_state() == MEGAMORPHIC) return false;
+      nexus.ConfigureMegamorphicKeyed(ELEMENT);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+
+// static
+bool Deoptimizer::RecordDeoptimizationSite(Isolate* isolate,
+                                           JSFunction* function,
+                                           JavaScriptFrame* frame,
+                                           BailoutType type,
+                                           DeoptimizeReason reason) {
+  DCHECK(type == EAGER || type == SOFT);
+  List<FrameSummary> frames(FLAG_max_inlining_levels + 1);
+  frame->Summarize(&frames);
+  FrameSummary& summary = frames.last();
+  int position = summary.abstract_code()->SourcePosition(summary.code_offset());
+  DeoptimizationSiteStats::Site* site =
+      isolate->deoptimizer_data()->site_stats()->Record(
+          summary.function()->shared(), position, reason);
+
+  if (type != EAGER || !IsFeedbackShapeReason(reason) || site->generalized ||
+      !frame->is_interpreted() ||
+      site->count < FLAG_deopt_site_generalize_count) {
+    return false;
+  }
+  if (!GeneralizeFeedbackAt(static_cast<InterpretedFrame*>(frame))) {
+    return false;
+  }
+  site->generalized = true;
+  if (FLAG_trace_deopt) {
+    PrintF("[generalizing feedback at deopt site <%s> @%d (%s) after %d "
+           "deopts]\n",
+           site->function_name.get(), position,
+           DeoptimizeReasonToString(reason), site->count);
+  }
+  // The site is expected to be stable in the reoptimized code, so don't let
+  // this deoptimization count against the function's optimization limit.
+  int opt_count = function->shared()->opt_count();
+  if (opt_count > 0) function->shared()->set_opt_count(opt_count - 1);
+  return true;
+}
+
+
 // static
 int Deoptimizer::ComputeSourcePosition(SharedFunctionInfo* shared,
                                        BailoutId node_id) {
@@ -2822,6 +3042,14 @@ TranslatedValue TranslatedValue::NewDouble(TranslatedState* container,
   return slot;
 }
 
+// static
+TranslatedValue TranslatedValue::NewSimd128(TranslatedState* container,
+                                            const void* bits) {
+  TranslatedValue slot(container, kSimd128);
+  memcpy(slot.simd128_value_, bits, kSimd128Size);
+  return slot;
+}
+
 
 // static
 TranslatedValue TranslatedValue::NewInt32(TranslatedState* container,
@@ -2895,6 +3123,11 @@ double TranslatedValue::double_value() const {
   return double_value_;
 }
 
+void TranslatedValue::CopySimd128Value(void* destination) const {
+  DCHECK_EQ(kSimd128, kind());
+  memcpy(destination, simd128_value_, kSimd128Size);
+}
+
 
 int TranslatedValue::object_length() const {
   DCHECK(kind() == kArgumentsObject || kind() == kCapturedObject);
@@ -2978,6 +3211,7 @@ Handle<Object> TranslatedValue::GetValue() {
     case TranslatedValue::kDuplicatedObject:
       return container_->MaterializeObjectAt(object_index());
 
+    case TranslatedValue::kSimd128:
     case TranslatedValue::kInvalid:
       FATAL("unexpected case");
       return Handle<Object>::null();
@@ -3017,6 +3251,7 @@ void TranslatedValue::MaterializeSimple() {
       value_ = Handle<Object>(isolate()->factory()->NewNumber(double_value()));
       return;
 
+    case kSimd128:
     case kCapturedObject:
     case kDuplicatedObject:
     case kArgumentsObject:
@@ -3290,6 +3525,7 @@ TranslatedFrame TranslatedState::CreateNextTranslatedFrame(
     case Translation::BOOL_STACK_SLOT:
     case Translation::FLOAT_STACK_SLOT:
     case Translation::DOUBLE_STACK_SLOT:
+    case Translation::SIMD128_STACK_SLOT:
     case Translation::LITERAL:
       break;
   }
@@ -3507,6 +3743,16 @@ TranslatedValue TranslatedState::CreateNextTranslatedValue(
       return TranslatedValue::NewDouble(this, value);
     }
 
+    case Translation::SIMD128_STACK_SLOT: {
+      int slot_offset =
+          OptimizedFrame::StackSlotOffsetRelativeToFp(iterator->Next());
+      if (trace_file != nullptr) {
+        PrintF(trace_file, "(simd128) [fp %c %d] ", slot_offset < 0 ? '-' : '+',
+               std::abs(slot_offset));
+      }
+      return TranslatedValue::NewSimd128(this, fp + slot_offset);
+    }
+
     case Translation::LITERAL: {
       int literal_index = iterator->Next();
       Object* value = literal_array->get(literal_index);
@@ -3653,6 +3899,11 @@ Handle<Object> TranslatedState::MaterializeAt(int frame_index,
       return value;
     }
 
+    case TranslatedValue::kSimd128:
+      // The raw bits are consumed by the SIMD128_VALUE_TYPE case of the
+      // enclosing captured object; we only get here when skipping them.
+      return isolate_->factory()->undefined_value();
+
     case TranslatedValue::kArgumentsObject: {
       int length = slot->GetChildrenCount();
       Handle<JSObject> arguments;
@@ -3712,6 +3963,27 @@ Handle<Object> TranslatedState::MaterializeAt(int frame_index,
           }
           return object;
         }
+        case SIMD128_VALUE_TYPE: {
+          TranslatedValue* bits = &(frame->values_[*value_index]);
+          (*value_index)++;
+          CHECK_EQ(TranslatedValue::kSimd128, bits->kind());
+          Handle<Object> object;
+          if (*map == isolate_->heap()->float32x4_map()) {
+            float lanes[4];
+            bits->CopySimd128Value(lanes);
+            object = isolate_->factory()->NewFloat32x4(lanes);
+          } else {
+            CHECK(*map == isolate_->heap()->int32x4_map());
+            int32_t lanes[4];
+            bits->CopySimd128Value(lanes);
+            object = isolate_->factory()->NewInt32x4(lanes);
+          }
+          slot->value_ = object;
+          for (int i = 0; i < length - 2; i++) {
+            MaterializeAt(frame_index, value_index);
+          }
+          return object;
+        }
         case JS_OBJECT_TYPE:
         case JS_ERROR_TYPE:
         case JS_ARGUMENTS_TYPE: {
@@ -5,7 +5,12 @@
 #ifndef V8_DEOPTIMIZER_H_
 #define V8_DEOPTIMIZER_H_
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include "src/allocation.h"
+#include "src/base/functional.h"
 #include "src/deoptimize-reason.h"
 #include "src/macro-assembler.h"
 
@@ -42,6 +47,8 @@ class TranslatedValue {
     kBoolBit,
     kFloat,
     kDouble,
+    kSimd128,           // Raw bits of a SIMD value; only occurs as the
+                        // payload of a captured SIMD128_VALUE_TYPE object.
     kCapturedObject,    // Object captured by the escape analysis.
                         // The number of nested objects can be obtained
                         // with the DeferredObjectLength() method
@@ -65,6 +72,8 @@ class TranslatedValue {
   static TranslatedValue NewDuplicateObject(TranslatedState* container, int id);
   static TranslatedValue NewFloat(TranslatedState* container, float value);
   static TranslatedValue NewDouble(TranslatedState* container, double value);
+  static TranslatedValue NewSimd128(TranslatedState* container,
+                                    const void* bits);
   static TranslatedValue NewInt32(TranslatedState* container, int32_t value);
   static TranslatedValue NewUInt32(TranslatedState* container, uint32_t value);
   static TranslatedValue NewBool(TranslatedState* container, uint32_t value);
@@ -100,6 +109,8 @@ class TranslatedValue {
     float float_value_;
     // kind is kDouble
     double double_value_;
+    // kind is kSimd128
+    uint8_t simd128_value_[kSimd128Size];
     // kind is kDuplicatedObject or kArgumentsObject or kCapturedObject.
     MaterializedObjectInfo materialization_info_;
   };
@@ -110,6 +121,7 @@ class TranslatedValue {
   uint32_t uint32_value() const;
   float float_value() const;
   double double_value() const;
+  void CopySimd128Value(void* destination) const;
   int object_length() const;
   int object_index() const;
 };
@@ -390,6 +402,7 @@ class Deoptimizer : public Malloced {
   Handle<JSFunction> function() const { return Handle<JSFunction>(function_); }
   Handle<Code> compiled_code() const { return Handle<Code>(compiled_code_); }
   BailoutType bailout_type() const { return bailout_type_; }
+  Address from() const { return from_; }
 
   // Number of created JS frames. Not all created frames are necessarily JS.
   int jsframe_count() const { return jsframe_count_; }
@@ -441,6 +454,19 @@ class Deoptimizer : public Malloced {
 
   static void ComputeOutputFrames(Deoptimizer* deoptimizer);
 
+  // Records an eager or soft deoptimization of {function} at the site that
+  // the unoptimized {frame} continues at. Once an eager site has been hit
+  // --deopt-site-generalize-count times for a {reason} that indicates an
+  // unexpected receiver or target shape, its inline cache feedback is made
+  // megamorphic so that the next optimization does not speculate on it
+  // again; that deoptimization then does not count against the
+  // reoptimization limit of the function. Returns true if the feedback was
+  // generalized.
+  static bool RecordDeoptimizationSite(Isolate* isolate, JSFunction* function,
+                                       JavaScriptFrame* frame,
+                                       BailoutType type,
+                                       DeoptimizeReason reason);
+
 
   enum GetEntryMode {
     CALCULATE_ENTRY_ADDRESS,
@@ -836,17 +862,90 @@ class FrameDescription {
 };
 
 
+// Counts eager and soft deoptimizations per deoptimization site. A site is
+// the source position in the unoptimized code that execution continues at,
+// together with the reason of the deoptimization. Sites are identified by
+// script id and source position, so entries survive garbage collection and
+// recompilation of the function.
+class DeoptimizationSiteStats {
+ public:
+  struct Site {
+    Site(int script_id, int position, DeoptimizeReason reason,
+         std::unique_ptr<char[]> function_name)
+        : script_id(script_id),
+          position(position),
+          reason(reason),
+          function_name(std::move(function_name)),
+          count(0),
+          generalized(false) {}
+
+    int script_id;
+    int position;
+    DeoptimizeReason reason;
+    std::unique_ptr<char[]> function_name;
+    int count;
+    // Whether the feedback at this site has been generalized already.
+    bool generalized;
+  };
+
+  DeoptimizationSiteStats() {}
+
+  // The number of sites tracked at a time. When a new site would exceed it,
+  // the counts of all sites are aged and sites that drop to zero are removed.
+  static const size_t kMaxSites = 1024;
+
+  // Records a deoptimization at the given site and returns the site.
+  Site* Record(SharedFunctionInfo* shared, int position,
+               DeoptimizeReason reason);
+
+  // Returns up to {count} sites, the most frequently hit ones first.
+  std::vector<const Site*> TopSites(size_t count) const;
+
+  void Print(std::ostream& os, size_t count) const;
+
+  size_t size() const { return sites_.size(); }
+
+ private:
+  struct SiteKey {
+    int script_id;
+    int position;
+    DeoptimizeReason reason;
+
+    bool operator==(const SiteKey& other) const {
+      return script_id == other.script_id && position == other.position &&
+             reason == other.reason;
+    }
+  };
+  struct SiteKeyHash {
+    size_t operator()(const SiteKey& key) const {
+      return base::hash_combine(key.script_id, key.position,
+                                static_cast<uint8_t>(key.reason));
+    }
+  };
+
+  // Halves the counts of all sites and removes the sites that reach zero.
+  void Age();
+
+  std::unordered_map<SiteKey, std::unique_ptr<Site>, SiteKeyHash> sites_;
+
+  DISALLOW_COPY_AND_ASSIGN(DeoptimizationSiteStats);
+};
+
+
 class DeoptimizerData {
  public:
   explicit DeoptimizerData(MemoryAllocator* allocator);
   ~DeoptimizerData();
 
+  DeoptimizationSiteStats* site_stats() { return &site_stats_; }
+
  private:
   MemoryAllocator* allocator_;
   int deopt_entry_code_entries_[Deoptimizer::kLastBailoutType + 1];
   MemoryChunk* deopt_entry_code_[Deoptimizer::kLastBailoutType + 1];
 
   Deoptimizer* current_;
+  DeoptimizationSiteStats site_stats_;
 
   friend class Deoptimizer;
 
@@ -913,6 +1012,7 @@ class TranslationIterator BASE_EMBEDDED {
   V(BOOL_STACK_SLOT)               \
   V(FLOAT_STACK_SLOT)              \
   V(DOUBLE_STACK_SLOT)             \
+  V(SIMD128_STACK_SLOT)            \
   V(LITERAL)
 
 class Translation BASE_EMBEDDED {
@@ -961,6 +1061,7 @@ class Translation BASE_EMBEDDED {
   void StoreBoolStackSlot(int index);
   void StoreFloatStackSlot(int index);
   void StoreDoubleStackSlot(int index);
+  void StoreSimd128StackSlot(int index);
   void StoreLiteral(int literal_id);
   void StoreArgumentsObject(bool args_known, int args_index, int args_length);
   void StoreJSFrameFunction();
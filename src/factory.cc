@@ -11,6 +11,7 @@
 #include "src/conversions.h"
 #include "src/isolate-inl.h"
 #include "src/macro-assembler.h"
+#include "src/wasm/wasm-trap-handler.h"
 
 namespace v8 {
 namespace internal {
@@ -1477,13 +1478,22 @@ Handle<Code> Factory::NewCode(const CodeDesc& desc,
 }
 
 
-Handle<Code> Factory::CopyCode(Handle<Code> code) {
+Handle<Code> Factory::CopyCodeRaw(Handle<Code> code) {
   CALL_HEAP_FUNCTION(isolate(),
                      isolate()->heap()->CopyCode(*code),
                      Code);
 }
 
 
+Handle<Code> Factory::CopyCode(Handle<Code> code) {
+  Handle<Code> copy = CopyCodeRaw(code);
+  // The copy runs at a different address, so the trap handler needs its own
+  // entry for the protected instructions.
+  wasm::RegisterProtectedInstructions(*copy);
+  return copy;
+}
+
+
 Handle<BytecodeArray> Factory::CopyBytecodeArray(
     Handle<BytecodeArray> bytecode_array) {
   CALL_HEAP_FUNCTION(isolate(),
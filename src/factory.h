@@ -735,6 +735,10 @@ class Factory final {
   // Creates a code object that is not yet fully initialized yet.
   inline Handle<Code> NewCodeRaw(int object_size, bool immovable);
 
+  // Allocates a copy of {code}. CopyCode additionally enters the copy into the
+  // protected instruction table of the wasm trap handler.
+  Handle<Code> CopyCodeRaw(Handle<Code> code);
+
   // Attempt to find the number in a small cache.  If we finds it, return
   // the string representation of the number.  Otherwise return undefined.
   Handle<Object> GetNumberStringCache(Handle<Object> number);
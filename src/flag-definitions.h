@@ -298,7 +298,6 @@ DEFINE_BOOL(string_slices, true, "use string slices")
 DEFINE_BOOL(ignition, false, "use ignition interpreter")
 DEFINE_BOOL(ignition_staging, false, "use ignition with all staged features")
 DEFINE_IMPLICATION(ignition_staging, ignition)
-DEFINE_IMPLICATION(ignition_staging, ignition_osr)
 DEFINE_IMPLICATION(ignition_staging, turbo_from_bytecode)
 DEFINE_BOOL(ignition_eager, false, "eagerly compile and parse with ignition")
 DEFINE_STRING(ignition_filter, "*", "filter for ignition interpreter")
@@ -429,10 +428,16 @@ DEFINE_IMPLICATION(turbo, turbo_asm_deoptimization)
 DEFINE_IMPLICATION(turbo, turbo_store_elimination)
 DEFINE_IMPLICATION(turbo, turbo_loop_peeling)
 DEFINE_BOOL(turbo_from_bytecode, false, "enable building graphs from bytecode")
+DEFINE_IMPLICATION(turbo_from_bytecode, ignition_osr)
 DEFINE_BOOL(turbo_sp_frame_access, false,
             "use stack pointer-relative access to frame wherever possible")
 DEFINE_BOOL(turbo_preprocess_ranges, true,
             "run pre-register allocation heuristics")
+DEFINE_BOOL(turbo_fast_regalloc, true,
+            "use the fast register allocation mode for very large functions")
+DEFINE_INT(turbo_fast_regalloc_threshold, 50000,
+           "instruction count above which the fast register allocation mode "
+           "is used")
 DEFINE_BOOL(turbo_loop_stackcheck, true, "enable stack checks in loops")
 DEFINE_STRING(turbo_filter, "~~", "optimization filter for TurboFan compiler")
 DEFINE_BOOL(trace_turbo, false, "trace generated TurboFan IR")
@@ -479,11 +484,18 @@ DEFINE_BOOL(turbo_stress_loop_peeling, false,
             "stress loop peeling optimization")
 DEFINE_BOOL(turbo_loop_peeling, false, "Turbofan loop peeling")
 DEFINE_BOOL(turbo_loop_variable, false, "Turbofan loop variable optimization")
+DEFINE_BOOL(turbo_loop_vectorization, false,
+            "vectorize element-wise Float32Array loops in TurboFan")
+// Only accesses proven to be in bounds are vectorized.
+DEFINE_IMPLICATION(turbo_loop_vectorization, turbo_loop_variable)
 DEFINE_BOOL(turbo_cf_optimization, true, "optimize control flow in TurboFan")
 DEFINE_BOOL(turbo_frame_elision, true, "elide frames in TurboFan")
 DEFINE_BOOL(turbo_cache_shared_code, true, "cache context-independent code")
 DEFINE_BOOL(turbo_preserve_shared_code, false, "keep context-independent code")
 DEFINE_BOOL(turbo_escape, false, "enable escape analysis")
+// Off on every port. The x64 latency model is an estimate; it can only be
+// turned on once the Compute and ComputeScheduling js-perf-test runs show
+// that the scheduled code pays for the extra compile time.
 DEFINE_BOOL(turbo_instruction_scheduling, false,
             "enable instruction scheduling in TurboFan")
 DEFINE_BOOL(turbo_stress_instruction_scheduling, false,
@@ -503,6 +515,9 @@ DEFINE_NEG_IMPLICATION(minimal, use_ic)
 DEFINE_BOOL(expose_wasm, false, "expose WASM interface to JavaScript")
 DEFINE_INT(wasm_num_compilation_tasks, 10,
            "number of parallel compilation tasks for wasm")
+DEFINE_BOOL(wasm_compile_largest_first, true,
+            "compile the largest wasm functions first when compiling in "
+            "parallel")
 DEFINE_BOOL(trace_wasm_encoder, false, "trace encoding of wasm code")
 DEFINE_BOOL(trace_wasm_decoder, false, "trace decoding of wasm code")
 DEFINE_BOOL(trace_wasm_decode_time, false, "trace decoding time of wasm code")
@@ -516,6 +531,17 @@ DEFINE_BOOL(wasm_break_on_decoder_error, false,
             "debug break when wasm decoder encounters an error")
 DEFINE_BOOL(wasm_loop_assignment_analysis, true,
             "perform loop assignment analysis for WASM")
+DEFINE_BOOL(wasm_trap_handler, false,
+            "catch out-of-bounds wasm memory accesses in a signal handler "
+            "instead of emitting bounds checks (x64 Linux only)")
+DEFINE_BOOL(wasm_lazy_compilation, false,
+            "compile wasm functions on their first call")
+DEFINE_BOOL(wasm_tier_up, false,
+            "compile wasm functions quickly first and recompile the hot ones "
+            "with all optimizations in the background")
+DEFINE_INT(wasm_tier_up_budget, 10000,
+           "number of calls and loop iterations of a wasm function before "
+           "it is recompiled")
 
 DEFINE_BOOL(validate_asm, false, "validate asm.js modules before compiling")
 
@@ -529,6 +555,8 @@ DEFINE_BOOL(wasm_jit_prototype, false,
             "enable experimental wasm runtime dynamic code generation")
 DEFINE_BOOL(wasm_simd_prototype, false,
             "enable prototype simd opcodes for wasm")
+DEFINE_BOOL(wasm_threads_prototype, false,
+            "enable prototype shared memory and atomic opcodes for wasm")
 
 // Profiler flags.
 DEFINE_INT(frame_count, 1, "number of stack frames inspected by the profiler")
@@ -540,6 +568,19 @@ DEFINE_INT(type_info_threshold, 25,
 DEFINE_INT(generic_ic_threshold, 30,
            "max percentage of megamorphic/generic ICs to allow optimization")
 DEFINE_INT(self_opt_count, 130, "call count before self-optimization")
+DEFINE_INT(ignition_tierup_ticks, 2,
+           "profiler ticks before an interpreted function is optimized")
+DEFINE_INT(ignition_tierup_bytes_per_tick, 1024,
+           "bytecode size that adds one profiler tick to the optimization "
+           "threshold of interpreted functions (0 to ignore size)")
+DEFINE_INT(ignition_tierup_max_ticks, 100,
+           "profiler ticks after which an interpreted function is optimized "
+           "even without stable type feedback")
+DEFINE_INT(ignition_early_opt_size, 64,
+           "max bytecode size of interpreted functions that are optimized on "
+           "their first tick if their type feedback is stable")
+DEFINE_BOOL(trace_ignition_tierup, false,
+            "trace tier-up decisions for interpreted functions")
 
 DEFINE_BOOL(trace_opt_verbose, false, "extra verbose compilation tracing")
 DEFINE_IMPLICATION(trace_opt_verbose, trace_opt)
@@ -642,6 +683,18 @@ DEFINE_INT(min_preparse_length, 1024,
            "minimum length for automatic enable preparsing")
 DEFINE_INT(max_opt_count, 10,
            "maximum number of optimization attempts before giving up.")
+DEFINE_BOOL(track_deopt_sites, false,
+            "count deoptimizations per site and generalize the feedback at "
+            "unstable sites")
+DEFINE_INT(deopt_site_generalize_count, 3,
+           "number of eager deopts at one site after which the inline cache "
+           "feedback at that site is generalized")
+DEFINE_BOOL(trace_deopt_sites, false,
+            "print the most frequent deoptimization sites on exit")
+DEFINE_IMPLICATION(trace_deopt_sites, track_deopt_sites)
+DEFINE_BOOL(lazy_feedback_vectors, true,
+            "allocate the feedback vector of a closure whose function is "
+            "already compiled on its first call")
 
 // compilation-cache.cc
 DEFINE_BOOL(compilation_cache, true, "enable compilation cache")
@@ -5,10 +5,24 @@
 #include "src/heap/array-buffer-tracker.h"
 #include "src/heap/array-buffer-tracker-inl.h"
 #include "src/heap/heap.h"
+#include "src/wasm/wasm-trap-handler.h"
 
 namespace v8 {
 namespace internal {
 
+namespace {
+
+void FreeBackingStore(Heap* heap, JSArrayBuffer* buffer, size_t length) {
+  if (buffer->has_guard_region()) {
+    wasm::FreeGuardRegionMemory(buffer->backing_store());
+  } else {
+    heap->isolate()->array_buffer_allocator()->Free(buffer->backing_store(),
+                                                    length);
+  }
+}
+
+}  // namespace
+
 LocalArrayBufferTracker::~LocalArrayBufferTracker() {
   CHECK(array_buffers_.empty());
 }
@@ -22,8 +36,7 @@ void LocalArrayBufferTracker::Free() {
     if ((free_mode == kFreeAll) ||
         Marking::IsWhite(ObjectMarking::MarkBitFrom(buffer))) {
       const size_t len = it->second;
-      heap_->isolate()->array_buffer_allocator()->Free(buffer->backing_store(),
-                                                       len);
+      FreeBackingStore(heap_, buffer, len);
       freed_memory += len;
       it = array_buffers_.erase(it);
     } else {
@@ -62,8 +75,7 @@ void LocalArrayBufferTracker::Process(Callback callback) {
       it = array_buffers_.erase(it);
     } else if (result == kRemoveEntry) {
       const size_t len = it->second;
-      heap_->isolate()->array_buffer_allocator()->Free(
-          it->first->backing_store(), len);
+      FreeBackingStore(heap_, it->first, len);
       freed_memory += len;
       it = array_buffers_.erase(it);
     } else {
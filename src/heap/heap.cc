@@ -44,6 +44,7 @@
 #include "src/v8.h"
 #include "src/v8threads.h"
 #include "src/vm-state-inl.h"
+#include "src/wasm/wasm-trap-handler.h"
 
 namespace v8 {
 namespace internal {
@@ -4429,6 +4430,10 @@ void Heap::MemoryPressureNotification(MemoryPressureLevel level,
                                       bool is_isolate_locked) {
   MemoryPressureLevel previous = memory_pressure_level_.Value();
   memory_pressure_level_.SetValue(level);
+  if (level != MemoryPressureLevel::kNone) {
+    // The zone segment pool is thread-safe, release it right away.
+    isolate()->allocator()->ClearPool();
+  }
   if ((previous != MemoryPressureLevel::kCritical &&
        level == MemoryPressureLevel::kCritical) ||
       (previous == MemoryPressureLevel::kNone &&
@@ -5515,6 +5520,8 @@ void Heap::TearDown() {
 
   external_string_table_.TearDown();
 
+  wasm::ReleaseProtectedInstructions(this, nullptr);
+
   delete tracer_;
   tracer_ = nullptr;
 
@@ -27,6 +27,7 @@
 #include "src/ic/stub-cache.h"
 #include "src/utils-inl.h"
 #include "src/v8.h"
+#include "src/wasm/wasm-trap-handler.h"
 
 namespace v8 {
 namespace internal {
@@ -2415,6 +2416,12 @@ void MarkCompactCollector::ClearNonLiveReferences() {
     heap()->isolate()->global_handles()->RemoveImplicitRefGroups();
   }
 
+  // Forget the protected instructions of dead wasm code before its space is
+  // reused.
+  wasm::ReleaseProtectedInstructions(heap(), [](Code* code) {
+    return Marking::IsWhite(ObjectMarking::MarkBitFrom(code));
+  });
+
   // Flush code from collected candidates.
   if (is_code_flushing_enabled()) {
     TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_CLEAR_CODE_FLUSH);
@@ -3561,6 +3568,9 @@ void MarkCompactCollector::EvacuateNewSpaceAndCandidates() {
     heap()->new_space()->set_age_mark(heap()->new_space()->top());
   }
 
+  // Moved wasm code still has its forwarding address at the old location.
+  wasm::UpdateProtectedInstructionsAfterEvacuation(heap());
+
   UpdatePointersAfterEvacuation();
 
   if (!heap()->new_space()->Rebalance()) {
@@ -386,6 +386,18 @@ void IC::OnTypeFeedbackChanged(Isolate* isolate, Code* host) {
   // unoptimized version for the benefit of later inlining.
 }
 
+void IC::OnTypeFeedbackChanged() {
+  Code* host = get_host();
+  if (host->kind() == Code::BYTECODE_HANDLER) {
+    // Interpreted functions count their profiler ticks on the shared function
+    // info; reset them so that only stable feedback leads to optimization.
+    GetSharedFunctionInfo()->set_profiler_ticks(0);
+    isolate()->runtime_profiler()->NotifyICChanged();
+    return;
+  }
+  OnTypeFeedbackChanged(isolate(), host);
+}
+
 void IC::PostPatching(Address address, Code* target, Code* old_target) {
   // Type vector based ICs update these statistics at a different time because
   // they don't always patch on state change.
@@ -538,7 +550,7 @@ void IC::ConfigureVectorState(IC::State new_state, Handle<Object> key) {
   }
 
   vector_set_ = true;
-  OnTypeFeedbackChanged(isolate(), get_host());
+  OnTypeFeedbackChanged();
 }
 
 void IC::ConfigureVectorState(Handle<Name> name, Handle<Map> map,
@@ -563,7 +575,7 @@ void IC::ConfigureVectorState(Handle<Name> name, Handle<Map> map,
   }
 
   vector_set_ = true;
-  OnTypeFeedbackChanged(isolate(), get_host());
+  OnTypeFeedbackChanged();
 }
 
 void IC::ConfigureVectorState(Handle<Name> name, MapHandleList* maps,
@@ -585,7 +597,7 @@ void IC::ConfigureVectorState(Handle<Name> name, MapHandleList* maps,
   }
 
   vector_set_ = true;
-  OnTypeFeedbackChanged(isolate(), get_host());
+  OnTypeFeedbackChanged();
 }
 
 
@@ -598,7 +610,7 @@ void IC::ConfigureVectorState(MapHandleList* maps,
   nexus->ConfigurePolymorphic(maps, transitioned_maps, handlers);
 
   vector_set_ = true;
-  OnTypeFeedbackChanged(isolate(), get_host());
+  OnTypeFeedbackChanged();
 }
 
 
@@ -2220,7 +2232,7 @@ void CallIC::HandleMiss(Handle<Object> function) {
     name = handle(js_function->shared()->name(), isolate());
   }
 
-  OnTypeFeedbackChanged(isolate(), get_host());
+  OnTypeFeedbackChanged();
   TRACE_IC("CallIC", name);
 }
 
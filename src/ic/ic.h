@@ -133,6 +133,9 @@ class IC {
                                         Address constant_pool);
   // As a vector-based IC, type feedback must be updated differently.
   static void OnTypeFeedbackChanged(Isolate* isolate, Code* host);
+  // Same as above for the function this IC belongs to, which may also be
+  // running in the interpreter.
+  void OnTypeFeedbackChanged();
   static void PostPatching(Address address, Code* target, Code* old_target);
 
   // Compute the handler either by compiling or by retrieving a cached version.
@@ -0,0 +1,33 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_INTERPRETER_BYTECODE_SUPERINSTRUCTIONS_H_
+#define V8_INTERPRETER_BYTECODE_SUPERINSTRUCTIONS_H_
+
+// Pairs of bytecodes whose handlers are fused. The handler for the first
+// bytecode checks whether the next bytecode is the second one and, if so,
+// runs the inlined handler for it instead of dispatching to it. The bytecode
+// array itself is unchanged. Each first bytecode may appear only once, the
+// second one has to satisfy Bytecodes::IsSuperinstructionSuffix().
+//
+// Regenerate from dispatch profiles with
+//   tools/ignition/superinstruction_candidates.py -o <this file> <profiles>
+// or from the bytecode expectations with
+//   tools/ignition/superinstruction_candidates.py -g -w -o <this file>
+//       test/cctest/interpreter/bytecode_expectations/*.golden
+//
+// V(First, Second)
+#define SUPERINSTRUCTION_LIST(V)   \
+  V(StackCheck, LdaSmi)            \
+  V(LdaUndefined, Return)          \
+  V(Star, LdaSmi)                  \
+  V(Ldar, Return)                  \
+  V(CreateObjectLiteral, Star)     \
+  V(CallRuntime, PushContext)      \
+  V(Mov, Mov)                      \
+  V(CreateClosure, Star)           \
+  V(LdaNamedProperty, Nop)         \
+  V(StaContextSlot, CreateClosure)
+
+#endif  // V8_INTERPRETER_BYTECODE_SUPERINSTRUCTIONS_H_
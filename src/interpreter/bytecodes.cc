@@ -8,6 +8,7 @@
 
 #include "src/base/bits.h"
 #include "src/globals.h"
+#include "src/interpreter/bytecode-superinstructions.h"
 #include "src/interpreter/bytecode-traits.h"
 
 namespace v8 {
@@ -598,6 +599,31 @@ bool Bytecodes::IsStarLookahead(Bytecode bytecode, OperandScale operand_scale) {
   return false;
 }
 
+// static
+Bytecode Bytecodes::GetSuperinstructionSuffix(Bytecode bytecode,
+                                              OperandScale operand_scale) {
+  if (operand_scale == OperandScale::kSingle) {
+    switch (bytecode) {
+#define CASE(First, Second) \
+  case Bytecode::k##First:  \
+    return Bytecode::k##Second;
+      SUPERINSTRUCTION_LIST(CASE)
+#undef CASE
+      default:
+        break;
+    }
+  }
+  return Bytecode::kIllegal;
+}
+
+// static
+bool Bytecodes::IsSuperinstructionSuffix(Bytecode bytecode) {
+  // Prefixes change the operand scale of the next bytecode, and debug breaks
+  // dispatch to the handler of the bytecode they replace.
+  return bytecode != Bytecode::kIllegal && !IsPrefixScalingBytecode(bytecode) &&
+         !IsDebugBreak(bytecode);
+}
+
 // static
 int Bytecodes::GetNumberOfRegistersRepresentedBy(OperandType operand_type) {
   switch (operand_type) {
@@ -540,6 +540,17 @@ class Bytecodes final {
   // dispatch to a Star bytecode.
   static bool IsStarLookahead(Bytecode bytecode, OperandScale operand_scale);
 
+  // Returns the bytecode whose handler is inlined into the handler for
+  // |bytecode| when it comes next, or Bytecode::kIllegal if there is none.
+  // See bytecode-superinstructions.h.
+  static Bytecode GetSuperinstructionSuffix(Bytecode bytecode,
+                                            OperandScale operand_scale);
+
+  // Returns true if the handler for |bytecode| can be inlined into another
+  // handler. The inlined handler may call out, and ends in its own dispatch,
+  // jump or return.
+  static bool IsSuperinstructionSuffix(Bytecode bytecode);
+
   // Returns the number of registers represented by a register operand. For
   // instance, a RegPair represents two registers.
   static int GetNumberOfRegistersRepresentedBy(OperandType operand_type);
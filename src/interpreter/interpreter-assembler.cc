@@ -36,6 +36,7 @@ InterpreterAssembler::InterpreterAssembler(Isolate* isolate, Zone* zone,
       accumulator_(this, MachineRepresentation::kTagged),
       accumulator_use_(AccumulatorUse::kNone),
       made_call_(false),
+      superinstruction_suffix_(Bytecode::kIllegal),
       disable_stack_check_across_call_(false),
       stack_pointer_before_call_(nullptr) {
   accumulator_.Bind(Parameter(InterpreterDispatchDescriptor::kAccumulator));
@@ -752,12 +753,65 @@ void InterpreterAssembler::InlineStar() {
   accumulator_use_ = previous_acc_use;
 }
 
+void InterpreterAssembler::SetSuperinstructionSuffix(
+    Bytecode suffix, const HandlerGenerator& generator) {
+  DCHECK(Bytecodes::IsSuperinstructionSuffix(suffix));
+  DCHECK(!Bytecodes::IsStarLookahead(bytecode_, operand_scale_));
+  DCHECK_EQ(OperandScale::kSingle, operand_scale_);
+  superinstruction_suffix_ = suffix;
+  superinstruction_generator_ = generator;
+}
+
+Node* InterpreterAssembler::SuperinstructionDispatchLookahead(
+    Node* target_bytecode) {
+  Label do_inline_suffix(this), done(this);
+
+  Node* suffix_bytecode =
+      IntPtrConstant(static_cast<int>(superinstruction_suffix_));
+  Node* is_suffix = WordEqual(target_bytecode, suffix_bytecode);
+  BranchIf(is_suffix, &do_inline_suffix, &done);
+
+  Bind(&do_inline_suffix);
+  {
+    // The inlined dispatch still counts as a dispatch to the suffix.
+    if (FLAG_trace_ignition_dispatches) {
+      TraceBytecodeDispatch(target_bytecode);
+    }
+
+    Bytecode previous_bytecode = bytecode_;
+    Bytecode previous_suffix = superinstruction_suffix_;
+    AccumulatorUse previous_acc_use = accumulator_use_;
+    bool previous_made_call = made_call_;
+
+    bytecode_ = superinstruction_suffix_;
+    superinstruction_suffix_ = Bytecode::kIllegal;
+    accumulator_use_ = AccumulatorUse::kNone;
+
+    if (FLAG_trace_ignition) {
+      TraceBytecode(Runtime::kInterpreterTraceBytecodeEntry);
+    }
+    // The inlined handler ends the way it would on its own, in a dispatch,
+    // a jump or a return, so control does not come back here.
+    superinstruction_generator_(this);
+
+    DCHECK_EQ(accumulator_use_, Bytecodes::GetAccumulatorUse(bytecode_));
+    bytecode_ = previous_bytecode;
+    superinstruction_suffix_ = previous_suffix;
+    accumulator_use_ = previous_acc_use;
+    made_call_ = previous_made_call;
+  }
+  Bind(&done);
+  return target_bytecode;
+}
+
 Node* InterpreterAssembler::Dispatch() {
   Node* target_offset = Advance();
   Node* target_bytecode = LoadBytecode(target_offset);
 
   if (Bytecodes::IsStarLookahead(bytecode_, operand_scale_)) {
     target_bytecode = StarDispatchLookahead(target_bytecode);
+  } else if (superinstruction_suffix_ != Bytecode::kIllegal) {
+    target_bytecode = SuperinstructionDispatchLookahead(target_bytecode);
   }
   return DispatchToBytecode(target_bytecode, BytecodeOffset());
 }
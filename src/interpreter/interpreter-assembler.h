@@ -5,6 +5,8 @@
 #ifndef V8_INTERPRETER_INTERPRETER_ASSEMBLER_H_
 #define V8_INTERPRETER_INTERPRETER_ASSEMBLER_H_
 
+#include <functional>
+
 #include "src/allocation.h"
 #include "src/builtins/builtins.h"
 #include "src/code-stub-assembler.h"
@@ -151,6 +153,14 @@ class InterpreterAssembler : public CodeStubAssembler {
   // Dispatch to the bytecode.
   compiler::Node* Dispatch();
 
+  typedef std::function<void(InterpreterAssembler* assembler)>
+      HandlerGenerator;
+
+  // Makes Dispatch() look ahead for |suffix| and run the handler built by
+  // |generator| inline when it comes next, see bytecode-superinstructions.h.
+  void SetSuperinstructionSuffix(Bytecode suffix,
+                                 const HandlerGenerator& generator);
+
   // Dispatch to bytecode handler.
   compiler::Node* DispatchToBytecodeHandler(compiler::Node* handler) {
     return DispatchToBytecodeHandler(handler, BytecodeOffset());
@@ -253,6 +263,11 @@ class InterpreterAssembler : public CodeStubAssembler {
   // next dispatch offset.
   void InlineStar();
 
+  // Look ahead for the superinstruction suffix and inline its handler in a
+  // branch that does not return. Returns the target bytecode for dispatch.
+  compiler::Node* SuperinstructionDispatchLookahead(
+      compiler::Node* target_bytecode);
+
   // Dispatch to |target_bytecode| at |new_bytecode_offset|.
   // |target_bytecode| should be equivalent to loading from the offset.
   compiler::Node* DispatchToBytecode(compiler::Node* target_bytecode,
@@ -276,6 +291,9 @@ class InterpreterAssembler : public CodeStubAssembler {
   AccumulatorUse accumulator_use_;
   bool made_call_;
 
+  Bytecode superinstruction_suffix_;
+  HandlerGenerator superinstruction_generator_;
+
   bool disable_stack_check_across_call_;
   compiler::Node* stack_pointer_before_call_;
 
@@ -60,6 +60,7 @@ void Interpreter::Initialize() {
     if (Bytecodes::BytecodeHasHandler(Bytecode::k##Name, operand_scale)) {     \
       InterpreterAssembler assembler(isolate_, &zone, Bytecode::k##Name,       \
                                      operand_scale);                           \
+      SetUpSuperinstruction(&assembler, Bytecode::k##Name, operand_scale);     \
       Do##Name(&assembler);                                                    \
       Handle<Code> code = assembler.GenerateCode();                            \
       size_t index = GetDispatchTableIndex(Bytecode::k##Name, operand_scale);  \
@@ -87,6 +88,30 @@ void Interpreter::Initialize() {
   }
 }
 
+void Interpreter::SetUpSuperinstruction(InterpreterAssembler* assembler,
+                                        Bytecode bytecode,
+                                        OperandScale operand_scale) {
+  Bytecode suffix =
+      Bytecodes::GetSuperinstructionSuffix(bytecode, operand_scale);
+  if (suffix == Bytecode::kIllegal) return;
+  assembler->SetSuperinstructionSuffix(
+      suffix, [this, suffix](InterpreterAssembler* inlined_assembler) {
+        GenerateHandler(suffix, inlined_assembler);
+      });
+}
+
+void Interpreter::GenerateHandler(Bytecode bytecode,
+                                  InterpreterAssembler* assembler) {
+  switch (bytecode) {
+#define CASE(Name, ...)   \
+  case Bytecode::k##Name: \
+    Do##Name(assembler);  \
+    break;
+    BYTECODE_LIST(CASE)
+#undef CASE
+  }
+}
+
 Code* Interpreter::GetBytecodeHandler(Bytecode bytecode,
                                       OperandScale operand_scale) {
   DCHECK(IsDispatchTableInitialized());
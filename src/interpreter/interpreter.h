@@ -75,6 +75,14 @@ class Interpreter {
   BYTECODE_LIST(DECLARE_BYTECODE_HANDLER_GENERATOR)
 #undef DECLARE_BYTECODE_HANDLER_GENERATOR
 
+  // Sets up |assembler| to inline the handler for the superinstruction
+  // suffix of |bytecode|, if any.
+  void SetUpSuperinstruction(InterpreterAssembler* assembler, Bytecode bytecode,
+                             OperandScale operand_scale);
+
+  // Generates the handler for |bytecode| into |assembler|.
+  void GenerateHandler(Bytecode bytecode, InterpreterAssembler* assembler);
+
   // Generates code to perform the binary operation via |Generator|.
   template <class Generator>
   void DoBinaryOp(InterpreterAssembler* assembler);
@@ -43,6 +43,12 @@ class PeepholeActionTableWriter final {
   void BuildTable();
   void Write(std::ostream& os);
 
+  // Writes the bytecode pairs that have a rewrite action as JSON, keyed by
+  // the names of the first and second bytecode. Used by
+  // tools/ignition/superinstruction_candidates.py to tell which of the hot
+  // dispatch pairs of a profile are already handled by the peephole table.
+  void WriteRewrittenPairs(std::ostream& os);
+
  private:
   static const char* kIndent;
   static const char* kNamespaceElements[];
@@ -56,7 +62,9 @@ class PeepholeActionTableWriter final {
   void WriteOpenNamespace(std::ostream& os);
   void WriteCloseNamespace(std::ostream& os);
 
-  PeepholeActionAndData LookupActionAndData(Bytecode last, Bytecode current);
+  static PeepholeActionAndData LookupActionAndData(Bytecode last,
+                                                   Bytecode current);
+  static bool IsRewriteAction(PeepholeAction action);
   void BuildRow(Bytecode last, Row* row);
   size_t HashRow(const Row* row);
   void InsertRow(size_t row_index, const Row* const row, size_t row_hash,
@@ -242,6 +250,44 @@ PeepholeActionAndData PeepholeActionTableWriter::LookupActionAndData(
   }
 }
 
+// static
+bool PeepholeActionTableWriter::IsRewriteAction(PeepholeAction action) {
+  switch (action) {
+    case PeepholeAction::kDefaultAction:
+    case PeepholeAction::kDefaultJumpAction:
+    case PeepholeAction::kUpdateLastAction:
+    case PeepholeAction::kUpdateLastJumpAction:
+    case PeepholeAction::kUpdateLastIfSourceInfoPresentAction:
+      return false;
+    default:
+      return true;
+  }
+}
+
+void PeepholeActionTableWriter::WriteRewrittenPairs(std::ostream& os) {
+  os << "{\n";
+  bool first_row = true;
+  for (size_t i = 0; i < kNumberOfBytecodes; ++i) {
+    Bytecode last = Bytecodes::FromByte(static_cast<uint8_t>(i));
+    bool first_entry = true;
+    for (size_t j = 0; j < kNumberOfBytecodes; ++j) {
+      Bytecode current = Bytecodes::FromByte(static_cast<uint8_t>(j));
+      PeepholeActionAndData action_data = LookupActionAndData(last, current);
+      if (!IsRewriteAction(action_data.action)) continue;
+      if (first_entry) {
+        os << (first_row ? "" : ",\n") << kIndent << "\""
+           << Bytecodes::ToString(last) << "\": {";
+        first_row = false;
+      }
+      os << (first_entry ? "" : ", ") << "\"" << Bytecodes::ToString(current)
+         << "\": \"" << ActionName(action_data.action) << "\"";
+      first_entry = false;
+    }
+    if (!first_entry) os << "}";
+  }
+  os << "\n}\n";
+}
+
 void PeepholeActionTableWriter::Write(std::ostream& os) {
   WriteHeader(os);
   WriteIncludeFiles(os);
@@ -374,8 +420,9 @@ size_t PeepholeActionTableWriter::HashRow(const Row* row) {
 }  // namespace internal
 }  // namespace v8
 
+// Usage: mkpeephole <table.cc> [<rewritten-pairs.json>]
 int main(int argc, const char* argv[]) {
-  CHECK_EQ(argc, 2);
+  CHECK(argc == 2 || argc == 3);
 
   std::ofstream ofs(argv[1], std::ofstream::trunc);
   v8::internal::interpreter::PeepholeActionTableWriter writer;
@@ -384,5 +431,12 @@ int main(int argc, const char* argv[]) {
   ofs.flush();
   ofs.close();
 
+  if (argc == 3) {
+    std::ofstream json(argv[2], std::ofstream::trunc);
+    writer.WriteRewrittenPairs(json);
+    json.flush();
+    json.close();
+  }
+
   return 0;
 }
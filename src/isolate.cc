@@ -36,6 +36,7 @@
 #include "src/runtime-profiler.h"
 #include "src/simulator.h"
 #include "src/snapshot/deserializer.h"
+#include "src/type-feedback-profile.h"
 #include "src/v8.h"
 #include "src/version.h"
 #include "src/vm-state-inl.h"
@@ -1981,6 +1982,7 @@ Isolate::Isolate(bool enable_serializer)
       is_running_microtasks_(false),
       use_counter_callback_(NULL),
       basic_block_profiler_(NULL),
+      type_feedback_profile_(NULL),
       cancelable_task_manager_(new CancelableTaskManager()),
       abort_on_uncaught_exception_callback_(NULL) {
   {
@@ -2089,6 +2091,11 @@ void Isolate::Deinit() {
     PrintF(stdout, "=== Stress deopt counter: %u\n", stress_deopt_count_);
   }
 
+  if (FLAG_trace_deopt_sites) {
+    OFStream os(stdout);
+    deoptimizer_data_->site_stats()->Print(os, 20);
+  }
+
   if (cpu_profiler_) {
     cpu_profiler_->DeleteAllProfiles();
   }
@@ -2110,6 +2117,9 @@ void Isolate::Deinit() {
   delete basic_block_profiler_;
   basic_block_profiler_ = NULL;
 
+  delete type_feedback_profile_;
+  type_feedback_profile_ = NULL;
+
   delete heap_profiler_;
   heap_profiler_ = NULL;
 
@@ -3060,6 +3070,12 @@ BasicBlockProfiler* Isolate::GetOrCreateBasicBlockProfiler() {
 }
 
 
+void Isolate::SetTypeFeedbackProfile(TypeFeedbackProfile* profile) {
+  delete type_feedback_profile_;
+  type_feedback_profile_ = profile;
+}
+
+
 std::string Isolate::GetTurboCfgFileName() {
   if (FLAG_trace_turbo_cfg_file == NULL) {
     std::ostringstream os;
@@ -78,6 +78,7 @@ class SweeperThread;
 class ThreadManager;
 class ThreadState;
 class ThreadVisitor;  // Defined in v8threads.h
+class TypeFeedbackProfile;
 class UnicodeCache;
 template <StateTag Tag> class VMState;
 
@@ -1112,6 +1113,12 @@ class Isolate {
   BasicBlockProfiler* GetOrCreateBasicBlockProfiler();
   BasicBlockProfiler* basic_block_profiler() { return basic_block_profiler_; }
 
+  // Takes ownership of |profile|, replacing any previously installed one.
+  void SetTypeFeedbackProfile(TypeFeedbackProfile* profile);
+  TypeFeedbackProfile* type_feedback_profile() {
+    return type_feedback_profile_;
+  }
+
   std::string GetTurboCfgFileName();
 
 #if TRACE_MAPS
@@ -1414,6 +1421,7 @@ class Isolate {
 
   v8::Isolate::UseCounterCallback use_counter_callback_;
   BasicBlockProfiler* basic_block_profiler_;
+  TypeFeedbackProfile* type_feedback_profile_;
 
   List<Object*> partial_snapshot_cache_;
 
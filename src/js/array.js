@@ -1021,6 +1021,7 @@ function InnerArrayFilter(f, receiver, array, length, result) {
   }
   return result;
 }
+%SetForceInlineFlag(InnerArrayFilter);
 
 
 
@@ -1035,6 +1036,7 @@ function ArrayFilter(f, receiver) {
   var result = ArraySpeciesCreate(array, 0);
   return InnerArrayFilter(f, receiver, array, length, result);
 }
+%SetForceInlineFlag(ArrayFilter);
 
 
 function InnerArrayForEach(f, receiver, array, length) {
@@ -1056,6 +1058,7 @@ function InnerArrayForEach(f, receiver, array, length) {
     }
   }
 }
+%SetForceInlineFlag(InnerArrayForEach);
 
 
 function ArrayForEach(f, receiver) {
@@ -1067,6 +1070,7 @@ function ArrayForEach(f, receiver) {
   var length = TO_LENGTH(array.length);
   InnerArrayForEach(f, receiver, array, length);
 }
+%SetForceInlineFlag(ArrayForEach);
 
 
 function InnerArraySome(f, receiver, array, length) {
@@ -1080,6 +1084,7 @@ function InnerArraySome(f, receiver, array, length) {
   }
   return false;
 }
+%SetForceInlineFlag(InnerArraySome);
 
 
 // Executes the function once for each element present in the
@@ -1093,6 +1098,7 @@ function ArraySome(f, receiver) {
   var length = TO_LENGTH(array.length);
   return InnerArraySome(f, receiver, array, length);
 }
+%SetForceInlineFlag(ArraySome);
 
 
 function InnerArrayEvery(f, receiver, array, length) {
@@ -1106,6 +1112,7 @@ function InnerArrayEvery(f, receiver, array, length) {
   }
   return true;
 }
+%SetForceInlineFlag(InnerArrayEvery);
 
 function ArrayEvery(f, receiver) {
   CHECK_OBJECT_COERCIBLE(this, "Array.prototype.every");
@@ -1116,6 +1123,19 @@ function ArrayEvery(f, receiver) {
   var length = TO_LENGTH(array.length);
   return InnerArrayEvery(f, receiver, array, length);
 }
+%SetForceInlineFlag(ArrayEvery);
+
+
+function InnerArrayMap(f, receiver, array, length, result) {
+  for (var i = 0; i < length; i++) {
+    if (i in array) {
+      var element = array[i];
+      %CreateDataProperty(result, i, %_Call(f, receiver, element, i, array));
+    }
+  }
+  return result;
+}
+%SetForceInlineFlag(InnerArrayMap);
 
 
 function ArrayMap(f, receiver) {
@@ -1127,14 +1147,9 @@ function ArrayMap(f, receiver) {
   var length = TO_LENGTH(array.length);
   if (!IS_CALLABLE(f)) throw MakeTypeError(kCalledNonCallable, f);
   var result = ArraySpeciesCreate(array, length);
-  for (var i = 0; i < length; i++) {
-    if (i in array) {
-      var element = array[i];
-      %CreateDataProperty(result, i, %_Call(f, receiver, element, i, array));
-    }
-  }
-  return result;
+  return InnerArrayMap(f, receiver, array, length, result);
 }
+%SetForceInlineFlag(ArrayMap);
 
 
 // For .indexOf, we don't need to pass in the number of arguments
@@ -1286,6 +1301,7 @@ function InnerArrayReduce(callback, current, array, length, argumentsLength) {
   }
   return current;
 }
+%SetForceInlineFlag(InnerArrayReduce);
 
 
 function ArrayReduce(callback, current) {
@@ -1298,6 +1314,7 @@ function ArrayReduce(callback, current) {
   return InnerArrayReduce(callback, current, array, length,
                           arguments.length);
 }
+%SetForceInlineFlag(ArrayReduce);
 
 
 function InnerArrayReduceRight(callback, current, array, length,
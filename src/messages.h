@@ -534,7 +534,8 @@ class CallSiteUtils : public AllStatic {
   T(WasmTrapFuncInvalid, "invalid function")                                   \
   T(WasmTrapFuncSigMismatch, "function signature mismatch")                    \
   T(WasmTrapMemAllocationFail, "failed to allocate memory")                    \
-  T(WasmTrapInvalidIndex, "invalid index into function table")
+  T(WasmTrapInvalidIndex, "invalid index into function table")                 \
+  T(WasmTrapUnalignedAccess, "unaligned memory access")
 
 class MessageTemplate {
  public:
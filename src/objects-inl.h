@@ -3492,6 +3492,15 @@ void HandlerTable::SetRangeData(int index, int value) {
 }
 
 
+int HandlerTable::GetReturnOffset(int index) const {
+  return Smi::cast(get(index * kReturnEntrySize + kReturnOffsetIndex))->value();
+}
+
+int HandlerTable::GetReturnHandler(int index) const {
+  return HandlerOffsetField::decode(
+      Smi::cast(get(index * kReturnEntrySize + kReturnHandlerIndex))->value());
+}
+
 void HandlerTable::SetReturnOffset(int index, int value) {
   set(index * kReturnEntrySize + kReturnOffsetIndex, Smi::FromInt(value));
 }
@@ -3508,6 +3517,10 @@ int HandlerTable::NumberOfRangeEntries() const {
   return length() / kRangeEntrySize;
 }
 
+int HandlerTable::NumberOfReturnEntries() const {
+  return length() / kReturnEntrySize;
+}
+
 #define MAKE_STRUCT_CAST(NAME, Name, name) CAST_ACCESSOR(Name)
   STRUCT_LIST(MAKE_STRUCT_CAST)
 #undef MAKE_STRUCT_CAST
@@ -6831,6 +6844,16 @@ void JSArrayBuffer::set_is_shared(bool value) {
 }
 
 
+bool JSArrayBuffer::has_guard_region() {
+  return HasGuardRegion::decode(bit_field());
+}
+
+
+void JSArrayBuffer::set_has_guard_region(bool value) {
+  set_bit_field(HasGuardRegion::update(bit_field(), value));
+}
+
+
 Object* JSArrayBufferView::byte_offset() const {
   if (WasNeutered()) return Smi::FromInt(0);
   return Object::cast(READ_FIELD(this, kByteOffsetOffset));
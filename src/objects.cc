@@ -57,6 +57,7 @@
 #include "src/string-builder.h"
 #include "src/string-search.h"
 #include "src/string-stream.h"
+#include "src/type-feedback-profile.h"
 #include "src/utils.h"
 #include "src/zone.h"
 
@@ -11660,6 +11661,10 @@ Handle<LiteralsArray> SharedFunctionInfo::FindOrCreateLiterals(
 
   Handle<TypeFeedbackVector> feedback_vector =
       TypeFeedbackVector::New(isolate, handle(shared->feedback_metadata()));
+  if (isolate->type_feedback_profile() != nullptr) {
+    isolate->type_feedback_profile()->Apply(shared, feedback_vector,
+                                               native_context);
+  }
   Handle<LiteralsArray> literals =
       LiteralsArray::New(isolate, feedback_vector, shared->num_literals());
   Handle<Code> code;
@@ -14149,6 +14154,12 @@ void DeoptimizationInputData::DeoptimizationInputDataPrint(
           break;
         }
 
+        case Translation::SIMD128_STACK_SLOT: {
+          int input_slot_index = iterator.Next();
+          os << "{input=" << input_slot_index << " (simd128)}";
+          break;
+        }
+
         case Translation::LITERAL: {
           int literal_index = iterator.Next();
           Object* literal_value = LiteralArray()->get(literal_index);
@@ -4913,6 +4913,10 @@ class HandlerTable : public FixedArray {
   inline void SetRangeHandler(int index, int offset, CatchPrediction pred);
   inline void SetRangeData(int index, int value);
 
+  // Getters for handler table based on return addresses.
+  inline int GetReturnOffset(int index) const;
+  inline int GetReturnHandler(int index) const;
+
   // Setters for handler table based on return addresses.
   inline void SetReturnOffset(int index, int value);
   inline void SetReturnHandler(int index, int offset, CatchPrediction pred);
@@ -4928,6 +4932,7 @@ class HandlerTable : public FixedArray {
 
   // Returns the number of entries in the table.
   inline int NumberOfRangeEntries() const;
+  inline int NumberOfReturnEntries() const;
 
   // Returns the required length of the underlying fixed array.
   static int LengthForRange(int entries) { return entries * kRangeEntrySize; }
@@ -6826,12 +6831,23 @@ class Script: public Struct {
   V(Atomics, load, AtomicsLoad)          \
   V(Atomics, store, AtomicsStore)
 
+#define SIMD_FUNCTIONS_WITH_ID_LIST(V)                 \
+  V(SIMD.Float32x4, add, Float32x4Add)                 \
+  V(SIMD.Float32x4, sub, Float32x4Sub)                 \
+  V(SIMD.Float32x4, mul, Float32x4Mul)                 \
+  V(SIMD.Float32x4, div, Float32x4Div)                 \
+  V(SIMD.Float32x4, extractLane, Float32x4ExtractLane) \
+  V(SIMD.Int32x4, add, Int32x4Add)                     \
+  V(SIMD.Int32x4, sub, Int32x4Sub)                     \
+  V(SIMD.Int32x4, extractLane, Int32x4ExtractLane)
+
 enum BuiltinFunctionId {
   kArrayCode,
 #define DECLARE_FUNCTION_ID(ignored1, ignore2, name)    \
   k##name,
   FUNCTIONS_WITH_ID_LIST(DECLARE_FUNCTION_ID)
       ATOMIC_FUNCTIONS_WITH_ID_LIST(DECLARE_FUNCTION_ID)
+          SIMD_FUNCTIONS_WITH_ID_LIST(DECLARE_FUNCTION_ID)
 #undef DECLARE_FUNCTION_ID
   // Fake id for a special case of Math.pow. Note, it continues the
   // list of math functions.
@@ -10212,6 +10228,11 @@ class JSArrayBuffer: public JSObject {
   inline bool is_shared();
   inline void set_is_shared(bool value);
 
+  // Whether the backing store is a wasm memory reservation with a trailing
+  // guard region, which has to be released instead of freed.
+  inline bool has_guard_region();
+  inline void set_has_guard_region(bool value);
+
   DECLARE_CAST(JSArrayBuffer)
 
   void Neuter();
@@ -10250,6 +10271,7 @@ class JSArrayBuffer: public JSObject {
   class IsNeuterable : public BitField<bool, 2, 1> {};
   class WasNeutered : public BitField<bool, 3, 1> {};
   class IsShared : public BitField<bool, 4, 1> {};
+  class HasGuardRegion : public BitField<bool, 5, 1> {};
 
  private:
   DISALLOW_IMPLICIT_CONSTRUCTORS(JSArrayBuffer);
@@ -22,9 +22,6 @@ namespace internal {
 // Number of times a function has to be seen on the stack before it is
 // compiled for baseline.
 static const int kProfilerTicksBeforeBaseline = 1;
-// Number of times a function has to be seen on the stack before it is
-// optimized.
-static const int kProfilerTicksBeforeOptimization = 2;
 // If the function optimization was disabled due to high deoptimization count,
 // but the function is hot and has been seen on the stack this number of times,
 // then we try to reenable optimization for this function.
@@ -34,7 +31,7 @@ static const int kProfilerTicksBeforeReenablingOptimization = 250;
 // optimize it as it is.
 static const int kTicksWhenNotEnoughTypeInfo = 100;
 // We only have one byte to store the number of ticks.
-STATIC_ASSERT(kProfilerTicksBeforeOptimization < 256);
+STATIC_ASSERT(RuntimeProfiler::kProfilerTicksBeforeOptimization < 256);
 STATIC_ASSERT(kProfilerTicksBeforeReenablingOptimization < 256);
 STATIC_ASSERT(kTicksWhenNotEnoughTypeInfo < 256);
 
@@ -79,10 +76,13 @@ static void GetICCounts(JSFunction* function, int* ic_with_type_info_count,
 
   // Harvest vector-ics as well
   TypeFeedbackVector* vector = function->feedback_vector();
-  int with = 0, gen = 0;
-  vector->ComputeCounts(&with, &gen);
+  int with = 0, gen = 0, total = 0;
+  vector->ComputeCounts(&with, &gen, &total);
   *ic_with_type_info_count += with;
   *ic_generic_count += gen;
+  // The type feedback info of full-codegen code already counts its vector
+  // ICs, but interpreted functions only have the vector.
+  if (function->code()->kind() != Code::FUNCTION) *ic_total_count += total;
 
   if (*ic_total_count > 0) {
     *type_info_percentage = 100 * *ic_with_type_info_count / *ic_total_count;
@@ -112,6 +112,26 @@ static void TraceRecompile(JSFunction* function, const char* reason,
   }
 }
 
+static void TraceIgnitionTierUp(JSFunction* function, int ticks,
+                                int ticks_for_optimization, int bytecode_size,
+                                const char* reason) {
+  if (!function->shared()->PassesFilter(FLAG_hydrogen_filter)) return;
+  int typeinfo, generic, total, type_percentage, generic_percentage;
+  GetICCounts(function, &typeinfo, &generic, &total, &type_percentage,
+              &generic_percentage);
+  PrintF("[ignition tier-up ");
+  function->ShortPrint();
+  PrintF(": ticks %d/%d, bytecode size %d", ticks, ticks_for_optimization,
+         bytecode_size);
+  PrintF(", ICs with typeinfo: %d/%d (%d%%)", typeinfo, total, type_percentage);
+  PrintF(", generic ICs: %d/%d (%d%%)", generic, total, generic_percentage);
+  if (reason != nullptr) {
+    PrintF(" -> optimize, reason: %s]\n", reason);
+  } else {
+    PrintF(" -> wait]\n");
+  }
+}
+
 void RuntimeProfiler::Optimize(JSFunction* function, const char* reason) {
   TraceRecompile(function, reason, "optimized");
   function->AttemptConcurrentOptimization();
@@ -142,6 +162,10 @@ void RuntimeProfiler::AttemptOnStackReplacement(JSFunction* function,
   // arguments accesses, which is unsound.  Don't try OSR.
   if (shared->uses_arguments()) return;
 
+  // OSR from bytecode needs TurboFan to build its graph from bytecode, so
+  // don't arm back edges whose OSR compile is bound to fail.
+  if (shared->HasBytecodeArray() && !FLAG_turbo_from_bytecode) return;
+
   // We're using on-stack replacement: modify unoptimized code so that
   // certain back edges in any unoptimized frame will trigger on-stack
   // replacement for that frame.
@@ -345,28 +369,61 @@ void RuntimeProfiler::MaybeOptimizeIgnition(JSFunction* function) {
   }
   if (function->IsOptimized()) return;
 
-  if (ticks >= kProfilerTicksBeforeOptimization) {
-    int typeinfo, generic, total, type_percentage, generic_percentage;
-    GetICCounts(function, &typeinfo, &generic, &total, &type_percentage,
-                &generic_percentage);
-    if (type_percentage >= FLAG_type_info_threshold &&
-        generic_percentage <= FLAG_generic_ic_threshold) {
-      // If this particular function hasn't had any ICs patched for enough
-      // ticks, optimize it now.
-      Optimize(function, "hot and stable");
-    } else if (ticks >= kTicksWhenNotEnoughTypeInfo) {
-      Optimize(function, "not much type info but very hot");
-    } else {
-      if (FLAG_trace_opt_verbose) {
-        PrintF("[not yet optimizing ");
-        function->PrintName();
-        PrintF(", not enough type info: %d/%d (%d%%)]\n", typeinfo, total,
-               type_percentage);
-      }
+  const char* reason = IgnitionTierUpDecision(function, ticks, any_ic_changed_);
+  if (FLAG_trace_ignition_tierup) {
+    int bytecode_size = shared->bytecode_array()->length();
+    TraceIgnitionTierUp(function, ticks,
+                        IgnitionTicksForOptimization(bytecode_size),
+                        bytecode_size, reason);
+  }
+  if (reason != nullptr) Optimize(function, reason);
+}
+
+// static
+int RuntimeProfiler::IgnitionTicksForOptimization(int bytecode_size) {
+  // Larger functions are seen on the stack more often per invocation and are
+  // more expensive to optimize, so they need to accumulate more ticks.
+  int ticks_for_optimization = FLAG_ignition_tierup_ticks;
+  if (FLAG_ignition_tierup_bytes_per_tick > 0) {
+    ticks_for_optimization +=
+        bytecode_size / FLAG_ignition_tierup_bytes_per_tick;
+  }
+  return Min(ticks_for_optimization, FLAG_ignition_tierup_max_ticks);
+}
+
+// static
+const char* RuntimeProfiler::IgnitionTierUpDecision(JSFunction* function,
+                                                    int ticks,
+                                                    bool any_ic_changed) {
+  // The ticks are reset whenever an IC of the function changes state, see
+  // IC::OnTypeFeedbackChanged, so they measure how long the feedback has
+  // been stable.
+  int bytecode_size = function->shared()->bytecode_array()->length();
+  int typeinfo, generic, total, type_percentage, generic_percentage;
+  GetICCounts(function, &typeinfo, &generic, &total, &type_percentage,
+              &generic_percentage);
+  bool stable = type_percentage >= FLAG_type_info_threshold &&
+                generic_percentage <= FLAG_generic_ic_threshold;
+
+  if (ticks >= IgnitionTicksForOptimization(bytecode_size)) {
+    // If this particular function hasn't had any ICs patched for enough
+    // ticks, optimize it now.
+    if (stable) return "hot and stable";
+    if (ticks >= FLAG_ignition_tierup_max_ticks) {
+      return "not much type info but very hot";
     }
+    if (FLAG_trace_opt_verbose) {
+      PrintF("[not yet optimizing ");
+      function->PrintName();
+      PrintF(", not enough type info: %d/%d (%d%%)]\n", typeinfo, total,
+             type_percentage);
+    }
+  } else if (!any_ic_changed && bytecode_size <= FLAG_ignition_early_opt_size) {
+    // If no IC was patched since the last tick and this function is very
+    // small, optimistically optimize it now.
+    if (stable) return "small function";
   }
-  // TODO(rmcilroy): Consider whether we should optimize small functions when
-  // they are first seen on the stack (e.g., kMaxSizeEarlyOpt).
+  return nullptr;
 }
 
 void RuntimeProfiler::MarkCandidatesForOptimization() {
@@ -15,6 +15,10 @@ class JSFunction;
 
 class RuntimeProfiler {
  public:
+  // Number of times a function has to be seen on the stack before it is
+  // optimized.
+  static const int kProfilerTicksBeforeOptimization = 2;
+
   explicit RuntimeProfiler(Isolate* isolate);
 
   void MarkCandidatesForOptimization();
@@ -23,6 +27,14 @@ class RuntimeProfiler {
 
   void AttemptOnStackReplacement(JSFunction* function, int nesting_levels = 1);
 
+  // Returns the reason for optimizing the interpreted {function} after it has
+  // been seen on the stack for {ticks} ticks, or nullptr if it should stay in
+  // the interpreter. {any_ic_changed} tells whether any IC changed state
+  // since the last tick. Has no side effects, so tests can query the policy
+  // without depending on when the profiler ticks.
+  static const char* IgnitionTierUpDecision(JSFunction* function, int ticks,
+                                            bool any_ic_changed);
+
  private:
   void MaybeOptimizeFullCodegen(JSFunction* function, int frame_count,
                                 bool frame_optimized);
@@ -31,6 +43,8 @@ class RuntimeProfiler {
   void Optimize(JSFunction* function, const char* reason);
   void Baseline(JSFunction* function, const char* reason);
 
+  static int IgnitionTicksForOptimization(int bytecode_size);
+
   bool CodeSizeOKForOSR(Code* shared_code);
 
   Isolate* isolate_;
@@ -154,6 +154,13 @@ RUNTIME_FUNCTION(Runtime_NotifyDeoptimized) {
   DCHECK(optimized_code->kind() == Code::OPTIMIZED_FUNCTION);
   DCHECK(type == deoptimizer->bailout_type());
 
+  DeoptimizeReason deopt_reason = DeoptimizeReason::kNoReason;
+  if (FLAG_track_deopt_sites) {
+    deopt_reason =
+        Deoptimizer::GetDeoptInfo(*optimized_code, deoptimizer->from())
+            .deopt_reason;
+  }
+
   // Make sure to materialize objects before causing any allocation.
   JavaScriptFrameIterator it(isolate);
   deoptimizer->MaterializeHeapObjects(&it);
@@ -168,6 +175,11 @@ RUNTIME_FUNCTION(Runtime_NotifyDeoptimized) {
     return isolate->heap()->undefined_value();
   }
 
+  if (FLAG_track_deopt_sites) {
+    Deoptimizer::RecordDeoptimizationSite(isolate, *function, top_frame, type,
+                                          deopt_reason);
+  }
+
   // Search for other activations of the same optimized code.
   // At this point {it} is at the topmost frame of all the frames materialized
   // by the deoptimizer. Note that this frame does not necessarily represent
@@ -11,7 +11,9 @@
 #include "src/frames-inl.h"
 #include "src/full-codegen/full-codegen.h"
 #include "src/isolate-inl.h"
+#include "src/snapshot/code-serializer.h"
 #include "src/snapshot/natives.h"
+#include "src/wasm/wasm-module.h"
 
 namespace v8 {
 namespace internal {
@@ -255,6 +257,24 @@ RUNTIME_FUNCTION(Runtime_GetOptimizationCount) {
 }
 
 
+// Returns the reason the runtime profiler gives for optimizing the
+// interpreted function after {ticks} ticks on the stack without any IC
+// changes in between, or undefined if the function stays in the interpreter.
+RUNTIME_FUNCTION(Runtime_GetIgnitionTierUpDecision) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 2);
+  CONVERT_ARG_HANDLE_CHECKED(JSFunction, function, 0);
+  CONVERT_SMI_ARG_CHECKED(ticks, 1);
+  if (!function->shared()->HasBytecodeArray()) {
+    return isolate->heap()->undefined_value();
+  }
+  const char* reason =
+      RuntimeProfiler::IgnitionTierUpDecision(*function, ticks, false);
+  if (reason == nullptr) return isolate->heap()->undefined_value();
+  return *isolate->factory()->NewStringFromAsciiChecked(reason);
+}
+
+
 RUNTIME_FUNCTION(Runtime_GetUndetectable) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 0);
@@ -578,6 +598,83 @@ RUNTIME_FUNCTION(Runtime_SpeciesProtector) {
   return isolate->heap()->ToBoolean(isolate->IsArraySpeciesLookupChainIntact());
 }
 
+// Take a compiled wasm module and serialize it into an array buffer, which is
+// then returned.
+RUNTIME_FUNCTION(Runtime_SerializeWasmModule) {
+  HandleScope shs(isolate);
+  DCHECK(args.length() == 1);
+  CONVERT_ARG_HANDLE_CHECKED(JSObject, module_obj, 0);
+
+  CHECK(module_obj->GetInternalFieldCount() >= 1 &&
+        module_obj->GetInternalField(0)->IsFixedArray());
+  Handle<FixedArray> compiled_module(
+      FixedArray::cast(module_obj->GetInternalField(0)), isolate);
+  std::unique_ptr<ScriptData> data(
+      WasmCompiledModuleSerializer::SerializeWasmModule(isolate,
+                                                        compiled_module));
+  Handle<JSArrayBuffer> buffer =
+      isolate->factory()->NewJSArrayBuffer(SharedFlag::kNotShared);
+  size_t byte_length = static_cast<size_t>(data->length());
+  if (!JSArrayBuffer::SetupAllocatingData(buffer, isolate, byte_length,
+                                          false)) {
+    return isolate->heap()->undefined_value();
+  }
+  memcpy(buffer->backing_store(), data->data(), byte_length);
+  return *buffer;
+}
+
+// Take an array buffer produced by %SerializeWasmModule and the bytes of the
+// module it was compiled from, and return a WebAssembly.Module object. Returns
+// undefined if the data was rejected, e.g. because it was produced by another
+// V8 version or for other CPU features.
+RUNTIME_FUNCTION(Runtime_DeserializeWasmModule) {
+  HandleScope shs(isolate);
+  DCHECK(args.length() == 2);
+  CONVERT_ARG_HANDLE_CHECKED(JSArrayBuffer, buffer, 0);
+  CONVERT_ARG_HANDLE_CHECKED(JSArrayBuffer, wire_bytes, 1);
+
+  Address mem_start = static_cast<Address>(buffer->backing_store());
+  int mem_size = static_cast<int>(buffer->byte_length()->Number());
+  Address bytes_start = static_cast<Address>(wire_bytes->backing_store());
+  int bytes_size = static_cast<int>(wire_bytes->byte_length()->Number());
+
+  Handle<String> module_bytes;
+  ASSIGN_RETURN_FAILURE_ON_EXCEPTION(
+      isolate, module_bytes,
+      isolate->factory()->NewStringFromOneByte(
+          Vector<const uint8_t>(bytes_start, bytes_size), TENURED));
+
+  // The constructor of {ScriptData} copies the data if it is not aligned.
+  ScriptData data(mem_start, mem_size);
+  Handle<FixedArray> compiled_module;
+  if (!WasmCompiledModuleSerializer::DeserializeWasmModule(isolate, &data,
+                                                           module_bytes)
+           .ToHandle(&compiled_module)) {
+    return isolate->heap()->undefined_value();
+  }
+  return *wasm::CreateModuleObject(isolate, compiled_module, wire_bytes);
+}
+
+// Returns the tier of the code that an exported wasm function calls:
+// 0 == "lazy compile stub", 1 == "baseline", 2 == "optimized". Unless the
+// second argument is "no sync", waits for a pending tier-up to be installed.
+RUNTIME_FUNCTION(Runtime_GetWasmFunctionTier) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 1 || args.length() == 2);
+  CONVERT_ARG_HANDLE_CHECKED(JSFunction, function, 0);
+  bool sync_with_compiler_thread = true;
+  if (args.length() == 2) {
+    CONVERT_ARG_HANDLE_CHECKED(String, sync, 1);
+    if (sync->IsOneByteEqualTo(STATIC_CHAR_VECTOR("no sync"))) {
+      sync_with_compiler_thread = false;
+    }
+  }
+  CHECK(function->GetInternalFieldCount() > 0 &&
+        wasm::IsWasmObject(function->GetInternalField(0)));
+  return Smi::FromInt(wasm::GetExportedFunctionTier(
+      isolate, function, sync_with_compiler_thread));
+}
+
 
 }  // namespace internal
 }  // namespace v8
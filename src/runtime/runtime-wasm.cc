@@ -11,40 +11,54 @@
 #include "src/debug/debug.h"
 #include "src/factory.h"
 #include "src/frames-inl.h"
+#include "src/futex-emulation.h"
 #include "src/objects-inl.h"
 #include "src/v8memory.h"
 #include "src/wasm/wasm-module.h"
+#include "src/wasm/wasm-trap-handler.h"
 
 namespace v8 {
 namespace internal {
 
 namespace {
 const int kWasmMemArrayBuffer = 2;
+
+// Returns the instance of the wasm code that called the runtime function.
+Handle<JSObject> GetWasmInstanceOnStackTop(Isolate* isolate) {
+  DisallowHeapAllocation no_allocation;
+  const Address entry = Isolate::c_entry_fp(isolate->thread_local_top());
+  Address pc =
+      Memory::Address_at(entry + StandardFrameConstants::kCallerPCOffset);
+  Code* code = isolate->inner_pointer_to_code_cache()->GetCacheEntry(pc)->code;
+  FixedArray* deopt_data = code->deoptimization_data();
+  DCHECK(deopt_data->length() == 2);
+  Object* module_object = deopt_data->get(0);
+  CHECK(!module_object->IsNull(isolate));
+  return handle(JSObject::cast(module_object), isolate);
+}
+
+// Returns the memory of the calling instance, which atomic operations
+// require to be shared.
+Handle<JSArrayBuffer> GetSharedWasmMemory(Isolate* isolate) {
+  Handle<JSObject> instance = GetWasmInstanceOnStackTop(isolate);
+  Handle<JSArrayBuffer> buffer(
+      JSArrayBuffer::cast(instance->GetInternalField(kWasmMemArrayBuffer)),
+      isolate);
+  CHECK(buffer->is_shared());
+  return buffer;
 }
+}  // namespace
 
 RUNTIME_FUNCTION(Runtime_WasmGrowMemory) {
   HandleScope scope(isolate);
   DCHECK_EQ(1, args.length());
   uint32_t delta_pages = 0;
   CHECK(args[0]->ToUint32(&delta_pages));
-  Handle<JSObject> module_object;
-
-  {
-    // Get the module JSObject
-    DisallowHeapAllocation no_allocation;
-    const Address entry = Isolate::c_entry_fp(isolate->thread_local_top());
-    Address pc =
-        Memory::Address_at(entry + StandardFrameConstants::kCallerPCOffset);
-    Code* code =
-        isolate->inner_pointer_to_code_cache()->GetCacheEntry(pc)->code;
-    FixedArray* deopt_data = code->deoptimization_data();
-    DCHECK(deopt_data->length() == 2);
-    module_object = Handle<JSObject>::cast(handle(deopt_data->get(0), isolate));
-    CHECK(!module_object->IsNull(isolate));
-  }
+  Handle<JSObject> module_object = GetWasmInstanceOnStackTop(isolate);
 
   Address old_mem_start, new_mem_start;
   uint32_t old_size, new_size;
+  bool has_guard_region = false;
 
   // Get mem buffer associated with module object
   Handle<Object> obj(module_object->GetInternalField(kWasmMemArrayBuffer),
@@ -76,12 +90,19 @@ RUNTIME_FUNCTION(Runtime_WasmGrowMemory) {
 #endif
   } else {
     Handle<JSArrayBuffer> old_buffer = Handle<JSArrayBuffer>::cast(obj);
+    // Other threads keep using the backing store of a shared memory, which
+    // can therefore not be moved or replaced.
+    if (old_buffer->is_shared()) {
+      THROW_NEW_ERROR_RETURN_FAILURE(
+          isolate, NewRangeError(MessageTemplate::kWasmTrapMemAllocationFail));
+    }
     old_mem_start = static_cast<Address>(old_buffer->backing_store());
     old_size = old_buffer->byte_length()->Number();
+    has_guard_region = old_buffer->has_guard_region();
     // If the old memory was zero-sized, we should have been in the
-    // "undefined" case above.
+    // "undefined" case above, unless it is followed by a guard region.
     DCHECK_NOT_NULL(old_mem_start);
-    DCHECK_NE(0, old_size);
+    DCHECK(has_guard_region || old_size != 0);
 
     new_size = old_size + delta_pages * wasm::WasmModule::kPageSize;
     if (new_size >
@@ -89,20 +110,33 @@ RUNTIME_FUNCTION(Runtime_WasmGrowMemory) {
       THROW_NEW_ERROR_RETURN_FAILURE(
           isolate, NewRangeError(MessageTemplate::kWasmTrapMemOutOfBounds));
     }
-    new_mem_start = static_cast<Address>(realloc(old_mem_start, new_size));
-    if (new_mem_start == NULL) {
-      THROW_NEW_ERROR_RETURN_FAILURE(
-          isolate, NewRangeError(MessageTemplate::kWasmTrapMemAllocationFail));
+    if (has_guard_region) {
+      // The guard region already reserves the address space, so the memory
+      // grows in place and freshly committed pages are zero-initialized.
+      if (!wasm::GrowGuardRegionMemory(old_mem_start, old_size, new_size)) {
+        THROW_NEW_ERROR_RETURN_FAILURE(
+            isolate,
+            NewRangeError(MessageTemplate::kWasmTrapMemAllocationFail));
+      }
+      new_mem_start = old_mem_start;
+    } else {
+      new_mem_start = static_cast<Address>(realloc(old_mem_start, new_size));
+      if (new_mem_start == NULL) {
+        THROW_NEW_ERROR_RETURN_FAILURE(
+            isolate,
+            NewRangeError(MessageTemplate::kWasmTrapMemAllocationFail));
+      }
+      // Zero initializing uninitialized memory from realloc
+      memset(new_mem_start + old_size, 0, new_size - old_size);
     }
     old_buffer->set_is_external(true);
     isolate->heap()->UnregisterArrayBuffer(*old_buffer);
-    // Zero initializing uninitialized memory from realloc
-    memset(new_mem_start + old_size, 0, new_size - old_size);
   }
 
   Handle<JSArrayBuffer> buffer = isolate->factory()->NewJSArrayBuffer();
   JSArrayBuffer::Setup(buffer, isolate, false, new_mem_start, new_size);
   buffer->set_is_neuterable(false);
+  buffer->set_has_guard_region(has_guard_region);
 
   // Set new buffer to be wasm memory
   module_object->SetInternalField(kWasmMemArrayBuffer, *buffer);
@@ -114,6 +148,84 @@ RUNTIME_FUNCTION(Runtime_WasmGrowMemory) {
                                                 wasm::WasmModule::kPageSize);
 }
 
+RUNTIME_FUNCTION(Runtime_WasmCompileLazy) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(0, args.length());
+
+  // The runtime is called from the lazy compile stub of the function to
+  // compile, which in turn is called from the code to patch.
+  Handle<Code> stub;
+  Handle<Code> caller;
+  {
+    DisallowHeapAllocation no_allocation;
+    StackFrameIterator it(isolate);
+    DCHECK(it.frame()->is_exit());
+    it.Advance();
+    DCHECK(it.frame()->is_wasm());
+    stub = handle(it.frame()->LookupCode(), isolate);
+    it.Advance();
+    caller = handle(it.frame()->LookupCode(), isolate);
+  }
+
+  Handle<Code> code;
+  if (!wasm::CompileLazy(isolate, stub, caller).ToHandle(&code)) {
+    DCHECK(isolate->has_pending_exception());
+    return isolate->heap()->exception();
+  }
+  return *code;
+}
+
+RUNTIME_FUNCTION(Runtime_WasmTierUp) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(0, args.length());
+
+  // The runtime is called from the function whose tier-up budget ran out.
+  Handle<Code> code;
+  {
+    DisallowHeapAllocation no_allocation;
+    StackFrameIterator it(isolate);
+    DCHECK(it.frame()->is_exit());
+    it.Advance();
+    DCHECK(it.frame()->is_wasm());
+    code = handle(it.frame()->LookupCode(), isolate);
+  }
+
+  wasm::TierUp(isolate, code);
+  return isolate->heap()->undefined_value();
+}
+
+RUNTIME_FUNCTION(Runtime_WasmAtomicWait) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(3, args.length());
+  CONVERT_SIZE_ARG_CHECKED(address, 0);
+  CONVERT_INT32_ARG_CHECKED(value, 1);
+  CONVERT_DOUBLE_ARG_CHECKED(timeout, 2);
+  Handle<JSArrayBuffer> buffer = GetSharedWasmMemory(isolate);
+
+  // The timeout is interpreted like the one of Atomics.wait.
+  if (std::isnan(timeout)) {
+    timeout = V8_INFINITY;
+  } else if (timeout < 0) {
+    timeout = 0;
+  }
+  Object* result = FutexEmulation::Wait(isolate, buffer, address, value,
+                                        timeout);
+  if (result == isolate->heap()->ok()) return Smi::FromInt(0);
+  if (result == isolate->heap()->not_equal()) return Smi::FromInt(1);
+  if (result == isolate->heap()->timed_out()) return Smi::FromInt(2);
+  // The wait was interrupted by an exception.
+  return result;
+}
+
+RUNTIME_FUNCTION(Runtime_WasmAtomicWake) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(2, args.length());
+  CONVERT_SIZE_ARG_CHECKED(address, 0);
+  CONVERT_INT32_ARG_CHECKED(count, 1);
+  Handle<JSArrayBuffer> buffer = GetSharedWasmMemory(isolate);
+  return FutexEmulation::Wake(isolate, buffer, address, count);
+}
+
 RUNTIME_FUNCTION(Runtime_JITSingleFunction) {
   const int fixed_args = 6;
 
@@ -126,21 +238,7 @@ RUNTIME_FUNCTION(Runtime_JITSingleFunction) {
   CONVERT_UINT32_ARG_CHECKED(sig_index, 4);
   CONVERT_SMI_ARG_CHECKED(return_count, 5);
 
-  Handle<JSObject> module_object;
-
-  {
-    // Get the module JSObject
-    DisallowHeapAllocation no_allocation;
-    const Address entry = Isolate::c_entry_fp(isolate->thread_local_top());
-    Address pc =
-        Memory::Address_at(entry + StandardFrameConstants::kCallerPCOffset);
-    Code* code =
-        isolate->inner_pointer_to_code_cache()->GetCacheEntry(pc)->code;
-    FixedArray* deopt_data = code->deoptimization_data();
-    DCHECK(deopt_data->length() == 2);
-    module_object = Handle<JSObject>::cast(handle(deopt_data->get(0), isolate));
-    CHECK(!module_object->IsNull(isolate));
-  }
+  Handle<JSObject> module_object = GetWasmInstanceOnStackTop(isolate);
 
   // Get mem buffer associated with module object
   Handle<Object> obj(module_object->GetInternalField(kWasmMemArrayBuffer),
@@ -185,8 +283,8 @@ RUNTIME_FUNCTION(Runtime_JITSingleFunction) {
     return isolate->heap()->undefined_value();
   }
 
-  function_table->set(index, Smi::FromInt(sig_index));
-  function_table->set(index + function_table->length() / 2, *code);
+  function_table->set(2 * index, Smi::FromInt(sig_index));
+  function_table->set(2 * index + 1, *code);
 
   return isolate->heap()->undefined_value();
 }
@@ -6,11 +6,13 @@
 
 #include <memory>
 
+#include "src/base/functional.h"
 #include "src/code-stubs.h"
 #include "src/log.h"
 #include "src/macro-assembler.h"
 #include "src/snapshot/deserializer.h"
 #include "src/version.h"
+#include "src/wasm/wasm-module.h"
 
 namespace v8 {
 namespace internal {
@@ -87,7 +89,10 @@ void CodeSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
       case Code::WASM_FUNCTION:
       case Code::WASM_TO_JS_FUNCTION:
       case Code::JS_TO_WASM_FUNCTION:
-        UNREACHABLE();
+        // Wasm code is found in compiled wasm modules and in the wasm data
+        // of asm.js modules.
+        SerializeGeneric(code_object, how_to_code, where_to_point);
+        return;
     }
     UNREACHABLE();
   }
@@ -149,6 +154,10 @@ void CodeSerializer::SerializeCodeStub(Code* code_stub, HowToCode how_to_code,
   PutAttachedReference(reference, how_to_code, where_to_point);
 }
 
+uint32_t CodeSerializer::SourceHash() const {
+  return SerializedCodeData::SourceHash(source());
+}
+
 MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
     Isolate* isolate, ScriptData* cached_data, Handle<String> source) {
   base::ElapsedTimer timer;
@@ -157,15 +166,18 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
   HandleScope scope(isolate);
 
   std::unique_ptr<SerializedCodeData> scd(
-      SerializedCodeData::FromCachedData(isolate, cached_data, *source));
+      SerializedCodeData::FromCachedData(
+          isolate, cached_data, SerializedCodeData::SourceHash(*source)));
   if (!scd) {
     if (FLAG_profile_deserialization) PrintF("[Cached code failed check]\n");
     DCHECK(cached_data->rejected());
     return MaybeHandle<SharedFunctionInfo>();
   }
 
+  // The attached objects mirror the references added by the serializer.
   Deserializer deserializer(scd.get());
   deserializer.AddAttachedObject(source);
+  deserializer.AddAttachedObject(isolate->native_context());
   Vector<const uint32_t> code_stub_keys = scd->CodeStubKeys();
   for (int i = 0; i < code_stub_keys.length(); i++) {
     deserializer.AddAttachedObject(
@@ -199,6 +211,85 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
   return scope.CloseAndEscape(result);
 }
 
+ScriptData* WasmCompiledModuleSerializer::SerializeWasmModule(
+    Isolate* isolate, Handle<FixedArray> compiled_module) {
+  base::ElapsedTimer timer;
+  if (FLAG_profile_deserialization) timer.Start();
+
+  Handle<String> module_bytes =
+      wasm::GetCompiledModuleBytes(isolate, compiled_module);
+  WasmCompiledModuleSerializer wcs(isolate, *module_bytes);
+  Object** location = Handle<Object>::cast(compiled_module).location();
+  wcs.VisitPointer(location);
+  wcs.SerializeDeferredObjects();
+  wcs.Pad();
+
+  SerializedCodeData data(wcs.sink()->data(), &wcs);
+  ScriptData* script_data = data.GetScriptData();
+
+  if (FLAG_profile_deserialization) {
+    double ms = timer.Elapsed().InMillisecondsF();
+    int length = script_data->length();
+    PrintF("[Serializing wasm module to %d bytes took %0.3f ms]\n", length,
+           ms);
+  }
+
+  return script_data;
+}
+
+MaybeHandle<FixedArray> WasmCompiledModuleSerializer::DeserializeWasmModule(
+    Isolate* isolate, ScriptData* data, Handle<String> module_bytes) {
+  base::ElapsedTimer timer;
+  if (FLAG_profile_deserialization) timer.Start();
+
+  HandleScope scope(isolate);
+
+  // The header checks reject data produced by a different V8 version, for
+  // different CPU features or with different flags. The caller then has to
+  // compile the module bytes instead.
+  std::unique_ptr<SerializedCodeData> scd(
+      SerializedCodeData::FromCachedData(isolate, data,
+                                         ModuleBytesHash(*module_bytes)));
+  if (!scd) {
+    if (FLAG_profile_deserialization) PrintF("[Cached code failed check]\n");
+    DCHECK(data->rejected());
+    return MaybeHandle<FixedArray>();
+  }
+
+  // The attached objects mirror the references added by the serializer.
+  Deserializer deserializer(scd.get());
+  deserializer.AddAttachedObject(module_bytes);
+  deserializer.AddAttachedObject(isolate->native_context());
+  Vector<const uint32_t> code_stub_keys = scd->CodeStubKeys();
+  for (int i = 0; i < code_stub_keys.length(); i++) {
+    deserializer.AddAttachedObject(
+        CodeStub::GetCode(isolate, code_stub_keys[i]).ToHandleChecked());
+  }
+
+  Handle<FixedArray> result;
+  if (!deserializer.DeserializeWasmCompiledModule(isolate).ToHandle(&result)) {
+    // Deserializing may fail if the reservations cannot be fulfilled.
+    if (FLAG_profile_deserialization) PrintF("[Deserializing failed]\n");
+    return MaybeHandle<FixedArray>();
+  }
+
+  if (FLAG_profile_deserialization) {
+    double ms = timer.Elapsed().InMillisecondsF();
+    int length = data->length();
+    PrintF("[Deserializing wasm module from %d bytes took %0.3f ms]\n",
+           length, ms);
+  }
+  return scope.CloseAndEscape(result);
+}
+
+uint32_t WasmCompiledModuleSerializer::ModuleBytesHash(String* module_bytes) {
+  DisallowHeapAllocation no_gc;
+  SeqOneByteString* bytes = SeqOneByteString::cast(module_bytes);
+  const uint8_t* start = bytes->GetChars();
+  size_t hash = base::hash_range(start, start + bytes->length());
+  return static_cast<uint32_t>(hash ^ (static_cast<uint64_t>(hash) >> 32));
+}
+
 class Checksum {
  public:
   explicit Checksum(Vector<const byte> payload) {
@@ -260,7 +351,7 @@ SerializedCodeData::SerializedCodeData(const List<byte>* payload,
   // Set header values.
   SetMagicNumber(cs->isolate());
   SetHeaderValue(kVersionHashOffset, Version::Hash());
-  SetHeaderValue(kSourceHashOffset, SourceHash(cs->source()));
+  SetHeaderValue(kSourceHashOffset, cs->SourceHash());
   SetHeaderValue(kCpuFeaturesOffset,
                  static_cast<uint32_t>(CpuFeatures::SupportedFeatures()));
   SetHeaderValue(kFlagHashOffset, FlagList::Hash());
@@ -288,7 +379,7 @@ SerializedCodeData::SerializedCodeData(const List<byte>* payload,
 }
 
 SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
-    Isolate* isolate, String* source) const {
+    Isolate* isolate, uint32_t expected_source_hash) const {
   uint32_t magic_number = GetMagicNumber();
   if (magic_number != ComputeMagicNumber(isolate)) return MAGIC_NUMBER_MISMATCH;
   uint32_t version_hash = GetHeaderValue(kVersionHashOffset);
@@ -298,7 +389,7 @@ SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
   uint32_t c1 = GetHeaderValue(kChecksum1Offset);
   uint32_t c2 = GetHeaderValue(kChecksum2Offset);
   if (version_hash != Version::Hash()) return VERSION_MISMATCH;
-  if (source_hash != SourceHash(source)) return SOURCE_MISMATCH;
+  if (source_hash != expected_source_hash) return SOURCE_MISMATCH;
   if (cpu_features != static_cast<uint32_t>(CpuFeatures::SupportedFeatures())) {
     return CPU_FEATURES_MISMATCH;
   }
@@ -307,7 +398,7 @@ SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
   return CHECK_SUCCESS;
 }
 
-uint32_t SerializedCodeData::SourceHash(String* source) const {
+uint32_t SerializedCodeData::SourceHash(String* source) {
   return source->length();
 }
 
@@ -350,15 +441,14 @@ Vector<const uint32_t> SerializedCodeData::CodeStubKeys() const {
 SerializedCodeData::SerializedCodeData(ScriptData* data)
     : SerializedData(const_cast<byte*>(data->data()), data->length()) {}
 
-SerializedCodeData* SerializedCodeData::FromCachedData(Isolate* isolate,
-                                                       ScriptData* cached_data,
-                                                       String* source) {
+SerializedCodeData* SerializedCodeData::FromCachedData(
+    Isolate* isolate, ScriptData* cached_data, uint32_t expected_source_hash) {
   DisallowHeapAllocation no_gc;
   SerializedCodeData* scd = new SerializedCodeData(cached_data);
-  SanityCheckResult r = scd->SanityCheck(isolate, source);
+  SanityCheckResult r = scd->SanityCheck(isolate, expected_source_hash);
   if (r == CHECK_SUCCESS) return scd;
   cached_data->Reject();
-  source->GetIsolate()->counters()->code_cache_reject_reason()->AddSample(r);
+  isolate->counters()->code_cache_reject_reason()->AddSample(r);
   delete scd;
   return NULL;
 }
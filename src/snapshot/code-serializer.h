@@ -27,14 +27,25 @@ class CodeSerializer : public Serializer {
 
   const List<uint32_t>* stub_keys() const { return &stub_keys_; }
 
- private:
+  // The hash of the source that is stored in the header of the serialized
+  // data and checked when it is consumed.
+  virtual uint32_t SourceHash() const;
+
+ protected:
   CodeSerializer(Isolate* isolate, String* source)
       : Serializer(isolate), source_(source) {
     reference_map_.AddAttachedReference(source);
+    // Wasm code, including the code of asm.js modules translated to wasm,
+    // embeds the native context it was compiled for.
+    reference_map_.AddAttachedReference(*isolate->native_context());
   }
 
   ~CodeSerializer() override { OutputStatistics("CodeSerializer"); }
 
+  void SerializeGeneric(HeapObject* heap_object, HowToCode how_to_code,
+                        WhereToPoint where_to_point);
+
+ private:
   void SerializeObject(HeapObject* o, HowToCode how_to_code,
                        WhereToPoint where_to_point, int skip) override;
 
@@ -42,8 +53,6 @@ class CodeSerializer : public Serializer {
                         WhereToPoint where_to_point);
   void SerializeCodeStub(Code* code_stub, HowToCode how_to_code,
                          WhereToPoint where_to_point);
-  void SerializeGeneric(HeapObject* heap_object, HowToCode how_to_code,
-                        WhereToPoint where_to_point);
 
   DisallowHeapAllocation no_gc_;
   String* source_;
@@ -51,13 +60,42 @@ class CodeSerializer : public Serializer {
   DISALLOW_COPY_AND_ASSIGN(CodeSerializer);
 };
 
+// Serializes the compiled module of a wasm module, i.e. the FixedArray that
+// WasmModule::CompileFunctions produces, so that it can be instantiated in a
+// later run without compiling the functions again. The module bytes take the
+// role of the source: they are not part of the serialized data and have to
+// be passed back in when deserializing.
+class WasmCompiledModuleSerializer : public CodeSerializer {
+ public:
+  static ScriptData* SerializeWasmModule(Isolate* isolate,
+                                         Handle<FixedArray> compiled_module);
+
+  MUST_USE_RESULT static MaybeHandle<FixedArray> DeserializeWasmModule(
+      Isolate* isolate, ScriptData* data, Handle<String> module_bytes);
+
+  // The length of the module bytes says little about whether the compiled
+  // code belongs to them, so the hash covers the bytes themselves.
+  static uint32_t ModuleBytesHash(String* module_bytes);
+
+  uint32_t SourceHash() const override { return ModuleBytesHash(source()); }
+
+ private:
+  WasmCompiledModuleSerializer(Isolate* isolate, String* module_bytes)
+      : CodeSerializer(isolate, module_bytes) {}
+
+  DISALLOW_COPY_AND_ASSIGN(WasmCompiledModuleSerializer);
+};
+
 // Wrapper around ScriptData to provide code-serializer-specific functionality.
 class SerializedCodeData : public SerializedData {
  public:
   // Used when consuming.
   static SerializedCodeData* FromCachedData(Isolate* isolate,
                                             ScriptData* cached_data,
-                                            String* source);
+                                            uint32_t expected_source_hash);
+
+  // The source hash of script code.
+  static uint32_t SourceHash(String* source);
 
   // Used when producing.
   SerializedCodeData(const List<byte>* payload, const CodeSerializer* cs);
@@ -83,9 +121,8 @@ class SerializedCodeData : public SerializedData {
     CHECKSUM_MISMATCH = 6
   };
 
-  SanityCheckResult SanityCheck(Isolate* isolate, String* source) const;
-
-  uint32_t SourceHash(String* source) const;
+  SanityCheckResult SanityCheck(Isolate* isolate,
+                                uint32_t expected_source_hash) const;
 
   // The data header consists of uint32_t-sized entries:
   // [0] magic number and external reference count
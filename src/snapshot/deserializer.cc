@@ -135,20 +135,37 @@ MaybeHandle<Object> Deserializer::DeserializePartial(
 
 MaybeHandle<SharedFunctionInfo> Deserializer::DeserializeCode(
     Isolate* isolate) {
+  Handle<HeapObject> result;
+  if (!DeserializeObject(isolate).ToHandle(&result)) {
+    return MaybeHandle<SharedFunctionInfo>();
+  }
+  return Handle<SharedFunctionInfo>::cast(result);
+}
+
+MaybeHandle<FixedArray> Deserializer::DeserializeWasmCompiledModule(
+    Isolate* isolate) {
+  Handle<HeapObject> result;
+  if (!DeserializeObject(isolate).ToHandle(&result)) {
+    return MaybeHandle<FixedArray>();
+  }
+  return Handle<FixedArray>::cast(result);
+}
+
+MaybeHandle<HeapObject> Deserializer::DeserializeObject(Isolate* isolate) {
   Initialize(isolate);
   if (!ReserveSpace()) {
-    return Handle<SharedFunctionInfo>();
+    return MaybeHandle<HeapObject>();
   } else {
     deserializing_user_code_ = true;
     HandleScope scope(isolate);
-    Handle<SharedFunctionInfo> result;
+    Handle<HeapObject> result;
     {
       DisallowHeapAllocation no_gc;
       Object* root;
       VisitPointer(&root);
       DeserializeDeferredObjects();
       FlushICacheForNewCodeObjects();
-      result = Handle<SharedFunctionInfo>(SharedFunctionInfo::cast(root));
+      result = Handle<HeapObject>(HeapObject::cast(root));
       isolate->heap()->RegisterReservationsForBlackAllocation(reservations_);
     }
     CommitPostProcessedObjects(isolate);
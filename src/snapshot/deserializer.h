@@ -53,6 +53,9 @@ class Deserializer : public SerializerDeserializer {
   // Deserialize a shared function info. Fail gracefully.
   MaybeHandle<SharedFunctionInfo> DeserializeCode(Isolate* isolate);
 
+  // Deserialize the compiled module of a wasm module. Fail gracefully.
+  MaybeHandle<FixedArray> DeserializeWasmCompiledModule(Isolate* isolate);
+
   // Add an object to back an attached reference. The order to add objects must
   // mirror the order they are added in the serializer.
   void AddAttachedObject(Handle<HeapObject> attached_object) {
@@ -68,6 +71,10 @@ class Deserializer : public SerializerDeserializer {
 
   void Initialize(Isolate* isolate);
 
+  // Deserialize the root object of user code and the objects reachable from
+  // it.
+  MaybeHandle<HeapObject> DeserializeObject(Isolate* isolate);
+
   bool deserializing_user_code() { return deserializing_user_code_; }
 
   void DecodeReservation(Vector<const SerializedData::Reservation> res);
@@ -36,6 +36,10 @@ class TypeCache final {
       CreateNative(Type::Unsigned32(), Type::UntaggedIntegral32());
   Type* const kFloat32 = CreateNative(Type::Number(), Type::UntaggedFloat32());
   Type* const kFloat64 = CreateNative(Type::Number(), Type::UntaggedFloat64());
+  // The unboxed payload of SIMD values, as opposed to Type::Simd(), which
+  // describes the boxed JavaScript values.
+  Type* const kSimd128 =
+      CreateNative(Type::Internal(), Type::UntaggedSimd128());
 
   Type* const kSmi = CreateNative(Type::SignedSmall(), Type::TaggedSigned());
   Type* const kHeapNumber = CreateNative(Type::Number(), Type::TaggedPointer());
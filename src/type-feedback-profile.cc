@@ -0,0 +1,414 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/type-feedback-profile.h"
+
+#include <cstring>
+#include <memory>
+
+#include "src/heap/heap.h"
+#include "src/ic/handler-compiler.h"
+#include "src/isolate.h"
+#include "src/objects-inl.h"
+#include "src/runtime-profiler.h"
+#include "src/type-feedback-vector-inl.h"
+#include "src/version.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// Serialized layout, all fields are host-endian uint32 values:
+//
+//   magic number, V8 version hash, number of functions,
+//   per function: source hash, start position, ticks, flags,
+//                 number of megamorphic slots,
+//                 per slot: slot index, call count,
+//                 number of elements slots,
+//                 per slot: slot index, elements kind.
+const uint32_t kMagicNumber = 0x54465047;  // "TFPG"
+const uint32_t kWasOptimizedFlag = 1 << 0;
+
+void WriteUint32(std::vector<byte>* data, uint32_t value) {
+  byte bytes[sizeof(value)];
+  memcpy(bytes, &value, sizeof(value));
+  data->insert(data->end(), bytes, bytes + sizeof(value));
+}
+
+class ProfileReader {
+ public:
+  ProfileReader(const byte* data, int length)
+      : data_(data), length_(length), position_(0) {}
+
+  bool ReadUint32(uint32_t* value) {
+    if (length_ - position_ < static_cast<int>(sizeof(*value))) return false;
+    memcpy(value, data_ + position_, sizeof(*value));
+    position_ += sizeof(*value);
+    return true;
+  }
+
+  bool AtEnd() const { return position_ == length_; }
+
+ private:
+  const byte* data_;
+  int length_;
+  int position_;
+};
+
+bool IsPersistableSlotKind(FeedbackVectorSlotKind kind) {
+  switch (kind) {
+    case FeedbackVectorSlotKind::CALL_IC:
+    case FeedbackVectorSlotKind::LOAD_IC:
+    case FeedbackVectorSlotKind::KEYED_LOAD_IC:
+    case FeedbackVectorSlotKind::STORE_IC:
+    case FeedbackVectorSlotKind::KEYED_STORE_IC:
+      return true;
+    // Global loads never go megamorphic and general slots hold allocation
+    // sites and the like, none of which is portable.
+    case FeedbackVectorSlotKind::LOAD_GLOBAL_IC:
+    case FeedbackVectorSlotKind::GENERAL:
+      return false;
+    case FeedbackVectorSlotKind::INVALID:
+    case FeedbackVectorSlotKind::KINDS_NUMBER:
+      break;
+  }
+  UNREACHABLE();
+  return false;
+}
+
+InlineCacheState StateOf(TypeFeedbackVector* vector, FeedbackVectorSlot slot,
+                         FeedbackVectorSlotKind kind) {
+  switch (kind) {
+    case FeedbackVectorSlotKind::CALL_IC:
+      return CallICNexus(vector, slot).StateFromFeedback();
+    case FeedbackVectorSlotKind::LOAD_IC:
+      return LoadICNexus(vector, slot).StateFromFeedback();
+    case FeedbackVectorSlotKind::KEYED_LOAD_IC:
+      return KeyedLoadICNexus(vector, slot).StateFromFeedback();
+    case FeedbackVectorSlotKind::STORE_IC:
+      return StoreICNexus(vector, slot).StateFromFeedback();
+    case FeedbackVectorSlotKind::KEYED_STORE_IC:
+      return KeyedStoreICNexus(vector, slot).StateFromFeedback();
+    default:
+      UNREACHABLE();
+  }
+  return UNINITIALIZED;
+}
+
+// Returns true if the keyed load at |slot| is monomorphic on the initial
+// JSArray map of a fast elements kind. That kind is the only part of
+// monomorphic feedback that means the same thing in another process.
+bool GetArrayElementsKind(TypeFeedbackVector* vector, FeedbackVectorSlot slot,
+                          Context* native_context, ElementsKind* result) {
+  if (KeyedLoadICNexus(vector, slot).StateFromFeedback() != MONOMORPHIC) {
+    return false;
+  }
+  Object* feedback = vector->Get(slot);
+  // Named keyed loads keep the name as feedback.
+  if (!feedback->IsWeakCell()) return false;
+  WeakCell* cell = WeakCell::cast(feedback);
+  if (cell->cleared() || !cell->value()->IsMap()) return false;
+  Map* map = Map::cast(cell->value());
+  if (map->instance_type() != JS_ARRAY_TYPE) return false;
+  ElementsKind kind = map->elements_kind();
+  if (!IsFastElementsKind(kind)) return false;
+  if (native_context->get(Context::ArrayMapIndex(kind)) != map) return false;
+  *result = kind;
+  return true;
+}
+
+int ProfilerTicksOf(SharedFunctionInfo* shared) {
+  if (shared->HasBytecodeArray()) return shared->profiler_ticks();
+  if (shared->code()->kind() == Code::FUNCTION) {
+    return shared->code()->profiler_ticks();
+  }
+  return 0;
+}
+
+}  // namespace
+
+// static
+uint32_t TypeFeedbackProfile::SourceHash(String* source) {
+  // A simple FNV-1a hash. The string hash of the heap is seeded per process
+  // and hence unsuitable for identifying sources across runs.
+  DisallowHeapAllocation no_gc;
+  String::FlatContent content = source->GetFlatContent();
+  DCHECK(content.IsFlat());
+  uint32_t hash = 2166136261u;
+  int length = source->length();
+  for (int i = 0; i < length; i++) {
+    uc16 c = content.IsOneByte() ? content.ToOneByteVector()[i]
+                                 : content.ToUC16Vector()[i];
+    hash = (hash ^ c) * 16777619u;
+  }
+  return hash;
+}
+
+// static
+void TypeFeedbackProfile::Serialize(Isolate* isolate,
+                                    std::vector<byte>* data) {
+  HandleScope scope(isolate);
+
+  // Hash the script sources up front, flattening them may allocate which is
+  // not allowed while iterating the heap below.
+  std::vector<Handle<Script>> scripts;
+  {
+    DisallowHeapAllocation no_gc;
+    Script::Iterator iterator(isolate);
+    Script* script;
+    while ((script = iterator.Next()) != nullptr) {
+      if (script->source()->IsString() && script->HasValidSource()) {
+        scripts.push_back(handle(script, isolate));
+      }
+    }
+  }
+  std::unordered_map<int, uint32_t> source_hashes;
+  for (Handle<Script> script : scripts) {
+    Handle<String> source =
+        String::Flatten(handle(String::cast(script->source()), isolate));
+    source_hashes[script->id()] = SourceHash(*source);
+  }
+
+  FunctionMap functions;
+  {
+    HeapIterator iterator(isolate->heap());
+    DisallowHeapAllocation no_gc;
+    for (HeapObject* obj = iterator.next(); obj != nullptr;
+         obj = iterator.next()) {
+      if (!obj->IsJSFunction()) continue;
+      JSFunction* function = JSFunction::cast(obj);
+      SharedFunctionInfo* shared = function->shared();
+      if (!shared->script()->IsScript()) continue;
+      auto hash = source_hashes.find(Script::cast(shared->script())->id());
+      if (hash == source_hashes.end()) continue;
+      if (function->literals() == isolate->heap()->empty_literals_array()) {
+        continue;
+      }
+
+      // Several closures may share a function literal, merge their feedback.
+      FunctionProfile& profile =
+          functions[MakeKey(hash->second, shared->start_position())];
+      profile.ticks = Max(profile.ticks, ProfilerTicksOf(shared));
+      if (function->IsOptimized() || shared->opt_count() > 0) {
+        profile.was_optimized = true;
+      }
+
+      TypeFeedbackVector* vector = function->feedback_vector();
+      TypeFeedbackMetadataIterator slots(vector->metadata());
+      while (slots.HasNext()) {
+        FeedbackVectorSlot slot = slots.Next();
+        FeedbackVectorSlotKind kind = slots.kind();
+        if (!IsPersistableSlotKind(kind)) continue;
+        ElementsKind elements_kind;
+        if (kind == FeedbackVectorSlotKind::KEYED_LOAD_IC &&
+            GetArrayElementsKind(vector, slot, function->native_context(),
+                                 &elements_kind)) {
+          // Closures that disagree on the kind record the more general one.
+          bool found = false;
+          for (ElementsSlotProfile& slot_profile : profile.elements_slots) {
+            if (slot_profile.slot == slot.ToInt()) {
+              if (IsMoreGeneralElementsKindTransition(
+                      slot_profile.elements_kind, elements_kind)) {
+                slot_profile.elements_kind = elements_kind;
+              }
+              found = true;
+              break;
+            }
+          }
+          if (!found) {
+            profile.elements_slots.push_back({slot.ToInt(), elements_kind});
+          }
+          continue;
+        }
+        if (StateOf(vector, slot, kind) != MEGAMORPHIC) continue;
+        int call_count = 0;
+        if (kind == FeedbackVectorSlotKind::CALL_IC) {
+          call_count = Max(0, CallICNexus(vector, slot).ExtractCallCount());
+        }
+        bool found = false;
+        for (SlotProfile& slot_profile : profile.megamorphic_slots) {
+          if (slot_profile.slot == slot.ToInt()) {
+            slot_profile.call_count += call_count;
+            found = true;
+            break;
+          }
+        }
+        if (!found) {
+          profile.megamorphic_slots.push_back({slot.ToInt(), call_count});
+        }
+      }
+    }
+  }
+
+  data->clear();
+  WriteUint32(data, kMagicNumber);
+  WriteUint32(data, Version::Hash());
+  WriteUint32(data, static_cast<uint32_t>(functions.size()));
+  for (const auto& entry : functions) {
+    const FunctionProfile& profile = entry.second;
+    WriteUint32(data, static_cast<uint32_t>(entry.first >> 32));
+    WriteUint32(data, static_cast<uint32_t>(entry.first));
+    WriteUint32(data, static_cast<uint32_t>(profile.ticks));
+    WriteUint32(data, profile.was_optimized ? kWasOptimizedFlag : 0);
+    WriteUint32(data, static_cast<uint32_t>(profile.megamorphic_slots.size()));
+    for (const SlotProfile& slot_profile : profile.megamorphic_slots) {
+      WriteUint32(data, static_cast<uint32_t>(slot_profile.slot));
+      WriteUint32(data, static_cast<uint32_t>(slot_profile.call_count));
+    }
+    WriteUint32(data, static_cast<uint32_t>(profile.elements_slots.size()));
+    for (const ElementsSlotProfile& slot_profile : profile.elements_slots) {
+      WriteUint32(data, static_cast<uint32_t>(slot_profile.slot));
+      WriteUint32(data, static_cast<uint32_t>(slot_profile.elements_kind));
+    }
+  }
+}
+
+// static
+TypeFeedbackProfile* TypeFeedbackProfile::Deserialize(Isolate* isolate,
+                                                      const byte* data,
+                                                      int length) {
+  ProfileReader reader(data, length);
+  uint32_t magic, version, function_count;
+  if (!reader.ReadUint32(&magic) || magic != kMagicNumber) return nullptr;
+  if (!reader.ReadUint32(&version) || version != Version::Hash()) {
+    return nullptr;
+  }
+  if (!reader.ReadUint32(&function_count)) return nullptr;
+
+  std::unique_ptr<TypeFeedbackProfile> result(
+      new TypeFeedbackProfile(isolate));
+  for (uint32_t i = 0; i < function_count; i++) {
+    uint32_t source_hash, position, ticks, flags, slot_count;
+    if (!reader.ReadUint32(&source_hash) || !reader.ReadUint32(&position) ||
+        !reader.ReadUint32(&ticks) || !reader.ReadUint32(&flags) ||
+        !reader.ReadUint32(&slot_count)) {
+      return nullptr;
+    }
+    FunctionProfile& profile =
+        result->functions_[MakeKey(source_hash, static_cast<int>(position))];
+    profile.ticks = static_cast<int>(Min(ticks, 255u));
+    profile.was_optimized = (flags & kWasOptimizedFlag) != 0;
+    for (uint32_t j = 0; j < slot_count; j++) {
+      uint32_t slot, call_count;
+      if (!reader.ReadUint32(&slot) || !reader.ReadUint32(&call_count)) {
+        return nullptr;
+      }
+      if (slot > static_cast<uint32_t>(Smi::kMaxValue) ||
+          call_count > static_cast<uint32_t>(Smi::kMaxValue)) {
+        return nullptr;
+      }
+      profile.megamorphic_slots.push_back(
+          {static_cast<int>(slot), static_cast<int>(call_count)});
+    }
+    uint32_t elements_slot_count;
+    if (!reader.ReadUint32(&elements_slot_count)) return nullptr;
+    for (uint32_t j = 0; j < elements_slot_count; j++) {
+      uint32_t slot, elements_kind;
+      if (!reader.ReadUint32(&slot) || !reader.ReadUint32(&elements_kind)) {
+        return nullptr;
+      }
+      if (slot > static_cast<uint32_t>(Smi::kMaxValue) ||
+          elements_kind > static_cast<uint32_t>(LAST_FAST_ELEMENTS_KIND)) {
+        return nullptr;
+      }
+      profile.elements_slots.push_back(
+          {static_cast<int>(slot), static_cast<ElementsKind>(elements_kind)});
+    }
+  }
+  if (!reader.AtEnd()) return nullptr;
+  return result.release();
+}
+
+bool TypeFeedbackProfile::LookupSourceHash(Handle<SharedFunctionInfo> shared,
+                                           uint32_t* hash) {
+  if (!shared->script()->IsScript()) return false;
+  Handle<Script> script(Script::cast(shared->script()), isolate_);
+  auto it = source_hashes_.find(script->id());
+  if (it != source_hashes_.end()) {
+    *hash = it->second;
+    return true;
+  }
+  if (!script->source()->IsString() || !script->HasValidSource()) {
+    return false;
+  }
+  Handle<String> source =
+      String::Flatten(handle(String::cast(script->source()), isolate_));
+  *hash = SourceHash(*source);
+  source_hashes_[script->id()] = *hash;
+  return true;
+}
+
+void TypeFeedbackProfile::Apply(Handle<SharedFunctionInfo> shared,
+                                Handle<TypeFeedbackVector> vector,
+                                Handle<Context> native_context) {
+  uint32_t source_hash;
+  if (!LookupSourceHash(shared, &source_hash)) return;
+  auto it = functions_.find(MakeKey(source_hash, shared->start_position()));
+  if (it == functions_.end()) return;
+  const FunctionProfile& profile = it->second;
+
+  // Getting the element handlers may allocate, so do this before the
+  // megamorphic slots below.
+  for (const ElementsSlotProfile& slot_profile : profile.elements_slots) {
+    if (slot_profile.slot >= vector->slot_count()) continue;
+    FeedbackVectorSlot slot(slot_profile.slot);
+    if (vector->GetKind(slot) != FeedbackVectorSlotKind::KEYED_LOAD_IC) {
+      continue;
+    }
+    Handle<Map> map(
+        Map::cast(native_context->get(
+            Context::ArrayMapIndex(slot_profile.elements_kind))),
+        isolate_);
+    Handle<Code> handler =
+        ElementHandlerCompiler::GetKeyedLoadHandler(map, isolate_);
+    KeyedLoadICNexus(vector, slot)
+        .ConfigureMonomorphic(Handle<Name>(), map, handler);
+  }
+
+  DisallowHeapAllocation no_gc;
+  for (const SlotProfile& slot_profile : profile.megamorphic_slots) {
+    // The profile is only keyed by position, so be defensive about slots
+    // that do not match the layout of the vector.
+    if (slot_profile.slot >= vector->slot_count()) continue;
+    FeedbackVectorSlot slot(slot_profile.slot);
+    switch (vector->GetKind(slot)) {
+      case FeedbackVectorSlotKind::CALL_IC:
+        CallICNexus(*vector, slot).ConfigureMegamorphic(
+            slot_profile.call_count);
+        break;
+      case FeedbackVectorSlotKind::LOAD_IC:
+        LoadICNexus(*vector, slot).ConfigureMegamorphic();
+        break;
+      case FeedbackVectorSlotKind::STORE_IC:
+        StoreICNexus(*vector, slot).ConfigureMegamorphic();
+        break;
+      case FeedbackVectorSlotKind::KEYED_LOAD_IC:
+        KeyedLoadICNexus(*vector, slot).ConfigureMegamorphicKeyed(ELEMENT);
+        break;
+      case FeedbackVectorSlotKind::KEYED_STORE_IC:
+        KeyedStoreICNexus(*vector, slot).ConfigureMegamorphicKeyed(ELEMENT);
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Functions that were hot in the recorded run get optimized on their first
+  // profiler tick.
+  if (shared->HasBytecodeArray()) {
+    int ticks = FLAG_ignition_tierup_ticks - 1;
+    if (!profile.was_optimized) ticks = Min(ticks, profile.ticks);
+    if (shared->profiler_ticks() < ticks) shared->set_profiler_ticks(ticks);
+  } else if (shared->code()->kind() == Code::FUNCTION) {
+    int ticks = RuntimeProfiler::kProfilerTicksBeforeOptimization - 1;
+    if (!profile.was_optimized) ticks = Min(ticks, profile.ticks);
+    if (shared->code()->profiler_ticks() < ticks) {
+      shared->code()->set_profiler_ticks(ticks);
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,96 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_TYPE_FEEDBACK_PROFILE_H_
+#define V8_TYPE_FEEDBACK_PROFILE_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "src/elements-kind.h"
+#include "src/handles.h"
+
+namespace v8 {
+namespace internal {
+
+class Context;
+class Isolate;
+class SharedFunctionInfo;
+class String;
+class TypeFeedbackVector;
+
+// A summary of the type feedback gathered by one run of an embedder, in a form
+// that can be persisted and fed to a later run so that it warms up faster.
+// Functions are identified by a hash of their script's source and their start
+// position in it, so a profile only applies to scripts with identical source.
+//
+// Only the portable parts of the feedback are recorded: how hot a function
+// was, whether it got optimized, which of its inline caches went megamorphic
+// (together with the call count for call ICs) and the elements kind of keyed
+// loads that only saw JSArrays with an initial map. Other monomorphic and
+// polymorphic feedback refers to maps and closures of the producing process
+// and cannot be carried over.
+class TypeFeedbackProfile {
+ public:
+  // Collects the feedback of all closures on the heap of |isolate|.
+  static void Serialize(Isolate* isolate, std::vector<byte>* data);
+
+  // Returns nullptr if |data| is malformed or was produced by a different
+  // version of V8.
+  static TypeFeedbackProfile* Deserialize(Isolate* isolate, const byte* data,
+                                          int length);
+
+  // Seeds the freshly created |vector| of |shared| and its profiler ticks
+  // with the recorded feedback, if any. Elements kind feedback is resolved
+  // against the initial array maps of |native_context|.
+  void Apply(Handle<SharedFunctionInfo> shared,
+             Handle<TypeFeedbackVector> vector,
+             Handle<Context> native_context);
+
+  int function_count() const { return static_cast<int>(functions_.size()); }
+
+  static uint32_t SourceHash(String* source);
+
+ private:
+  struct SlotProfile {
+    int slot;
+    int call_count;
+  };
+
+  struct ElementsSlotProfile {
+    int slot;
+    ElementsKind elements_kind;
+  };
+
+  struct FunctionProfile {
+    int ticks = 0;
+    bool was_optimized = false;
+    std::vector<SlotProfile> megamorphic_slots;
+    std::vector<ElementsSlotProfile> elements_slots;
+  };
+
+  typedef std::unordered_map<uint64_t, FunctionProfile> FunctionMap;
+
+  explicit TypeFeedbackProfile(Isolate* isolate) : isolate_(isolate) {}
+
+  static uint64_t MakeKey(uint32_t source_hash, int position) {
+    return (static_cast<uint64_t>(source_hash) << 32) |
+           static_cast<uint32_t>(position);
+  }
+
+  // Returns false if the source of |script_id| could not be hashed.
+  bool LookupSourceHash(Handle<SharedFunctionInfo> shared, uint32_t* hash);
+
+  Isolate* isolate_;
+  FunctionMap functions_;
+  // Source hashes of the scripts seen so far, keyed by script id.
+  std::unordered_map<int, uint32_t> source_hashes_;
+
+  DISALLOW_COPY_AND_ASSIGN(TypeFeedbackProfile);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_TYPE_FEEDBACK_PROFILE_H_
@@ -114,21 +114,24 @@ void TypeFeedbackVector::Set(FeedbackVectorSlot slot, Object* value,
 }
 
 
-void TypeFeedbackVector::ComputeCounts(int* with_type_info, int* generic) {
+void TypeFeedbackVector::ComputeCounts(int* with_type_info, int* generic,
+                                       int* total) {
   Object* uninitialized_sentinel =
       TypeFeedbackVector::RawUninitializedSentinel(GetIsolate());
   Object* megamorphic_sentinel =
       *TypeFeedbackVector::MegamorphicSentinel(GetIsolate());
   int with = 0;
   int gen = 0;
+  int all = 0;
   TypeFeedbackMetadataIterator iter(metadata());
   while (iter.HasNext()) {
     FeedbackVectorSlot slot = iter.Next();
     FeedbackVectorSlotKind kind = iter.kind();
+    if (kind == FeedbackVectorSlotKind::GENERAL) continue;
+    all++;
 
     Object* obj = Get(slot);
-    if (obj != uninitialized_sentinel &&
-        kind != FeedbackVectorSlotKind::GENERAL) {
+    if (obj != uninitialized_sentinel) {
       if (obj->IsWeakCell() || obj->IsFixedArray() || obj->IsString()) {
         with++;
       } else if (obj == megamorphic_sentinel) {
@@ -139,6 +142,7 @@ void TypeFeedbackVector::ComputeCounts(int* with_type_info, int* generic) {
 
   *with_type_info = with;
   *generic = gen;
+  *total = all;
 }
 
 Handle<Symbol> TypeFeedbackVector::UninitializedSentinel(Isolate* isolate) {
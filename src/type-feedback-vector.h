@@ -236,7 +236,7 @@ class TypeFeedbackVector : public FixedArray {
   static const int kMetadataIndex = 0;
   static const int kReservedIndexCount = 1;
 
-  inline void ComputeCounts(int* with_type_info, int* generic);
+  inline void ComputeCounts(int* with_type_info, int* generic, int* total);
 
   inline bool is_empty() const;
 
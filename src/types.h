@@ -75,7 +75,7 @@ namespace internal {
 //                 UntaggedInt16 \/ UntaggedInt32
 //   UntaggedFloat = UntaggedFloat32 \/ UntaggedFloat64
 //   UntaggedNumber = UntaggedInt \/ UntaggedFloat
-//   Untagged = UntaggedNumber \/ UntaggedPtr
+//   Untagged = UntaggedNumber \/ UntaggedSimd128 \/ UntaggedPtr
 //   Tagged = TaggedInt \/ TaggedPtr
 //
 // Subtyping relates the two dimensions, for example:
@@ -174,7 +174,8 @@ namespace internal {
                         kUntaggedIntegral16 | kUntaggedIntegral32) \
   V(UntaggedFloat,      kUntaggedFloat32 | kUntaggedFloat64)       \
   V(UntaggedNumber,     kUntaggedIntegral | kUntaggedFloat)        \
-  V(Untagged,           kUntaggedNumber | kUntaggedPointer)        \
+  V(Untagged,           kUntaggedNumber | kUntaggedSimd128 |       \
+                        kUntaggedPointer)                          \
   V(Tagged,             kTaggedSigned | kTaggedPointer)
 
 #define INTERNAL_BITSET_TYPE_LIST(V)                                      \
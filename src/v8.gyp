@@ -395,8 +395,15 @@
       'actions':[{
         'action_name': 'run mkpeephole',
         'inputs': ['<(mkpeephole_exec)'],
-        'outputs': ['<(INTERMEDIATE_DIR)/bytecode-peephole-table.cc'],
-        'action': ['<(mkpeephole_exec)', '<(INTERMEDIATE_DIR)/bytecode-peephole-table.cc' ],
+        'outputs': [
+          '<(INTERMEDIATE_DIR)/bytecode-peephole-table.cc',
+          '<(PRODUCT_DIR)/v8.ignition_peephole_pairs.json',
+        ],
+        'action': [
+          '<(mkpeephole_exec)',
+          '<(INTERMEDIATE_DIR)/bytecode-peephole-table.cc',
+          '<(PRODUCT_DIR)/v8.ignition_peephole_pairs.json',
+        ],
         'process_outputs_as_sources': 1,
         'conditions': [
           ['want_separate_host_toolset_mkpeephole==1', {
@@ -661,6 +668,8 @@
         'compiler/loop-peeling.h',
         'compiler/loop-variable-optimizer.cc',
         'compiler/loop-variable-optimizer.h',
+        'compiler/loop-vectorizer.cc',
+        'compiler/loop-vectorizer.h',
         'compiler/machine-operator-reducer.cc',
         'compiler/machine-operator-reducer.h',
         'compiler/machine-operator.cc',
@@ -994,6 +1003,7 @@
         'interpreter/bytecode-register-allocator.h',
         'interpreter/bytecode-register-optimizer.cc',
         'interpreter/bytecode-register-optimizer.h',
+        'interpreter/bytecode-superinstructions.h',
         'interpreter/bytecode-traits.h',
         'interpreter/constant-array-builder.cc',
         'interpreter/constant-array-builder.h',
@@ -1203,6 +1213,8 @@
         'transitions.h',
         'type-cache.cc',
         'type-cache.h',
+        'type-feedback-profile.cc',
+        'type-feedback-profile.h',
         'type-feedback-vector-inl.h',
         'type-feedback-vector.cc',
         'type-feedback-vector.h',
@@ -1240,6 +1252,8 @@
         'wasm/leb-helper.h',
         'wasm/module-decoder.cc',
         'wasm/module-decoder.h',
+        'wasm/signature-map.cc',
+        'wasm/signature-map.h',
         'wasm/switch-logic.h',
         'wasm/switch-logic.cc',
         'wasm/wasm-debug.cc',
@@ -1259,6 +1273,8 @@
         'wasm/wasm-opcodes.h',
         'wasm/wasm-result.cc',
         'wasm/wasm-result.h',
+        'wasm/wasm-trap-handler.cc',
+        'wasm/wasm-trap-handler.h',
         'zone.cc',
         'zone.h',
         'zone-allocator.h',
@@ -2378,6 +2394,7 @@
        ],
       'sources': [
         'interpreter/bytecode-peephole-table.h',
+        'interpreter/bytecode-superinstructions.h',
         'interpreter/bytecodes.h',
         'interpreter/bytecodes.cc',
         'interpreter/mkpeephole.cc'
@@ -305,6 +305,11 @@ class WasmDecoder : public Decoder {
       }
       case kExprJITSingleFunction:
         return 3;
+      case kAtomicPrefix: {
+        FunctionSig* sig = WasmOpcodes::Signature(
+            static_cast<WasmOpcode>(kAtomicPrefix << 8 | pc[1]));
+        return sig ? static_cast<unsigned>(sig->parameter_count()) : 0;
+      }
 
 #define DECLARE_OPCODE_CASE(name, opcode, sig) \
   case kExpr##name:                            \
@@ -362,6 +367,10 @@ class WasmDecoder : public Decoder {
         JITSingleFunctionOperand operand(this, pc);
         return 1 + operand.length;
       }
+      case kAtomicPrefix: {
+        MemoryAccessOperand operand(this, pc + 1);
+        return 2 + operand.length;
+      }
       case kExprSetLocal:
       case kExprGetLocal: {
         LocalIndexOperand operand(this, pc);
@@ -532,6 +541,7 @@ class WasmFullDecoder : public WasmDecoder {
     ssa_env->control = start;
     ssa_env->effect = start;
     SetEnv("initial", ssa_env);
+    if (builder_) builder_->TierUpCheck();
   }
 
   TFNode* DefaultValue(LocalType type) {
@@ -659,6 +669,7 @@ class WasmFullDecoder : public WasmDecoder {
             SetEnv("loop:start", Split(cont_env));
             ssa_env_->SetNotMerged();
             PushLoop(cont_env);
+            if (build()) builder_->TierUpCheck();
             break;
           }
           case kExprIf: {
@@ -1018,6 +1029,16 @@ class WasmFullDecoder : public WasmDecoder {
             len = 1 + operand.length;
             break;
           }
+          case kAtomicPrefix: {
+            if (!FLAG_wasm_threads_prototype) {
+              error("Invalid opcode");
+              return;
+            }
+            byte atomic_index = *(pc_ + 1);
+            opcode = static_cast<WasmOpcode>(opcode << 8 | atomic_index);
+            len = DecodeAtomicOpcode(opcode);
+            break;
+          }
           case kSimdPrefix: {
             if (FLAG_wasm_simd_prototype) {
               len++;
@@ -1158,6 +1179,31 @@ class WasmFullDecoder : public WasmDecoder {
     Push(GetReturnType(sig), node);
   }
 
+  unsigned DecodeAtomicOpcode(WasmOpcode opcode) {
+    FunctionSig* sig = WasmOpcodes::Signature(opcode);
+    if (sig == nullptr) {
+      error("invalid atomic opcode");
+      return 2;
+    }
+    MemoryAccessOperand operand(this, pc_ + 1);
+    // Atomic accesses are always naturally aligned, which is checked at
+    // runtime, and they are restricted to shared memories.
+    if (operand.alignment != 2) {
+      error(pc_, pc_ + 2, "invalid alignment for atomic operation");
+    }
+    if (module_ && module_->module && !module_->module->mem_shared) {
+      error("atomic operation requires a shared memory");
+    }
+    compiler::NodeVector inputs(sig->parameter_count(), zone_);
+    for (size_t i = sig->parameter_count(); i > 0; i--) {
+      Value val = Pop(static_cast<int>(i - 1), sig->GetParam(i - 1));
+      inputs[i - 1] = val.node;
+    }
+    TFNode* node = BUILD(AtomicOp, opcode, inputs, operand.offset, position());
+    Push(GetReturnType(sig), node);
+    return 2 + operand.length;
+  }
+
   void DoReturn() {
     int count = static_cast<int>(sig_->return_count());
     TFNode** buffer = nullptr;
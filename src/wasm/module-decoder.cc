@@ -77,6 +77,7 @@ class ModuleDecoder : public Decoder {
     module->min_mem_pages = 0;
     module->max_mem_pages = 0;
     module->mem_export = false;
+    module->mem_shared = false;
     module->mem_external = false;
     module->origin = origin_;
 
@@ -144,7 +145,14 @@ class ModuleDecoder : public Decoder {
         case WasmSection::Code::Memory: {
           module->min_mem_pages = consume_u32v("min memory");
           module->max_mem_pages = consume_u32v("max memory");
-          module->mem_export = consume_u8("export memory") != 0;
+          // Bit 0 of the flags exports the memory, bit 1 shares it.
+          const byte* pos = pc_;
+          uint8_t flags = consume_u8("memory flags");
+          module->mem_export = (flags & kMemoryExportFlag) != 0;
+          module->mem_shared = (flags & kMemorySharedFlag) != 0;
+          if (module->mem_shared && !FLAG_wasm_threads_prototype) {
+            error(pos, pos, "shared memory requires --wasm-threads-prototype");
+          }
           break;
         }
         case WasmSection::Code::Signatures: {
@@ -157,6 +165,7 @@ class ModuleDecoder : public Decoder {
                   static_cast<int>(pc_ - start_));
             FunctionSig* s = consume_sig();
             module->signatures.push_back(s);
+            if (s != nullptr) module->signature_map.FindOrInsert(s, i);
           }
           break;
         }
@@ -765,6 +774,147 @@ ModuleResult DecodeWasmModule(Isolate* isolate, Zone* zone,
   return result;
 }
 
+ModuleStreamDecoder::ModuleStreamDecoder(Isolate* isolate, Zone* zone,
+                                         size_t expected_size,
+                                         ModuleOrigin origin,
+                                         StreamingCompilation* compilation)
+    : isolate_(isolate),
+      zone_(zone),
+      origin_(origin),
+      compilation_(compilation),
+      state_(kModuleHeader),
+      buffer_(expected_size > 0 ? new byte[expected_size] : nullptr),
+      capacity_(expected_size),
+      size_(0),
+      offset_(0),
+      section_end_(0),
+      functions_count_(0),
+      functions_received_(0) {}
+
+void ModuleStreamDecoder::OnBytesReceived(const byte* bytes, size_t length) {
+  if (size_ + length > capacity_) Grow(length);
+  memcpy(buffer_.get() + size_, bytes, length);
+  size_ += length;
+  while (DecodeNext()) {
+  }
+}
+
+void ModuleStreamDecoder::Grow(size_t length) {
+  size_t new_capacity = std::max(2 * capacity_, size_ + length);
+  byte* new_buffer = new byte[new_capacity];
+  if (size_ > 0) memcpy(new_buffer, buffer_.get(), size_);
+  if (partial_module_) {
+    // Compilation units may still be reading function bodies from the old
+    // buffer, and {partial_module_} cannot be moved under their feet. Leave
+    // the remaining bodies to {StreamingCompilation::Finish}.
+    old_buffers_.push_back(std::move(buffer_));
+    if (state_ == kFunctionCount || state_ == kFunctionBody) {
+      TRACE("Stream exceeded %zu bytes, buffering\n", capacity_);
+      state_ = kBuffering;
+    }
+  }
+  buffer_.reset(new_buffer);
+  capacity_ = new_capacity;
+}
+
+bool ModuleStreamDecoder::DecodeNext() {
+  // Malformed input is not reported here; the stream is only decoded as far
+  // as it makes sense, and {Finish} reports the error.
+  const byte* start = buffer_.get() + offset_;
+  Decoder decoder(start, buffer_.get() + size_);
+  switch (state_) {
+    case kModuleHeader: {
+      static const size_t kHeaderSize = 2 * sizeof(uint32_t);
+      if (size_ - offset_ < kHeaderSize) return false;
+      offset_ += kHeaderSize;
+      state_ = kSectionHeader;
+      return true;
+    }
+    case kSectionHeader: {
+      if (offset_ == size_) return false;
+      uint32_t string_length = decoder.consume_u32v("section name length");
+      const byte* section_name_start = decoder.pc();
+      decoder.consume_bytes(string_length);
+      uint32_t section_length = decoder.consume_u32v("section length");
+      if (decoder.failed()) return false;
+      WasmSection::Code section =
+          WasmSection::lookup(section_name_start, string_length);
+      size_t section_start = offset_;
+      offset_ += decoder.pc_offset();
+      section_end_ = offset_ + section_length;
+      if (section == WasmSection::Code::FunctionBodies) {
+        StartCodeSection(section_start);
+      } else if (section == WasmSection::Code::End) {
+        state_ = kBuffering;
+      } else {
+        state_ = kSectionBody;
+      }
+      return true;
+    }
+    case kSectionBody:
+      if (size_ < section_end_) return false;
+      offset_ = section_end_;
+      state_ = kSectionHeader;
+      return true;
+    case kFunctionCount: {
+      functions_count_ = decoder.consume_u32v("functions count");
+      if (decoder.failed()) return false;
+      offset_ += decoder.pc_offset();
+      if (functions_count_ != partial_module_->functions.size()) {
+        state_ = kBuffering;
+      } else {
+        state_ = functions_count_ > 0 ? kFunctionBody : kSectionBody;
+      }
+      return true;
+    }
+    case kFunctionBody: {
+      uint32_t size = decoder.consume_u32v("body size");
+      if (decoder.failed()) return false;
+      size_t code_start = offset_ + decoder.pc_offset();
+      size_t code_end = code_start + size;
+      if (code_end > section_end_) {
+        state_ = kBuffering;
+        return false;
+      }
+      if (code_end > size_) return false;
+      uint32_t index = functions_received_++;
+      WasmFunction* function = &partial_module_->functions[index];
+      function->code_start_offset = static_cast<uint32_t>(code_start);
+      function->code_end_offset = static_cast<uint32_t>(code_end);
+      TRACE("  +%zu  %-20s: (%u bytes)\n", code_start, "streamed body", size);
+      offset_ = code_end;
+      if (functions_received_ == functions_count_) state_ = kSectionBody;
+      if (compilation_ != nullptr) compilation_->AddFunction(index);
+      return true;
+    }
+    case kBuffering:
+      return false;
+  }
+  UNREACHABLE();
+  return false;
+}
+
+void ModuleStreamDecoder::StartCodeSection(size_t section_start) {
+  // The sections received so far make up a module without function bodies,
+  // which is all that compiling the bodies needs to know.
+  WasmModule* module = new WasmModule();
+  partial_module_.reset(module);
+  ModuleDecoder decoder(zone_, buffer_.get(), buffer_.get() + section_start,
+                        origin_);
+  ModuleResult result = decoder.DecodeModule(module, false);
+  if (result.failed()) {
+    state_ = kBuffering;
+    return;
+  }
+  state_ = kFunctionCount;
+  if (compilation_ != nullptr) compilation_->Start(module);
+}
+
+ModuleResult ModuleStreamDecoder::Finish(bool verify_functions) {
+  return DecodeWasmModule(isolate_, zone_, buffer_.get(),
+                          buffer_.get() + size_, verify_functions, origin_);
+}
+
 FunctionSig* DecodeWasmSignatureForTesting(Zone* zone, const byte* start,
                                            const byte* end) {
   ModuleDecoder decoder(zone, start, end, kWasmOrigin);
@@ -16,6 +16,65 @@ ModuleResult DecodeWasmModule(Isolate* isolate, Zone* zone,
                               const byte* module_start, const byte* module_end,
                               bool verify_functions, ModuleOrigin origin);
 
+// Decodes a module whose bytes arrive in chunks. Sections are delimited as
+// their bytes come in; once the code section is reached, the sections before
+// it are decoded and every function body is passed on to {compilation}, if
+// any, as soon as it has been received completely. The module as a whole is
+// decoded and validated by {Finish}.
+class ModuleStreamDecoder {
+ public:
+  // {expected_size} is the size of the module if known beforehand (e.g. from
+  // a Content-Length header), or 0. Function bodies are only passed on while
+  // the buffer it reserves suffices, since compilation units refer to it.
+  ModuleStreamDecoder(Isolate* isolate, Zone* zone, size_t expected_size,
+                      ModuleOrigin origin,
+                      StreamingCompilation* compilation = nullptr);
+
+  void OnBytesReceived(const byte* bytes, size_t length);
+
+  // Decodes the bytes received so far as a complete module. The result refers
+  // to the buffer of this decoder, as does {compilation}.
+  ModuleResult Finish(bool verify_functions);
+
+  uint32_t functions_received() const { return functions_received_; }
+
+ private:
+  enum State {
+    kModuleHeader,
+    kSectionHeader,
+    kSectionBody,
+    kFunctionCount,
+    kFunctionBody,
+    kBuffering  // Only buffer the remaining bytes for {Finish}.
+  };
+
+  // Decodes the next unit of the stream. Returns false if more bytes are
+  // needed.
+  bool DecodeNext();
+  void StartCodeSection(size_t section_start);
+  void Grow(size_t length);
+
+  Isolate* isolate_;
+  Zone* zone_;
+  ModuleOrigin origin_;
+  StreamingCompilation* compilation_;
+  State state_;
+  std::unique_ptr<byte[]> buffer_;
+  size_t capacity_;
+  size_t size_;
+  size_t offset_;  // Start of the next unit to decode.
+  size_t section_end_;
+  uint32_t functions_count_;
+  uint32_t functions_received_;
+  // The sections preceding the code section, with the offsets of the function
+  // bodies received so far.
+  std::unique_ptr<WasmModule> partial_module_;
+  // Outgrown buffers that {partial_module_} may still refer to.
+  std::vector<std::unique_ptr<byte[]>> old_buffers_;
+
+  DISALLOW_COPY_AND_ASSIGN(ModuleStreamDecoder);
+};
+
 // Exposed for testing. Decodes a single function signature, allocating it
 // in the given zone. Returns {nullptr} upon failure.
 FunctionSig* DecodeWasmSignatureForTesting(Zone* zone, const byte* start,
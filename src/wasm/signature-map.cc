@@ -0,0 +1,44 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/wasm/signature-map.h"
+
+#include "src/base/functional.h"
+
+namespace v8 {
+namespace internal {
+namespace wasm {
+
+uint32_t SignatureMap::FindOrInsert(FunctionSig* sig, uint32_t index) {
+  return map_.insert(std::make_pair(sig, index)).first->second;
+}
+
+int32_t SignatureMap::Find(FunctionSig* sig) const {
+  auto pos = map_.find(sig);
+  if (pos == map_.end()) return -1;
+  return static_cast<int32_t>(pos->second);
+}
+
+size_t SignatureMap::Hash::operator()(FunctionSig* sig) const {
+  size_t hash = base::hash_combine(sig->return_count(), sig->parameter_count());
+  size_t count = sig->return_count() + sig->parameter_count();
+  for (size_t i = 0; i < count; ++i) {
+    hash = base::hash_combine(hash, static_cast<int>(sig->raw_data()[i]));
+  }
+  return hash;
+}
+
+bool SignatureMap::Equal::operator()(FunctionSig* a, FunctionSig* b) const {
+  if (a->return_count() != b->return_count()) return false;
+  if (a->parameter_count() != b->parameter_count()) return false;
+  size_t count = a->return_count() + a->parameter_count();
+  for (size_t i = 0; i < count; ++i) {
+    if (a->raw_data()[i] != b->raw_data()[i]) return false;
+  }
+  return true;
+}
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
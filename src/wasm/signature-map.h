@@ -0,0 +1,43 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_WASM_SIGNATURE_MAP_H_
+#define V8_WASM_SIGNATURE_MAP_H_
+
+#include <unordered_map>
+
+#include "src/signature.h"
+#include "src/wasm/wasm-opcodes.h"
+
+namespace v8 {
+namespace internal {
+namespace wasm {
+
+// A signature map canonicalizes signatures: structurally equal signatures
+// share the index of the first of them that was inserted.
+class SignatureMap {
+ public:
+  // Gets the canonical index of {sig}, which becomes {index} if no equal
+  // signature was inserted before.
+  uint32_t FindOrInsert(FunctionSig* sig, uint32_t index);
+
+  // Gets the canonical index of {sig}, or -1 if it was not inserted.
+  int32_t Find(FunctionSig* sig) const;
+
+ private:
+  struct Hash {
+    size_t operator()(FunctionSig* sig) const;
+  };
+  struct Equal {
+    bool operator()(FunctionSig* a, FunctionSig* b) const;
+  };
+
+  std::unordered_map<FunctionSig*, uint32_t, Hash, Equal> map_;
+};
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_WASM_SIGNATURE_MAP_H_
@@ -163,6 +163,81 @@ namespace wasm {
   V(I32AsmjsSConvertF64, double) \
   V(I32AsmjsUConvertF64, double)
 
+// The opcodes that {ThreadImpl::Execute} handles in addition to the binops and
+// unops above.
+#define FOREACH_EXECUTED_OPCODE(V) \
+  V(Nop)                           \
+  V(Block)                         \
+  V(Loop)                          \
+  V(If)                            \
+  V(Else)                          \
+  V(Select)                        \
+  V(Br)                            \
+  V(BrIf)                          \
+  V(BrTable)                       \
+  V(Return)                        \
+  V(Unreachable)                   \
+  V(End)                           \
+  V(I8Const)                       \
+  V(I32Const)                      \
+  V(I64Const)                      \
+  V(F32Const)                      \
+  V(F64Const)                      \
+  V(GetLocal)                      \
+  V(SetLocal)                      \
+  V(CallFunction)                  \
+  V(CallIndirect)                  \
+  V(CallImport)                    \
+  V(LoadGlobal)                    \
+  V(StoreGlobal)                   \
+  V(I32LoadMem8S)                  \
+  V(I32LoadMem8U)                  \
+  V(I32LoadMem16S)                 \
+  V(I32LoadMem16U)                 \
+  V(I64LoadMem8S)                  \
+  V(I64LoadMem8U)                  \
+  V(I64LoadMem16S)                 \
+  V(I64LoadMem16U)                 \
+  V(I64LoadMem32S)                 \
+  V(I64LoadMem32U)                 \
+  V(I32LoadMem)                    \
+  V(I64LoadMem)                    \
+  V(F32LoadMem)                    \
+  V(F64LoadMem)                    \
+  V(I32StoreMem8)                  \
+  V(I32StoreMem16)                 \
+  V(I64StoreMem8)                  \
+  V(I64StoreMem16)                 \
+  V(I64StoreMem32)                 \
+  V(I32StoreMem)                   \
+  V(I64StoreMem)                   \
+  V(F32StoreMem)                   \
+  V(F64StoreMem)                   \
+  V(I32AsmjsLoadMem8S)             \
+  V(I32AsmjsLoadMem8U)             \
+  V(I32AsmjsLoadMem16S)            \
+  V(I32AsmjsLoadMem16U)            \
+  V(I32AsmjsLoadMem)               \
+  V(F32AsmjsLoadMem)               \
+  V(F64AsmjsLoadMem)               \
+  V(I32AsmjsStoreMem8)             \
+  V(I32AsmjsStoreMem16)            \
+  V(I32AsmjsStoreMem)              \
+  V(F32AsmjsStoreMem)              \
+  V(F64AsmjsStoreMem)              \
+  V(MemorySize)
+
+// With GCC and clang, the interpreter jumps to the handler of an instruction
+// through a table of label addresses ("computed goto"). That saves the range
+// check of the switch, and lets the compiler give each handler its own
+// indirect jump, which branch predictors handle better than the single jump
+// of a switch. Other compilers dispatch through the switch.
+#if V8_CC_GNU
+#define WASM_INTERPRETER_COMPUTED_GOTO 1
+#else
+#define WASM_INTERPRETER_COMPUTED_GOTO 0
+#endif
+
 static inline int32_t ExecuteI32DivS(int32_t a, int32_t b, TrapReason* trap) {
   if (b == 0) {
     *trap = kTrapDivByZero;
@@ -858,16 +933,63 @@ class ControlTransfers : public ZoneObject {
       }
     }
   }
+};
 
-  ControlTransfer Lookup(pc_t from) {
-    auto result = map_.find(from);
-    if (result == map_.end()) {
-      V8_Fatal(__FILE__, __LINE__, "no control target for pc %zu", from);
-    }
-    return result->second;
-  }
+// The decoded immediates and the resolved control transfer of an instruction,
+// so that executing it neither decodes LEB128 immediates nor searches the
+// control transfer map. Only the instructions for which
+// {HasSideTableEntry} holds have an entry; all other instructions are one
+// byte long. The entries of a function are stored in the order of its code,
+// and the interpreter keeps the index of the next entry along with the pc.
+// A br_table entry is followed by one entry per target, which only holds
+// the control transfer to that target.
+struct SideTableEntry {
+  uint32_t length;  // of the whole instruction, in bytes.
+  uint32_t arity;   // of branches, returns and calls.
+  union {
+    int32_t i32;
+    int64_t i64;
+    float f32;
+    double f64;
+    uint32_t index;        // of locals, globals, functions and signatures.
+    uint32_t offset;       // of memory accesses.
+    uint32_t table_count;  // of br_table.
+  } imm;
+  ControlTransfer transfer;  // of Br, BrIf, If, Else, End and br_table.
+  int32_t sidediff;          // to the index of the next entry at the target.
 };
 
+bool HasSideTableEntry(byte opcode) {
+  switch (opcode) {
+    case kExprBr:
+    case kExprBrIf:
+    case kExprBrTable:
+    case kExprIf:
+    case kExprElse:
+    case kExprEnd:
+    case kExprReturn:
+    case kExprI8Const:
+    case kExprI32Const:
+    case kExprI64Const:
+    case kExprF32Const:
+    case kExprF64Const:
+    case kExprGetLocal:
+    case kExprSetLocal:
+    case kExprLoadGlobal:
+    case kExprStoreGlobal:
+    case kExprCallFunction:
+    case kExprCallIndirect:
+    case kExprCallImport:
+#define DECLARE_OPCODE_CASE(name, opcode, sig) case kExpr##name:
+      FOREACH_LOAD_MEM_OPCODE(DECLARE_OPCODE_CASE)
+      FOREACH_STORE_MEM_OPCODE(DECLARE_OPCODE_CASE)
+#undef DECLARE_OPCODE_CASE
+      return true;
+    default:
+      return false;
+  }
+}
+
 // Code and metadata needed to execute a function.
 struct InterpreterCode {
   const WasmFunction* function;  // wasm function
@@ -877,6 +999,8 @@ struct InterpreterCode {
   byte* start;                   // start of (maybe altered) code
   byte* end;                     // end of (maybe altered) code
   ControlTransfers* targets;     // helper for control flow.
+  SideTableEntry* side_table;    // pre-decoded instructions.
+  int32_t canonical_sig_index;   // checked by indirect calls.
 
   const byte* at(pc_t pc) { return start + pc; }
 };
@@ -932,16 +1056,163 @@ class CodeMap {
       code->targets =
           new (zone_) ControlTransfers(zone_, code->locals.decls_encoded_size,
                                        code->orig_start, code->orig_end);
+      code->side_table = Predecode(code);
+      code->canonical_sig_index =
+          module_ == nullptr ? -1
+                             : module_->signature_map.Find(code->function->sig);
     }
     return code;
   }
 
+  // Decode the immediates of all instructions in the original code and
+  // resolve their control transfers. Breakpoints do not alter the result,
+  // since they only patch the copy of the code at {code->start}.
+  SideTableEntry* Predecode(InterpreterCode* code) {
+    size_t size = static_cast<size_t>(code->orig_end - code->orig_start);
+    const ControlTransferMap& transfers = code->targets->map_;
+    std::vector<SideTableEntry> entries;
+    // The entries with a control transfer and the pcs they transfer from.
+    std::vector<std::pair<size_t, pc_t>> transfer_entries;
+    // The index of the next entry at each target pc.
+    std::map<pc_t, int32_t> target_indices;
+    for (auto& transfer : transfers) {
+      target_indices[transfer.first + transfer.second.pcdiff] = 0;
+    }
+    for (BytecodeIterator i(code->orig_start + code->locals.decls_encoded_size,
+                            code->orig_end);
+         i.has_next(); i.next()) {
+      pc_t pc = static_cast<pc_t>(i.pc() - code->orig_start);
+      auto target = target_indices.find(pc);
+      if (target != target_indices.end()) {
+        target->second = static_cast<int32_t>(entries.size());
+      }
+      if (!HasSideTableEntry(i.current())) continue;
+      entries.push_back(SideTableEntry());
+      SideTableEntry* insn = &entries.back();
+      insn->length = OpcodeLength(i.pc(), code->orig_end);
+      auto transfer = transfers.find(pc);
+      if (i.current() != kExprBrTable && transfer != transfers.end()) {
+        insn->transfer = transfer->second;
+        transfer_entries.push_back({entries.size() - 1, pc});
+      }
+      switch (i.current()) {
+        case kExprBr:
+        case kExprBrIf: {
+          BreakDepthOperand operand(&i, i.pc());
+          insn->arity = operand.arity;
+          break;
+        }
+        case kExprBrTable: {
+          BranchTableOperand operand(&i, i.pc());
+          insn->arity = operand.arity;
+          insn->imm.table_count = operand.table_count;
+          break;
+        }
+        case kExprReturn: {
+          ReturnArityOperand operand(&i, i.pc());
+          insn->arity = operand.arity;
+          break;
+        }
+        case kExprI8Const: {
+          ImmI8Operand operand(&i, i.pc());
+          insn->imm.i32 = operand.value;
+          break;
+        }
+        case kExprI32Const: {
+          ImmI32Operand operand(&i, i.pc());
+          insn->imm.i32 = operand.value;
+          break;
+        }
+        case kExprI64Const: {
+          ImmI64Operand operand(&i, i.pc());
+          insn->imm.i64 = operand.value;
+          break;
+        }
+        case kExprF32Const: {
+          ImmF32Operand operand(&i, i.pc());
+          insn->imm.f32 = operand.value;
+          break;
+        }
+        case kExprF64Const: {
+          ImmF64Operand operand(&i, i.pc());
+          insn->imm.f64 = operand.value;
+          break;
+        }
+        case kExprGetLocal:
+        case kExprSetLocal: {
+          LocalIndexOperand operand(&i, i.pc());
+          insn->imm.index = operand.index;
+          break;
+        }
+        case kExprLoadGlobal:
+        case kExprStoreGlobal: {
+          GlobalIndexOperand operand(&i, i.pc());
+          insn->imm.index = operand.index;
+          break;
+        }
+        case kExprCallFunction: {
+          CallFunctionOperand operand(&i, i.pc());
+          insn->arity = operand.arity;
+          insn->imm.index = operand.index;
+          break;
+        }
+        case kExprCallIndirect: {
+          CallIndirectOperand operand(&i, i.pc());
+          insn->arity = operand.arity;
+          // Structurally equal signatures match, so the call checks the
+          // canonical index of the signature.
+          insn->imm.i32 =
+              module_->signature_map.Find(module_->signatures[operand.index]);
+          break;
+        }
+#define DECLARE_OPCODE_CASE(name, opcode, sig) case kExpr##name:
+          FOREACH_LOAD_MEM_OPCODE(DECLARE_OPCODE_CASE)
+          FOREACH_STORE_MEM_OPCODE(DECLARE_OPCODE_CASE)
+#undef DECLARE_OPCODE_CASE
+          {
+            MemoryAccessOperand operand(&i, i.pc());
+            insn->imm.offset = operand.offset;
+            break;
+          }
+        default:
+          break;
+      }
+      if (i.current() == kExprBrTable) {
+        // The transfers to the targets are recorded at the pcs right behind
+        // the opcode, each target gets an entry of its own.
+        uint32_t table_count = insn->imm.table_count;
+        for (uint32_t j = 0; j <= table_count; ++j) {
+          DCHECK_EQ(1u, transfers.count(pc + j));
+          entries.push_back(SideTableEntry());
+          entries.back().transfer = transfers.find(pc + j)->second;
+          transfer_entries.push_back({entries.size() - 1, pc + j});
+        }
+      }
+    }
+    // Falling off the end of the code does an implicit return.
+    auto end_target = target_indices.find(size);
+    if (end_target != target_indices.end()) {
+      end_target->second = static_cast<int32_t>(entries.size());
+    }
+    for (auto& entry : transfer_entries) {
+      SideTableEntry* insn = &entries[entry.first];
+      pc_t target = entry.second + insn->transfer.pcdiff;
+      DCHECK_EQ(1u, target_indices.count(target));
+      insn->sidediff =
+          target_indices[target] - static_cast<int32_t>(entry.first);
+    }
+    SideTableEntry* side_table = zone_->NewArray<SideTableEntry>(
+        std::max(entries.size(), static_cast<size_t>(1)));
+    std::copy(entries.begin(), entries.end(), side_table);
+    return side_table;
+  }
+
   int AddFunction(const WasmFunction* function, const byte* code_start,
                   const byte* code_end) {
     InterpreterCode code = {
         function, AstLocalDecls(zone_),          code_start,
         code_end, const_cast<byte*>(code_start), const_cast<byte*>(code_end),
-        nullptr};
+        nullptr,  nullptr};
 
     DCHECK_EQ(interpreter_code_.size(), function->func_index);
     interpreter_code_.push_back(code);
@@ -953,6 +1224,7 @@ class CodeMap {
     InterpreterCode* code = FindCode(function);
     if (code == nullptr) return false;
     code->targets = nullptr;
+    code->side_table = nullptr;
     code->orig_start = start;
     code->orig_end = end;
     code->start = const_cast<byte*>(start);
@@ -985,7 +1257,7 @@ class ThreadImpl : public WasmInterpreter::Thread {
   virtual void PushFrame(const WasmFunction* function, WasmVal* args) {
     InterpreterCode* code = codemap()->FindCode(function);
     CHECK_NOT_NULL(code);
-    frames_.push_back({code, 0, 0, stack_.size()});
+    frames_.push_back({code, 0, 0, 0, stack_.size()});
     for (size_t i = 0; i < function->sig->parameter_count(); ++i) {
       stack_.push_back(args[i]);
     }
@@ -1000,7 +1272,8 @@ class ThreadImpl : public WasmInterpreter::Thread {
       if (state_ == WasmInterpreter::STOPPED ||
           state_ == WasmInterpreter::PAUSED) {
         state_ = WasmInterpreter::RUNNING;
-        Execute(frames_.back().code, frames_.back().ret_pc, kRunSteps);
+        Execute(frames_.back().code, frames_.back().ret_pc,
+                frames_.back().ret_side, kRunSteps);
       }
     } while (state_ == WasmInterpreter::STOPPED);
     return state_;
@@ -1011,7 +1284,8 @@ class ThreadImpl : public WasmInterpreter::Thread {
     if (state_ == WasmInterpreter::STOPPED ||
         state_ == WasmInterpreter::PAUSED) {
       state_ = WasmInterpreter::RUNNING;
-      Execute(frames_.back().code, frames_.back().ret_pc, 1);
+      Execute(frames_.back().code, frames_.back().ret_pc,
+              frames_.back().ret_side, 1);
     }
     return state_;
   }
@@ -1058,6 +1332,7 @@ class ThreadImpl : public WasmInterpreter::Thread {
     InterpreterCode* code;
     pc_t call_pc;
     pc_t ret_pc;
+    size_t ret_side;  // index of the next side table entry at {ret_pc}.
     sp_t sp;
 
     // Limit of parameters.
@@ -1073,27 +1348,33 @@ class ThreadImpl : public WasmInterpreter::Thread {
   WasmInterpreter::State state_;
   pc_t break_pc_;
   TrapReason trap_reason_;
+#if WASM_INTERPRETER_COMPUTED_GOTO
+  // The handler in {Execute} for each opcode, filled in by its first call.
+  void* handlers_[256] = {nullptr};
+#endif
 
   CodeMap* codemap() { return codemap_; }
   WasmModuleInstance* instance() { return instance_; }
   const WasmModule* module() { return instance_->module; }
 
-  void DoTrap(TrapReason trap, pc_t pc) {
+  void DoTrap(TrapReason trap, pc_t pc, size_t side) {
     state_ = WasmInterpreter::TRAPPED;
     trap_reason_ = trap;
-    CommitPc(pc);
+    CommitPc(pc, side);
   }
 
   // Push a frame with arguments already on the stack.
-  void PushFrame(InterpreterCode* code, pc_t call_pc, pc_t ret_pc) {
+  void PushFrame(InterpreterCode* code, pc_t call_pc, pc_t ret_pc,
+                 size_t ret_side) {
     CHECK_NOT_NULL(code);
     DCHECK(!frames_.empty());
     frames_.back().call_pc = call_pc;
     frames_.back().ret_pc = ret_pc;
+    frames_.back().ret_side = ret_side;
     size_t arity = code->function->sig->parameter_count();
     DCHECK_GE(stack_.size(), arity);
     // The parameters will overlap the arguments already on the stack.
-    frames_.push_back({code, 0, 0, stack_.size() - arity});
+    frames_.push_back({code, 0, 0, 0, stack_.size() - arity});
     frames_.back().ret_pc = InitLocals(code);
     TRACE("  => push func#%u @%zu\n", code->function->func_index,
           frames_.back().ret_pc);
@@ -1124,9 +1405,10 @@ class ThreadImpl : public WasmInterpreter::Thread {
     return code->locals.decls_encoded_size;
   }
 
-  void CommitPc(pc_t pc) {
+  void CommitPc(pc_t pc, size_t side) {
     if (!frames_.empty()) {
       frames_.back().ret_pc = pc;
+      frames_.back().ret_side = side;
     }
   }
 
@@ -1138,7 +1420,8 @@ class ThreadImpl : public WasmInterpreter::Thread {
     return false;
   }
 
-  bool DoReturn(InterpreterCode** code, pc_t* pc, pc_t* limit, WasmVal val) {
+  bool DoReturn(InterpreterCode** code, pc_t* pc, size_t* side, pc_t* limit,
+                WasmVal val) {
     DCHECK_GT(frames_.size(), 0u);
     stack_.resize(frames_.back().sp);
     frames_.pop_back();
@@ -1154,6 +1437,7 @@ class ThreadImpl : public WasmInterpreter::Thread {
       Frame* top = &frames_.back();
       *code = top->code;
       *pc = top->ret_pc;
+      *side = top->ret_side;
       *limit = top->code->end - top->code->start;
       if (top->code->start[top->call_pc] == kExprCallIndirect ||
           (top->code->orig_start &&
@@ -1169,17 +1453,22 @@ class ThreadImpl : public WasmInterpreter::Thread {
     }
   }
 
-  void DoCall(InterpreterCode* target, pc_t* pc, pc_t ret_pc, pc_t* limit) {
-    PushFrame(target, *pc, ret_pc);
+  void DoCall(InterpreterCode* target, pc_t* pc, pc_t ret_pc, size_t* side,
+              pc_t* limit) {
+    PushFrame(target, *pc, ret_pc, *side);
     *pc = frames_.back().ret_pc;
+    *side = 0;
     *limit = target->end - target->start;
   }
 
-  // Adjust the program counter {pc} and the stack contents according to the
-  // code's precomputed control transfer map. Returns the different between
-  // the new pc and the old pc.
-  int DoControlTransfer(InterpreterCode* code, pc_t pc) {
-    auto target = code->targets->Lookup(pc);
+  // Adjust the side table index {side} and the stack contents according to
+  // the pre-decoded control transfer of the side table entry at {index}.
+  // Returns the difference between the new pc and the pc of the transfer.
+  int DoControlTransfer(InterpreterCode* code, pc_t pc, size_t index,
+                        size_t* side) {
+    const ControlTransfer& target = code->side_table[index].transfer;
+    *side = index + code->side_table[index].sidediff;
+    DCHECK_NE(0, target.pcdiff);
     switch (target.action) {
       case ControlTransfer::kNoAction:
         TRACE("  action [sp-%u]\n", target.spdiff);
@@ -1202,27 +1491,40 @@ class ThreadImpl : public WasmInterpreter::Thread {
     return target.pcdiff;
   }
 
-  void Execute(InterpreterCode* code, pc_t pc, int max) {
-    Decoder decoder(code->start, code->end);
+  void Execute(InterpreterCode* code, pc_t pc, size_t side, int max) {
+#if WASM_INTERPRETER_COMPUTED_GOTO
+    if (handlers_[0] == nullptr) {
+      for (void*& handler : handlers_) handler = &&handle_default;
+#define SET_HANDLER(name, ...) handlers_[kExpr##name] = &&handle_##name;
+      FOREACH_EXECUTED_OPCODE(SET_HANDLER)
+      FOREACH_SIMPLE_BINOP(SET_HANDLER)
+      FOREACH_OTHER_BINOP(SET_HANDLER)
+      FOREACH_OTHER_UNOP(SET_HANDLER)
+#undef SET_HANDLER
+    }
+#define CASE(name)  \
+  case kExpr##name: \
+  handle_##name:
+#else
+#define CASE(name) case kExpr##name:
+#endif
     pc_t limit = code->end - code->start;
     while (true) {
       if (max-- <= 0) {
         // Maximum number of instructions reached.
         state_ = WasmInterpreter::PAUSED;
-        return CommitPc(pc);
+        return CommitPc(pc, side);
       }
 
       if (pc >= limit) {
         // Fell off end of code; do an implicit return.
         TRACE("@%-3zu: ImplicitReturn\n", pc);
         WasmVal val = PopArity(code->function->sig->return_count());
-        if (!DoReturn(&code, &pc, &limit, val)) return;
-        decoder.Reset(code->start, code->end);
+        if (!DoReturn(&code, &pc, &side, &limit, val)) return;
         continue;
       }
 
       const char* skip = "        ";
-      int len = 1;
       byte opcode = code->start[pc];
       byte orig = opcode;
       if (opcode == kInternalBreakpoint) {
@@ -1237,7 +1539,7 @@ class ThreadImpl : public WasmInterpreter::Thread {
           TraceValueStack();
           TRACE("\n");
           break_pc_ = pc;
-          return CommitPc(pc);
+          return CommitPc(pc, side);
         }
       }
 
@@ -1247,167 +1549,153 @@ class ThreadImpl : public WasmInterpreter::Thread {
       TraceValueStack();
       TRACE("\n");
 
+      // The entry of the instruction, if it has one. Taken control transfers
+      // set {side} to the entry at the target, otherwise it moves past the
+      // entry.
+      const SideTableEntry* insn = nullptr;
+      size_t entry = side;
+      int len = 1;
+      if (HasSideTableEntry(orig)) {
+        insn = &code->side_table[entry];
+        len = static_cast<int>(insn->length);
+        side = entry + 1;
+      }
+
+#if WASM_INTERPRETER_COMPUTED_GOTO
+      goto* handlers_[orig];
+#endif
       switch (orig) {
-        case kExprNop:
+        CASE(Nop)
           Push(pc, WasmVal());
           break;
-        case kExprBlock:
-        case kExprLoop: {
+        CASE(Block)
+        CASE(Loop) {
           // Do nothing.
           break;
         }
-        case kExprIf: {
+        CASE(If) {
           WasmVal cond = Pop();
           bool is_true = cond.to<uint32_t>() != 0;
           if (is_true) {
             // fall through to the true block.
             TRACE("  true => fallthrough\n");
           } else {
-            len = DoControlTransfer(code, pc);
+            len = DoControlTransfer(code, pc, entry, &side);
             TRACE("  false => @%zu\n", pc + len);
           }
           break;
         }
-        case kExprElse: {
-          len = DoControlTransfer(code, pc);
+        CASE(Else) {
+          len = DoControlTransfer(code, pc, entry, &side);
           TRACE("  end => @%zu\n", pc + len);
           break;
         }
-        case kExprSelect: {
+        CASE(Select) {
           WasmVal cond = Pop();
           WasmVal fval = Pop();
           WasmVal tval = Pop();
           Push(pc, cond.to<int32_t>() != 0 ? tval : fval);
           break;
         }
-        case kExprBr: {
-          BreakDepthOperand operand(&decoder, code->at(pc));
-          WasmVal val = PopArity(operand.arity);
-          len = DoControlTransfer(code, pc);
+        CASE(Br) {
+          WasmVal val = PopArity(insn->arity);
+          len = DoControlTransfer(code, pc, entry, &side);
           TRACE("  br => @%zu\n", pc + len);
-          if (operand.arity > 0) Push(pc, val);
+          if (insn->arity > 0) Push(pc, val);
           break;
         }
-        case kExprBrIf: {
-          BreakDepthOperand operand(&decoder, code->at(pc));
+        CASE(BrIf) {
           WasmVal cond = Pop();
-          WasmVal val = PopArity(operand.arity);
+          WasmVal val = PopArity(insn->arity);
           bool is_true = cond.to<uint32_t>() != 0;
           if (is_true) {
-            len = DoControlTransfer(code, pc);
+            len = DoControlTransfer(code, pc, entry, &side);
             TRACE("  br_if => @%zu\n", pc + len);
-            if (operand.arity > 0) Push(pc, val);
+            if (insn->arity > 0) Push(pc, val);
           } else {
             TRACE("  false => fallthrough\n");
-            len = 1 + operand.length;
             Push(pc, WasmVal());
           }
           break;
         }
-        case kExprBrTable: {
-          BranchTableOperand operand(&decoder, code->at(pc));
+        CASE(BrTable) {
           uint32_t key = Pop().to<uint32_t>();
-          WasmVal val = PopArity(operand.arity);
-          if (key >= operand.table_count) key = operand.table_count;
-          len = DoControlTransfer(code, pc + key) + key;
+          WasmVal val = PopArity(insn->arity);
+          if (key >= insn->imm.table_count) key = insn->imm.table_count;
+          len = DoControlTransfer(code, pc + key, entry + 1 + key, &side) + key;
           TRACE("  br[%u] => @%zu\n", key, pc + len);
-          if (operand.arity > 0) Push(pc, val);
+          if (insn->arity > 0) Push(pc, val);
           break;
         }
-        case kExprReturn: {
-          ReturnArityOperand operand(&decoder, code->at(pc));
-          WasmVal val = PopArity(operand.arity);
-          if (!DoReturn(&code, &pc, &limit, val)) return;
-          decoder.Reset(code->start, code->end);
+        CASE(Return) {
+          WasmVal val = PopArity(insn->arity);
+          if (!DoReturn(&code, &pc, &side, &limit, val)) return;
           continue;
         }
-        case kExprUnreachable: {
-          DoTrap(kTrapUnreachable, pc);
-          return CommitPc(pc);
+        CASE(Unreachable) {
+          return DoTrap(kTrapUnreachable, pc, entry);
         }
-        case kExprEnd: {
-          len = DoControlTransfer(code, pc);
+        CASE(End) {
+          len = DoControlTransfer(code, pc, entry, &side);
           DCHECK_EQ(1, len);
           break;
         }
-        case kExprI8Const: {
-          ImmI8Operand operand(&decoder, code->at(pc));
-          Push(pc, WasmVal(operand.value));
-          len = 1 + operand.length;
+        CASE(I8Const)
+        CASE(I32Const) {
+          Push(pc, WasmVal(insn->imm.i32));
           break;
         }
-        case kExprI32Const: {
-          ImmI32Operand operand(&decoder, code->at(pc));
-          Push(pc, WasmVal(operand.value));
-          len = 1 + operand.length;
-          break;
-        }
-        case kExprI64Const: {
-          ImmI64Operand operand(&decoder, code->at(pc));
-          Push(pc, WasmVal(operand.value));
-          len = 1 + operand.length;
+        CASE(I64Const) {
+          Push(pc, WasmVal(insn->imm.i64));
           break;
         }
-        case kExprF32Const: {
-          ImmF32Operand operand(&decoder, code->at(pc));
-          Push(pc, WasmVal(operand.value));
-          len = 1 + operand.length;
+        CASE(F32Const) {
+          Push(pc, WasmVal(insn->imm.f32));
           break;
         }
-        case kExprF64Const: {
-          ImmF64Operand operand(&decoder, code->at(pc));
-          Push(pc, WasmVal(operand.value));
-          len = 1 + operand.length;
+        CASE(F64Const) {
+          Push(pc, WasmVal(insn->imm.f64));
           break;
         }
-        case kExprGetLocal: {
-          LocalIndexOperand operand(&decoder, code->at(pc));
-          Push(pc, stack_[frames_.back().sp + operand.index]);
-          len = 1 + operand.length;
+        CASE(GetLocal) {
+          Push(pc, stack_[frames_.back().sp + insn->imm.index]);
           break;
         }
-        case kExprSetLocal: {
-          LocalIndexOperand operand(&decoder, code->at(pc));
+        CASE(SetLocal) {
           WasmVal val = Pop();
-          stack_[frames_.back().sp + operand.index] = val;
+          stack_[frames_.back().sp + insn->imm.index] = val;
           Push(pc, val);
-          len = 1 + operand.length;
           break;
         }
-        case kExprCallFunction: {
-          CallFunctionOperand operand(&decoder, code->at(pc));
-          InterpreterCode* target = codemap()->GetCode(operand.index);
-          DoCall(target, &pc, pc + 1 + operand.length, &limit);
+        CASE(CallFunction) {
+          InterpreterCode* target = codemap()->GetCode(insn->imm.index);
+          DoCall(target, &pc, pc + len, &side, &limit);
           code = target;
-          decoder.Reset(code->start, code->end);
           continue;
         }
-        case kExprCallIndirect: {
-          CallIndirectOperand operand(&decoder, code->at(pc));
-          size_t index = stack_.size() - operand.arity - 1;
+        CASE(CallIndirect) {
+          size_t index = stack_.size() - insn->arity - 1;
           DCHECK_LT(index, stack_.size());
           uint32_t entry_index = stack_[index].to<uint32_t>();
           // Assume only one table for now.
           DCHECK_LE(module()->function_tables.size(), 1u);
           InterpreterCode* target = codemap()->GetIndirectCode(0, entry_index);
           if (target == nullptr) {
-            return DoTrap(kTrapFuncInvalid, pc);
-          } else if (target->function->sig_index != operand.index) {
-            return DoTrap(kTrapFuncSigMismatch, pc);
+            return DoTrap(kTrapFuncInvalid, pc, entry);
+          } else if (target->canonical_sig_index != insn->imm.i32) {
+            return DoTrap(kTrapFuncSigMismatch, pc, entry);
           }
 
-          DoCall(target, &pc, pc + 1 + operand.length, &limit);
+          DoCall(target, &pc, pc + len, &side, &limit);
           code = target;
-          decoder.Reset(code->start, code->end);
           continue;
         }
-        case kExprCallImport: {
+        CASE(CallImport) {
           UNIMPLEMENTED();
           break;
         }
-        case kExprLoadGlobal: {
-          GlobalIndexOperand operand(&decoder, code->at(pc));
-          const WasmGlobal* global = &module()->globals[operand.index];
+        CASE(LoadGlobal) {
+          const WasmGlobal* global = &module()->globals[insn->imm.index];
           byte* ptr = instance()->globals_start + global->offset;
           LocalType type = global->type;
           WasmVal val;
@@ -1423,12 +1711,10 @@ class ThreadImpl : public WasmInterpreter::Thread {
             UNREACHABLE();
           }
           Push(pc, val);
-          len = 1 + operand.length;
           break;
         }
-        case kExprStoreGlobal: {
-          GlobalIndexOperand operand(&decoder, code->at(pc));
-          const WasmGlobal* global = &module()->globals[operand.index];
+        CASE(StoreGlobal) {
+          const WasmGlobal* global = &module()->globals[insn->imm.index];
           byte* ptr = instance()->globals_start + global->offset;
           LocalType type = global->type;
           WasmVal val = Pop();
@@ -1444,23 +1730,21 @@ class ThreadImpl : public WasmInterpreter::Thread {
             UNREACHABLE();
           }
           Push(pc, val);
-          len = 1 + operand.length;
           break;
         }
 
 #define LOAD_CASE(name, ctype, mtype)                                       \
-  case kExpr##name: {                                                       \
-    MemoryAccessOperand operand(&decoder, code->at(pc));                    \
+  CASE(name) {                                                              \
+    uint32_t offset = insn->imm.offset;                                     \
     uint32_t index = Pop().to<uint32_t>();                                  \
     size_t effective_mem_size = instance()->mem_size - sizeof(mtype);       \
-    if (operand.offset > effective_mem_size ||                              \
-        index > (effective_mem_size - operand.offset)) {                    \
-      return DoTrap(kTrapMemOutOfBounds, pc);                               \
+    if (offset > effective_mem_size ||                                      \
+        index > (effective_mem_size - offset)) {                            \
+      return DoTrap(kTrapMemOutOfBounds, pc, entry);                        \
     }                                                                       \
-    byte* addr = instance()->mem_start + operand.offset + index;            \
+    byte* addr = instance()->mem_start + offset + index;                    \
     WasmVal result(static_cast<ctype>(ReadLittleEndianValue<mtype>(addr))); \
     Push(pc, result);                                                       \
-    len = 1 + operand.length;                                               \
     break;                                                                  \
   }
 
@@ -1481,19 +1765,18 @@ class ThreadImpl : public WasmInterpreter::Thread {
 #undef LOAD_CASE
 
 #define STORE_CASE(name, ctype, mtype)                                        \
-  case kExpr##name: {                                                         \
-    MemoryAccessOperand operand(&decoder, code->at(pc));                      \
+  CASE(name) {                                                                \
+    uint32_t offset = insn->imm.offset;                                       \
     WasmVal val = Pop();                                                      \
     uint32_t index = Pop().to<uint32_t>();                                    \
     size_t effective_mem_size = instance()->mem_size - sizeof(mtype);         \
-    if (operand.offset > effective_mem_size ||                                \
-        index > (effective_mem_size - operand.offset)) {                      \
-      return DoTrap(kTrapMemOutOfBounds, pc);                                 \
+    if (offset > effective_mem_size ||                                        \
+        index > (effective_mem_size - offset)) {                              \
+      return DoTrap(kTrapMemOutOfBounds, pc, entry);                          \
     }                                                                         \
-    byte* addr = instance()->mem_start + operand.offset + index;              \
+    byte* addr = instance()->mem_start + offset + index;                      \
     WriteLittleEndianValue<mtype>(addr, static_cast<mtype>(val.to<ctype>())); \
     Push(pc, val);                                                            \
-    len = 1 + operand.length;                                                 \
     break;                                                                    \
   }
 
@@ -1509,7 +1792,7 @@ class ThreadImpl : public WasmInterpreter::Thread {
 #undef STORE_CASE
 
 #define ASMJS_LOAD_CASE(name, ctype, mtype, defval)                 \
-  case kExpr##name: {                                               \
+  CASE(name) {                                                      \
     uint32_t index = Pop().to<uint32_t>();                          \
     ctype result;                                                   \
     if (index >= (instance()->mem_size - sizeof(mtype))) {          \
@@ -1534,7 +1817,7 @@ class ThreadImpl : public WasmInterpreter::Thread {
 #undef ASMJS_LOAD_CASE
 
 #define ASMJS_STORE_CASE(name, ctype, mtype)                                   \
-  case kExpr##name: {                                                          \
+  CASE(name) {                                                                 \
     WasmVal val = Pop();                                                       \
     uint32_t index = Pop().to<uint32_t>();                                     \
     if (index < (instance()->mem_size - sizeof(mtype))) {                      \
@@ -1553,12 +1836,12 @@ class ThreadImpl : public WasmInterpreter::Thread {
           ASMJS_STORE_CASE(F64AsmjsStoreMem, double, double);
 #undef ASMJS_STORE_CASE
 
-        case kExprMemorySize: {
+        CASE(MemorySize) {
           Push(pc, WasmVal(static_cast<uint32_t>(instance()->mem_size)));
           break;
         }
 #define EXECUTE_SIMPLE_BINOP(name, ctype, op)             \
-  case kExpr##name: {                                     \
+  CASE(name) {                                            \
     WasmVal rval = Pop();                                 \
     WasmVal lval = Pop();                                 \
     WasmVal result(lval.to<ctype>() op rval.to<ctype>()); \
@@ -1568,32 +1851,35 @@ class ThreadImpl : public WasmInterpreter::Thread {
           FOREACH_SIMPLE_BINOP(EXECUTE_SIMPLE_BINOP)
 #undef EXECUTE_SIMPLE_BINOP
 
-#define EXECUTE_OTHER_BINOP(name, ctype)              \
-  case kExpr##name: {                                 \
-    TrapReason trap = kTrapCount;                     \
-    volatile ctype rval = Pop().to<ctype>();          \
-    volatile ctype lval = Pop().to<ctype>();          \
-    WasmVal result(Execute##name(lval, rval, &trap)); \
-    if (trap != kTrapCount) return DoTrap(trap, pc);  \
-    Push(pc, result);                                 \
-    break;                                            \
+#define EXECUTE_OTHER_BINOP(name, ctype)                    \
+  CASE(name) {                                              \
+    TrapReason trap = kTrapCount;                           \
+    volatile ctype rval = Pop().to<ctype>();                \
+    volatile ctype lval = Pop().to<ctype>();                \
+    WasmVal result(Execute##name(lval, rval, &trap));       \
+    if (trap != kTrapCount) return DoTrap(trap, pc, entry); \
+    Push(pc, result);                                       \
+    break;                                                  \
   }
           FOREACH_OTHER_BINOP(EXECUTE_OTHER_BINOP)
 #undef EXECUTE_OTHER_BINOP
 
-#define EXECUTE_OTHER_UNOP(name, ctype)              \
-  case kExpr##name: {                                \
-    TrapReason trap = kTrapCount;                    \
-    volatile ctype val = Pop().to<ctype>();          \
-    WasmVal result(Execute##name(val, &trap));       \
-    if (trap != kTrapCount) return DoTrap(trap, pc); \
-    Push(pc, result);                                \
-    break;                                           \
+#define EXECUTE_OTHER_UNOP(name, ctype)                     \
+  CASE(name) {                                              \
+    TrapReason trap = kTrapCount;                           \
+    volatile ctype val = Pop().to<ctype>();                 \
+    WasmVal result(Execute##name(val, &trap));              \
+    if (trap != kTrapCount) return DoTrap(trap, pc, entry); \
+    Push(pc, result);                                       \
+    break;                                                  \
   }
           FOREACH_OTHER_UNOP(EXECUTE_OTHER_UNOP)
 #undef EXECUTE_OTHER_UNOP
 
         default:
+#if WASM_INTERPRETER_COMPUTED_GOTO
+        handle_default:
+#endif
           V8_Fatal(__FILE__, __LINE__, "Unknown or unimplemented opcode #%d:%s",
                    code->start[pc], OpcodeName(code->start[pc]));
           UNREACHABLE();
@@ -1602,6 +1888,7 @@ class ThreadImpl : public WasmInterpreter::Thread {
       pc += len;
     }
     UNREACHABLE();  // above decoding loop should run forever.
+#undef CASE
   }
 
   WasmVal Pop() {
@@ -585,6 +585,16 @@ class LocalDeclEncoder {
 #define WASM_SIMD_I32x4_SPLAT(x) x, kSimdPrefix, kExprI32x4Splat & 0xff
 #define WASM_SIMD_I32x4_EXTRACT_LANE(x, y) \
   x, y, kSimdPrefix, kExprI32x4ExtractLane & 0xff
+#define WASM_SIMD_I32x4_ADD(x, y) x, y, kSimdPrefix, kExprI32x4Add & 0xff
+#define WASM_SIMD_I32x4_SUB(x, y) x, y, kSimdPrefix, kExprI32x4Sub & 0xff
+#define WASM_SIMD_I32x4_MUL(x, y) x, y, kSimdPrefix, kExprI32x4Mul & 0xff
+#define WASM_SIMD_F32x4_SPLAT(x) x, kSimdPrefix, kExprF32x4Splat & 0xff
+#define WASM_SIMD_F32x4_EXTRACT_LANE(x, y) \
+  x, y, kSimdPrefix, kExprF32x4ExtractLane & 0xff
+#define WASM_SIMD_F32x4_ADD(x, y) x, y, kSimdPrefix, kExprF32x4Add & 0xff
+#define WASM_SIMD_F32x4_SUB(x, y) x, y, kSimdPrefix, kExprF32x4Sub & 0xff
+#define WASM_SIMD_F32x4_MUL(x, y) x, y, kSimdPrefix, kExprF32x4Mul & 0xff
+#define WASM_SIMD_F32x4_DIV(x, y) x, y, kSimdPrefix, kExprF32x4Div & 0xff
 
 #define SIG_ENTRY_v_v kWasmFunctionTypeForm, 0, 0
 #define SIZEOF_SIG_ENTRY_v_v 3
@@ -2,9 +2,13 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <memory>
 
 #include "src/base/atomic-utils.h"
+#include "src/base/platform/elapsed-timer.h"
+#include "src/compiler-dispatcher/optimizing-compile-dispatcher.h"
+#include "src/compiler.h"
 #include "src/macro-assembler.h"
 #include "src/objects.h"
 #include "src/property-descriptor.h"
@@ -18,6 +22,7 @@
 #include "src/wasm/wasm-function-name-table.h"
 #include "src/wasm/wasm-module.h"
 #include "src/wasm/wasm-result.h"
+#include "src/wasm/wasm-trap-handler.h"
 
 #include "src/compiler/wasm-compiler.h"
 
@@ -139,7 +144,18 @@ const int kWasmGlobalsArrayBuffer = 3;
 const int kWasmFunctionNamesArray = 4;
 const int kWasmModuleBytesString = 5;
 const int kWasmDebugInfo = 6;
-const int kWasmModuleInternalFieldCount = 7;
+// Only used by instances of lazily compiled modules, for the code of their
+// imports and for the lazy compile stubs not replaced by compiled code yet.
+const int kWasmImportCodeTable = 7;
+const int kWasmLazyCompileStubs = 8;
+// Only used by instances of modules compiled for tier-up, for the budgets
+// of their baseline code and for the wrappers of their exported functions.
+const int kWasmTierUpBudgets = 9;
+const int kWasmExportWrappers = 10;
+// Only used by instances that compile functions after instantiation, for the
+// module decoded once for all of these compilations.
+const int kWasmDecodedModule = 11;
+const int kWasmModuleInternalFieldCount = 12;
 
 // TODO(mtrofin): Unnecessary once we stop using JS Heap for wasm code.
 // For now, each field is expected to have the type commented by its side.
@@ -167,6 +183,9 @@ enum CompiledWasmObjectFields {
   kGlobalsSize,                 // Smi. an uint32_t
   kExportMem,                   // Smi. bool
   kOrigin,                      // Smi. ModuleOrigin
+  kLazyCompilation,             // Smi. bool
+  kTierUpBudgets,               // maybe ByteArray of int32_t
+  kSharedMemory,                // Smi. bool
   kCompiledWasmObjectTableSize  // Sentinel value.
 };
 
@@ -198,6 +217,17 @@ enum WasmIndirectFunctionTableMetadata {
   kWasmIndirectFunctionTableMetadataSize  // Sentinel value.
 };
 
+// Returns true if the functions of {module} are compiled on their first call.
+bool CompileLazily(const WasmModule* module) {
+  return FLAG_wasm_lazy_compilation && module->origin == kWasmOrigin;
+}
+
+// Returns true if the functions of {module} are compiled to baseline code
+// first, which gets replaced by optimized code when it turns out to be hot.
+bool TierUpEnabled(const WasmModule* module) {
+  return FLAG_wasm_tier_up && module->origin == kWasmOrigin;
+}
+
 uint32_t GetMinModuleMemSize(const WasmModule* module) {
   return WasmModule::kPageSize * module->min_mem_pages;
 }
@@ -264,23 +294,26 @@ void SaveDataSegmentInfo(Factory* factory, const WasmModule* module,
   compiled_module->set(kDataSegments, *data);
 }
 
-void PatchFunctionTable(Handle<Code> code,
-                        Handle<FixedArray> old_indirect_table,
-                        Handle<FixedArray> new_indirect_table) {
+void PatchEmbeddedObject(Handle<Code> code, Handle<HeapObject> old_object,
+                         Handle<HeapObject> new_object) {
   for (RelocIterator it(*code, 1 << RelocInfo::EMBEDDED_OBJECT); !it.done();
        it.next()) {
-    if (it.rinfo()->target_object() == *old_indirect_table) {
-      it.rinfo()->set_target_object(*new_indirect_table);
+    if (it.rinfo()->target_object() == *old_object) {
+      it.rinfo()->set_target_object(*new_object);
     }
   }
 }
 
-Handle<JSArrayBuffer> NewArrayBuffer(Isolate* isolate, size_t size) {
+Handle<JSArrayBuffer> NewArrayBuffer(Isolate* isolate, size_t size,
+                                     bool enable_guard_region = false,
+                                     bool shared = false) {
   if (size > (WasmModule::kMaxMemPages * WasmModule::kPageSize)) {
     // TODO(titzer): lift restriction on maximum memory allocated here.
     return Handle<JSArrayBuffer>::null();
   }
-  void* memory = isolate->array_buffer_allocator()->Allocate(size);
+  void* memory = enable_guard_region
+                     ? AllocateGuardRegionMemory(size)
+                     : isolate->array_buffer_allocator()->Allocate(size);
   if (memory == nullptr) {
     return Handle<JSArrayBuffer>::null();
   }
@@ -293,9 +326,14 @@ Handle<JSArrayBuffer> NewArrayBuffer(Isolate* isolate, size_t size) {
   }
 #endif
 
-  Handle<JSArrayBuffer> buffer = isolate->factory()->NewJSArrayBuffer();
-  JSArrayBuffer::Setup(buffer, isolate, false, memory, static_cast<int>(size));
+  SharedFlag shared_flag =
+      shared ? SharedFlag::kShared : SharedFlag::kNotShared;
+  Handle<JSArrayBuffer> buffer =
+      isolate->factory()->NewJSArrayBuffer(shared_flag);
+  JSArrayBuffer::Setup(buffer, isolate, false, memory, static_cast<int>(size),
+                       shared_flag);
   buffer->set_is_neuterable(false);
+  buffer->set_has_guard_region(enable_guard_region);
   return buffer;
 }
 
@@ -317,13 +355,15 @@ void RelocateInstanceCode(Handle<JSObject> instance, Address start,
 
 // Allocate memory for a module instance as a new JSArrayBuffer.
 Handle<JSArrayBuffer> AllocateMemory(ErrorThrower* thrower, Isolate* isolate,
-                                     uint32_t min_mem_pages) {
+                                     uint32_t min_mem_pages,
+                                     bool enable_guard_region, bool shared) {
   if (min_mem_pages > WasmModule::kMaxMemPages) {
     thrower->Error("Out of memory: wasm memory too large");
     return Handle<JSArrayBuffer>::null();
   }
   Handle<JSArrayBuffer> mem_buffer =
-      NewArrayBuffer(isolate, min_mem_pages * WasmModule::kPageSize);
+      NewArrayBuffer(isolate, min_mem_pages * WasmModule::kPageSize,
+                     enable_guard_region, shared);
 
   if (mem_buffer.is_null()) {
     thrower->Error("Out of memory: wasm memory");
@@ -432,6 +472,7 @@ WasmModule::WasmModule(byte* module_start)
       min_mem_pages(0),
       max_mem_pages(0),
       mem_export(false),
+      mem_shared(false),
       mem_external(false),
       start_function_index(-1),
       origin(kWasmOrigin),
@@ -563,6 +604,23 @@ class WasmCompilationTask : public CancelableTask {
   base::AtomicNumber<size_t>* next_unit_;
 };
 
+class StreamingCompilationTask : public CancelableTask {
+ public:
+  StreamingCompilationTask(Isolate* isolate, StreamingCompilation* compilation,
+                           base::Semaphore* on_finished)
+      : CancelableTask(isolate),
+        compilation_(compilation),
+        on_finished_(on_finished) {}
+
+  void RunInternal() override {
+    compilation_->ExecutePendingUnits(true);
+    on_finished_->Signal();
+  }
+
+  StreamingCompilation* compilation_;
+  base::Semaphore* on_finished_;
+};
+
 static void RecordStats(Isolate* isolate, Code* code) {
   isolate->counters()->wasm_generated_code_size()->Increment(code->body_size());
   isolate->counters()->wasm_reloc_size()->Increment(
@@ -680,15 +738,18 @@ void InitializeParallelCompilation(
   }
 }
 
+size_t NumberOfCompilationTasks() {
+  return Min(static_cast<size_t>(FLAG_wasm_num_compilation_tasks),
+             V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads());
+}
+
 uint32_t* StartCompilationTasks(
     Isolate* isolate,
     std::vector<compiler::WasmCompilationUnit*>& compilation_units,
     std::queue<compiler::WasmCompilationUnit*>& executed_units,
     base::Semaphore* pending_tasks, base::Mutex& result_mutex,
     base::AtomicNumber<size_t>& next_unit) {
-  const size_t num_tasks =
-      Min(static_cast<size_t>(FLAG_wasm_num_compilation_tasks),
-          V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads());
+  const size_t num_tasks = NumberOfCompilationTasks();
   uint32_t* task_ids = new uint32_t[num_tasks];
   for (size_t i = 0; i < num_tasks; ++i) {
     WasmCompilationTask* task =
@@ -703,9 +764,7 @@ uint32_t* StartCompilationTasks(
 
 void WaitForCompilationTasks(Isolate* isolate, uint32_t* task_ids,
                              base::Semaphore* pending_tasks) {
-  const size_t num_tasks =
-      Min(static_cast<size_t>(FLAG_wasm_num_compilation_tasks),
-          V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads());
+  const size_t num_tasks = NumberOfCompilationTasks();
   for (size_t i = 0; i < num_tasks; ++i) {
     // If the task has not started yet, then we abort it. Otherwise we wait for
     // it to finish.
@@ -734,13 +793,71 @@ void FinishCompilationUnits(
   }
 }
 
+// Executes the parallel phase of the non-null {compilation_units}, in order,
+// on the background threads and on the main thread, and finishes them into
+// {results}.
+void ExecuteCompilationUnits(
+    Isolate* isolate, const WasmModule* module,
+    std::vector<compiler::WasmCompilationUnit*>& compilation_units,
+    std::vector<Handle<Code>>& results, size_t first_unit) {
+  std::queue<compiler::WasmCompilationUnit*> executed_units;
+  base::ElapsedTimer compile_timer;
+  if (FLAG_trace_wasm_decode_time) compile_timer.Start();
+
+  // Objects for the synchronization with the background threads.
+  base::Mutex result_mutex;
+  base::AtomicNumber<size_t> next_unit(first_unit);
+
+  // 2) The main thread spawns {WasmCompilationTask} instances which run on
+  //    the background threads.
+  std::unique_ptr<uint32_t[]> task_ids(StartCompilationTasks(
+      isolate, compilation_units, executed_units, module->pending_tasks.get(),
+      result_mutex, next_unit));
+
+  // 3.a) The background threads and the main thread pick one compilation
+  //      unit at a time and execute the parallel phase of the compilation
+  //      unit. After finishing the execution of the parallel phase, the
+  //      result is enqueued in {executed_units}.
+  while (FetchAndExecuteCompilationUnit(isolate, &compilation_units,
+                                        &executed_units, &result_mutex,
+                                        &next_unit)) {
+    // 3.b) If {executed_units} contains a compilation unit, the main thread
+    //      dequeues it and finishes the compilation unit. Compilation units
+    //      are finished concurrently to the background threads to save
+    //      memory.
+    FinishCompilationUnits(executed_units, results, result_mutex);
+  }
+  // 4) After the parallel phase of all compilation units has started, the
+  //    main thread waits for all {WasmCompilationTask} instances to finish.
+  double all_started_ms = 0;
+  if (FLAG_trace_wasm_decode_time) {
+    all_started_ms = compile_timer.Elapsed().InMillisecondsF();
+  }
+  WaitForCompilationTasks(isolate, task_ids.get(), module->pending_tasks.get());
+  // Finish the compilation of the remaining compilation units.
+  FinishCompilationUnits(executed_units, results, result_mutex);
+
+  if (FLAG_trace_wasm_decode_time) {
+    // The time after the last unit was started is spent on the units that
+    // are still executing, while the other threads are idle. This is what
+    // compiling the largest functions first reduces.
+    double compile_ms = compile_timer.Elapsed().InMillisecondsF();
+    size_t num_units =
+        compilation_units.size() - Min(first_unit, compilation_units.size());
+    PrintF(
+        "wasm-parallel-compilation: %zu functions, %zu tasks, %0.3f ms, "
+        "%0.3f ms after the last function was started\n",
+        num_units, NumberOfCompilationTasks(), compile_ms,
+        compile_ms - all_started_ms);
+  }
+}
+
 void CompileInParallel(Isolate* isolate, const WasmModule* module,
                        std::vector<Handle<Code>>& functions,
                        ErrorThrower* thrower, ModuleEnv* module_env) {
   // Data structures for the parallel compilation.
   std::vector<compiler::WasmCompilationUnit*> compilation_units(
       module->functions.size());
-  std::queue<compiler::WasmCompilationUnit*> executed_units;
 
   //-----------------------------------------------------------------------
   // For parallel compilation:
@@ -749,11 +866,13 @@ void CompileInParallel(Isolate* isolate, const WasmModule* module,
   // 2) The main thread spawns {WasmCompilationTask} instances which run on
   //    the background threads.
   // 3.a) The background threads and the main thread pick one compilation
-  //      unit at a time and execute the parallel phase of the compilation
-  //      unit. After finishing the execution of the parallel phase, the
-  //      result is enqueued in {executed_units}.
+  //      unit at a time, largest first, and execute the parallel phase of the
+  //      compilation unit, which includes the assembly of the machine code.
+  //      After finishing the execution of the parallel phase, the result is
+  //      enqueued in {executed_units}.
   // 3.b) If {executed_units} contains a compilation unit, the main thread
-  //      dequeues it and finishes the compilation.
+  //      dequeues it and finishes the compilation, i.e. allocates the code
+  //      object and copies the machine code into it.
   // 4) After the parallel phase of all compilation units has started, the
   //    main thread waits for all {WasmCompilationTask} instances to finish.
   // 5) The main thread finishes the compilation.
@@ -767,35 +886,25 @@ void CompileInParallel(Isolate* isolate, const WasmModule* module,
   InitializeParallelCompilation(isolate, module->functions, compilation_units,
                                 *module_env, *thrower);
 
-  // Objects for the synchronization with the background threads.
-  base::Mutex result_mutex;
-  base::AtomicNumber<size_t> next_unit(
-      static_cast<size_t>(FLAG_skip_compiling_wasm_funcs));
-
-  // 2) The main thread spawns {WasmCompilationTask} instances which run on
-  //    the background threads.
-  std::unique_ptr<uint32_t[]> task_ids(StartCompilationTasks(
-      isolate, compilation_units, executed_units, module->pending_tasks.get(),
-      result_mutex, next_unit));
-
-  // 3.a) The background threads and the main thread pick one compilation
-  //      unit at a time and execute the parallel phase of the compilation
-  //      unit. After finishing the execution of the parallel phase, the
-  //      result is enqueued in {executed_units}.
-  while (FetchAndExecuteCompilationUnit(isolate, &compilation_units,
-                                        &executed_units, &result_mutex,
-                                        &next_unit)) {
-    // 3.b) If {executed_units} contains a compilation unit, the main thread
-    //      dequeues it and finishes the compilation unit. Compilation units
-    //      are finished concurrently to the background threads to save
-    //      memory.
-    FinishCompilationUnits(executed_units, functions, result_mutex);
-  }
-  // 4) After the parallel phase of all compilation units has started, the
-  //    main thread waits for all {WasmCompilationTask} instances to finish.
-  WaitForCompilationTasks(isolate, task_ids.get(), module->pending_tasks.get());
-  // Finish the compilation of the remaining compilation units.
-  FinishCompilationUnits(executed_units, functions, result_mutex);
+  // Execute the largest units first. Otherwise a large function picked up at
+  // the end keeps one thread busy while all others are idle already.
+  size_t first_unit = static_cast<size_t>(FLAG_skip_compiling_wasm_funcs);
+  if (FLAG_wasm_compile_largest_first &&
+      first_unit < compilation_units.size()) {
+    std::stable_sort(
+        compilation_units.begin() + first_unit, compilation_units.end(),
+        [module](compiler::WasmCompilationUnit* a,
+                 compiler::WasmCompilationUnit* b) {
+          const WasmFunction& func_a = module->functions[a->index()];
+          const WasmFunction& func_b = module->functions[b->index()];
+          return func_a.code_end_offset - func_a.code_start_offset >
+                 func_b.code_end_offset - func_b.code_start_offset;
+        });
+  }
+
+  // 2) - 5) happen in {ExecuteCompilationUnits}.
+  ExecuteCompilationUnits(isolate, module, compilation_units, functions,
+                          first_unit);
 }
 
 void CompileSequentially(Isolate* isolate, const WasmModule* module,
@@ -823,6 +932,55 @@ void CompileSequentially(Isolate* isolate, const WasmModule* module,
   }
 }
 
+// Validates the function bodies, which would otherwise only be decoded on
+// their first call, and installs a lazy compile stub for each function.
+// Functions of the same signature share the code of their stubs, but each
+// function needs its own copy for the runtime to tell them apart.
+void InstallLazyCompileStubs(Isolate* isolate, const WasmModule* module,
+                             std::vector<Handle<Code>>& functions,
+                             ErrorThrower* thrower, ModuleEnv* module_env) {
+  DCHECK(!thrower->error());
+  Factory* factory = isolate->factory();
+  std::vector<Handle<Code>> stubs(module->signatures.size());
+
+  for (uint32_t i = FLAG_skip_compiling_wasm_funcs;
+       i < module->functions.size(); ++i) {
+    const WasmFunction& func = module->functions[i];
+    DecodeResult result =
+        VerifyWasmCode(isolate->allocator(), module_env, func.sig,
+                       module->module_start + func.code_start_offset,
+                       module->module_start + func.code_end_offset);
+    if (result.failed()) {
+      WasmName str = module->GetName(func.name_offset, func.name_length);
+      ScopedVector<char> buffer(128);
+      SNPrintF(buffer, "Compiling WASM function #%d:%.*s failed:", i,
+               str.length(), str.start());
+      thrower->Failed(buffer.start(), result);
+      return;
+    }
+    Handle<Code>& stub = stubs[func.sig_index];
+    if (stub.is_null()) {
+      stub = compiler::CompileWasmLazyCompileStub(
+          isolate, isolate->native_context(), func.sig,
+          module_env->will_serialize);
+    }
+    functions[i] = factory->CopyCode(stub);
+  }
+}
+
+// Records the instance and the index of a wasm function in the deoptimization
+// data of its code, where the stack walker and the runtime look for them.
+void SetFunctionDeoptimizationData(Factory* factory, Handle<Code> code,
+                                   Handle<JSObject> js_object, int index) {
+  Handle<FixedArray> deopt_data = factory->NewFixedArray(2, TENURED);
+  if (!js_object.is_null()) {
+    deopt_data->set(0, *js_object);
+  }
+  deopt_data->set(1, Smi::FromInt(index));
+  deopt_data->set_length(2);
+  code->set_deoptimization_data(*deopt_data);
+}
+
 void SetDebugSupport(Factory* factory, Handle<FixedArray> compiled_module,
                      Handle<JSObject> js_object) {
   Isolate* isolate = compiled_module->GetIsolate();
@@ -839,13 +997,7 @@ void SetDebugSupport(Factory* factory, Handle<FixedArray> compiled_module,
     Handle<Code> code = functions->GetValueChecked<Code>(isolate, i);
     DCHECK(code->deoptimization_data() == nullptr ||
            code->deoptimization_data()->length() == 0);
-    Handle<FixedArray> deopt_data = factory->NewFixedArray(2, TENURED);
-    if (!js_object.is_null()) {
-      deopt_data->set(0, *js_object);
-    }
-    deopt_data->set(1, Smi::FromInt(static_cast<int>(i)));
-    deopt_data->set_length(2);
-    code->set_deoptimization_data(*deopt_data);
+    SetFunctionDeoptimizationData(factory, code, js_object, i);
   }
 
   MaybeHandle<ByteArray> function_name_table =
@@ -882,8 +1034,29 @@ bool SetupInstanceHeap(Isolate* isolate, Handle<FixedArray> compiled_module,
   isolate->counters()->wasm_min_mem_pages_count()->AddSample(min_mem_pages);
   // TODO(wasm): re-enable counter for max_mem_pages when we use that field.
 
-  if (memory.is_null() && min_mem_pages > 0) {
-    memory = AllocateMemory(thrower, isolate, min_mem_pages);
+  // Code compiled for the trap handler does not check its memory accesses
+  // and relies on the guard region behind the memory, even an empty one.
+  ModuleOrigin origin = static_cast<ModuleOrigin>(
+      Smi::cast(compiled_module->get(kOrigin))->value());
+  bool needs_guard_region = origin != kAsmJsOrigin && UseTrapHandler();
+  if (!memory.is_null() && needs_guard_region &&
+      !memory->has_guard_region()) {
+    thrower->Error("Memory must be allocated by wasm when using trap handler");
+    return false;
+  }
+  // Atomic operations are only valid on a shared memory, and a shared memory
+  // must not be handed to code that does not expect other threads.
+  bool shared = static_cast<bool>(
+      Smi::cast(compiled_module->get(kSharedMemory))->value());
+  if (!memory.is_null() && memory->is_shared() != shared) {
+    thrower->Error(shared ? "Memory must be a SharedArrayBuffer"
+                          : "Memory must not be a SharedArrayBuffer");
+    return false;
+  }
+
+  if (memory.is_null() && (min_mem_pages > 0 || needs_guard_region)) {
+    memory = AllocateMemory(thrower, isolate, min_mem_pages,
+                            needs_guard_region, shared);
     if (memory.is_null()) {
       return false;
     }
@@ -930,6 +1103,16 @@ bool SetupImports(Isolate* isolate, Handle<FixedArray> compiled_module,
   }
 
   LinkImports(isolate, function_code, import_code);
+
+  // Functions compiled later on call the imports directly.
+  if (Smi::cast(compiled_module->get(kLazyCompilation))->value()) {
+    Handle<FixedArray> import_code_table = isolate->factory()->NewFixedArray(
+        static_cast<int>(import_code.size()), TENURED);
+    for (size_t i = 0; i < import_code.size(); ++i) {
+      import_code_table->set(static_cast<int>(i), *import_code[i]);
+    }
+    instance->SetInternalField(kWasmImportCodeTable, *import_code_table);
+  }
   return true;
 }
 
@@ -959,6 +1142,16 @@ bool SetupExportsObject(Handle<FixedArray> compiled_module, Isolate* isolate,
     Handle<FixedArray> exports;
     if (maybe_exports.ToHandle(&exports)) {
       int exports_size = exports->length();
+      // The wrappers call the baseline code until it gets tiered up.
+      if (compiled_module->get(kTierUpBudgets)->IsByteArray()) {
+        Handle<FixedArray> wrappers =
+            factory->NewFixedArray(exports_size, TENURED);
+        for (int i = 0; i < exports_size; ++i) {
+          wrappers->set(i, exports->GetValueChecked<FixedArray>(isolate, i)
+                               ->get(kExportCode));
+        }
+        instance->SetInternalField(kWasmExportWrappers, *wrappers);
+      }
       for (int i = 0; i < exports_size; ++i) {
         if (thrower->error()) return false;
         Handle<FixedArray> export_metadata =
@@ -994,17 +1187,15 @@ bool SetupExportsObject(Handle<FixedArray> compiled_module, Isolate* isolate,
 
 }  // namespace
 
-MaybeHandle<FixedArray> WasmModule::CompileFunctions(
-    Isolate* isolate, ErrorThrower* thrower) const {
+MaybeHandle<FixedArray> WasmModule::PrepareCompilation(
+    Isolate* isolate, WasmModuleInstance* temp_instance,
+    ModuleEnv* module_env) const {
   Factory* factory = isolate->factory();
 
-  MaybeHandle<FixedArray> nothing;
-
-  WasmModuleInstance temp_instance_for_compilation(this);
-  temp_instance_for_compilation.context = isolate->native_context();
-  temp_instance_for_compilation.mem_size = GetMinModuleMemSize(this);
-  temp_instance_for_compilation.mem_start = nullptr;
-  temp_instance_for_compilation.globals_start = nullptr;
+  temp_instance->context = isolate->native_context();
+  temp_instance->mem_size = GetMinModuleMemSize(this);
+  temp_instance->mem_start = nullptr;
+  temp_instance->globals_start = nullptr;
 
   MaybeHandle<FixedArray> indirect_table =
       function_tables.size()
@@ -1012,7 +1203,7 @@ MaybeHandle<FixedArray> WasmModule::CompileFunctions(
           : MaybeHandle<FixedArray>();
   for (uint32_t i = 0; i < function_tables.size(); ++i) {
     Handle<FixedArray> values = wasm::BuildFunctionTable(isolate, i, this);
-    temp_instance_for_compilation.function_tables[i] = values;
+    temp_instance->function_tables[i] = values;
 
     Handle<FixedArray> metadata = isolate->factory()->NewFixedArray(
         kWasmIndirectFunctionTableMetadataSize);
@@ -1021,26 +1212,48 @@ MaybeHandle<FixedArray> WasmModule::CompileFunctions(
     indirect_table.ToHandleChecked()->set(i, *metadata);
   }
 
-  HistogramTimerScope wasm_compile_module_time_scope(
-      isolate->counters()->wasm_compile_module_time());
+  module_env->module = this;
+  module_env->instance = temp_instance;
+  module_env->origin = origin;
+  InitializePlaceholders(factory, &module_env->placeholders, functions.size());
 
-  ModuleEnv module_env;
-  module_env.module = this;
-  module_env.instance = &temp_instance_for_compilation;
-  module_env.origin = origin;
-  InitializePlaceholders(factory, &module_env.placeholders, functions.size());
-
-  Handle<FixedArray> compiled_functions =
-      factory->NewFixedArray(static_cast<int>(functions.size()), TENURED);
-
-  temp_instance_for_compilation.import_code.resize(import_table.size());
+  temp_instance->import_code.resize(import_table.size());
   for (uint32_t i = 0; i < import_table.size(); ++i) {
-    temp_instance_for_compilation.import_code[i] =
+    temp_instance->import_code[i] =
         CreatePlaceholder(factory, i, Code::WASM_TO_JS_FUNCTION);
   }
+
+  // Each instance counts down its own copy of the budgets.
+  if (TierUpEnabled(this)) {
+    int function_count = static_cast<int>(functions.size());
+    Handle<ByteArray> budgets =
+        factory->NewByteArray(function_count * kIntSize, TENURED);
+    for (int i = 0; i < function_count; ++i) {
+      budgets->set_int(i, FLAG_wasm_tier_up_budget);
+    }
+    temp_instance->tier_up_budgets = budgets;
+  }
   isolate->counters()->wasm_functions_per_module()->AddSample(
       static_cast<int>(functions.size()));
-  if (FLAG_wasm_num_compilation_tasks != 0) {
+  return indirect_table;
+}
+
+MaybeHandle<FixedArray> WasmModule::CompileFunctions(
+    Isolate* isolate, ErrorThrower* thrower, bool will_serialize) const {
+  WasmModuleInstance temp_instance_for_compilation(this);
+  ModuleEnv module_env;
+  MaybeHandle<FixedArray> indirect_table = PrepareCompilation(
+      isolate, &temp_instance_for_compilation, &module_env);
+  module_env.will_serialize = will_serialize;
+
+  HistogramTimerScope wasm_compile_module_time_scope(
+      isolate->counters()->wasm_compile_module_time());
+
+  if (CompileLazily(this)) {
+    InstallLazyCompileStubs(isolate, this,
+                            temp_instance_for_compilation.function_code,
+                            thrower, &module_env);
+  } else if (FLAG_wasm_num_compilation_tasks != 0) {
     CompileInParallel(isolate, this,
                       temp_instance_for_compilation.function_code, thrower,
                       &module_env);
@@ -1049,12 +1262,27 @@ MaybeHandle<FixedArray> WasmModule::CompileFunctions(
                         temp_instance_for_compilation.function_code, thrower,
                         &module_env);
   }
-  if (thrower->error()) return nothing;
+  if (thrower->error()) return MaybeHandle<FixedArray>();
+
+  return CreateCompiledModule(isolate, thrower, &temp_instance_for_compilation,
+                              &module_env, indirect_table);
+}
+
+MaybeHandle<FixedArray> WasmModule::CreateCompiledModule(
+    Isolate* isolate, ErrorThrower* thrower,
+    WasmModuleInstance* temp_instance, ModuleEnv* module_env,
+    MaybeHandle<FixedArray> indirect_table) const {
+  Factory* factory = isolate->factory();
+
+  MaybeHandle<FixedArray> nothing;
+
+  Handle<FixedArray> compiled_functions =
+      factory->NewFixedArray(static_cast<int>(functions.size()), TENURED);
 
   // At this point, compilation has completed. Update the code table.
   for (size_t i = FLAG_skip_compiling_wasm_funcs;
-       i < temp_instance_for_compilation.function_code.size(); ++i) {
-    Code* code = *temp_instance_for_compilation.function_code[i];
+       i < temp_instance->function_code.size(); ++i) {
+    Code* code = *temp_instance->function_code[i];
     compiled_functions->set(static_cast<int>(i), code);
   }
 
@@ -1082,10 +1310,9 @@ MaybeHandle<FixedArray> WasmModule::CompileFunctions(
       const WasmExport& exp = export_table[i];
       WasmName str = GetName(exp.name_offset, exp.name_length);
       Handle<String> name = factory->InternalizeUtf8String(str);
-      Handle<Code> code =
-          temp_instance_for_compilation.function_code[exp.func_index];
+      Handle<Code> code = temp_instance->function_code[exp.func_index];
       Handle<Code> export_code = compiler::CompileJSToWasmWrapper(
-          isolate, &module_env, code, exp.func_index);
+          isolate, module_env, code, exp.func_index);
       if (thrower->error()) return nothing;
       export_metadata->set(kExportCode, *export_code);
       export_metadata->set(kExportName, *name);
@@ -1107,10 +1334,10 @@ MaybeHandle<FixedArray> WasmModule::CompileFunctions(
     uint32_t index = static_cast<uint32_t>(start_function_index);
     HandleScope scope(isolate);
     if (startup_fct.is_null()) {
-      Handle<Code> code = temp_instance_for_compilation.function_code[index];
+      Handle<Code> code = temp_instance->function_code[index];
       DCHECK_EQ(0, functions[index].sig->parameter_count());
       startup_fct =
-          compiler::CompileJSToWasmWrapper(isolate, &module_env, code, index);
+          compiler::CompileJSToWasmWrapper(isolate, module_env, code, index);
     }
     Handle<FixedArray> metadata =
         factory->NewFixedArray(kWasmExportMetadataTableSize, TENURED);
@@ -1134,16 +1361,191 @@ MaybeHandle<FixedArray> WasmModule::CompileFunctions(
   }
 
   Handle<ByteArray> function_name_table =
-      BuildFunctionNamesTable(isolate, module_env.module);
+      BuildFunctionNamesTable(isolate, module_env->module);
   ret->set(kFunctionNameTable, *function_name_table);
   ret->set(kMinRequiredMemory, Smi::FromInt(min_mem_pages));
   if (data_segments.size() > 0) SaveDataSegmentInfo(factory, this, ret);
   ret->set(kGlobalsSize, Smi::FromInt(globals_size));
   ret->set(kExportMem, Smi::FromInt(mem_export));
+  ret->set(kSharedMemory, Smi::FromInt(mem_shared));
   ret->set(kOrigin, Smi::FromInt(origin));
+  ret->set(kLazyCompilation, Smi::FromInt(CompileLazily(this)));
+  if (!temp_instance->tier_up_budgets.is_null()) {
+    ret->set(kTierUpBudgets, *temp_instance->tier_up_budgets);
+  }
   return ret;
 }
 
+StreamingCompilation::StreamingCompilation(Isolate* isolate,
+                                           ErrorThrower* thrower)
+    : isolate_(isolate), thrower_(thrower) {}
+
+StreamingCompilation::~StreamingCompilation() { Cancel(); }
+
+void StreamingCompilation::Cancel() {
+  if (!started()) return;
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    while (!pending_units_.empty()) {
+      delete pending_units_.front();
+      pending_units_.pop();
+    }
+  }
+  WaitForCompilationTasks();
+  while (!executed_units_.empty()) {
+    delete executed_units_.front();
+    executed_units_.pop();
+  }
+  canonical_.reset();
+}
+
+void StreamingCompilation::Start(const WasmModule* module) {
+  DCHECK(!started());
+  partial_module_ = module;
+  temp_instance_.reset(new WasmModuleInstance(module));
+  indirect_table_ =
+      module->PrepareCompilation(isolate_, temp_instance_.get(), &module_env_);
+  max_tasks_ =
+      Min(static_cast<size_t>(FLAG_wasm_num_compilation_tasks),
+          V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads());
+  // Turn on the {CanonicalHandleScope} so that the background threads can
+  // use the node cache.
+  canonical_.reset(new CanonicalHandleScope(isolate_));
+}
+
+void StreamingCompilation::AddFunction(uint32_t index) {
+  DCHECK(started());
+  DCHECK_LT(index, partial_module_->functions.size());
+  if (index < static_cast<uint32_t>(FLAG_skip_compiling_wasm_funcs)) return;
+  if (thrower_->error()) return;
+  // Lazily compiled functions are only validated, by {Finish}.
+  if (CompileLazily(partial_module_)) return;
+  const WasmFunction* function = &partial_module_->functions[index];
+
+  if (FLAG_wasm_num_compilation_tasks == 0) {
+    temp_instance_->function_code[index] =
+        compiler::WasmCompilationUnit::CompileWasmFunction(
+            thrower_, isolate_, &module_env_, function);
+    return;
+  }
+
+  compiler::WasmCompilationUnit* unit = new compiler::WasmCompilationUnit(
+      thrower_, isolate_, &module_env_, function, index);
+  bool spawn_task = false;
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    pending_units_.push(unit);
+    if (running_tasks_ < max_tasks_) {
+      ++running_tasks_;
+      spawn_task = true;
+    }
+  }
+  if (spawn_task) {
+    StreamingCompilationTask* task = new StreamingCompilationTask(
+        isolate_, this, partial_module_->pending_tasks.get());
+    task_ids_.push_back(task->id());
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        task, v8::Platform::kShortRunningTask);
+  }
+  // Finish the units executed so far to free their graph zones early.
+  FinishExecutedUnits();
+}
+
+void StreamingCompilation::ExecutePendingUnits(bool on_background_thread) {
+  DisallowHeapAllocation no_allocation;
+  DisallowHandleAllocation no_handles;
+  DisallowHandleDereference no_deref;
+  DisallowCodeDependencyChange no_dependency_change;
+
+  while (true) {
+    compiler::WasmCompilationUnit* unit = nullptr;
+    {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      if (pending_units_.empty()) {
+        // Leave under the lock, so that {AddFunction} spawns a new task for
+        // units it queues from now on.
+        if (on_background_thread) --running_tasks_;
+        return;
+      }
+      unit = pending_units_.front();
+      pending_units_.pop();
+    }
+    unit->ExecuteCompilation();
+    {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      executed_units_.push(unit);
+    }
+  }
+}
+
+void StreamingCompilation::FinishExecutedUnits() {
+  while (true) {
+    compiler::WasmCompilationUnit* unit = nullptr;
+    {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      if (executed_units_.empty()) return;
+      unit = executed_units_.front();
+      executed_units_.pop();
+    }
+    temp_instance_->function_code[unit->index()] = unit->FinishCompilation();
+    delete unit;
+  }
+}
+
+void StreamingCompilation::WaitForCompilationTasks() {
+  for (uint32_t task_id : task_ids_) {
+    // If the task has not started yet, then we abort it. Otherwise we wait for
+    // it to finish.
+    if (!isolate_->cancelable_task_manager()->TryAbort(task_id)) {
+      partial_module_->pending_tasks->Wait();
+    }
+  }
+  task_ids_.clear();
+  running_tasks_ = 0;
+}
+
+MaybeHandle<FixedArray> StreamingCompilation::Finish(const WasmModule* module) {
+  if (!started() || CompileLazily(module)) {
+    return module->CompileFunctions(isolate_, thrower_);
+  }
+
+  // Execute the units no background task got to, then wait for the others.
+  ExecutePendingUnits(false);
+  WaitForCompilationTasks();
+  FinishExecutedUnits();
+  canonical_.reset();
+  if (thrower_->error()) return MaybeHandle<FixedArray>();
+
+  // The code compiled so far bakes in the global offsets and the function
+  // signatures of {partial_module_}. Sections following the code section
+  // cannot change the latter, but may declare further globals.
+  if (module->globals.size() != partial_module_->globals.size() ||
+      module->functions.size() != partial_module_->functions.size()) {
+    return module->CompileFunctions(isolate_, thrower_);
+  }
+
+  // Compile the functions that were not received before the end of the
+  // stream, or could not be compiled from the stream buffer.
+  module_env_.module = module;
+  for (uint32_t i = FLAG_skip_compiling_wasm_funcs;
+       i < module->functions.size(); ++i) {
+    if (!temp_instance_->function_code[i].is_null()) continue;
+    const WasmFunction& func = module->functions[i];
+    Handle<Code> code = compiler::WasmCompilationUnit::CompileWasmFunction(
+        thrower_, isolate_, &module_env_, &func);
+    if (code.is_null()) {
+      WasmName str = module->GetName(func.name_offset, func.name_length);
+      thrower_->Error("Compilation of #%d:%.*s failed.", i, str.length(),
+                      str.start());
+      return MaybeHandle<FixedArray>();
+    }
+    temp_instance_->function_code[i] = code;
+  }
+
+  return module->CreateCompiledModule(isolate_, thrower_, temp_instance_.get(),
+                                      &module_env_, indirect_table_);
+}
+
 void PatchJSWrapper(Isolate* isolate, Handle<Code> wrapper,
                     Handle<Code> new_target) {
   AllowDeferredHandleDereference embedding_raw_address;
@@ -1190,8 +1592,19 @@ Handle<FixedArray> CloneModuleForInstance(Isolate* isolate,
     }
   }
 
+  // Copy the tier-up budgets, so that each instance tiers up on its own.
+  MaybeHandle<ByteArray> maybe_budgets =
+      original->GetValue<ByteArray>(isolate, kTierUpBudgets);
+  Handle<ByteArray> budgets, clone_budgets;
+  if (maybe_budgets.ToHandle(&budgets)) {
+    clone_budgets = factory->NewByteArray(budgets->length(), TENURED);
+    budgets->copy_out(0, clone_budgets->GetDataStartAddress(),
+                      budgets->length());
+    clone->set(kTierUpBudgets, *clone_budgets);
+  }
+
   // Clone each code, then if indirect tables are used, patch the cloned code to
-  // refer to the cloned kTable.
+  // refer to the cloned kTable. Baseline code also gets the cloned budgets.
   Handle<FixedArray> orig_wasm_functions =
       original->GetValueChecked<FixedArray>(isolate, kFunctions);
   Handle<FixedArray> clone_wasm_functions =
@@ -1203,6 +1616,10 @@ Handle<FixedArray> CloneModuleForInstance(Isolate* isolate,
     Handle<Code> cloned_code = factory->CopyCode(orig_code);
     clone_wasm_functions->set(i, *cloned_code);
 
+    if (!clone_budgets.is_null()) {
+      PatchEmbeddedObject(cloned_code, budgets, clone_budgets);
+    }
+
     if (!clone_indirect_tables.is_null()) {
       for (int j = 0; j < clone_indirect_tables->length(); ++j) {
         Handle<FixedArray> orig_metadata =
@@ -1215,7 +1632,7 @@ Handle<FixedArray> CloneModuleForInstance(Isolate* isolate,
         Handle<FixedArray> clone_table =
             clone_metadata->GetValueChecked<FixedArray>(isolate, kTable);
 
-        PatchFunctionTable(cloned_code, orig_table, clone_table);
+        PatchEmbeddedObject(cloned_code, orig_table, clone_table);
       }
     }
   }
@@ -1305,6 +1722,12 @@ MaybeHandle<JSObject> WasmModule::Instantiate(
       JSObject::kHeaderSize + kWasmModuleInternalFieldCount * kPointerSize);
   Handle<JSObject> js_object = factory->NewJSObjectFromMap(map, TENURED);
   js_object->SetInternalField(kWasmModuleCodeTable, *code_table);
+  if (Smi::cast(compiled_module->get(kLazyCompilation))->value()) {
+    js_object->SetInternalField(kWasmLazyCompileStubs,
+                                *factory->CopyFixedArray(code_table));
+  }
+  js_object->SetInternalField(kWasmTierUpBudgets,
+                              compiled_module->get(kTierUpBudgets));
 
   if (!(SetupInstanceHeap(isolate, compiled_module, js_object, memory,
                           &thrower) &&
@@ -1445,6 +1868,23 @@ SeqOneByteString* GetWasmBytes(JSObject* wasm) {
   return SeqOneByteString::cast(wasm->GetInternalField(kWasmModuleBytesString));
 }
 
+Handle<String> GetCompiledModuleBytes(Isolate* isolate,
+                                      Handle<FixedArray> compiled_module) {
+  return compiled_module->GetValueChecked<String>(isolate, kModuleBytes);
+}
+
+Handle<JSObject> CreateModuleObject(Isolate* isolate,
+                                    Handle<FixedArray> compiled_module,
+                                    Handle<Object> source) {
+  Handle<Context> native_context = isolate->native_context();
+  Handle<JSFunction> module_cons(native_context->wasm_module_constructor());
+  Handle<JSObject> module_obj = isolate->factory()->NewJSObject(module_cons);
+  module_obj->SetInternalField(0, *compiled_module);
+  Handle<Symbol> module_sym(native_context->wasm_module_sym());
+  Object::SetProperty(module_obj, module_sym, source, STRICT).Check();
+  return module_obj;
+}
+
 Handle<WasmDebugInfo> GetDebugInfo(Handle<JSObject> wasm) {
   Handle<Object> info(wasm->GetInternalField(kWasmDebugInfo),
                       wasm->GetIsolate());
@@ -1487,6 +1927,607 @@ bool UpdateWasmModuleMemory(Handle<JSObject> object, Address old_start,
   return true;
 }
 
+namespace {
+
+// Returns the code that the instance of the wasm function {code} has
+// installed for that function, which differs from {code} if it is a lazy
+// compile stub or baseline code that has been replaced.
+Code* GetInstalledCode(Code* code) {
+  FixedArray* deopt_data = code->deoptimization_data();
+  if (deopt_data->length() != 2 || !deopt_data->get(0)->IsJSObject()) {
+    return code;
+  }
+  JSObject* instance = JSObject::cast(deopt_data->get(0));
+  int index = Smi::cast(deopt_data->get(1))->value();
+  FixedArray* code_table =
+      FixedArray::cast(instance->GetInternalField(kWasmModuleCodeTable));
+  return Code::cast(code_table->get(index));
+}
+
+// Redirects the calls of {code} to lazy compile stubs or baseline code that
+// have been replaced to the code that replaced them. If {replacement} is
+// given, only the calls to code replaced by it are redirected.
+void PatchReplacedCalls(Isolate* isolate, Handle<Code> code,
+                        Code* replacement = nullptr) {
+  bool modified = false;
+  {
+    DisallowHeapAllocation no_allocation;
+    for (RelocIterator it(*code, RelocInfo::kCodeTargetMask); !it.done();
+         it.next()) {
+      if (!RelocInfo::IsCodeTarget(it.rinfo()->rmode())) continue;
+      Code* target =
+          Code::GetCodeFromTargetAddress(it.rinfo()->target_address());
+      if (target->kind() != Code::WASM_FUNCTION) continue;
+      Code* installed = GetInstalledCode(target);
+      if (installed == target) continue;
+      if (replacement != nullptr && installed != replacement) continue;
+      it.rinfo()->set_target_address(installed->instruction_start(),
+                                     UPDATE_WRITE_BARRIER, SKIP_ICACHE_FLUSH);
+      modified = true;
+    }
+  }
+  if (modified) {
+    Assembler::FlushICache(isolate, code->instruction_start(),
+                           code->instruction_size());
+  }
+}
+
+// Replaces the code that has been replaced in the code table of {instance}
+// in its indirect function tables as well.
+void PatchReplacedCodeInFunctionTables(Isolate* isolate,
+                                       Handle<JSObject> instance) {
+  Object* tables = instance->GetInternalField(kWasmModuleFunctionTable);
+  if (!tables->IsFixedArray()) return;
+  Handle<FixedArray> indirect_tables(FixedArray::cast(tables), isolate);
+  for (int i = 0; i < indirect_tables->length(); ++i) {
+    Handle<FixedArray> metadata =
+        indirect_tables->GetValueChecked<FixedArray>(isolate, i);
+    Handle<FixedArray> table =
+        metadata->GetValueChecked<FixedArray>(isolate, kTable);
+    // The second element of each entry holds the code of the function.
+    for (int j = 1; j < table->length(); j += 2) {
+      Object* entry = table->get(j);
+      if (!entry->IsCode()) continue;
+      Code* installed = GetInstalledCode(Code::cast(entry));
+      if (installed != entry) table->set(j, installed);
+    }
+  }
+}
+
+bool IsLazyCompileStub(Handle<JSObject> instance, uint32_t index) {
+  Object* stubs = instance->GetInternalField(kWasmLazyCompileStubs);
+  return stubs->IsFixedArray() &&
+         FixedArray::cast(stubs)->get(static_cast<int>(index))->IsCode();
+}
+
+// Returns the functions that {function} calls directly, without duplicates.
+std::vector<uint32_t> GetDirectCallees(Isolate* isolate,
+                                       const WasmModule* module,
+                                       const WasmFunction* function) {
+  std::vector<uint32_t> indices;
+  Zone zone(isolate->allocator());
+  AstLocalDecls decls(&zone);
+  for (BytecodeIterator it(module->module_start + function->code_start_offset,
+                           module->module_start + function->code_end_offset,
+                           &decls);
+       it.has_next(); it.next()) {
+    if (it.current() != kExprCallFunction) continue;
+    CallFunctionOperand operand(&it, it.pc());
+    if (operand.index >= module->functions.size()) continue;
+    if (std::find(indices.begin(), indices.end(), operand.index) !=
+        indices.end()) {
+      continue;
+    }
+    indices.push_back(operand.index);
+  }
+  return indices;
+}
+
+// The module of an instance decoded from its module bytes, for compiling
+// functions of the instance after instantiation. Lazy compilation and
+// background compile jobs share it by reference counting, so a job still
+// running when the instance dies keeps the module alive. Compilation units
+// read the function bodies off the module bytes, so it owns a copy of them.
+class DecodedModule {
+ public:
+  // Returns the decoded module of {instance}, decoding it on first use.
+  static std::shared_ptr<const DecodedModule> Get(Isolate* isolate,
+                                                  Handle<JSObject> instance,
+                                                  ErrorThrower* thrower);
+
+  const WasmModule* module() const { return module_.get(); }
+
+  // Returns the functions that call function {func_index} directly. The
+  // callers of all functions are collected on first use, which must be on the
+  // main thread.
+  const std::vector<uint32_t>& GetCallers(Isolate* isolate,
+                                          uint32_t func_index) const;
+
+ private:
+  explicit DecodedModule(Isolate* isolate) : zone_(isolate->allocator()) {}
+
+  Zone zone_;
+  std::unique_ptr<byte[]> bytes_;
+  std::unique_ptr<const WasmModule> module_;
+  mutable std::vector<std::vector<uint32_t>> callers_;
+
+  DISALLOW_COPY_AND_ASSIGN(DecodedModule);
+};
+
+// The instance refers to its decoded module through a Foreign, which owns a
+// reference until the weak callback of the Foreign runs.
+struct DecodedModuleHolder {
+  std::shared_ptr<const DecodedModule> decoded;
+  Object** location;
+};
+
+void DeleteDecodedModuleHolder(const v8::WeakCallbackInfo<void>& data) {
+  DecodedModuleHolder* holder =
+      reinterpret_cast<DecodedModuleHolder*>(data.GetParameter());
+  GlobalHandles::Destroy(holder->location);
+  delete holder;
+}
+
+std::shared_ptr<const DecodedModule> DecodedModule::Get(
+    Isolate* isolate, Handle<JSObject> instance, ErrorThrower* thrower) {
+  Object* field = instance->GetInternalField(kWasmDecodedModule);
+  if (field->IsForeign()) {
+    return reinterpret_cast<DecodedModuleHolder*>(
+               Foreign::cast(field)->foreign_address())
+        ->decoded;
+  }
+
+  // The function bodies were verified when the module was compiled.
+  std::shared_ptr<DecodedModule> decoded(new DecodedModule(isolate));
+  Handle<SeqOneByteString> module_bytes(GetWasmBytes(*instance), isolate);
+  int length = module_bytes->length();
+  decoded->bytes_.reset(new byte[length]);
+  memcpy(decoded->bytes_.get(), module_bytes->GetChars(), length);
+  ModuleResult result = DecodeWasmModule(
+      isolate, &decoded->zone_, decoded->bytes_.get(),
+      decoded->bytes_.get() + length, false, kWasmOrigin);
+  decoded->module_.reset(result.val);
+  if (result.failed()) {
+    thrower->Failed("", result);
+    return nullptr;
+  }
+
+  DecodedModuleHolder* holder = new DecodedModuleHolder();
+  holder->decoded = decoded;
+  Handle<Foreign> foreign = isolate->factory()->NewForeign(
+      reinterpret_cast<Address>(holder), TENURED);
+  Handle<Object> global = isolate->global_handles()->Create(*foreign);
+  holder->location = global.location();
+  GlobalHandles::MakeWeak(global.location(), holder,
+                          &DeleteDecodedModuleHolder,
+                          v8::WeakCallbackType::kParameter);
+  instance->SetInternalField(kWasmDecodedModule, *foreign);
+  return decoded;
+}
+
+const std::vector<uint32_t>& DecodedModule::GetCallers(
+    Isolate* isolate, uint32_t func_index) const {
+  if (callers_.empty()) {
+    callers_.resize(module_->functions.size());
+    for (const WasmFunction& function : module_->functions) {
+      for (uint32_t callee : GetDirectCallees(isolate, module(), &function)) {
+        callers_[callee].push_back(function.func_index);
+      }
+    }
+  }
+  return callers_[func_index];
+}
+
+// Collects the functions that {function} calls directly and that are not
+// compiled yet, as the ones most likely to be called next.
+std::vector<uint32_t> GetUncompiledCallees(Handle<JSObject> instance,
+                                           const WasmModule* module,
+                                           const WasmFunction* function) {
+  std::vector<uint32_t> indices =
+      GetDirectCallees(instance->GetIsolate(), module, function);
+  indices.erase(std::remove_if(indices.begin(), indices.end(),
+                               [&instance](uint32_t index) {
+                                 return !IsLazyCompileStub(instance, index);
+                               }),
+                indices.end());
+  return indices;
+}
+
+// Sets up {temp_instance} to compile against the current state of
+// {instance}, which saves the relocation that instantiation performs on
+// eagerly compiled code. Without placeholders, direct calls target the code
+// table of the instance as it is, stubs and baseline code included.
+void InitializeFromInstance(Isolate* isolate, Handle<JSObject> instance,
+                            WasmModuleInstance* temp_instance) {
+  temp_instance->js_object = instance;
+  temp_instance->context = isolate->native_context();
+  Object* memory = instance->GetInternalField(kWasmMemArrayBuffer);
+  if (memory->IsJSArrayBuffer()) {
+    JSArrayBuffer* buffer = JSArrayBuffer::cast(memory);
+    temp_instance->mem_start = static_cast<byte*>(buffer->backing_store());
+    temp_instance->mem_size =
+        static_cast<uint32_t>(buffer->byte_length()->Number());
+  }
+  Object* globals = instance->GetInternalField(kWasmGlobalsArrayBuffer);
+  if (globals->IsJSArrayBuffer()) {
+    temp_instance->globals_start = static_cast<byte*>(
+        JSArrayBuffer::cast(globals)->backing_store());
+  }
+  Object* tables = instance->GetInternalField(kWasmModuleFunctionTable);
+  if (tables->IsFixedArray()) {
+    Handle<FixedArray> indirect_tables(FixedArray::cast(tables), isolate);
+    for (int i = 0; i < indirect_tables->length(); ++i) {
+      Handle<FixedArray> metadata =
+          indirect_tables->GetValueChecked<FixedArray>(isolate, i);
+      temp_instance->function_tables[i] =
+          metadata->GetValueChecked<FixedArray>(isolate, kTable);
+    }
+  }
+  Handle<FixedArray> code_table(
+      FixedArray::cast(instance->GetInternalField(kWasmModuleCodeTable)),
+      isolate);
+  for (int i = 0; i < code_table->length(); ++i) {
+    if (!code_table->get(i)->IsCode()) continue;
+    temp_instance->function_code[i] =
+        code_table->GetValueChecked<Code>(isolate, i);
+  }
+  Object* imports = instance->GetInternalField(kWasmImportCodeTable);
+  if (imports->IsFixedArray()) {
+    Handle<FixedArray> import_code(FixedArray::cast(imports), isolate);
+    for (int i = 0; i < import_code->length(); ++i) {
+      temp_instance->import_code[i] =
+          import_code->GetValueChecked<Code>(isolate, i);
+    }
+  }
+}
+
+// Lazily compiled functions of modules compiled for tier-up are baseline
+// code as well.
+void SetUpBaselineCompilation(Isolate* isolate, Handle<JSObject> instance,
+                              WasmModuleInstance* temp_instance) {
+  Object* budgets = instance->GetInternalField(kWasmTierUpBudgets);
+  if (budgets->IsByteArray()) {
+    temp_instance->tier_up_budgets = handle(ByteArray::cast(budgets), isolate);
+  }
+}
+
+// Installs {code} for function {func_index} of {instance} in place of its
+// lazy compile stub. Stale direct calls to the stub are patched when they
+// next reach it.
+void InstallLazilyCompiledCode(Isolate* isolate, Handle<JSObject> instance,
+                               uint32_t func_index, Handle<Code> code) {
+  SetFunctionDeoptimizationData(isolate->factory(), code, instance,
+                                static_cast<int>(func_index));
+  RecordStats(isolate, *code);
+  Assembler::FlushICache(isolate, code->instruction_start(),
+                         code->instruction_size());
+  Handle<FixedArray> code_table(
+      FixedArray::cast(instance->GetInternalField(kWasmModuleCodeTable)),
+      isolate);
+  Handle<FixedArray> stubs(
+      FixedArray::cast(instance->GetInternalField(kWasmLazyCompileStubs)),
+      isolate);
+  code_table->set(static_cast<int>(func_index), *code);
+  stubs->set_undefined(static_cast<int>(func_index));
+  PatchReplacedCodeInFunctionTables(isolate, instance);
+}
+
+// Compiles a function of an instance on a background thread of the
+// optimizing compile dispatcher, either ahead of its first call or to
+// recompile hot baseline code with all optimizations. The job holds a
+// reference to the decoded module of the instance, and the handles of the
+// instance state to compile against live as long as the job.
+class BackgroundCompileJob final : public CompilationJob {
+ public:
+  enum Purpose { kPrefetch, kTierUp };
+
+  BackgroundCompileJob(Isolate* isolate, uint32_t func_index, Purpose purpose)
+      // Note that the CompilationInfo is not initialized at the time we pass it
+      // to the CompilationJob constructor, but it is not dereferenced there.
+      : CompilationJob(&info_, "TurboFan"),
+        zone_(isolate->allocator()),
+        info_(CStrVector(purpose == kPrefetch ? "wasm-prefetch"
+                                              : "wasm-tier-up"),
+              isolate, &zone_, Code::ComputeFlags(Code::WASM_FUNCTION)),
+        func_index_(func_index),
+        purpose_(purpose),
+        thrower_(isolate, purpose == kPrefetch ? "WasmCompileLazy"
+                                               : "WasmTierUp") {}
+
+  // Prepares the compilation of the function in {instance}. All handles that
+  // the job keeps are created here, in a deferred handle scope.
+  bool Initialize(Handle<JSObject> instance) {
+    Isolate* isolate = info_.isolate();
+    DeferredHandleScope deferred(isolate);
+    instance_ = handle(*instance, isolate);
+    decoded_ = DecodedModule::Get(isolate, instance_, &thrower_);
+    if (decoded_) {
+      const WasmModule* module = decoded_->module();
+      DCHECK_LT(func_index_, module->functions.size());
+      temp_instance_.reset(new WasmModuleInstance(module));
+      InitializeFromInstance(isolate, instance_, temp_instance_.get());
+      if (purpose_ == kPrefetch) {
+        SetUpBaselineCompilation(isolate, instance_, temp_instance_.get());
+      }
+      module_env_.module = module;
+      module_env_.instance = temp_instance_.get();
+      module_env_.origin = kWasmOrigin;
+      unit_.reset(new compiler::WasmCompilationUnit(
+          &thrower_, isolate, &module_env_, &module->functions[func_index_],
+          func_index_));
+    }
+    info_.set_deferred_handles(deferred.Detach());
+    if (!decoded_) thrower_.Reify();
+    return decoded_ != nullptr;
+  }
+
+ protected:
+  Status CreateGraphImpl() final { return SUCCEEDED; }
+
+  Status OptimizeGraphImpl() final {
+    unit_->ExecuteCompilation();
+    return SUCCEEDED;
+  }
+
+  Status GenerateCodeImpl() final;
+
+ private:
+  // Adapts the code to a memory that grew or moved while it was compiled.
+  void UpdateMemoryReferences(Handle<Code> code);
+
+  Zone zone_;
+  CompilationInfo info_;
+  uint32_t func_index_;
+  Purpose purpose_;
+  ErrorThrower thrower_;
+  Handle<JSObject> instance_;
+  std::shared_ptr<const DecodedModule> decoded_;
+  std::unique_ptr<WasmModuleInstance> temp_instance_;
+  ModuleEnv module_env_;
+  std::unique_ptr<compiler::WasmCompilationUnit> unit_;
+
+  DISALLOW_COPY_AND_ASSIGN(BackgroundCompileJob);
+};
+
+void BackgroundCompileJob::UpdateMemoryReferences(Handle<Code> code) {
+  Object* memory = instance_->GetInternalField(kWasmMemArrayBuffer);
+  if (!memory->IsJSArrayBuffer()) return;
+  JSArrayBuffer* buffer = JSArrayBuffer::cast(memory);
+  Address mem_start = static_cast<Address>(buffer->backing_store());
+  uint32_t mem_size = static_cast<uint32_t>(buffer->byte_length()->Number());
+  if (mem_start == temp_instance_->mem_start &&
+      mem_size == temp_instance_->mem_size) {
+    return;
+  }
+  int mask = RelocInfo::ModeMask(RelocInfo::WASM_MEMORY_REFERENCE) |
+             RelocInfo::ModeMask(RelocInfo::WASM_MEMORY_SIZE_REFERENCE);
+  for (RelocIterator it(*code, mask); !it.done(); it.next()) {
+    it.rinfo()->update_wasm_memory_reference(
+        temp_instance_->mem_start, mem_start, temp_instance_->mem_size,
+        mem_size);
+  }
+}
+
+CompilationJob::Status BackgroundCompileJob::GenerateCodeImpl() {
+  Isolate* isolate = info_.isolate();
+  Handle<Code> code = unit_->FinishCompilation();
+  if (code.is_null()) {
+    // The function keeps its stub or baseline code.
+    thrower_.Reify();
+    return FAILED;
+  }
+  if (purpose_ == kPrefetch) {
+    // The first call of the function may have compiled it meanwhile.
+    if (!IsLazyCompileStub(instance_, func_index_)) return SUCCEEDED;
+    UpdateMemoryReferences(code);
+    InstallLazilyCompiledCode(isolate, instance_, func_index_, code);
+    return SUCCEEDED;
+  }
+
+  SetFunctionDeoptimizationData(isolate->factory(), code, instance_,
+                                static_cast<int>(func_index_));
+  RecordStats(isolate, *code);
+  UpdateMemoryReferences(code);
+  PatchReplacedCalls(isolate, code);
+  Assembler::FlushICache(isolate, code->instruction_start(),
+                         code->instruction_size());
+
+  // Swap in the code and redirect the calls to the baseline code, which only
+  // the direct callers of the function and its export wrappers make. Baseline
+  // code that is still running keeps working, it just keeps the calls it
+  // makes until it returns.
+  Handle<FixedArray> code_table(
+      FixedArray::cast(instance_->GetInternalField(kWasmModuleCodeTable)),
+      isolate);
+  code_table->set(static_cast<int>(func_index_), *code);
+  for (uint32_t caller : decoded_->GetCallers(isolate, func_index_)) {
+    PatchReplacedCalls(
+        isolate,
+        code_table->GetValueChecked<Code>(isolate, static_cast<int>(caller)),
+        *code);
+  }
+  Object* wrappers = instance_->GetInternalField(kWasmExportWrappers);
+  if (wrappers->IsFixedArray()) {
+    Handle<FixedArray> export_wrappers(FixedArray::cast(wrappers), isolate);
+    const std::vector<WasmExport>& exports = decoded_->module()->export_table;
+    DCHECK_EQ(exports.size(), static_cast<size_t>(export_wrappers->length()));
+    for (size_t i = 0; i < exports.size(); ++i) {
+      if (exports[i].func_index != func_index_) continue;
+      PatchReplacedCalls(isolate,
+                         export_wrappers->GetValueChecked<Code>(
+                             isolate, static_cast<int>(i)),
+                         *code);
+    }
+  }
+  PatchReplacedCodeInFunctionTables(isolate, instance_);
+  return SUCCEEDED;
+}
+
+// Queues the direct callees of function {func_index} that are still lazy
+// compile stubs for compilation in the background, as the functions most
+// likely to be called next. Without concurrent recompilation they are
+// compiled on their first call instead.
+void PrefetchCallees(Isolate* isolate, Handle<JSObject> instance,
+                     const WasmModule* module, uint32_t func_index) {
+  if (!isolate->concurrent_recompilation_enabled()) return;
+  OptimizingCompileDispatcher* dispatcher =
+      isolate->optimizing_compile_dispatcher();
+  for (uint32_t index : GetUncompiledCallees(instance, module,
+                                             &module->functions[func_index])) {
+    if (!dispatcher->IsQueueAvailable()) return;
+    std::unique_ptr<BackgroundCompileJob> job(new BackgroundCompileJob(
+        isolate, index, BackgroundCompileJob::kPrefetch));
+    if (!job->Initialize(instance)) return;
+    dispatcher->QueueForOptimization(job.release());
+  }
+}
+
+// Compiles function {func_index} of {instance}, which must still be a lazy
+// compile stub, and installs the code in place of the stub.
+bool CompileAndInstall(Isolate* isolate, Handle<JSObject> instance,
+                       uint32_t func_index, ErrorThrower* thrower) {
+  HistogramTimerScope wasm_compile_function_time_scope(
+      isolate->counters()->wasm_compile_function_time());
+
+  std::shared_ptr<const DecodedModule> decoded =
+      DecodedModule::Get(isolate, instance, thrower);
+  if (!decoded) return false;
+  const WasmModule* module = decoded->module();
+  DCHECK_LT(func_index, module->functions.size());
+
+  WasmModuleInstance temp_instance(module);
+  InitializeFromInstance(isolate, instance, &temp_instance);
+  SetUpBaselineCompilation(isolate, instance, &temp_instance);
+
+  ModuleEnv module_env;
+  module_env.module = module;
+  module_env.instance = &temp_instance;
+  module_env.origin = kWasmOrigin;
+
+  Handle<Code> code = compiler::WasmCompilationUnit::CompileWasmFunction(
+      thrower, isolate, &module_env, &module->functions[func_index]);
+  if (thrower->error()) return false;
+  InstallLazilyCompiledCode(isolate, instance, func_index, code);
+  PrefetchCallees(isolate, instance, module, func_index);
+  return true;
+}
+
+}  // namespace
+
+MaybeHandle<Code> CompileLazy(Isolate* isolate, Handle<Code> stub,
+                              Handle<Code> caller) {
+  FixedArray* deopt_data = stub->deoptimization_data();
+  DCHECK_EQ(2, deopt_data->length());
+  Handle<JSObject> instance(JSObject::cast(deopt_data->get(0)), isolate);
+  uint32_t func_index =
+      static_cast<uint32_t>(Smi::cast(deopt_data->get(1))->value());
+
+  // Callers that have not been patched yet may call a stub that has been
+  // replaced already.
+  if (IsLazyCompileStub(instance, func_index)) {
+    ErrorThrower thrower(isolate, "WasmCompileLazy");
+    if (!CompileAndInstall(isolate, instance, func_index, &thrower)) {
+      isolate->Throw(*thrower.Reify());
+      return MaybeHandle<Code>();
+    }
+  }
+  PatchReplacedCalls(isolate, caller);
+  return handle(GetInstalledCode(*stub), isolate);
+}
+
+void TierUp(Isolate* isolate, Handle<Code> code) {
+  FixedArray* deopt_data = code->deoptimization_data();
+  DCHECK_EQ(2, deopt_data->length());
+  Handle<JSObject> instance(JSObject::cast(deopt_data->get(0)), isolate);
+  uint32_t func_index =
+      static_cast<uint32_t>(Smi::cast(deopt_data->get(1))->value());
+  Handle<ByteArray> budgets(
+      ByteArray::cast(instance->GetInternalField(kWasmTierUpBudgets)),
+      isolate);
+
+  OptimizingCompileDispatcher* dispatcher =
+      isolate->concurrent_recompilation_enabled()
+          ? isolate->optimizing_compile_dispatcher()
+          : nullptr;
+  if (dispatcher != nullptr && !dispatcher->IsQueueAvailable()) {
+    // Try again later.
+    budgets->set_int(static_cast<int>(func_index), FLAG_wasm_tier_up_budget);
+    return;
+  }
+  // Each function is recompiled at most once. Baseline code that has been
+  // replaced already may still be running, e.g. in a loop.
+  budgets->set_int(static_cast<int>(func_index), kMaxInt);
+  if (GetInstalledCode(*code) != *code) return;
+
+  std::unique_ptr<BackgroundCompileJob> job(new BackgroundCompileJob(
+      isolate, func_index, BackgroundCompileJob::kTierUp));
+  if (!job->Initialize(instance)) return;
+  if (dispatcher != nullptr) {
+    dispatcher->QueueForOptimization(job.release());
+  } else if (job->OptimizeGraph() == CompilationJob::SUCCEEDED) {
+    USE(job->GenerateCode());
+  }
+}
+
+namespace {
+
+// Baseline code refers to the tier-up budgets of its instance.
+bool IsBaselineCode(Code* code, Object* budgets) {
+  for (RelocIterator it(code, RelocInfo::ModeMask(RelocInfo::EMBEDDED_OBJECT));
+       !it.done(); it.next()) {
+    if (it.rinfo()->target_object() == budgets) return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+WasmFunctionTier GetExportedFunctionTier(Isolate* isolate,
+                                         Handle<JSFunction> function,
+                                         bool sync) {
+  Handle<JSObject> instance(JSObject::cast(function->GetInternalField(0)),
+                            isolate);
+  Code* target = nullptr;
+  for (RelocIterator it(function->code(), RelocInfo::kCodeTargetMask);
+       !it.done(); it.next()) {
+    Code* code = Code::GetCodeFromTargetAddress(it.rinfo()->target_address());
+    if (code->kind() != Code::WASM_FUNCTION) continue;
+    target = code;
+    break;
+  }
+  CHECK_NOT_NULL(target);
+  FixedArray* deopt_data = target->deoptimization_data();
+  // Only lazily compiled functions and baseline code carry their index.
+  if (deopt_data->length() != 2) return kWasmOptimized;
+  int func_index = Smi::cast(deopt_data->get(1))->value();
+  if (IsLazyCompileStub(instance, func_index)) return kWasmLazyCompileStub;
+  Object* budgets = instance->GetInternalField(kWasmTierUpBudgets);
+  if (!budgets->IsByteArray()) return kWasmOptimized;
+
+  FixedArray* code_table =
+      FixedArray::cast(instance->GetInternalField(kWasmModuleCodeTable));
+  // Baseline code may be queued for tier-up once its budget is set beyond
+  // reach. Compiling the queued jobs takes bounded time, but the tier-up
+  // can still fail, so the function is not guaranteed to be optimized
+  // afterwards.
+  if (sync && isolate->concurrent_recompilation_enabled() &&
+      IsBaselineCode(Code::cast(code_table->get(func_index)), budgets) &&
+      ByteArray::cast(budgets)->get_int(func_index) >
+          FLAG_wasm_tier_up_budget) {
+    OptimizingCompileDispatcher* dispatcher =
+        isolate->optimizing_compile_dispatcher();
+    dispatcher->AwaitCompileTasks();
+    dispatcher->InstallOptimizedFunctions();
+    // Installing code can allocate and move the arrays.
+    code_table =
+        FixedArray::cast(instance->GetInternalField(kWasmModuleCodeTable));
+    budgets = instance->GetInternalField(kWasmTierUpBudgets);
+  }
+  return IsBaselineCode(Code::cast(code_table->get(func_index)), budgets)
+             ? kWasmBaseline
+             : kWasmOptimized;
+}
+
 Handle<FixedArray> BuildFunctionTable(Isolate* isolate, uint32_t index,
                                       const WasmModule* module) {
   const WasmIndirectFunctionTable* table = &module->function_tables[index];
@@ -1494,30 +2535,34 @@ Handle<FixedArray> BuildFunctionTable(Isolate* isolate, uint32_t index,
   DCHECK_GE(table->max_size, table->size);
   Handle<FixedArray> values =
       isolate->factory()->NewFixedArray(2 * table->max_size);
+  // Each signature is stored next to its code, so that an indirect call
+  // loads both from the same cache line.
   for (uint32_t i = 0; i < table->size; ++i) {
     const WasmFunction* function = &module->functions[table->values[i]];
-    values->set(i, Smi::FromInt(function->sig_index));
-    values->set(i + table->max_size, Smi::FromInt(table->values[i]));
+    int32_t sig_index = module->signature_map.Find(function->sig);
+    DCHECK_LE(0, sig_index);
+    values->set(2 * i, Smi::FromInt(sig_index));
+    values->set(2 * i + 1, Smi::FromInt(table->values[i]));
   }
-  // Set the remaining elements to -1 (instead of "undefined"). These
+  // Set the remaining signatures to -1 (instead of "undefined"). These
   // elements are accessed directly as SMIs (without a check). On 64-bit
   // platforms, it is possible to have the top bits of "undefined" take
   // small integer values (or zero), which are more likely to be equal to
   // the signature index we check against.
   for (uint32_t i = table->size; i < table->max_size; i++) {
-    values->set(i, Smi::FromInt(-1));
+    values->set(2 * i, Smi::FromInt(-1));
   }
   return values;
 }
 
 void PopulateFunctionTable(Handle<FixedArray> table, uint32_t table_size,
                            const std::vector<Handle<Code>>* code_table) {
-  uint32_t max_size = table->length() / 2;
-  for (uint32_t i = max_size; i < max_size + table_size; ++i) {
-    int index = Smi::cast(table->get(static_cast<int>(i)))->value();
+  for (uint32_t i = 0; i < table_size; ++i) {
+    int entry = static_cast<int>(2 * i + 1);
+    int index = Smi::cast(table->get(entry))->value();
     DCHECK_GE(index, 0);
     DCHECK_LT(static_cast<size_t>(index), code_table->size());
-    table->set(static_cast<int>(i), *(*code_table)[index]);
+    table->set(entry, *(*code_table)[index]);
   }
 }
 
@@ -1561,8 +2606,15 @@ int32_t CompileAndRunWasmModule(Isolate* isolate, const byte* module_start,
       module->CompileFunctions(isolate, &thrower);
 
   if (compiled_module.is_null()) return -1;
+  return InstantiateAndRunWasmModule(
+      isolate, compiled_module.ToHandleChecked(), &thrower);
+}
+
+int32_t InstantiateAndRunWasmModule(Isolate* isolate,
+                                    Handle<FixedArray> compiled_module,
+                                    ErrorThrower* thrower) {
   Handle<JSObject> instance =
-      WasmModule::Instantiate(isolate, compiled_module.ToHandleChecked(),
+      WasmModule::Instantiate(isolate, compiled_module,
                               Handle<JSReceiver>::null(),
                               Handle<JSArrayBuffer>::null())
           .ToHandleChecked();
@@ -1585,7 +2637,7 @@ int32_t CompileAndRunWasmModule(Isolate* isolate, const byte* module_start,
 
   // The result should be a number.
   if (retval.is_null()) {
-    thrower.Error("WASM.compileRun() failed: Invocation was null");
+    thrower->Error("WASM.compileRun() failed: Invocation was null");
     return -1;
   }
   Handle<Object> result = retval.ToHandleChecked();
@@ -1595,7 +2647,7 @@ int32_t CompileAndRunWasmModule(Isolate* isolate, const byte* module_start,
   if (result->IsHeapNumber()) {
     return static_cast<int32_t>(HeapNumber::cast(*result)->value());
   }
-  thrower.Error("WASM.compileRun() failed: Return value should be number");
+  thrower->Error("WASM.compileRun() failed: Return value should be number");
   return -1;
 }
 
@@ -6,9 +6,11 @@
 #define V8_WASM_MODULE_H_
 
 #include <memory>
+#include <queue>
 
 #include "src/api.h"
 #include "src/handles.h"
+#include "src/wasm/signature-map.h"
 #include "src/wasm/wasm-opcodes.h"
 #include "src/wasm/wasm-result.h"
 
@@ -98,6 +100,9 @@ enum WasmFunctionDeclBit {
   kDeclFunctionExport = 0x08
 };
 
+// Flags of the memory declaration.
+enum WasmMemoryDeclBit { kMemoryExportFlag = 0x01, kMemorySharedFlag = 0x02 };
+
 // Constants for fixed-size elements within a module.
 static const size_t kDeclMemorySize = 3;
 static const size_t kDeclDataSegmentSize = 13;
@@ -158,6 +163,9 @@ struct WasmIndirectFunctionTable {
 
 enum ModuleOrigin { kWasmOrigin, kAsmJsOrigin };
 
+struct ModuleEnv;
+struct WasmModuleInstance;
+
 // Static representation of a module.
 struct WasmModule {
   static const uint32_t kPageSize = 0x10000;    // Page size, 64kb.
@@ -169,6 +177,7 @@ struct WasmModule {
   uint32_t min_mem_pages;     // minimum size of the memory in 64k pages.
   uint32_t max_mem_pages;     // maximum size of the memory in 64k pages.
   bool mem_export;            // true if the memory is exported.
+  bool mem_shared;            // true if the memory is shared.
   bool mem_external;          // true if the memory is external.
   // TODO(wasm): reconcile start function index being an int with
   // the fact that we index on uint32_t, so we may technically not be
@@ -179,6 +188,7 @@ struct WasmModule {
   std::vector<WasmGlobal> globals;             // globals in this module.
   uint32_t globals_size;                       // size of globals table.
   std::vector<FunctionSig*> signatures;        // signatures in this module.
+  SignatureMap signature_map;                  // canonical signatures.
   std::vector<WasmFunction> functions;         // functions in this module.
   std::vector<WasmDataSegment> data_segments;  // data segments in this module.
   std::vector<WasmIndirectFunctionTable> function_tables;  // function tables.
@@ -237,9 +247,24 @@ struct WasmModule {
                                            Handle<JSArrayBuffer> memory);
 
   MaybeHandle<FixedArray> CompileFunctions(Isolate* isolate,
-                                           ErrorThrower* thrower) const;
+                                           ErrorThrower* thrower,
+                                           bool will_serialize = false) const;
 
  private:
+  friend class StreamingCompilation;
+
+  // Sets up {temp_instance} and {module_env} for compiling the functions of
+  // this module, and returns the indirect function tables they refer to.
+  MaybeHandle<FixedArray> PrepareCompilation(Isolate* isolate,
+                                             WasmModuleInstance* temp_instance,
+                                             ModuleEnv* module_env) const;
+
+  // Creates the compiled module from the function code in {temp_instance}.
+  MaybeHandle<FixedArray> CreateCompiledModule(
+      Isolate* isolate, ErrorThrower* thrower,
+      WasmModuleInstance* temp_instance, ModuleEnv* module_env,
+      MaybeHandle<FixedArray> indirect_table) const;
+
   DISALLOW_COPY_AND_ASSIGN(WasmModule);
 };
 
@@ -254,6 +279,7 @@ struct WasmModuleInstance {
   std::vector<Handle<FixedArray>> function_tables;  // indirect function tables.
   std::vector<Handle<Code>> function_code;  // code objects for each function.
   std::vector<Handle<Code>> import_code;    // code objects for each import.
+  Handle<ByteArray> tier_up_budgets;  // maybe budgets of baseline code.
   // -- raw memory ------------------------------------------------------------
   byte* mem_start;  // start of linear memory.
   uint32_t mem_size;  // size of the linear memory.
@@ -276,6 +302,9 @@ struct ModuleEnv {
   const WasmModule* module;
   WasmModuleInstance* instance;
   ModuleOrigin origin;
+  // True if the compiled code is going to be serialized, in which case it
+  // needs relocation info for all external references.
+  bool will_serialize = false;
   // TODO(mtrofin): remove this once we introduce WASM_DIRECT_CALL
   // reloc infos.
   std::vector<Handle<Code>> placeholders;
@@ -311,6 +340,14 @@ struct ModuleEnv {
     DCHECK(IsValidSignature(index));
     return module->signatures[index];
   }
+  // Structurally equal signatures share the same canonical index, which
+  // indirect calls check against the function tables.
+  uint32_t GetCanonicalSignatureIndex(uint32_t index) const {
+    DCHECK(IsValidSignature(index));
+    int32_t canonical = module->signature_map.Find(module->signatures[index]);
+    DCHECK_LE(0, canonical);
+    return static_cast<uint32_t>(canonical);
+  }
   const WasmIndirectFunctionTable* GetTable(uint32_t index) const {
     DCHECK(IsValidTable(index));
     return &module->function_tables[index];
@@ -328,6 +365,61 @@ struct ModuleEnv {
   compiler::CallDescriptor* GetCallDescriptor(Zone* zone, uint32_t index);
 };
 
+// Compiles the functions of a module while the bytes following its code
+// section are still being received, see {ModuleStreamDecoder}. The parallel
+// phase of each function added runs on a background thread in the meantime.
+// All calls must be made from the same {HandleScope}.
+class StreamingCompilation {
+ public:
+  StreamingCompilation(Isolate* isolate, ErrorThrower* thrower);
+  ~StreamingCompilation();
+
+  // Called once the sections preceding the code section have been decoded
+  // into {module}, which must stay alive until the compilation is destroyed.
+  void Start(const WasmModule* module);
+
+  // Called once the body of function {index} has been received completely.
+  void AddFunction(uint32_t index);
+
+  // Compiles the functions that were not added yet and creates the compiled
+  // module of the completely decoded {module}, see
+  // {WasmModule::CompileFunctions}.
+  MaybeHandle<FixedArray> Finish(const WasmModule* module);
+
+  // Drops the functions that were not compiled yet and waits for the
+  // background tasks. Must be called before the partial module passed to
+  // {Start} goes away, unless {Finish} was called.
+  void Cancel();
+
+  bool started() const { return partial_module_ != nullptr; }
+
+  // Executes the parallel phase of the queued compilation units until there
+  // are none left.
+  void ExecutePendingUnits(bool on_background_thread);
+
+ private:
+  void FinishExecutedUnits();
+  void WaitForCompilationTasks();
+
+  Isolate* isolate_;
+  ErrorThrower* thrower_;
+  const WasmModule* partial_module_ = nullptr;
+  std::unique_ptr<WasmModuleInstance> temp_instance_;
+  ModuleEnv module_env_;
+  MaybeHandle<FixedArray> indirect_table_;
+  std::unique_ptr<CanonicalHandleScope> canonical_;
+
+  // Protects the unit queues and {running_tasks_}.
+  base::Mutex mutex_;
+  std::queue<compiler::WasmCompilationUnit*> pending_units_;
+  std::queue<compiler::WasmCompilationUnit*> executed_units_;
+  size_t running_tasks_ = 0;
+  size_t max_tasks_ = 0;
+  std::vector<uint32_t> task_ids_;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamingCompilation);
+};
+
 // A helper for printing out the names of functions.
 struct WasmFunctionName {
   const WasmFunction* function_;
@@ -360,6 +452,16 @@ Handle<Object> GetWasmFunctionNameOrNull(Isolate* isolate, Handle<Object> wasm,
 // Return the binary source bytes of a wasm module.
 SeqOneByteString* GetWasmBytes(JSObject* wasm);
 
+// Return the binary source bytes that {compiled_module} was compiled from.
+Handle<String> GetCompiledModuleBytes(Isolate* isolate,
+                                      Handle<FixedArray> compiled_module);
+
+// Create a WebAssembly.Module object for {compiled_module}, which was compiled
+// from the bytes in the buffer {source}.
+Handle<JSObject> CreateModuleObject(Isolate* isolate,
+                                    Handle<FixedArray> compiled_module,
+                                    Handle<Object> source);
+
 // Get the debug info associated with the given wasm object.
 // If no debug info exists yet, it is created automatically.
 Handle<WasmDebugInfo> GetDebugInfo(Handle<JSObject> wasm);
@@ -385,8 +487,34 @@ bool UpdateWasmModuleMemory(Handle<JSObject> object, Address old_start,
                             Address new_start, uint32_t old_size,
                             uint32_t new_size);
 
-// Constructs a single function table as a FixedArray of double size,
-// populating it with function signature indices and function indices.
+// Compiles the function that the lazy compile stub {stub} stands for, unless
+// that happened already, and installs the code in the instance of the stub.
+// Redirects the calls of {caller} to replaced stubs. Returns the code of the
+// function, or an empty handle with a pending exception.
+MaybeHandle<Code> CompileLazy(Isolate* isolate, Handle<Code> stub,
+                              Handle<Code> caller);
+
+// Recompiles the function of the baseline code {code}, whose tier-up budget
+// ran out, with all optimizations. The compilation runs in the background if
+// possible, and the new code replaces {code} in its instance when it is done.
+void TierUp(Isolate* isolate, Handle<Code> code);
+
+// The kinds of code that a wasm function can run.
+enum WasmFunctionTier {
+  kWasmLazyCompileStub,  // Not compiled yet.
+  kWasmBaseline,         // Counts down its tier-up budget.
+  kWasmOptimized         // Compiled with all optimizations.
+};
+
+// Returns the tier of the code that the exported wasm function {function}
+// calls. If {sync}, first waits for the pending background compile jobs to
+// finish and installs their code, once. For testing.
+WasmFunctionTier GetExportedFunctionTier(Isolate* isolate,
+                                         Handle<JSFunction> function,
+                                         bool sync);
+
+// Constructs a single function table as a FixedArray of (signature, code)
+// pairs, populating it with canonical signature indices and function indices.
 Handle<FixedArray> BuildFunctionTable(Isolate* isolate, uint32_t index,
                                       const WasmModule* module);
 
@@ -402,6 +530,11 @@ namespace testing {
 int32_t CompileAndRunWasmModule(Isolate* isolate, const byte* module_start,
                                 const byte* module_end, bool asm_js = false);
 
+// Instantiates the given compiled module and runs its function labeled "main".
+int32_t InstantiateAndRunWasmModule(Isolate* isolate,
+                                    Handle<FixedArray> compiled_module,
+                                    ErrorThrower* thrower);
+
 }  // namespace testing
 }  // namespace wasm
 }  // namespace internal
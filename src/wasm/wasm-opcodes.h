@@ -394,6 +394,22 @@ const WasmCodePosition kNoCodePosition = -1;
 // For enabling JIT functionality
 #define FOREACH_JIT_OPCODE(V) V(JITSingleFunction, 0xf0, _)
 
+// Atomic operations on shared memory. All of them take a memory access
+// operand after the opcode; the read-modify-write operations return the
+// previous value in memory, stores return the stored value.
+#define FOREACH_ATOMIC_OPCODE(V)             \
+  V(I32AtomicWake, 0xfe00, i_ii)             \
+  V(I32AtomicWait, 0xfe01, i_iid)            \
+  V(I32AtomicLoad, 0xfe10, i_i)              \
+  V(I32AtomicStore, 0xfe11, i_ii)            \
+  V(I32AtomicAdd, 0xfe12, i_ii)              \
+  V(I32AtomicSub, 0xfe13, i_ii)              \
+  V(I32AtomicAnd, 0xfe14, i_ii)              \
+  V(I32AtomicOr, 0xfe15, i_ii)               \
+  V(I32AtomicXor, 0xfe16, i_ii)              \
+  V(I32AtomicExchange, 0xfe17, i_ii)         \
+  V(I32AtomicCompareExchange, 0xfe18, i_iii)
+
 // All opcodes.
 #define FOREACH_OPCODE(V)        \
   FOREACH_CONTROL_OPCODE(V)      \
@@ -405,11 +421,13 @@ const WasmCodePosition kNoCodePosition = -1;
   FOREACH_MISC_MEM_OPCODE(V)     \
   FOREACH_ASMJS_COMPAT_OPCODE(V) \
   FOREACH_SIMD_OPCODE(V)         \
-  FOREACH_JIT_OPCODE(V)
+  FOREACH_JIT_OPCODE(V)          \
+  FOREACH_ATOMIC_OPCODE(V)
 
 // All signatures.
 #define FOREACH_SIGNATURE(V)         \
   FOREACH_SIMD_SIGNATURE(V)          \
+  FOREACH_ATOMIC_SIGNATURE(V)        \
   V(i_ii, kAstI32, kAstI32, kAstI32) \
   V(i_i, kAstI32, kAstI32)           \
   V(i_v, kAstI32)                    \
@@ -450,7 +468,13 @@ const WasmCodePosition kNoCodePosition = -1;
   V(s_sii, kAstS128, kAstS128, kAstI32, kAstI32)   \
   V(s_si, kAstS128, kAstS128, kAstI32)
 
-#define FOREACH_PREFIX(V) V(Simd, 0xe5)
+#define FOREACH_ATOMIC_SIGNATURE(V)            \
+  V(i_iii, kAstI32, kAstI32, kAstI32, kAstI32) \
+  V(i_iid, kAstI32, kAstI32, kAstI32, kAstF64)
+
+#define FOREACH_PREFIX(V) \
+  V(Simd, 0xe5)           \
+  V(Atomic, 0xfe)
 
 enum WasmOpcode {
 // Declare expression opcodes.
@@ -473,7 +497,8 @@ enum WasmOpcode {
   V(TrapFuncInvalid)               \
   V(TrapFuncSigMismatch)           \
   V(TrapMemAllocationFail)         \
-  V(TrapInvalidIndex)
+  V(TrapInvalidIndex)              \
+  V(TrapUnalignedAccess)
 
 enum TrapReason {
 #define DECLARE_ENUM(name) k##name,
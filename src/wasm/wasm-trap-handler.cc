@@ -0,0 +1,296 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/wasm/wasm-trap-handler.h"
+
+#if V8_TRAP_HANDLER_SUPPORTED
+#include <signal.h>
+#include <ucontext.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+#include "src/base/atomicops.h"
+#include "src/base/once.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
+#include "src/flags.h"
+#include "src/objects-inl.h"
+
+namespace v8 {
+namespace internal {
+namespace wasm {
+
+#if V8_TRAP_HANDLER_SUPPORTED
+
+namespace {
+
+struct sigaction old_segv_action;
+bool trap_handler_installed = false;
+
+struct ProtectedInstruction {
+  int pc_offset;
+  int landing_offset;
+
+  bool operator<(const ProtectedInstruction& other) const {
+    return pc_offset < other.pc_offset;
+  }
+};
+
+// The protected instructions of one wasm code object. Only the instruction
+// start changes after the entry is published, when the GC moves the code.
+struct ProtectedCode {
+  Heap* heap;
+  base::AtomicWord instruction_start;
+  int instruction_size;
+  std::vector<ProtectedInstruction> instructions;
+};
+
+// A fixed-capacity array of entries. Registering into a full table publishes
+// a copy with twice the capacity.
+struct ProtectedCodeTable {
+  explicit ProtectedCodeTable(size_t capacity)
+      : capacity(capacity), entries(new base::AtomicWord[capacity]()) {}
+  ~ProtectedCodeTable() { delete[] entries; }
+
+  size_t const capacity;
+  base::AtomicWord* const entries;
+};
+
+const size_t kInitialProtectedCodeCapacity = 64;
+
+// Updates of the table are serialized by {table_mutex}; the signal handler
+// never takes it. Instead it announces itself in {active_lookups}, and
+// writers wait for running lookups to finish before freeing anything they
+// unpublished.
+base::LazyMutex table_mutex = LAZY_MUTEX_INITIALIZER;
+base::AtomicWord current_table = 0;
+base::Atomic32 active_lookups = 0;
+size_t registered_code_count = 0;
+
+ProtectedCodeTable* CurrentTable() {
+  return reinterpret_cast<ProtectedCodeTable*>(
+      base::Acquire_Load(&current_table));
+}
+
+ProtectedCode* EntryAt(ProtectedCodeTable* table, size_t index) {
+  return reinterpret_cast<ProtectedCode*>(
+      base::Acquire_Load(&table->entries[index]));
+}
+
+Address InstructionStartOf(ProtectedCode* entry) {
+  return reinterpret_cast<Address>(
+      base::Acquire_Load(&entry->instruction_start));
+}
+
+void WaitForActiveLookups() {
+  base::MemoryBarrier();
+  while (base::Acquire_Load(&active_lookups) != 0) {
+  }
+}
+
+// Publishes {entry}, growing the table if needed. Called with {table_mutex}
+// held.
+void AddEntry(ProtectedCode* entry) {
+  ProtectedCodeTable* table = CurrentTable();
+  if (table == nullptr || registered_code_count == table->capacity) {
+    size_t capacity =
+        table == nullptr ? kInitialProtectedCodeCapacity : 2 * table->capacity;
+    ProtectedCodeTable* grown = new ProtectedCodeTable(capacity);
+    if (table != nullptr) {
+      for (size_t i = 0; i < table->capacity; ++i) {
+        grown->entries[i] = table->entries[i];
+      }
+    }
+    base::Release_Store(&current_table,
+                        reinterpret_cast<base::AtomicWord>(grown));
+    WaitForActiveLookups();
+    delete table;
+    table = grown;
+  }
+  for (size_t i = 0; i < table->capacity; ++i) {
+    if (EntryAt(table, i) != nullptr) continue;
+    base::Release_Store(&table->entries[i],
+                        reinterpret_cast<base::AtomicWord>(entry));
+    registered_code_count++;
+    return;
+  }
+  UNREACHABLE();
+}
+
+// Returns the landing pad that the code generator recorded for a protected
+// memory access at {pc}, or nullptr if {pc} is not such an access. This runs
+// in the signal handler and must neither lock nor allocate.
+Address FindLandingPad(Address pc) {
+  base::Barrier_AtomicIncrement(&active_lookups, 1);
+  Address landing_pad = nullptr;
+  ProtectedCodeTable* table = CurrentTable();
+  for (size_t i = 0; table != nullptr && i < table->capacity; ++i) {
+    ProtectedCode* entry = EntryAt(table, i);
+    if (entry == nullptr) continue;
+    Address start = InstructionStartOf(entry);
+    if (pc < start || pc >= start + entry->instruction_size) continue;
+    ProtectedInstruction key = {static_cast<int>(pc - start), 0};
+    auto it = std::lower_bound(entry->instructions.begin(),
+                               entry->instructions.end(), key);
+    if (it != entry->instructions.end() && it->pc_offset == key.pc_offset) {
+      landing_pad = start + it->landing_offset;
+    }
+    break;
+  }
+  base::Barrier_AtomicIncrement(&active_lookups, -1);
+  return landing_pad;
+}
+
+void HandleSegv(int signal, siginfo_t* info, void* context) {
+  ucontext_t* ucontext = reinterpret_cast<ucontext_t*>(context);
+  greg_t* rip = &ucontext->uc_mcontext.gregs[REG_RIP];
+  Address landing_pad = FindLandingPad(reinterpret_cast<Address>(*rip));
+  if (landing_pad != nullptr) {
+    *rip = reinterpret_cast<greg_t>(landing_pad);
+    return;
+  }
+
+  // Not a wasm trap, let the previous handler deal with the fault.
+  if (old_segv_action.sa_flags & SA_SIGINFO) {
+    old_segv_action.sa_sigaction(signal, info, context);
+  } else if (old_segv_action.sa_handler == SIG_DFL) {
+    // Returning re-executes the faulting instruction, which then crashes
+    // with the default action.
+    sigaction(SIGSEGV, &old_segv_action, nullptr);
+  } else if (old_segv_action.sa_handler != SIG_IGN) {
+    old_segv_action.sa_handler(signal);
+  }
+}
+
+void InstallTrapHandler() {
+  struct sigaction action;
+  action.sa_sigaction = &HandleSegv;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+  trap_handler_installed =
+      sigaction(SIGSEGV, &action, &old_segv_action) == 0;
+}
+
+base::OnceType install_once = V8_ONCE_INIT;
+
+}  // namespace
+
+bool UseTrapHandler() {
+  if (!FLAG_wasm_trap_handler) return false;
+  base::CallOnce(&install_once, &InstallTrapHandler);
+  return trap_handler_installed;
+}
+
+void* AllocateGuardRegionMemory(size_t size) {
+  DCHECK_LE(size, kGuardRegionSize);
+  size_t reservation_size = static_cast<size_t>(kGuardRegionSize);
+  void* start = base::VirtualMemory::ReserveRegion(reservation_size);
+  if (start == nullptr) return nullptr;
+  if (size > 0 && !base::VirtualMemory::CommitRegion(start, size, false)) {
+    base::VirtualMemory::ReleaseRegion(start, reservation_size);
+    return nullptr;
+  }
+  return start;
+}
+
+bool GrowGuardRegionMemory(void* start, size_t old_size, size_t new_size) {
+  DCHECK_LE(old_size, new_size);
+  DCHECK_LE(new_size, kGuardRegionSize);
+  if (new_size == old_size) return true;
+  return base::VirtualMemory::CommitRegion(
+      static_cast<byte*>(start) + old_size, new_size - old_size, false);
+}
+
+void FreeGuardRegionMemory(void* start) {
+  CHECK(base::VirtualMemory::ReleaseRegion(
+      start, static_cast<size_t>(kGuardRegionSize)));
+}
+
+void RegisterProtectedInstructions(Code* code) {
+  if (code->kind() != Code::WASM_FUNCTION) return;
+  if (code->handler_table()->length() == 0) return;
+  HandlerTable* table = HandlerTable::cast(code->handler_table());
+  ProtectedCode* entry = new ProtectedCode();
+  entry->heap = code->GetHeap();
+  entry->instruction_start =
+      reinterpret_cast<base::AtomicWord>(code->instruction_start());
+  entry->instruction_size = code->instruction_size();
+  int count = table->NumberOfReturnEntries();
+  entry->instructions.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    entry->instructions.push_back(
+        {table->GetReturnOffset(i), table->GetReturnHandler(i)});
+  }
+  std::sort(entry->instructions.begin(), entry->instructions.end());
+  base::LockGuard<base::Mutex> guard(table_mutex.Pointer());
+  AddEntry(entry);
+}
+
+void UpdateProtectedInstructionsAfterEvacuation(Heap* heap) {
+  base::LockGuard<base::Mutex> guard(table_mutex.Pointer());
+  if (registered_code_count == 0) return;
+  ProtectedCodeTable* table = CurrentTable();
+  for (size_t i = 0; i < table->capacity; ++i) {
+    ProtectedCode* entry = EntryAt(table, i);
+    if (entry == nullptr || entry->heap != heap) continue;
+    Code* code = Code::GetCodeFromTargetAddress(InstructionStartOf(entry));
+    MapWord map_word = code->map_word();
+    if (!map_word.IsForwardingAddress()) continue;
+    Code* moved = Code::cast(map_word.ToForwardingAddress());
+    base::Release_Store(
+        &entry->instruction_start,
+        reinterpret_cast<base::AtomicWord>(moved->instruction_start()));
+  }
+}
+
+void ReleaseProtectedInstructions(Heap* heap, DeadCodeCallback is_dead) {
+  base::LockGuard<base::Mutex> guard(table_mutex.Pointer());
+  if (registered_code_count == 0) return;
+  ProtectedCodeTable* table = CurrentTable();
+  std::vector<ProtectedCode*> released;
+  for (size_t i = 0; i < table->capacity; ++i) {
+    ProtectedCode* entry = EntryAt(table, i);
+    if (entry == nullptr || entry->heap != heap) continue;
+    if (is_dead != nullptr &&
+        !is_dead(Code::GetCodeFromTargetAddress(InstructionStartOf(entry)))) {
+      continue;
+    }
+    base::Release_Store(&table->entries[i], 0);
+    registered_code_count--;
+    released.push_back(entry);
+  }
+  if (released.empty()) return;
+  WaitForActiveLookups();
+  for (ProtectedCode* entry : released) delete entry;
+}
+
+#else  // V8_TRAP_HANDLER_SUPPORTED
+
+bool UseTrapHandler() { return false; }
+
+void* AllocateGuardRegionMemory(size_t size) {
+  UNREACHABLE();
+  return nullptr;
+}
+
+bool GrowGuardRegionMemory(void* start, size_t old_size, size_t new_size) {
+  UNREACHABLE();
+  return false;
+}
+
+void FreeGuardRegionMemory(void* start) { UNREACHABLE(); }
+
+void RegisterProtectedInstructions(Code* code) {}
+
+void UpdateProtectedInstructionsAfterEvacuation(Heap* heap) {}
+
+void ReleaseProtectedInstructions(Heap* heap, DeadCodeCallback is_dead) {}
+
+#endif  // V8_TRAP_HANDLER_SUPPORTED
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
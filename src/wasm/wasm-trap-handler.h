@@ -0,0 +1,74 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_WASM_TRAP_HANDLER_H_
+#define V8_WASM_TRAP_HANDLER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "src/base/build_config.h"
+#include "src/globals.h"
+
+// Out-of-bounds wasm memory accesses can only be caught by a signal handler
+// where we know how to find and rewrite the faulting pc.
+#if V8_OS_LINUX && V8_TARGET_ARCH_X64 && V8_HOST_ARCH_X64
+#define V8_TRAP_HANDLER_SUPPORTED 1
+#else
+#define V8_TRAP_HANDLER_SUPPORTED 0
+#endif
+
+namespace v8 {
+namespace internal {
+
+class Code;
+class Heap;
+
+namespace wasm {
+
+// A wasm memory access reaches at most a 32-bit index plus a 32-bit offset
+// plus the access size past the start of the memory. With the trap handler,
+// every wasm memory reserves this much address space and only commits its
+// actual size, so that any out-of-bounds access hits an inaccessible page.
+const uint64_t kGuardRegionSize = (static_cast<uint64_t>(1) << 33) + 0x10000;
+
+// Returns true if wasm code should omit explicit bounds checks on memory
+// accesses and rely on guard regions and the trap handler instead. Installs
+// the process-wide signal handler on first use.
+bool UseTrapHandler();
+
+// Reserves a guard region and commits its first {size} bytes, which are
+// zero-initialized. Returns nullptr on failure.
+void* AllocateGuardRegionMemory(size_t size);
+
+// Commits the bytes between {old_size} and {new_size} of a guard region
+// returned by AllocateGuardRegionMemory, leaving its start in place.
+bool GrowGuardRegionMemory(void* start, size_t old_size, size_t new_size);
+
+// Releases a guard region returned by AllocateGuardRegionMemory.
+void FreeGuardRegionMemory(void* start);
+
+// The signal handler maps a faulting pc to its landing pad through a
+// process-wide table of the protected instructions of every wasm code object,
+// without taking locks or touching the heap. The code generator records the
+// protected instructions in the handler table of a wasm code object; they are
+// entered into the table when the code is finalized or copied. Instances
+// always run copies, so deserialized code needs no entries of its own.
+void RegisterProtectedInstructions(Code* code);
+
+// Keeps the table up to date when the GC moves code objects. Called once
+// after evacuation, while the moved code objects of {heap} still hold their
+// forwarding addresses.
+void UpdateProtectedInstructionsAfterEvacuation(Heap* heap);
+
+// Drops the entries of dead code objects of {heap}, as determined by
+// {is_dead}, or of all code objects of {heap} if {is_dead} is nullptr.
+typedef bool (*DeadCodeCallback)(Code* code);
+void ReleaseProtectedInstructions(Heap* heap, DeadCodeCallback is_dead);
+
+}  // namespace wasm
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_WASM_TRAP_HANDLER_H_
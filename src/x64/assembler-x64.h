@@ -1406,6 +1406,8 @@ class Assembler : public AssemblerBase {
   AVX_P_3(vor, 0x56);
   AVX_P_3(vxor, 0x57);
   AVX_3(vpcmpeqd, 0x76, vpd);
+  AVX_3(vpaddd, 0xfe, vpd);
+  AVX_3(vpsubd, 0xfa, vpd);
   AVX_3(vcvtsd2ss, 0x5a, vsd);
 
 #undef AVX_3
@@ -1423,6 +1425,16 @@ class Assembler : public AssemblerBase {
     vpd(0x73, iop, dst, src);
     emit(imm8);
   }
+  void vpmulld(XMMRegister dst, XMMRegister src1, XMMRegister src2) {
+    vsd(0x40, dst, src1, src2, k66, k0F38, kWIG);
+  }
+  void vpmulld(XMMRegister dst, XMMRegister src1, const Operand& src2) {
+    vsd(0x40, dst, src1, src2, k66, k0F38, kWIG);
+  }
+  void vpshufd(XMMRegister dst, XMMRegister src, uint8_t shuffle) {
+    vpd(0x70, dst, xmm0, src);
+    emit(shuffle);
+  }
   void vcvtss2sd(XMMRegister dst, XMMRegister src1, XMMRegister src2) {
     vsd(0x5a, dst, src1, src2, kF3, k0F, kWIG);
   }
@@ -1543,6 +1555,16 @@ class Assembler : public AssemblerBase {
   void vmovups(const Operand& dst, XMMRegister src) {
     vps(0x11, src, xmm0, dst);
   }
+  void vsqrtps(XMMRegister dst, XMMRegister src) { vps(0x51, dst, xmm0, src); }
+  void vsqrtps(XMMRegister dst, const Operand& src) {
+    vps(0x51, dst, xmm0, src);
+  }
+  void vmovdqu(XMMRegister dst, const Operand& src) {
+    vsd(0x6f, dst, xmm0, src, kF3, k0F, kWIG);
+  }
+  void vmovdqu(const Operand& dst, XMMRegister src) {
+    vsd(0x7f, src, xmm0, dst, kF3, k0F, kWIG);
+  }
   void vmovapd(XMMRegister dst, XMMRegister src) { vpd(0x28, dst, xmm0, src); }
   void vmovupd(XMMRegister dst, const Operand& src) {
     vpd(0x10, dst, xmm0, src);
@@ -6,6 +6,7 @@
 
 #include <cstring>
 
+#include "src/base/bits.h"
 #include "src/v8.h"
 
 #ifdef V8_USE_ADDRESS_SANITIZER
@@ -252,6 +253,14 @@ Address Zone::NewExpand(size_t size) {
     // All the while making sure to allocate a segment large enough to hold the
     // requested size.
     new_size = Max(min_new_size, kMaximumSegmentSize);
+  } else {
+    // Use power-of-two segment sizes so that freed segments can be recycled
+    // by the allocator's segment pool. Round down where the request still
+    // fits, which keeps the growth rate of the segment size unchanged.
+    size_t rounded = base::bits::RoundDownToPowerOfTwo32(
+        static_cast<uint32_t>(new_size));
+    if (rounded < min_new_size) rounded <<= 1;
+    new_size = Min(rounded, kMaximumSegmentSize);
   }
   if (new_size > INT_MAX) {
     V8::FatalProcessOutOfMemory("Zone");
@@ -467,6 +467,30 @@ TEST(InlineMutuallyRecursive) {
   T.CheckCall(T.Val(42), T.Val(1));
 }
 
+
+TEST(InlineArrayForEachCallback) {
+  // The builtin entry point and its loop are force-inlined, which exposes the
+  // constant callback at the inner call site to the regular heuristic.
+  FLAG_allow_natives_syntax = true;
+  FLAG_always_opt = false;
+  FLAG_turbo = true;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  InstallAssertInlineCountHelper(env->GetIsolate());
+  CompileRun(
+      "var expected = 1;"
+      "function callback(x) { AssertInlineCount(expected); }"
+      "function bar(a) { a.forEach(callback); }"
+      "bar([1, 2]);"
+      "bar([1, 2]);"
+      "%OptimizeFunctionOnNextCall(bar);"
+      "expected = 4;"
+      "bar([1, 2]);");
+  CHECK_EQ(1, CompileRun("%GetOptimizationStatus(bar)")
+                  ->Int32Value(env.local())
+                  .FromJust());
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -2352,4 +2352,82 @@ TEST(AssemblerX64vmovups) {
   CHECK_EQ(-1.5, f(1.5, -1.5));
 }
 
+TEST(AssemblerX64AVX_ps) {
+  CcTest::InitializeVM();
+  if (!CpuFeatures::IsSupported(AVX)) return;
+
+  Isolate* isolate = reinterpret_cast<Isolate*>(CcTest::isolate());
+  HandleScope scope(isolate);
+  v8::internal::byte buffer[256];
+  MacroAssembler assm(isolate, buffer, sizeof(buffer),
+                      v8::internal::CodeObjectRequired::kYes);
+  {
+    CpuFeatureScope avx_scope(&assm, AVX);
+    __ shufps(xmm0, xmm0, 0x0);  // brocast first argument
+    __ shufps(xmm1, xmm1, 0x0);  // brocast second argument
+    // Compute ((x + y) * y - x) / y in all four lanes.
+    __ vaddps(xmm2, xmm0, xmm1);
+    __ vmulps(xmm2, xmm2, xmm1);
+    __ vsubps(xmm2, xmm2, xmm0);
+    __ vdivps(xmm2, xmm2, xmm1);
+    // Return the top lane.
+    __ vpshufd(xmm0, xmm2, 0x3);
+    __ ret(0);
+  }
+
+  CodeDesc desc;
+  assm.GetCode(&desc);
+  Handle<Code> code = isolate->factory()->NewCode(
+      desc, Code::ComputeFlags(Code::STUB), Handle<Code>());
+#ifdef OBJECT_PRINT
+  OFStream os(stdout);
+  code->Print(os);
+#endif
+
+  F9 f = FUNCTION_CAST<F9>(code->entry());
+  CHECK_EQ(2.5, f(1.0, 2.0));
+  CHECK_EQ(3.0, f(2.0, -1.0));
+}
+
+TEST(AssemblerX64AVX_pd32) {
+  CcTest::InitializeVM();
+  if (!CpuFeatures::IsSupported(AVX)) return;
+
+  Isolate* isolate = reinterpret_cast<Isolate*>(CcTest::isolate());
+  HandleScope scope(isolate);
+  v8::internal::byte buffer[256];
+  MacroAssembler assm(isolate, buffer, sizeof(buffer),
+                      v8::internal::CodeObjectRequired::kYes);
+  {
+    CpuFeatureScope avx_scope(&assm, AVX);
+    __ vmovq(xmm0, arg1);
+    // Round-trip through the stack to test "vmovdqu reg, mem".
+    __ subq(rsp, Immediate(kSimd128Size));
+    __ vmovdqu(Operand(rsp, 0), xmm0);
+    __ vmovdqu(xmm1, Operand(rsp, 0));
+    __ addq(rsp, Immediate(kSimd128Size));
+    // Compute (x + x) * x - x in the two low lanes.
+    __ vpaddd(xmm2, xmm1, xmm1);
+    __ vpmulld(xmm2, xmm2, xmm1);
+    __ vpsubd(xmm2, xmm2, xmm0);
+    // Swap the two low lanes.
+    __ vpshufd(xmm2, xmm2, 0xE1);
+    __ vmovq(rax, xmm2);
+    __ ret(0);
+  }
+
+  CodeDesc desc;
+  assm.GetCode(&desc);
+  Handle<Code> code = isolate->factory()->NewCode(
+      desc, Code::ComputeFlags(Code::STUB), Handle<Code>());
+#ifdef OBJECT_PRINT
+  OFStream os(stdout);
+  code->Print(os);
+#endif
+
+  F5 f = FUNCTION_CAST<F5>(code->entry());
+  CHECK_EQ(V8_UINT64_C(0x0000000F00000006),
+           f(V8_UINT64_C(0x0000000200000003)));
+}
+
 #undef __
@@ -932,3 +932,200 @@ UNINITIALIZED_TEST(DeoptimizeLoadICStoreICNested) {
   isolate->Exit();
   isolate->Dispose();
 }
+
+
+TEST(DeoptimizationSiteStats) {
+  i::FLAG_track_deopt_sites = true;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  i::DeoptimizationSiteStats* stats =
+      CcTest::i_isolate()->deoptimizer_data()->site_stats();
+
+  // An eager deoptimization of f on a map check must show up as a site.
+  {
+    AllowNativesSyntaxNoInlining options;
+    CompileRun(
+        "function f(o) { return o.x; };"
+        "f({x: 1});"
+        "f({x: 1});"
+        "%OptimizeFunctionOnNextCall(f);"
+        "f({x: 1});"
+        "f({y: 1, x: 2});");
+  }
+
+  std::vector<const i::DeoptimizationSiteStats::Site*> sites =
+      stats->TopSites(10);
+  CHECK_LE(1u, sites.size());
+  int f_count = 0;
+  for (auto site : sites) {
+    CHECK_LT(0, site->count);
+    if (strcmp("f", site->function_name.get()) == 0) f_count += site->count;
+  }
+  CHECK_LE(1, f_count);
+  // TopSites() returns the most frequent site first.
+  for (size_t i = 1; i < sites.size(); ++i) {
+    CHECK_GE(sites[i - 1]->count, sites[i]->count);
+  }
+
+  // The embedder API reports the same sites.
+  v8::DeoptimizationSiteStatistics api_sites[10];
+  size_t api_count =
+      env->GetIsolate()->GetDeoptimizationSiteStatistics(api_sites, 10);
+  CHECK_EQ(sites.size(), api_count);
+  for (size_t i = 0; i < api_count; ++i) {
+    CHECK_EQ(sites[i]->script_id, api_sites[i].script_id());
+    CHECK_EQ(sites[i]->position, api_sites[i].position());
+    CHECK_EQ(sites[i]->count, api_sites[i].count());
+    CHECK_EQ(0, strcmp(i::DeoptimizeReasonToString(sites[i]->reason),
+                       api_sites[i].reason()));
+  }
+}
+
+
+TEST(DeoptimizationSiteStatsNotTrackedByDefault) {
+  i::FLAG_track_deopt_sites = false;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  {
+    AllowNativesSyntaxNoInlining options;
+    CompileRun(
+        "function f(o) { return o.x; };"
+        "f({x: 1});"
+        "f({x: 1});"
+        "%OptimizeFunctionOnNextCall(f);"
+        "f({x: 1});"
+        "f({y: 1, x: 2});");
+  }
+  CHECK_EQ(0u, CcTest::i_isolate()->deoptimizer_data()->site_stats()->size());
+}
+
+
+TEST(DeoptimizationSiteStatsAreBounded) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CompileRun("function f() {}");
+  Handle<JSFunction> f = Handle<JSFunction>::cast(v8::Utils::OpenHandle(
+      *v8::Local<v8::Function>::Cast(CcTest::global()
+                                         ->Get(env.local(), v8_str("f"))
+                                         .ToLocalChecked())));
+  i::DeoptimizationSiteStats stats;
+  const size_t kMaxSites = i::DeoptimizationSiteStats::kMaxSites;
+
+  // A site hit twice survives one round of aging, sites hit once do not.
+  stats.Record(f->shared(), 0, i::DeoptimizeReason::kWrongMap);
+  stats.Record(f->shared(), 0, i::DeoptimizeReason::kWrongMap);
+  for (size_t i = 1; i < kMaxSites; ++i) {
+    stats.Record(f->shared(), static_cast<int>(i),
+                 i::DeoptimizeReason::kWrongMap);
+  }
+  CHECK_EQ(kMaxSites, stats.size());
+  i::DeoptimizationSiteStats::Site* site =
+      stats.Record(f->shared(), static_cast<int>(kMaxSites),
+                   i::DeoptimizeReason::kWrongMap);
+  CHECK_EQ(1, site->count);
+  CHECK_EQ(2u, stats.size());
+  std::vector<const i::DeoptimizationSiteStats::Site*> sites =
+      stats.TopSites(kMaxSites);
+  CHECK_EQ(0, sites[0]->position);
+  CHECK_EQ(1, sites[0]->count);
+}
+
+
+namespace {
+
+const i::DeoptimizationSiteStats::Site* FindDeoptimizationSite(
+    const char* function_name, i::DeoptimizeReason reason) {
+  i::DeoptimizationSiteStats* stats =
+      CcTest::i_isolate()->deoptimizer_data()->site_stats();
+  for (auto site : stats->TopSites(100)) {
+    if (site->reason == reason &&
+        strcmp(function_name, site->function_name.get()) == 0) {
+      return site;
+    }
+  }
+  return nullptr;
+}
+
+int GetOptimizationCount(LocalContext* env, const char* function_name) {
+  v8::Local<v8::Value> value = (*env)
+                                   ->Global()
+                                   ->Get(env->local(), v8_str(function_name))
+                                   .ToLocalChecked();
+  Handle<JSFunction> function = Handle<JSFunction>::cast(
+      v8::Utils::OpenHandle(*v8::Local<v8::Function>::Cast(value)));
+  return function->shared()->opt_count();
+}
+
+}  // namespace
+
+
+TEST(DeoptimizationSiteGeneralizesOnWrongMap) {
+  i::FLAG_track_deopt_sites = true;
+  i::FLAG_ignition = true;
+  i::FLAG_turbo = true;
+  i::FLAG_turbo_from_bytecode = true;
+  i::FLAG_always_opt = false;
+  i::FLAG_deopt_site_generalize_count = 3;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+
+  // Every round deopts at the load in f on an unseen map. The third deopt
+  // makes the load megamorphic and is not counted as a reoptimization.
+  {
+    AllowNativesSyntaxNoInlining options;
+    CompileRun(
+        "function f(o) { return o.x; };"
+        "var base = {x: 1};"
+        "f(base);"
+        "f(base);"
+        "for (var i = 0; i < 3; i++) {"
+        "  var o = {x: 1};"
+        "  o['p' + i] = i;"
+        "  %OptimizeFunctionOnNextCall(f);"
+        "  f(base);"
+        "  f(o);"
+        "}");
+  }
+
+  const i::DeoptimizationSiteStats::Site* site =
+      FindDeoptimizationSite("f", i::DeoptimizeReason::kWrongMap);
+  CHECK_NOT_NULL(site);
+  CHECK_EQ(3, site->count);
+  CHECK(site->generalized);
+  CHECK_EQ(2, GetOptimizationCount(&env, "f"));
+}
+
+
+TEST(DeoptimizationSiteKeepsFeedbackOnValueCheck) {
+  i::FLAG_track_deopt_sites = true;
+  i::FLAG_ignition = true;
+  i::FLAG_turbo = true;
+  i::FLAG_turbo_from_bytecode = true;
+  i::FLAG_always_opt = false;
+  i::FLAG_deopt_site_generalize_count = 1;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+
+  // A failed bounds check at the keyed load in g is not caused by the shape
+  // of the receiver, so the feedback stays and every deopt is counted.
+  {
+    AllowNativesSyntaxNoInlining options;
+    CompileRun(
+        "function g(a, i) { return a[i]; };"
+        "var array = [1, 2, 3];"
+        "g(array, 0);"
+        "g(array, 1);"
+        "for (var i = 0; i < 3; i++) {"
+        "  %OptimizeFunctionOnNextCall(g);"
+        "  g(array, 2);"
+        "  g(array, 10);"
+        "}");
+  }
+
+  const i::DeoptimizationSiteStats::Site* site =
+      FindDeoptimizationSite("g", i::DeoptimizeReason::kOutOfBounds);
+  CHECK_NOT_NULL(site);
+  CHECK_LE(1, site->count);
+  CHECK(!site->generalized);
+  CHECK_EQ(3, GetOptimizationCount(&env, "g"));
+}
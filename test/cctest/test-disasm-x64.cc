@@ -612,6 +612,9 @@ TEST(DisasmX64) {
       __ vmovups(xmm5, Operand(rdx, 4));
       __ vmovups(Operand(rdx, 4), xmm5);
 
+      __ vsqrtps(xmm1, xmm2);
+      __ vsqrtps(xmm9, Operand(rbx, rcx, times_4, 10000));
+
       __ vandps(xmm0, xmm9, xmm2);
       __ vandps(xmm9, xmm1, Operand(rbx, rcx, times_4, 10000));
       __ vxorps(xmm0, xmm1, xmm9);
@@ -628,6 +631,25 @@ TEST(DisasmX64) {
       __ vpcmpeqd(xmm15, xmm0, Operand(rbx, rcx, times_4, 10000));
       __ vpsllq(xmm0, xmm15, 21);
       __ vpsrlq(xmm15, xmm0, 21);
+
+      __ vaddps(xmm0, xmm1, xmm2);
+      __ vaddps(xmm9, xmm1, Operand(rbx, rcx, times_4, 10000));
+      __ vsubps(xmm0, xmm1, xmm2);
+      __ vmulps(xmm0, xmm1, xmm2);
+      __ vdivps(xmm0, xmm1, xmm2);
+      __ vminps(xmm8, xmm1, xmm2);
+      __ vmaxps(xmm9, xmm1, Operand(rbx, rcx, times_1, 10000));
+      __ vaddpd(xmm0, xmm1, xmm2);
+      __ vmulpd(xmm9, xmm1, Operand(rbx, rcx, times_4, 10000));
+
+      __ vpaddd(xmm0, xmm15, xmm5);
+      __ vpaddd(xmm15, xmm0, Operand(rbx, rcx, times_4, 10000));
+      __ vpsubd(xmm0, xmm15, xmm5);
+      __ vpmulld(xmm0, xmm15, xmm5);
+      __ vpmulld(xmm15, xmm0, Operand(rbx, rcx, times_4, 10000));
+      __ vpshufd(xmm9, xmm1, 0x1b);
+      __ vmovdqu(xmm9, Operand(rbx, rcx, times_4, 10000));
+      __ vmovdqu(Operand(rbx, rcx, times_4, 10000), xmm9);
     }
   }
 
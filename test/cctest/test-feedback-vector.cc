@@ -580,4 +580,130 @@ TEST(VectorStoreICBasic) {
   CHECK_EQ(MONOMORPHIC, nexus.StateFromFeedback());
 }
 
+
+TEST(TypeFeedbackProfileRoundTrip) {
+  if (i::FLAG_always_opt) return;
+  CcTest::InitializeVM();
+  v8::Isolate* v8_isolate = CcTest::isolate();
+  v8::HandleScope scope(v8_isolate);
+  const char* source = "function f(a) { return a.foo; }";
+
+  v8::ScriptCompiler::CachedData* data;
+  {
+    LocalContext context;
+    CompileRun(source);
+    CompileRun(
+        "f({ foo: 1 }); f({ foo: 1, a: 1 }); f({ foo: 1, b: 1 });"
+        "f({ foo: 1, c: 1 }); f({ foo: 1, d: 1 }); f({ foo: 1, e: 1 });"
+        "f({ foo: 1, g: 1 });");
+    Handle<JSFunction> f = GetFunction("f");
+    LoadICNexus nexus(f->feedback_vector(), FeedbackVectorSlot(0));
+    CHECK_EQ(MEGAMORPHIC, nexus.StateFromFeedback());
+    data = v8_isolate->SerializeTypeFeedback();
+  }
+
+  // Malformed data is rejected.
+  CHECK(!v8_isolate->SetTypeFeedbackProfile(data->data, data->length - 1));
+  CHECK(v8_isolate->SetTypeFeedbackProfile(data->data, data->length));
+  delete data;
+
+  {
+    // The same script starts out megamorphic in a fresh context.
+    LocalContext context;
+    CompileRun(source);
+    CompileRun("f({ foo: 1 });");
+    Handle<JSFunction> f = GetFunction("f");
+    LoadICNexus nexus(f->feedback_vector(), FeedbackVectorSlot(0));
+    CHECK_EQ(MEGAMORPHIC, nexus.StateFromFeedback());
+  }
+
+  {
+    // Other scripts are unaffected.
+    LocalContext context;
+    CompileRun("function f(a) { return a.foo;  }");
+    CompileRun("f({ foo: 1 });");
+    Handle<JSFunction> f = GetFunction("f");
+    LoadICNexus nexus(f->feedback_vector(), FeedbackVectorSlot(0));
+    CHECK_NE(MEGAMORPHIC, nexus.StateFromFeedback());
+  }
+
+  CHECK(v8_isolate->SetTypeFeedbackProfile(NULL, 0));
+}
+
+
+TEST(TypeFeedbackProfileElementsKind) {
+  if (i::FLAG_always_opt) return;
+  CcTest::InitializeVM();
+  v8::Isolate* v8_isolate = CcTest::isolate();
+  v8::HandleScope scope(v8_isolate);
+  const char* source = "function f(a, load) { return load ? a[0] : 0; }";
+
+  v8::ScriptCompiler::CachedData* data;
+  {
+    LocalContext context;
+    CompileRun(source);
+    CompileRun("f([1.5], true); f([2.5], true);");
+    Handle<JSFunction> f = GetFunction("f");
+    KeyedLoadICNexus nexus(f->feedback_vector(), FeedbackVectorSlot(0));
+    CHECK_EQ(MONOMORPHIC, nexus.StateFromFeedback());
+    data = v8_isolate->SerializeTypeFeedback();
+  }
+  CHECK(v8_isolate->SetTypeFeedbackProfile(data->data, data->length));
+  delete data;
+
+  {
+    // The keyed load starts out monomorphic on the double array map of the
+    // new context before it ever ran.
+    LocalContext context;
+    CompileRun(source);
+    CompileRun("f(null, false);");
+    Handle<JSFunction> f = GetFunction("f");
+    KeyedLoadICNexus nexus(f->feedback_vector(), FeedbackVectorSlot(0));
+    CHECK_EQ(MONOMORPHIC, nexus.StateFromFeedback());
+    Object* double_array_map =
+        f->native_context()->get(Context::ArrayMapIndex(FAST_DOUBLE_ELEMENTS));
+    CHECK(double_array_map == nexus.FindFirstMap());
+
+    CHECK_EQ(3.5, CompileRun("f([3.5], true)")
+                      ->NumberValue(context.local())
+                      .FromJust());
+    CHECK_EQ(MONOMORPHIC, nexus.StateFromFeedback());
+    CHECK(double_array_map == nexus.FindFirstMap());
+  }
+
+  CHECK(v8_isolate->SetTypeFeedbackProfile(NULL, 0));
+}
+
+
+TEST(LazyFeedbackVectorAllocation) {
+  if (i::FLAG_always_opt || !i::FLAG_lazy_feedback_vectors) return;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Isolate* isolate = CcTest::i_isolate();
+  const char* source = "function f(a) { return a.foo; }";
+
+  {
+    LocalContext context;
+    CompileRun(source);
+    CompileRun("f({ foo: 1 });");
+    CHECK(GetFunction("f")->shared()->is_compiled());
+  }
+
+  {
+    // The script comes from the compilation cache, so f is already compiled,
+    // but its new closure only gets a feedback vector when it is called.
+    LocalContext context;
+    CompileRun(source);
+    Handle<JSFunction> f = GetFunction("f");
+    CHECK(f->shared()->is_compiled());
+    CHECK(!f->is_compiled());
+    CHECK_EQ(isolate->heap()->empty_literals_array(), f->literals());
+
+    CompileRun("f({ foo: 1 });");
+    CHECK(f->is_compiled());
+    CHECK_NE(isolate->heap()->empty_literals_array(), f->literals());
+    CHECK(!f->feedback_vector()->is_empty());
+  }
+}
+
 }  // namespace
@@ -1808,6 +1808,72 @@ TEST(CodeSerializerEagerCompilationAndPreAge) {
   isolate2->Dispose();
 }
 
+TEST(CodeSerializerAsmModule) {
+  FLAG_serialize_toplevel = true;
+  FLAG_validate_asm = true;
+  LocalContext context;
+  Isolate* isolate = CcTest::i_isolate();
+  isolate->compilation_cache()->Disable();  // Disable same-isolate code cache.
+
+  v8::HandleScope scope(CcTest::isolate());
+
+  const char* source =
+      "var asm = (function Module(stdlib) {"
+      "  'use asm';"
+      "  function f(x) {"
+      "    x = x | 0;"
+      "    return (x + 1) | 0;"
+      "  }"
+      "  return { f: f };"
+      "})(this);"
+      "asm.f";
+
+  Handle<String> orig_source = isolate->factory()
+                                   ->NewStringFromUtf8(CStrVector(source))
+                                   .ToHandleChecked();
+  Handle<String> copy_source = isolate->factory()
+                                   ->NewStringFromUtf8(CStrVector(source))
+                                   .ToHandleChecked();
+
+  ScriptData* cache = NULL;
+
+  CompileScript(isolate, orig_source, Handle<String>(), &cache,
+                v8::ScriptCompiler::kProduceCodeCache);
+
+  Handle<SharedFunctionInfo> copy;
+  {
+    DisallowCompilation no_compile_expected(isolate);
+    copy = CompileScript(isolate, copy_source, Handle<String>(), &cache,
+                         v8::ScriptCompiler::kConsumeCodeCache);
+  }
+
+  // The asm.js module comes with its translation to wasm.
+  Handle<Script> script(Script::cast(copy->script()));
+  WeakFixedArray::Iterator iterator(script->shared_function_infos());
+  int count = 0;
+  while (SharedFunctionInfo* shared = iterator.Next<SharedFunctionInfo>()) {
+    if (shared->HasAsmWasmData()) count++;
+  }
+  CHECK_EQ(1, count);
+
+  Handle<JSFunction> copy_fun =
+      isolate->factory()->NewFunctionFromSharedFunctionInfo(
+          copy, isolate->native_context());
+  Handle<JSObject> global(isolate->context()->global_object());
+  Handle<Object> copy_result =
+      Execution::Call(isolate, copy_fun, global, 0, NULL).ToHandleChecked();
+  CHECK(copy_result->IsJSFunction());
+  Handle<JSFunction> f = Handle<JSFunction>::cast(copy_result);
+  CHECK_EQ(Code::JS_TO_WASM_FUNCTION, f->code()->kind());
+
+  Handle<Object> args[] = {handle(Smi::FromInt(41), isolate)};
+  Handle<Object> result =
+      Execution::Call(isolate, f, global, 1, args).ToHandleChecked();
+  CHECK_EQ(42, Handle<Smi>::cast(result)->value());
+
+  delete cache;
+}
+
 TEST(Regress503552) {
   // Test that the code serializer can deal with weak cells that form a linked
   // list during incremental marking.
@@ -286,6 +286,37 @@ TEST(Breakpoint_I32And_disable) {
   }
 }
 
+TEST(Breakpoint_I32Add_LongImmediate) {
+  static const int kLocalsDeclSize = 1;
+  static const int32_t kImmediate = 0x12345678;
+  byte code[] = {WASM_I32_ADD(WASM_GET_LOCAL(0), WASM_I32V_5(kImmediate))};
+  // The breakpoint is at the add, behind the five bytes of the immediate.
+  static const pc_t kAddOffset = kLocalsDeclSize + sizeof(code) - 1;
+
+  WasmRunner<int32_t> r(kExecuteInterpreted, MachineType::Uint32());
+
+  r.Build(code, code + arraysize(code));
+
+  WasmInterpreter* interpreter = r.interpreter();
+  WasmInterpreter::Thread* thread = interpreter->GetThread(0);
+  interpreter->SetBreakpoint(r.function(), kAddOffset, true);
+
+  FOR_UINT32_INPUTS(a) {
+    thread->Reset();
+    WasmVal args[] = {WasmVal(*a)};
+    thread->PushFrame(r.function(), args);
+
+    thread->Run();  // run to the breakpoint
+    CHECK_EQ(WasmInterpreter::PAUSED, thread->state());
+    CHECK_EQ(kAddOffset, thread->GetBreakpointPc());
+
+    thread->Run();  // run to completion
+    CHECK_EQ(WasmInterpreter::FINISHED, thread->state());
+    uint32_t expected = (*a) + static_cast<uint32_t>(kImmediate);
+    CHECK_EQ(expected, thread->GetReturnValue().to<uint32_t>());
+  }
+}
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8
@@ -6,6 +6,7 @@
 #include <string.h>
 
 #include "src/wasm/encoder.h"
+#include "src/wasm/module-decoder.h"
 #include "src/wasm/wasm-js.h"
 #include "src/wasm/wasm-macro-gen.h"
 #include "src/wasm/wasm-module.h"
@@ -33,11 +34,87 @@ void TestModule(Zone* zone, WasmModuleBuilder* builder,
   CHECK_EQ(expected_result, result);
 }
 
+// Compiles the module while feeding its bytes to a {ModuleStreamDecoder} in
+// chunks of {chunk_size}, reserving {expected_size} bytes upfront.
+void TestStreamedModule(Zone* zone, WasmModuleBuilder* builder,
+                        int32_t expected_result, size_t chunk_size,
+                        size_t expected_size) {
+  ZoneBuffer buffer(zone);
+  builder->WriteTo(buffer);
+
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  HandleScope scope(isolate);
+  WasmJs::InstallWasmFunctionMap(isolate, isolate->native_context());
+  ErrorThrower thrower(isolate, "TestStreamedModule");
+  Zone decoder_zone(isolate->allocator());
+  StreamingCompilation compilation(isolate, &thrower);
+  ModuleStreamDecoder decoder(isolate, &decoder_zone, expected_size,
+                              kWasmOrigin, &compilation);
+  for (const byte* pos = buffer.begin(); pos < buffer.end();
+       pos += chunk_size) {
+    size_t length =
+        std::min(chunk_size, static_cast<size_t>(buffer.end() - pos));
+    decoder.OnBytesReceived(pos, length);
+  }
+  CHECK(compilation.started());
+
+  ModuleResult result = decoder.Finish(false);
+  CHECK(result.ok());
+  std::unique_ptr<const WasmModule> module(result.val);
+  Handle<FixedArray> compiled_module =
+      compilation.Finish(module.get()).ToHandleChecked();
+  CHECK_EQ(expected_result, testing::InstantiateAndRunWasmModule(
+                                isolate, compiled_module, &thrower));
+}
+
 void ExportAsMain(WasmFunctionBuilder* f) {
   static const char kMainName[] = "main";
   f->SetExported();
   f->SetName(kMainName, arraysize(kMainName) - 1);
 }
+
+// Builds a module with a global and a call whose "main" returns 98. The
+// builder refers to the signatures in {sigs}.
+WasmModuleBuilder* BuildStreamedTestModule(Zone* zone, TestSignatures* sigs) {
+  WasmModuleBuilder* builder = new (zone) WasmModuleBuilder(zone);
+  uint32_t global = builder->AddGlobal(kAstI32, 0);
+  uint16_t f1_index = builder->AddFunction();
+  WasmFunctionBuilder* f = builder->FunctionAt(f1_index);
+  f->SetSignature(sigs->i_ii());
+  byte code1[] = {WASM_I32_ADD(WASM_GET_LOCAL(0), WASM_GET_LOCAL(1))};
+  f->EmitCode(code1, sizeof(code1));
+  uint16_t f2_index = builder->AddFunction();
+  f = builder->FunctionAt(f2_index);
+  f->SetSignature(sigs->i_v());
+  ExportAsMain(f);
+  byte code2[] = {WASM_STORE_GLOBAL(global, WASM_I32V_1(21)),
+                  WASM_CALL_FUNCTION2(f1_index, WASM_LOAD_GLOBAL(global),
+                                      WASM_I8(77))};
+  f->EmitCode(code2, sizeof(code2));
+  return builder;
+}
+
+// Hands out copies of the bytes in [start, end) in chunks of {chunk_size}.
+class ChunkedSourceStream : public v8::ScriptCompiler::ExternalSourceStream {
+ public:
+  ChunkedSourceStream(const byte* start, const byte* end, size_t chunk_size)
+      : pos_(start), end_(end), chunk_size_(chunk_size) {}
+
+  size_t GetMoreData(const uint8_t** src) override {
+    size_t length = std::min(chunk_size_, static_cast<size_t>(end_ - pos_));
+    if (length == 0) return 0;
+    uint8_t* chunk = new uint8_t[length];
+    memcpy(chunk, pos_, length);
+    pos_ += length;
+    *src = chunk;
+    return length;
+  }
+
+ private:
+  const byte* pos_;
+  const byte* end_;
+  size_t chunk_size_;
+};
 }  // namespace
 
 TEST(Run_WasmModule_Return114) {
@@ -126,6 +203,62 @@ TEST(Run_WasmModule_CheckMemoryIsZero) {
   TestModule(&zone, builder, 11);
 }
 
+namespace {
+// Runs a module whose main function accesses memory at the constant {index}
+// and returns whether the access trapped.
+bool ConstantIndexAccessTraps(int32_t index, bool store) {
+  v8::base::AccountingAllocator allocator;
+  Zone zone(&allocator);
+  TestSignatures sigs;
+
+  WasmModuleBuilder* builder = new (&zone) WasmModuleBuilder(&zone);
+  uint16_t f_index = builder->AddFunction();
+  WasmFunctionBuilder* f = builder->FunctionAt(f_index);
+  f->SetSignature(sigs.i_v());
+  ExportAsMain(f);
+  if (store) {
+    byte code[] = {WASM_STORE_MEM(MachineType::Int32(), WASM_I32V_5(index),
+                                  WASM_I32V_1(7)),
+                   WASM_I8(7)};
+    f->EmitCode(code, sizeof(code));
+  } else {
+    byte code[] = {WASM_I32_ADD(
+        WASM_LOAD_MEM(MachineType::Int32(), WASM_I32V_5(index)), WASM_I8(7))};
+    f->EmitCode(code, sizeof(code));
+  }
+  ZoneBuffer buffer(&zone);
+  builder->WriteTo(buffer);
+
+  Isolate* isolate = CcTest::InitIsolateOnce();
+  HandleScope scope(isolate);
+  WasmJs::InstallWasmFunctionMap(isolate, isolate->native_context());
+  int32_t result =
+      testing::CompileAndRunWasmModule(isolate, buffer.begin(), buffer.end());
+  if (!isolate->has_pending_exception()) {
+    CHECK_EQ(7, result);
+    return false;
+  }
+  isolate->clear_pending_exception();
+  return true;
+}
+}  // namespace
+
+TEST(Run_WasmModule_ConstantIndexOutOfBounds) {
+  // Memory of the module builder is 16 pages.
+  static const int32_t kMemSize = 16 * WasmModule::kPageSize;
+  bool trap_handler = FLAG_wasm_trap_handler;
+  FLAG_wasm_trap_handler = true;
+  for (bool store : {false, true}) {
+    CHECK(ConstantIndexAccessTraps(-1, store));
+    CHECK(ConstantIndexAccessTraps(static_cast<int32_t>(0x80000000u), store));
+    CHECK(ConstantIndexAccessTraps(kMemSize, store));
+    CHECK(ConstantIndexAccessTraps(kMemSize - 3, store));
+    CHECK(!ConstantIndexAccessTraps(kMemSize - 4, store));
+    CHECK(!ConstantIndexAccessTraps(0, store));
+  }
+  FLAG_wasm_trap_handler = trap_handler;
+}
+
 TEST(Run_WasmModule_CallMain_recursive) {
   v8::base::AccountingAllocator allocator;
   Zone zone(&allocator);
@@ -174,3 +307,121 @@ TEST(Run_WasmModule_Global) {
   f->EmitCode(code2, sizeof(code2));
   TestModule(&zone, builder, 97);
 }
+
+TEST(Run_WasmModule_Streamed) {
+  v8::base::AccountingAllocator allocator;
+  Zone zone(&allocator);
+  TestSignatures sigs;
+  WasmModuleBuilder* builder = BuildStreamedTestModule(&zone, &sigs);
+
+  ZoneBuffer buffer(&zone);
+  builder->WriteTo(buffer);
+  for (size_t chunk_size : {1, 3, 16, 1024}) {
+    // Reserving the whole module compiles all functions from the stream;
+    // outgrowing a small buffer leaves the rest to {Finish}.
+    TestStreamedModule(&zone, builder, 98, chunk_size, buffer.size());
+    TestStreamedModule(&zone, builder, 98, chunk_size, 0);
+    TestStreamedModule(&zone, builder, 98, chunk_size, buffer.size() - 4);
+  }
+}
+
+TEST(Run_WasmModule_CompileStreamedApi) {
+  FLAG_expose_wasm = true;
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  LocalContext env;
+  v8::base::AccountingAllocator allocator;
+  Zone zone(&allocator);
+  TestSignatures sigs;
+  WasmModuleBuilder* builder = BuildStreamedTestModule(&zone, &sigs);
+  ZoneBuffer buffer(&zone);
+  builder->WriteTo(buffer);
+
+  for (size_t chunk_size : {1, 16, 1024}) {
+    ChunkedSourceStream stream(buffer.begin(), buffer.end(), chunk_size);
+    v8::Local<v8::WasmCompiledModule> module =
+        v8::WasmCompiledModule::CompileStreamed(env.local(), &stream,
+                                                buffer.size())
+            .ToLocalChecked();
+    CHECK(module->IsWebAssemblyCompiledModule());
+    env->Global()->Set(env.local(), v8_str("module"), module).FromJust();
+    CHECK_EQ(98, CompileRun("new WebAssembly.Instance(module).exports.main()")
+                     ->Int32Value(env.local())
+                     .FromJust());
+  }
+
+  // A truncated module throws.
+  v8::TryCatch try_catch(isolate);
+  ChunkedSourceStream stream(buffer.begin(), buffer.end() - 1, 16);
+  CHECK(v8::WasmCompiledModule::CompileStreamed(env.local(), &stream,
+                                                buffer.size())
+            .IsEmpty());
+  CHECK(try_catch.HasCaught());
+}
+
+TEST(Run_WasmModule_IsCompiledModuleInOtherContext) {
+  FLAG_expose_wasm = true;
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  LocalContext env;
+  v8::base::AccountingAllocator allocator;
+  Zone zone(&allocator);
+  TestSignatures sigs;
+  WasmModuleBuilder* builder = BuildStreamedTestModule(&zone, &sigs);
+  ZoneBuffer buffer(&zone);
+  builder->WriteTo(buffer);
+
+  ChunkedSourceStream stream(buffer.begin(), buffer.end(), buffer.size());
+  v8::Local<v8::WasmCompiledModule> module =
+      v8::WasmCompiledModule::CompileStreamed(env.local(), &stream,
+                                              buffer.size())
+          .ToLocalChecked();
+  v8::Local<v8::Value> object = CompileRun("({})");
+
+  // The check must not depend on the context that is current.
+  v8::Local<v8::Context> other = v8::Context::New(isolate);
+  v8::Context::Scope other_scope(other);
+  CHECK(module->IsWebAssemblyCompiledModule());
+  CHECK(!object->IsWebAssemblyCompiledModule());
+  CHECK(!CompileRun("({})")->IsWebAssemblyCompiledModule());
+}
+
+TEST(Run_WasmModule_SerializationApi) {
+  FLAG_expose_wasm = true;
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope scope(isolate);
+  LocalContext env;
+  v8::base::AccountingAllocator allocator;
+  Zone zone(&allocator);
+  TestSignatures sigs;
+  WasmModuleBuilder* builder = BuildStreamedTestModule(&zone, &sigs);
+  ZoneBuffer buffer(&zone);
+  builder->WriteTo(buffer);
+
+  ChunkedSourceStream stream(buffer.begin(), buffer.end(), buffer.size());
+  v8::WasmCompiledModule::SerializedModule serialized =
+      v8::WasmCompiledModule::CompileStreamed(env.local(), &stream,
+                                              buffer.size())
+          .ToLocalChecked()
+          ->Serialize();
+  v8::WasmCompiledModule::CallerOwnedBuffer serialized_module(
+      serialized.first.get(), serialized.second);
+
+  v8::Local<v8::WasmCompiledModule> module =
+      v8::WasmCompiledModule::Deserialize(
+          env.local(), serialized_module, {buffer.begin(), buffer.size()})
+          .ToLocalChecked();
+  CHECK(module->IsWebAssemblyCompiledModule());
+  env->Global()->Set(env.local(), v8_str("module"), module).FromJust();
+  CHECK_EQ(98, CompileRun("new WebAssembly.Instance(module).exports.main()")
+                   ->Int32Value(env.local())
+                   .FromJust());
+
+  // Module bytes of the same length but with different contents are rejected.
+  std::vector<uint8_t> other_bytes(buffer.begin(), buffer.end());
+  other_bytes.back() ^= 1;
+  CHECK(v8::WasmCompiledModule::Deserialize(
+            env.local(), serialized_module,
+            {other_bytes.data(), other_bytes.size()})
+            .IsEmpty());
+}
@@ -40,9 +40,8 @@ void ExportAsMain(WasmFunctionBuilder* f) {
   f->SetExported();
   f->SetName(kMainName, arraysize(kMainName) - 1);
 }
-}  // namespace
 
-TEST(Run_WasmMoule_simd) {
+void TestMain(const byte* code, size_t code_size, int32_t expected_result) {
   v8::base::AccountingAllocator allocator;
   Zone zone(&allocator);
   TestSignatures sigs;
@@ -53,8 +52,53 @@ TEST(Run_WasmMoule_simd) {
   f->SetSignature(sigs.i_i());
   ExportAsMain(f);
 
+  f->EmitCode(code, static_cast<uint32_t>(code_size));
+  TestModule(&zone, builder, expected_result);
+}
+}  // namespace
+
+TEST(Run_WasmMoule_simd) {
   byte code[] = {WASM_SIMD_I32x4_EXTRACT_LANE(
       WASM_SIMD_I32x4_SPLAT(WASM_I8(123)), WASM_I8(2))};
-  f->EmitCode(code, sizeof(code));
-  TestModule(&zone, builder, 123);
+  TestMain(code, sizeof(code), 123);
+}
+
+TEST(Run_WasmModule_simd_I32x4Add) {
+  byte code[] = {WASM_SIMD_I32x4_EXTRACT_LANE(
+      WASM_SIMD_I32x4_ADD(WASM_SIMD_I32x4_SPLAT(WASM_I8(100)),
+                          WASM_SIMD_I32x4_SPLAT(WASM_I8(23))),
+      WASM_I8(3))};
+  TestMain(code, sizeof(code), 123);
+}
+
+TEST(Run_WasmModule_simd_I32x4Sub) {
+  byte code[] = {WASM_SIMD_I32x4_EXTRACT_LANE(
+      WASM_SIMD_I32x4_SUB(WASM_SIMD_I32x4_SPLAT(WASM_I8(100)),
+                          WASM_SIMD_I32x4_SPLAT(WASM_I8(123))),
+      WASM_I8(1))};
+  TestMain(code, sizeof(code), -23);
+}
+
+TEST(Run_WasmModule_simd_I32x4Mul) {
+  byte code[] = {WASM_SIMD_I32x4_EXTRACT_LANE(
+      WASM_SIMD_I32x4_MUL(WASM_SIMD_I32x4_SPLAT(WASM_I32V_2(-1000)),
+                          WASM_SIMD_I32x4_SPLAT(WASM_I32V_4(3000000))),
+      WASM_I8(2))};
+  // The product wraps around like i32.mul.
+  TestMain(code, sizeof(code), static_cast<int32_t>(-3000000000LL));
+}
+
+TEST(Run_WasmModule_simd_F32x4Arithmetic) {
+  // ((1.5 + 2.5) * 6 - 3) / 3 = 7
+  byte code[] = {WASM_I32_SCONVERT_F32(WASM_SIMD_F32x4_EXTRACT_LANE(
+      WASM_SIMD_F32x4_DIV(
+          WASM_SIMD_F32x4_SUB(
+              WASM_SIMD_F32x4_MUL(
+                  WASM_SIMD_F32x4_ADD(WASM_SIMD_F32x4_SPLAT(WASM_F32(1.5f)),
+                                      WASM_SIMD_F32x4_SPLAT(WASM_F32(2.5f))),
+                  WASM_SIMD_F32x4_SPLAT(WASM_F32(6.0f))),
+              WASM_SIMD_F32x4_SPLAT(WASM_F32(3.0f))),
+          WASM_SIMD_F32x4_SPLAT(WASM_F32(3.0f))),
+      WASM_I8(2)))};
+  TestMain(code, sizeof(code), 7);
 }
@@ -2464,6 +2464,48 @@ WASM_EXEC_TEST(MultipleCallIndirect) {
   CHECK_TRAP(r.Call(2, 1, 0));
 }
 
+WASM_EXEC_TEST(CallIndirect_CanonicalSignature) {
+  TestSignatures sigs;
+  TestingModule module(execution_mode);
+
+  // A signature that is structurally equal to i_ii.
+  LocalType types[] = {kAstI32, kAstI32, kAstI32};
+  FunctionSig other_i_ii(1, 2, types);
+
+  WasmFunctionCompiler t1(sigs.i_ii(), &module);
+  BUILD(t1, WASM_I32_ADD(WASM_GET_LOCAL(0), WASM_GET_LOCAL(1)));
+  t1.CompileAndAdd(/*sig_index*/ 0);
+
+  WasmFunctionCompiler t2(&other_i_ii, &module);
+  BUILD(t2, WASM_I32_SUB(WASM_GET_LOCAL(0), WASM_GET_LOCAL(1)));
+  t2.CompileAndAdd(/*sig_index*/ 2);
+
+  WasmFunctionCompiler t3(sigs.f_ff(), &module);
+  BUILD(t3, WASM_F32_SUB(WASM_GET_LOCAL(0), WASM_GET_LOCAL(1)));
+  t3.CompileAndAdd(/*sig_index*/ 1);
+
+  // Signature table.
+  module.AddSignature(sigs.i_ii());
+  module.AddSignature(sigs.f_ff());
+  module.AddSignature(&other_i_ii);
+
+  // Function table.
+  uint16_t indirect_function_table[] = {0, 1, 2};
+  module.AddIndirectFunctionTable(indirect_function_table,
+                                  arraysize(indirect_function_table));
+  module.PopulateIndirectFunctionTable();
+
+  // Builder the caller function.
+  WasmRunner<int32_t> r(&module, MachineType::Int32());
+  BUILD(r, WASM_CALL_INDIRECT2(2, WASM_GET_LOCAL(0), WASM_I8(66), WASM_I8(22)));
+
+  // Both functions match the call, whichever of the equal signatures
+  // they were declared with.
+  CHECK_EQ(88, r.Call(0));
+  CHECK_EQ(44, r.Call(1));
+  CHECK_TRAP(r.Call(2));
+}
+
 WASM_EXEC_TEST(CallIndirect_NoTable) {
   TestSignatures sigs;
   TestingModule module(execution_mode);
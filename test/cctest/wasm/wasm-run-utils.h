@@ -123,6 +123,7 @@ class TestingModule : public ModuleEnv {
     module_.signatures.push_back(sig);
     size_t size = module->signatures.size();
     CHECK(size < 127);
+    module_.signature_map.FindOrInsert(sig, static_cast<uint32_t>(size - 1));
     return static_cast<byte>(size - 1);
   }
 
@@ -0,0 +1,122 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Straight-line numeric kernels with independent chains of arithmetic,
+// which are sensitive to the order of instructions within a basic block.
+
+new BenchmarkSuite('MatrixMultiply', [1000], [
+  new Benchmark('MatrixMultiply', false, false, 0,
+                MatrixMultiply, MatrixMultiplySetup, MatrixMultiplyTearDown)
+]);
+
+new BenchmarkSuite('Mandelbrot', [1000], [
+  new Benchmark('Mandelbrot', false, false, 0,
+                Mandelbrot, MandelbrotSetup, MandelbrotTearDown)
+]);
+
+new BenchmarkSuite('IntegerHash', [1000], [
+  new Benchmark('IntegerHash', false, false, 0,
+                IntegerHash, IntegerHashSetup, IntegerHashTearDown)
+]);
+
+// ----------------------------------------------------------------------------
+
+var N = 32;
+var a;
+var b;
+var c;
+
+function MatrixMultiplySetup() {
+  a = new Float64Array(N * N);
+  b = new Float64Array(N * N);
+  c = new Float64Array(N * N);
+  for (var i = 0; i < N * N; ++i) {
+    a[i] = (i % 7) * 0.5;
+    b[i] = (i % 5) * 0.25;
+  }
+}
+
+function MatrixMultiply() {
+  for (var i = 0; i < N; ++i) {
+    for (var j = 0; j < N; j += 2) {
+      var sum0 = 0;
+      var sum1 = 0;
+      for (var k = 0; k < N; ++k) {
+        var x = a[i * N + k];
+        sum0 += x * b[k * N + j];
+        sum1 += x * b[k * N + j + 1];
+      }
+      c[i * N + j] = sum0;
+      c[i * N + j + 1] = sum1;
+    }
+  }
+}
+
+function MatrixMultiplyTearDown() {
+  var expected = 0;
+  for (var k = 0; k < N; ++k) {
+    expected += a[k] * b[k * N];
+  }
+  return c[0] === expected;
+}
+
+// ----------------------------------------------------------------------------
+
+var iterations;
+
+function MandelbrotSetup() {
+  iterations = 0;
+}
+
+function Mandelbrot() {
+  var count = 0;
+  for (var y = 0; y < 32; ++y) {
+    var ci = y / 16 - 1;
+    for (var x = 0; x < 32; ++x) {
+      var cr = x / 16 - 1.5;
+      var zr = 0;
+      var zi = 0;
+      var i = 0;
+      for (; i < 50; ++i) {
+        var zr2 = zr * zr;
+        var zi2 = zi * zi;
+        if (zr2 + zi2 > 4) break;
+        zi = 2 * zr * zi + ci;
+        zr = zr2 - zi2 + cr;
+      }
+      count += i;
+    }
+  }
+  iterations = count;
+}
+
+function MandelbrotTearDown() {
+  return iterations > 0;
+}
+
+// ----------------------------------------------------------------------------
+
+var hash;
+
+function IntegerHashSetup() {
+  hash = 0;
+}
+
+function IntegerHash() {
+  var h0 = 0x12345678 | 0;
+  var h1 = 0x9abcdef0 | 0;
+  for (var i = 0; i < 4096; ++i) {
+    h0 = (h0 ^ i) | 0;
+    h1 = (h1 + i) | 0;
+    h0 = Math.imul(h0, 0x85ebca6b);
+    h1 = Math.imul(h1, 0xc2b2ae35);
+    h0 = (h0 ^ (h0 >>> 13)) | 0;
+    h1 = (h1 ^ (h1 >>> 16)) | 0;
+  }
+  hash = (h0 ^ h1) | 0;
+}
+
+function IntegerHashTearDown() {
+  return hash !== 0;
+}
@@ -0,0 +1,94 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Throughput of indirect calls through an asm.js function table, which is
+// translated to wasm call_indirect with --validate-asm. This resembles the
+// virtual dispatch of compiled C++ code.
+
+new BenchmarkSuite('Monomorphic', [1000], [
+  new Benchmark('Monomorphic', false, false, 0,
+                Monomorphic, IndirectCallsSetup, IndirectCallsTearDown)
+]);
+
+new BenchmarkSuite('Polymorphic', [1000], [
+  new Benchmark('Polymorphic', false, false, 0,
+                Polymorphic, IndirectCallsSetup, IndirectCallsTearDown)
+]);
+
+// ----------------------------------------------------------------------------
+
+function IndirectCallsModule(stdlib) {
+  "use asm";
+
+  function add(a, b) {
+    a = a | 0;
+    b = b | 0;
+    return (a + b) | 0;
+  }
+
+  function sub(a, b) {
+    a = a | 0;
+    b = b | 0;
+    return (a - b) | 0;
+  }
+
+  function xor(a, b) {
+    a = a | 0;
+    b = b | 0;
+    return (a ^ b) | 0;
+  }
+
+  function shl(a, b) {
+    a = a | 0;
+    b = b | 0;
+    return (a << (b & 7)) | 0;
+  }
+
+  // Calls the same function of the table each time.
+  function monomorphic(n) {
+    n = n | 0;
+    var acc = 0;
+    var i = 0;
+    var k = 0;
+    for (i = 0; (i | 0) < (n | 0); i = (i + 1) | 0) {
+      acc = table[k & 3](acc, i) | 0;
+    }
+    return acc | 0;
+  }
+
+  // Cycles through all functions of the table.
+  function polymorphic(n) {
+    n = n | 0;
+    var acc = 0;
+    var i = 0;
+    for (i = 0; (i | 0) < (n | 0); i = (i + 1) | 0) {
+      acc = table[i & 3](acc, i) | 0;
+    }
+    return acc | 0;
+  }
+
+  var table = [add, sub, xor, shl];
+
+  return { monomorphic: monomorphic, polymorphic: polymorphic };
+}
+
+var module;
+var result;
+
+function IndirectCallsSetup() {
+  module = IndirectCallsModule(this);
+  result = 0;
+}
+
+function Monomorphic() {
+  result = module.monomorphic(10000);
+}
+
+function Polymorphic() {
+  result = module.polymorphic(10000);
+}
+
+function IndirectCallsTearDown() {
+  return result !== 0;
+}
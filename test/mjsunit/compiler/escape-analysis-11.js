@@ -0,0 +1,84 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-escape
+
+// Test temporary iterator results, small arrays and function contexts that
+// don't escape, including materialization of them on deoptimization.
+
+(function TestIterResultObject() {
+  function* gen() { yield 1; yield 2; }
+  function f() {
+    var sum = 0;
+    for (var x of gen()) sum += x;
+    return sum;
+  }
+  assertEquals(3, f());
+  assertEquals(3, f());
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(3, f());
+})();
+
+(function TestSmallArrayConstantIndex() {
+  function f(a, b) {
+    var arr = [a, b];
+    return arr[0] + arr[1];
+  }
+  assertEquals(3, f(1, 2));
+  assertEquals(3, f(1, 2));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(3, f(1, 2));
+  assertEquals("ab", f("a", "b"));
+})();
+
+(function TestSmallArrayDeopt() {
+  function f(a, b, deopt) {
+    var arr = [a, b];
+    if (deopt) %DeoptimizeNow();
+    return arr;
+  }
+  assertEquals([1, 2], f(1, 2, false));
+  assertEquals([1, 2], f(1, 2, false));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals([1, 2], f(1, 2, false));
+  assertEquals([3, 4], f(3, 4, true));
+})();
+
+(function TestIdentityOfVirtualObject() {
+  function f(x) {
+    var o = { x: x };
+    var p = o;
+    return o === p;
+  }
+  assertTrue(f(1));
+  assertTrue(f(1));
+  %OptimizeFunctionOnNextCall(f);
+  assertTrue(f(1));
+})();
+
+(function TestIsReceiverOfVirtualObject() {
+  function g(o) { return %_IsJSReceiver(o); }
+  function f(x) {
+    var o = { x: x };
+    return g(o) ? o.x : 0;
+  }
+  assertEquals(1, f(1));
+  assertEquals(1, f(1));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(1, f(1));
+})();
+
+(function TestFunctionContextDeopt() {
+  function f(x, deopt) {
+    function inner() { return x; }
+    var y = x + 1;
+    if (deopt) %DeoptimizeNow();
+    return y + inner();
+  }
+  assertEquals(3, f(1, false));
+  assertEquals(3, f(1, false));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(3, f(1, false));
+  assertEquals(5, f(2, true));
+})();
@@ -0,0 +1,102 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Test that the force-inlined higher-order Array builtins compute the same
+// results in optimized code, including deoptimization in the middle of the
+// loop over the elements.
+
+var deopt = false;
+var sum = 0;
+
+function add(x) { sum += x; }
+function double(x) { return x * 2; }
+function odd(x) { return (x & 1) == 1; }
+function big(x) { return x > 3; }
+function positive(x) { return x > 0; }
+function plus(acc, x) { return acc + x; }
+
+(function TestForEach() {
+  function test(a) { sum = 0; a.forEach(add); return sum; }
+  assertEquals(10, test([1, 2, 3, 4]));
+  assertEquals(10, test([1, 2, 3, 4]));
+  %OptimizeFunctionOnNextCall(test);
+  assertEquals(10, test([1, 2, 3, 4]));
+  assertOptimized(test);
+  assertEquals(6, test([1, , 2, , 3]));
+})();
+
+(function TestMap() {
+  function test(a) { return a.map(double); }
+  assertEquals([2, 4, 6], test([1, 2, 3]));
+  assertEquals([2, 4, 6], test([1, 2, 3]));
+  %OptimizeFunctionOnNextCall(test);
+  assertEquals([2, 4, 6], test([1, 2, 3]));
+  assertOptimized(test);
+  assertEquals([2.5, 5], test([1.25, 2.5]));
+})();
+
+(function TestFilter() {
+  function test(a) { return a.filter(odd); }
+  assertEquals([1, 3], test([1, 2, 3, 4]));
+  assertEquals([1, 3], test([1, 2, 3, 4]));
+  %OptimizeFunctionOnNextCall(test);
+  assertEquals([1, 3], test([1, 2, 3, 4]));
+  assertEquals([], test([]));
+})();
+
+(function TestSomeEvery() {
+  function test(a) { return [a.some(big), a.every(positive)]; }
+  assertEquals([true, true], test([1, 2, 3, 4]));
+  assertEquals([false, false], test([0, 1]));
+  %OptimizeFunctionOnNextCall(test);
+  assertEquals([true, true], test([1, 2, 3, 4]));
+  assertEquals([false, false], test([0, 1]));
+})();
+
+(function TestReduce() {
+  function test(a) { return a.reduce(plus); }
+  function testInitial(a) { return a.reduce(plus, 100); }
+  assertEquals(10, test([1, 2, 3, 4]));
+  assertEquals(110, testInitial([1, 2, 3, 4]));
+  %OptimizeFunctionOnNextCall(test);
+  %OptimizeFunctionOnNextCall(testInitial);
+  assertEquals(10, test([1, 2, 3, 4]));
+  assertEquals(110, testInitial([1, 2, 3, 4]));
+  assertThrows(() => test([]), TypeError);
+})();
+
+(function TestNonCallable() {
+  function test(a, f) { return a.map(f); }
+  assertEquals([2], test([1], double));
+  %OptimizeFunctionOnNextCall(test);
+  assertEquals([2], test([1], double));
+  assertThrows(() => test([1], 1), TypeError);
+})();
+
+(function TestDeoptInCallback() {
+  function callback(x, i) {
+    if (deopt && i == 2) %DeoptimizeFunction(test);
+    return x + i;
+  }
+  function test(a) { return a.map(callback); }
+  assertEquals([1, 3, 5, 7], test([1, 2, 3, 4]));
+  assertEquals([1, 3, 5, 7], test([1, 2, 3, 4]));
+  %OptimizeFunctionOnNextCall(test);
+  assertEquals([1, 3, 5, 7], test([1, 2, 3, 4]));
+  deopt = true;
+  assertEquals([1, 3, 5, 7], test([1, 2, 3, 4]));
+  deopt = false;
+})();
+
+(function TestDeoptOnElementsKindChange() {
+  function test(a) { sum = 0; a.forEach(add); return sum; }
+  assertEquals(6, test([1, 2, 3]));
+  assertEquals(6, test([1, 2, 3]));
+  %OptimizeFunctionOnNextCall(test);
+  assertEquals(6, test([1, 2, 3]));
+  assertEquals(6.5, test([1, 2, 3.5]));
+  assertEquals("0ab", test(["a", "b"]));
+})();
@@ -0,0 +1,74 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+function A() {}
+A.prototype.f = function() { return 1; };
+function B() {}
+B.prototype.f = function() { return 2; };
+function C() {}
+C.prototype.f = function() { throw 3; };
+function D() {}
+D.prototype.f = function() { return 4; };
+
+(function TestPolymorphicMethodCall() {
+  function test(o) { return o.f(); }
+  var a = new A(), b = new B();
+  assertEquals(1, test(a));
+  assertEquals(2, test(b));
+  %OptimizeFunctionOnNextCall(test);
+  assertEquals(1, test(a));
+  assertEquals(2, test(b));
+  assertEquals(4, test(new D()));
+})();
+
+(function TestPolymorphicConditionalTarget() {
+  function f(x) { return x + 1; }
+  function g(x) { return x + 2; }
+  function test(c, x) { return (c ? f : g)(x); }
+  assertEquals(2, test(true, 1));
+  assertEquals(3, test(false, 1));
+  %OptimizeFunctionOnNextCall(test);
+  assertEquals(2, test(true, 1));
+  assertEquals(3, test(false, 1));
+})();
+
+(function TestPolymorphicWithFallback() {
+  function f(x) { return x + 1; }
+  function h(x) { return x + 3; }
+  function test(c, k, x) { return (c ? f : k)(x); }
+  assertEquals(2, test(true, h, 1));
+  assertEquals(4, test(false, h, 1));
+  %OptimizeFunctionOnNextCall(test);
+  assertEquals(2, test(true, h, 1));
+  assertEquals(4, test(false, h, 1));
+  assertEquals(11, test(false, function(x) { return x + 10; }, 1));
+  assertEquals(2, test(false, f, 1));
+})();
+
+(function TestPolymorphicConstruct() {
+  function test(c) { return new (c ? A : B)(); }
+  assertInstanceof(test(true), A);
+  assertInstanceof(test(false), B);
+  %OptimizeFunctionOnNextCall(test);
+  assertInstanceof(test(true), A);
+  assertInstanceof(test(false), B);
+})();
+
+(function TestPolymorphicCallWithCatch() {
+  function test(o) {
+    try {
+      return o.f();
+    } catch (e) {
+      return e + 10;
+    }
+  }
+  var a = new A(), c = new C();
+  assertEquals(1, test(a));
+  assertEquals(13, test(c));
+  %OptimizeFunctionOnNextCall(test);
+  assertEquals(1, test(a));
+  assertEquals(13, test(c));
+})();
@@ -0,0 +1,52 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo --turbo-fast-regalloc-threshold=0
+
+// Force the fast register allocation mode for every function and check that
+// code with high register pressure, loops and phis still computes correctly.
+
+function sumOfProducts(a, n) {
+  var s0 = 0, s1 = 0, s2 = 0, s3 = 0, s4 = 0, s5 = 0, s6 = 0, s7 = 0;
+  for (var i = 0; i < n; i++) {
+    var x = a[i];
+    s0 += x * 1;
+    s1 += x * 2;
+    s2 += x * 3;
+    s3 += x * 4;
+    s4 += x * 5;
+    s5 += x * 6;
+    s6 += x * 7;
+    s7 += x * 8;
+  }
+  return s0 + s1 + s2 + s3 + s4 + s5 + s6 + s7;
+}
+
+var a = [];
+for (var i = 0; i < 100; i++) a.push(i);
+
+assertEquals(178200, sumOfProducts(a, 100));
+assertEquals(178200, sumOfProducts(a, 100));
+%OptimizeFunctionOnNextCall(sumOfProducts);
+assertEquals(178200, sumOfProducts(a, 100));
+assertEquals(1620, sumOfProducts(a, 10));
+
+function nestedLoops(n) {
+  var d = 0.5;
+  var r = 0;
+  for (var i = 0; i < n; i++) {
+    var t = i;
+    for (var j = 0; j < n; j++) {
+      t = (t * 31 + j) | 0;
+      d = d * 0.5 + j;
+    }
+    r = (r + t) | 0;
+  }
+  return r + Math.floor(d);
+}
+
+var expected = nestedLoops(20);
+nestedLoops(20);
+%OptimizeFunctionOnNextCall(nestedLoops);
+assertEquals(expected, nestedLoops(20));
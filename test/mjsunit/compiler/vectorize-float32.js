@@ -0,0 +1,130 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo --turbo-loop-vectorization
+
+// Lengths that are not multiples of the vector width exercise the scalar
+// epilogue after the vector loop.
+var N = 19;
+var a = new Float32Array(N);
+var b = new Float32Array(N);
+var c = new Float32Array(N);
+var buffer = new Float32Array(N + 8);
+var low = buffer.subarray(0, N);
+var high4 = buffer.subarray(4, N + 4);
+var high1 = buffer.subarray(1, N + 1);
+
+function fill() {
+  for (var i = 0; i < N; i++) {
+    a[i] = i + 0.1;
+    b[i] = 2 * i - 7.3;
+    c[i] = -1;
+  }
+}
+
+function check(expected, f) {
+  fill();
+  f();
+  for (var i = 0; i < N; i++) {
+    assertEquals(Math.fround(expected(i)), c[i]);
+  }
+}
+
+function test(expected, f) {
+  check(expected, f);
+  check(expected, f);
+  %OptimizeFunctionOnNextCall(f);
+  check(expected, f);
+}
+
+function copy() {
+  for (var i = 0; i < N; i++) c[i] = a[i];
+}
+test(function(i) { return a[i]; }, copy);
+
+function add() {
+  for (var i = 0; i < N; i++) c[i] = a[i] + b[i];
+}
+test(function(i) { return a[i] + b[i]; }, add);
+
+function mul() {
+  for (var i = 0; i < N; i++) c[i] = a[i] * b[i];
+}
+test(function(i) { return a[i] * b[i]; }, mul);
+
+function scale() {
+  for (var i = 0; i < N; i++) c[i] = a[i] / 3;
+}
+test(function(i) { return a[i] / 3; }, scale);
+
+function fround() {
+  for (var i = 0; i < N; i++) c[i] = Math.fround(a[i] * b[i]) - a[i];
+}
+test(function(i) { return Math.fround(a[i] * b[i]) - a[i]; }, fround);
+
+// Rounded only once in double precision, must not be vectorized.
+function fma() {
+  for (var i = 0; i < N; i++) c[i] = a[i] * b[i] + 1e-3;
+}
+test(function(i) { return a[i] * b[i] + 1e-3; }, fma);
+
+function partial(n) {
+  for (var i = 2; i < n; i++) c[i] = a[i] - b[i];
+}
+for (var n = 0; n <= N; n++) {
+  fill();
+  partial(n);
+  %OptimizeFunctionOnNextCall(partial);
+  fill();
+  partial(n);
+  for (var i = 0; i < N; i++) {
+    var expected = i >= 2 && i < n ? Math.fround(a[i] - b[i]) : -1;
+    assertEquals(expected, c[i]);
+  }
+}
+
+// Element-wise in place.
+function square() {
+  for (var i = 0; i < N; i++) low[i] = low[i] * low[i];
+}
+function checkSquare() {
+  for (var i = 0; i < buffer.length; i++) buffer[i] = i;
+  square();
+  for (var i = 0; i < buffer.length; i++) {
+    assertEquals(i < N ? i * i : i, buffer[i]);
+  }
+}
+checkSquare();
+checkSquare();
+%OptimizeFunctionOnNextCall(square);
+checkSquare();
+
+// Overlapping views, shifted by a whole vector and by a single element.
+function shift(dst, src) {
+  for (var i = 0; i < N; i++) dst[i] = src[i];
+}
+function shift4() {
+  for (var i = 0; i < N; i++) high4[i] = low[i];
+}
+function shift1() {
+  for (var i = 0; i < N; i++) high1[i] = low[i];
+}
+function checkShift(f, distance) {
+  for (var i = 0; i < buffer.length; i++) buffer[i] = i;
+  f();
+  var reference = new Float32Array(N + 8);
+  for (var i = 0; i < reference.length; i++) reference[i] = i;
+  shift(reference.subarray(distance, N + distance),
+        reference.subarray(0, N));
+  for (var i = 0; i < buffer.length; i++) {
+    assertEquals(reference[i], buffer[i]);
+  }
+}
+[shift4, shift1].forEach(function(f) {
+  var distance = f === shift4 ? 4 : 1;
+  checkShift(f, distance);
+  checkShift(f, distance);
+  %OptimizeFunctionOnNextCall(f);
+  checkShift(f, distance);
+});
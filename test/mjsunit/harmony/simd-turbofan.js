@@ -0,0 +1,103 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --harmony-simd --allow-natives-syntax --turbo --turbo-escape
+// Flags: --noalways-opt
+
+// Test that TurboFan lowers Float32x4 and Int32x4 arithmetic, removes the
+// intermediate wrappers and rematerializes them on deoptimization.
+
+function assertFloat32x4Equals(expected, actual) {
+  for (var i = 0; i < 4; i++) {
+    assertEquals(expected[i], SIMD.Float32x4.extractLane(actual, i));
+  }
+}
+
+function assertInt32x4Equals(expected, actual) {
+  for (var i = 0; i < 4; i++) {
+    assertEquals(expected[i], SIMD.Int32x4.extractLane(actual, i));
+  }
+}
+
+(function TestFloat32x4Arithmetic() {
+  function f(a, b) {
+    var c = SIMD.Float32x4.add(a, b);
+    var d = SIMD.Float32x4.sub(c, b);
+    var e = SIMD.Float32x4.mul(d, b);
+    return SIMD.Float32x4.div(e, a);
+  }
+  var a = SIMD.Float32x4(1, 2, 4, 8);
+  var b = SIMD.Float32x4(0.5, 1.5, -2, 3);
+  assertFloat32x4Equals([0.5, 1.5, -2, 3], f(a, b));
+  assertFloat32x4Equals([0.5, 1.5, -2, 3], f(a, b));
+  %OptimizeFunctionOnNextCall(f);
+  assertFloat32x4Equals([0.5, 1.5, -2, 3], f(a, b));
+  assertOptimized(f);
+})();
+
+(function TestInt32x4Arithmetic() {
+  function f(a, b) {
+    var c = SIMD.Int32x4.add(a, b);
+    return SIMD.Int32x4.sub(c, SIMD.Int32x4.add(b, b));
+  }
+  var a = SIMD.Int32x4(1, -2, 0x7fffffff, 0);
+  var b = SIMD.Int32x4(3, 4, 1, -1);
+  var expected = [-2, -6, 0x7ffffffe, 1];
+  assertInt32x4Equals(expected, f(a, b));
+  assertInt32x4Equals(expected, f(a, b));
+  %OptimizeFunctionOnNextCall(f);
+  assertInt32x4Equals(expected, f(a, b));
+  assertOptimized(f);
+})();
+
+(function TestExtractLaneWithoutWrapper() {
+  function f(a, b) {
+    var c = SIMD.Float32x4.add(a, b);
+    var d = SIMD.Int32x4.add(SIMD.Int32x4(1, 2, 3, 4),
+                             SIMD.Int32x4(4, 3, 2, 1));
+    return SIMD.Float32x4.extractLane(c, 2) + SIMD.Int32x4.extractLane(d, 3);
+  }
+  var a = SIMD.Float32x4(1, 2, 3, 4);
+  var b = SIMD.Float32x4(1, 1, 1, 1);
+  assertEquals(9, f(a, b));
+  assertEquals(9, f(a, b));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(9, f(a, b));
+  assertOptimized(f);
+})();
+
+(function TestMaterializeOnDeopt() {
+  function f(a, b, deopt) {
+    var c = SIMD.Float32x4.add(a, b);
+    var d = SIMD.Int32x4.sub(SIMD.Int32x4(5, 6, 7, 8),
+                             SIMD.Int32x4(1, 1, 1, 1));
+    if (deopt) %DeoptimizeNow();
+    return [c, d];
+  }
+  var a = SIMD.Float32x4(1, 2, 3, 4);
+  var b = SIMD.Float32x4(0.25, 0.5, 0.75, 1);
+  f(a, b, false);
+  f(a, b, false);
+  %OptimizeFunctionOnNextCall(f);
+  f(a, b, false);
+  var r = f(a, b, true);
+  assertFloat32x4Equals([1.25, 2.5, 3.75, 5], r[0]);
+  assertInt32x4Equals([4, 5, 6, 7], r[1]);
+  assertEquals("float32x4", typeof r[0]);
+  assertEquals("int32x4", typeof r[1]);
+})();
+
+(function TestWrongTypeDeopts() {
+  function f(a, b) {
+    return SIMD.Float32x4.extractLane(SIMD.Float32x4.add(a, b), 0);
+  }
+  var a = SIMD.Float32x4(1, 2, 3, 4);
+  assertEquals(2, f(a, a));
+  assertEquals(2, f(a, a));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(2, f(a, a));
+  assertOptimized(f);
+  assertThrows(function() { f(a, SIMD.Int32x4(1, 2, 3, 4)); }, TypeError);
+  assertUnoptimized(f);
+})();
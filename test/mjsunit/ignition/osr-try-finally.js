@@ -0,0 +1,122 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --ignition --turbo-from-bytecode
+
+// Note that --ignition-osr is not passed explicitly, OSR from bytecode is
+// expected to be on by default when TurboFan builds graphs from bytecode.
+
+(function TestOSRLoopInsideTryFinally() {
+  var finally_count = 0;
+  function f() {
+    var sum = 0;
+    try {
+      for (var i = 0; i < 10; i++) {
+        if (i == 5) %OptimizeOsr();
+        sum += i;
+      }
+    } finally {
+      finally_count++;
+    }
+    return sum;
+  }
+  assertEquals(45, f());
+  assertEquals(1, finally_count);
+})();
+
+(function TestOSRTryFinallyInsideLoop() {
+  function f() {
+    var sum = 0;
+    var finally_count = 0;
+    for (var i = 0; i < 10; i++) {
+      try {
+        if (i == 5) %OptimizeOsr();
+        if (i % 2 == 0) continue;
+        sum += i;
+      } finally {
+        finally_count++;
+      }
+    }
+    return sum * 100 + finally_count;
+  }
+  assertEquals(2510, f());
+})();
+
+(function TestOSRBreakThroughFinally() {
+  function f() {
+    var result = 0;
+    outer: for (var i = 0; i < 10; i++) {
+      for (var j = 0; j < 10; j++) {
+        try {
+          if (j == 5) %OptimizeOsr();
+          if (i == 3 && j == 7) break outer;
+          result++;
+        } finally {
+          result += 100;
+        }
+      }
+    }
+    return result;
+  }
+  assertEquals(3837, f());
+})();
+
+(function TestOSRThrowThroughFinally() {
+  var finally_count = 0;
+  function f() {
+    for (var i = 0; i < 10; i++) {
+      try {
+        if (i == 5) %OptimizeOsr();
+        if (i == 7) throw i;
+      } finally {
+        finally_count++;
+      }
+    }
+  }
+  assertThrowsEquals(f, 7);
+  assertEquals(8, finally_count);
+})();
+
+(function TestOSRGeneratorWithTryFinally() {
+  var finally_count = 0;
+  function* gen() {
+    for (var i = 0; i < 3; ++i) {
+      try {
+        for (var j = 0; j < 10; ++j) {
+          if (j == 5) %OptimizeOsr();
+        }
+        yield i;
+      } finally {
+        finally_count++;
+      }
+    }
+    return 23;
+  }
+  var g = gen();
+  assertEquals({ value:0, done:false }, g.next());
+  assertEquals({ value:1, done:false }, g.next());
+  assertEquals({ value:2, done:false }, g.next());
+  assertEquals({ value:23, done:true }, g.next());
+  assertEquals(3, finally_count);
+})();
+
+(function TestOSRGeneratorReturnThroughFinally() {
+  var finally_count = 0;
+  function* gen() {
+    try {
+      for (var i = 0; i < 10; ++i) {
+        if (i == 5) %OptimizeOsr();
+        yield i;
+      }
+    } finally {
+      finally_count++;
+    }
+  }
+  var g = gen();
+  for (var i = 0; i < 7; ++i) {
+    assertEquals({ value:i, done:false }, g.next());
+  }
+  assertEquals({ value:42, done:true }, g.return(42));
+  assertEquals(1, finally_count);
+})();
@@ -0,0 +1,55 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ignition --turbo-from-bytecode --allow-natives-syntax
+// Flags: --ignition-tierup-ticks=2 --ignition-tierup-bytes-per-tick=16
+// Flags: --ignition-early-opt-size=0 --ignition-tierup-max-ticks=1000
+
+// The policy is queried through %GetIgnitionTierUpDecision, which returns
+// what the runtime profiler would decide after the given number of ticks.
+// This keeps the test independent of when the profiler actually ticks.
+
+function small(a) { return a.x; }
+
+function large(a) {
+  var sum = 0;
+  for (var i = 0; i < a.length; i++) {
+    var o = a[i];
+    if (o.x > 0) sum += o.x; else sum -= o.x;
+    if (o.y !== undefined) sum += o.y;
+    sum = (sum * 31) | 0;
+  }
+  return sum;
+}
+
+function polymorphic(a) { return a.x; }
+
+var objects = [];
+for (var i = 0; i < 10; i++) objects.push({ x: i, y: i & 3 });
+
+for (var i = 0; i < 10; i++) {
+  small({ x: i });
+  large(objects);
+  var o = { x: i };
+  o["p" + (i % 8)] = i;
+  polymorphic(o);
+}
+
+// A small function with stable feedback is optimized after
+// --ignition-tierup-ticks ticks.
+assertEquals(undefined, %GetIgnitionTierUpDecision(small, 0));
+assertEquals(undefined, %GetIgnitionTierUpDecision(small, 1));
+assertEquals("hot and stable", %GetIgnitionTierUpDecision(small, 2));
+
+// A large function needs one more tick per 16 bytes of bytecode, but gets
+// there as well.
+assertEquals(undefined, %GetIgnitionTierUpDecision(large, 2));
+assertEquals("hot and stable", %GetIgnitionTierUpDecision(large, 999));
+
+// A megamorphic load counts as generic feedback, which keeps the function in
+// the interpreter until it reaches --ignition-tierup-max-ticks.
+assertEquals(undefined, %GetIgnitionTierUpDecision(polymorphic, 2));
+assertEquals(undefined, %GetIgnitionTierUpDecision(polymorphic, 999));
+assertEquals("not much type info but very hot",
+             %GetIgnitionTierUpDecision(polymorphic, 1000));
@@ -0,0 +1,208 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --expose-wasm --wasm-threads-prototype --harmony-sharedarraybuffer
+// Flags: --allow-natives-syntax
+
+load("test/mjsunit/wasm/wasm-constants.js");
+load("test/mjsunit/wasm/wasm-module-builder.js");
+
+var kPageSize = 0x10000;
+
+function addAtomicBinop(builder, name, op) {
+  builder.addFunction(name, kSig_i_ii)
+      .addBody([
+        kExprGetLocal, 0,
+        kExprGetLocal, 1,
+        kExprAtomicPrefix, op, 2, 0
+      ])
+      .exportFunc();
+}
+
+function genAtomicsModule() {
+  var builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, true, true);
+  builder.addFunction("load", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprAtomicPrefix, kExprI32AtomicLoad, 2, 0])
+      .exportFunc();
+  // Loads with a constant offset of 4.
+  builder.addFunction("load_offset", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprAtomicPrefix, kExprI32AtomicLoad, 2, 4])
+      .exportFunc();
+  addAtomicBinop(builder, "store", kExprI32AtomicStore);
+  addAtomicBinop(builder, "add", kExprI32AtomicAdd);
+  addAtomicBinop(builder, "sub", kExprI32AtomicSub);
+  addAtomicBinop(builder, "and", kExprI32AtomicAnd);
+  addAtomicBinop(builder, "or", kExprI32AtomicOr);
+  addAtomicBinop(builder, "xor", kExprI32AtomicXor);
+  addAtomicBinop(builder, "exchange", kExprI32AtomicExchange);
+  addAtomicBinop(builder, "wake", kExprI32AtomicWake);
+  builder.addFunction("compare_exchange", kSig_i_iii)
+      .addBody([
+        kExprGetLocal, 0,
+        kExprGetLocal, 1,
+        kExprGetLocal, 2,
+        kExprAtomicPrefix, kExprI32AtomicCompareExchange, 2, 0
+      ])
+      .exportFunc();
+  builder.addFunction("wait", makeSig([kAstI32, kAstI32, kAstF64], [kAstI32]))
+      .addBody([
+        kExprGetLocal, 0,
+        kExprGetLocal, 1,
+        kExprGetLocal, 2,
+        kExprAtomicPrefix, kExprI32AtomicWait, 2, 0
+      ])
+      .exportFunc();
+  return builder.instantiate();
+}
+
+(function testSharedMemory() {
+  var exports = genAtomicsModule().exports;
+  assertTrue(exports.memory instanceof SharedArrayBuffer);
+  assertEquals(kPageSize, exports.memory.byteLength);
+
+  var i32 = new Int32Array(exports.memory);
+  assertEquals(42, exports.store(8, 42));
+  assertEquals(42, Atomics.load(i32, 2));
+  Atomics.store(i32, 3, 17);
+  assertEquals(17, exports.load(12));
+  assertEquals(17, exports.load_offset(8));
+})();
+
+(function testReadModifyWrite() {
+  var exports = genAtomicsModule().exports;
+  var i32 = new Int32Array(exports.memory);
+
+  // Each operation returns the previous value.
+  i32[0] = 10;
+  assertEquals(10, exports.add(0, 5));
+  assertEquals(15, exports.sub(0, 20));
+  assertEquals(-5, exports.and(0, 0xff));
+  assertEquals(0xfb, exports.or(0, 0x100));
+  assertEquals(0x1fb, exports.xor(0, 0x1ff));
+  assertEquals(4, exports.exchange(0, 0x7fffffff));
+  assertEquals(0x7fffffff, exports.add(0, 1));
+  assertEquals(-0x80000000, i32[0]);
+
+  // The new value is only stored if the old one matches.
+  i32[1] = 3;
+  assertEquals(3, exports.compare_exchange(4, 4, 5));
+  assertEquals(3, i32[1]);
+  assertEquals(3, exports.compare_exchange(4, 3, 5));
+  assertEquals(5, i32[1]);
+
+  // The operations act on the whole word at the very end of the memory.
+  i32[i32.length - 1] = 1;
+  assertEquals(1, exports.add(kPageSize - 4, 1));
+  assertEquals(2, i32[i32.length - 1]);
+})();
+
+(function testTraps() {
+  var exports = genAtomicsModule().exports;
+  assertTraps(kTrapUnalignedAccess, () => exports.load(1));
+  assertTraps(kTrapUnalignedAccess, () => exports.store(2, 1));
+  assertTraps(kTrapUnalignedAccess, () => exports.add(3, 1));
+  assertTraps(kTrapUnalignedAccess, () => exports.compare_exchange(5, 0, 1));
+  assertTraps(kTrapUnalignedAccess, () => exports.wait(6, 0, 0));
+  assertTraps(kTrapMemOutOfBounds, () => exports.load(kPageSize));
+  assertTraps(kTrapMemOutOfBounds, () => exports.load_offset(kPageSize - 4));
+  assertTraps(kTrapMemOutOfBounds, () => exports.exchange(-4, 1));
+  assertTraps(kTrapMemOutOfBounds, () => exports.wake(kPageSize, 1));
+})();
+
+(function testWaitAndWake() {
+  var exports = genAtomicsModule().exports;
+  var i32 = new Int32Array(exports.memory);
+  i32[4] = 1;
+  // 1: the value did not match, 2: the wait timed out.
+  assertEquals(1, exports.wait(16, 0, 0));
+  assertEquals(2, exports.wait(16, 1, 0));
+  assertEquals(2, exports.wait(16, 1, -1));
+  // There are no waiters to wake.
+  assertEquals(0, exports.wake(16, 1));
+})();
+
+(function testInstantiateWithMemory() {
+  var builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, false, true);
+  builder.addFunction("add", kSig_i_ii)
+      .addBody([
+        kExprGetLocal, 0,
+        kExprGetLocal, 1,
+        kExprAtomicPrefix, kExprI32AtomicAdd, 2, 0
+      ])
+      .exportFunc();
+  var module = new WebAssembly.Module(builder.toBuffer());
+
+  // Two instances that share their memory see each other's updates.
+  var memory = new SharedArrayBuffer(kPageSize);
+  var first = new WebAssembly.Instance(module, null, memory).exports;
+  var second = new WebAssembly.Instance(module, null, memory).exports;
+  assertEquals(0, first.add(0, 2));
+  assertEquals(2, second.add(0, 3));
+  assertEquals(5, Atomics.load(new Int32Array(memory), 0));
+
+  // A shared memory must be a SharedArrayBuffer and vice versa.
+  assertThrows(() => new WebAssembly.Instance(module, null,
+                                              new ArrayBuffer(kPageSize)));
+})();
+
+if (this.Worker) {
+  (function testWaitAndWakeWithWorker() {
+    var builder = new WasmModuleBuilder();
+    builder.addMemory(1, 1, false, true);
+    builder.addFunction("wait", makeSig([kAstI32, kAstI32, kAstF64], [kAstI32]))
+        .addBody([
+          kExprGetLocal, 0,
+          kExprGetLocal, 1,
+          kExprGetLocal, 2,
+          kExprAtomicPrefix, kExprI32AtomicWait, 2, 0
+        ])
+        .exportFunc();
+    addAtomicBinop(builder, "wake", kExprI32AtomicWake);
+    var bytes = builder.toBuffer();
+
+    var workerScript =
+      `onmessage = function(msg) {
+         var module = new WebAssembly.Module(msg.bytes);
+         var instance = new WebAssembly.Instance(module, null, msg.memory);
+         postMessage(instance.exports.wait(16, 0, Infinity));
+       };`;
+
+    var memory = new SharedArrayBuffer(kPageSize);
+    var i32 = new Int32Array(memory);
+    var exports = new WebAssembly.Instance(
+        new WebAssembly.Module(bytes), null, memory).exports;
+
+    var worker = new Worker(workerScript);
+    worker.postMessage({bytes: bytes, memory: memory}, [memory]);
+
+    // Spin until the worker is blocked in the wasm wait on byte address 16.
+    while (%AtomicsNumWaitersForTesting(i32, 4) != 1) {}
+
+    // 0: the waiter was woken.
+    assertEquals(1, exports.wake(16, 1));
+    assertEquals(0, worker.getMessage());
+    assertEquals(0, %AtomicsNumWaitersForTesting(i32, 4));
+    worker.terminate();
+  })();
+}
+
+(function testAtomicsRequireSharedMemory() {
+  var builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, false);
+  builder.addFunction("load", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprAtomicPrefix, kExprI32AtomicLoad, 2, 0]);
+  assertThrows(() => new WebAssembly.Module(builder.toBuffer()));
+})();
+
+(function testSharedMemoryCannotGrow() {
+  var builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, false, true);
+  builder.addFunction("grow_memory", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprGrowMemory])
+      .exportFunc();
+  var exports = builder.instantiate().exports;
+  assertTraps(kTrapMemAllocationFail, () => exports.grow_memory(1));
+})();
@@ -0,0 +1,123 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --expose-wasm --allow-natives-syntax
+
+load("test/mjsunit/wasm/wasm-constants.js");
+load("test/mjsunit/wasm/wasm-module-builder.js");
+
+function SerializeAndDeserialize(wire_bytes) {
+  var module = new WebAssembly.Module(wire_bytes);
+  var buffer = %SerializeWasmModule(module);
+  assertTrue(buffer instanceof ArrayBuffer);
+  var clone = %DeserializeWasmModule(buffer, wire_bytes);
+  assertTrue(clone instanceof WebAssembly.Module);
+  return clone;
+}
+
+(function testCallsAndImports() {
+  var builder = new WasmModuleBuilder();
+  builder.addImport("add", kSig_i_ii);
+  var inc = builder.addFunction("inc", kSig_i_i)
+      .addBody([
+        kExprGetLocal, 0,
+        kExprI32Const, 1,
+        kExprCallImport, kArity2, 0
+      ])
+      .exportFunc();
+  builder.addFunction("main", kSig_i_i)
+      .addBody([
+        kExprGetLocal, 0,
+        kExprCallFunction, kArity1, inc.index,
+        kExprCallFunction, kArity1, inc.index
+      ])
+      .exportFunc();
+  var module = SerializeAndDeserialize(builder.toBuffer());
+
+  // Each instance links the deserialized code to its own imports.
+  var exports = new WebAssembly.Instance(module, {add: (a, b) => a + b})
+      .exports;
+  assertEquals(12, exports.main(10));
+  assertEquals(11, exports.inc(10));
+  exports = new WebAssembly.Instance(module, {add: (a, b) => a * b}).exports;
+  assertEquals(10, exports.main(10));
+})();
+
+(function testMemoryAndDataSegments() {
+  var builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, true);
+  builder.addDataSegment(16, [1, 2, 3, 4], true);
+  builder.addFunction("load", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprI32LoadMem, 0, 0])
+      .exportFunc();
+  builder.addFunction("store", kSig_i_ii)
+      .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32StoreMem, 0, 0])
+      .exportFunc();
+  var module = SerializeAndDeserialize(builder.toBuffer());
+
+  var first = new WebAssembly.Instance(module).exports;
+  var second = new WebAssembly.Instance(module).exports;
+  assertEquals(0x04030201, first.load(16));
+  assertEquals(42, first.store(16, 42));
+  assertEquals(42, first.load(16));
+  assertEquals(0x04030201, second.load(16));
+  assertTraps(kTrapMemOutOfBounds, () => second.load(0x10000));
+})();
+
+(function testIndirectCallsAndStartFunction() {
+  var builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, true);
+  var sig_index = builder.addType(kSig_i_ii);
+  builder.addFunction("add", sig_index)
+      .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32Add]);
+  builder.addFunction("sub", sig_index)
+      .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32Sub]);
+  builder.addFunction("main", kSig_i_iii)
+      .addBody([
+        kExprGetLocal, 0,
+        kExprGetLocal, 1,
+        kExprGetLocal, 2,
+        kExprCallIndirect, kArity2, sig_index
+      ])
+      .exportFunc();
+  var start = builder.addFunction("start", kSig_v_v)
+      .addBody([kExprI32Const, 0, kExprI32Const, 42, kExprI32StoreMem, 0, 0]);
+  builder.addStart(start.index);
+  builder.appendToTable([0, 1, 2]);
+  var module = SerializeAndDeserialize(builder.toBuffer());
+
+  var instance = new WebAssembly.Instance(module);
+  assertEquals(42, new Int32Array(instance.exports.memory)[0]);
+  assertEquals(19, instance.exports.main(0, 12, 7));
+  assertEquals(5, instance.exports.main(1, 12, 7));
+  assertTraps(kTrapFuncSigMismatch, () => instance.exports.main(2, 12, 33));
+  assertTraps(kTrapFuncInvalid, () => instance.exports.main(3, 12, 33));
+})();
+
+(function testCorruptedDataIsRejected() {
+  var builder = new WasmModuleBuilder();
+  builder.addFunction("main", kSig_i_v)
+      .addBody([kExprI32Const, 42])
+      .exportFunc();
+  var wire_bytes = builder.toBuffer();
+  var buffer = %SerializeWasmModule(new WebAssembly.Module(wire_bytes));
+
+  // The payload checksum catches changes to the data.
+  var corrupted = buffer.slice(0);
+  var view = new Uint8Array(corrupted);
+  view[view.length - 1] ^= 0xff;
+  assertEquals(undefined, %DeserializeWasmModule(corrupted, wire_bytes));
+
+  // The data does not match other module bytes.
+  var other_builder = new WasmModuleBuilder();
+  other_builder.addFunction("other", kSig_i_v)
+      .addBody([kExprI32Const, 42])
+      .exportFunc();
+  assertEquals(undefined,
+               %DeserializeWasmModule(buffer, other_builder.toBuffer()));
+
+  // The rejected attempts do not affect valid data.
+  var module = %DeserializeWasmModule(buffer, wire_bytes);
+  assertEquals(42, new WebAssembly.Instance(module).exports.main());
+})();
@@ -47,3 +47,30 @@ assertEquals(19, module.exports.main(0, 12, 7));
 
 assertTraps(kTrapFuncSigMismatch, "module.exports.main(2, 12, 33)");
 assertTraps(kTrapFuncInvalid, "module.exports.main(3, 12, 33)");
+
+(function testStructurallyEqualSignatures() {
+  var builder = new WasmModuleBuilder();
+  // Each of these functions gets a type of its own, which are all equal.
+  builder.addFunction("add", kSig_i_ii)
+    .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32Add]);
+  builder.addFunction("sub", kSig_i_ii)
+    .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32Sub]);
+  builder.addFunction("neg", kSig_i_i)
+    .addBody([kExprI32Const, 0, kExprGetLocal, 0, kExprI32Sub]);
+  var sig_index = builder.addType(kSig_i_ii);
+  builder.addFunction("main", kSig_i_iii)
+    .addBody([
+      kExprGetLocal, 0,
+      kExprGetLocal, 1,
+      kExprGetLocal, 2,
+      kExprCallIndirect, kArity2, sig_index
+    ])
+    .exportFunc();
+  builder.appendToTable([0, 1, 2]);
+  var main = builder.instantiate().exports.main;
+
+  assertEquals(19, main(0, 12, 7));
+  assertEquals(5, main(1, 12, 7));
+  assertTraps(kTrapFuncSigMismatch, () => main(2, 12, 7));
+  assertTraps(kTrapFuncInvalid, () => main(3, 12, 7));
+})();
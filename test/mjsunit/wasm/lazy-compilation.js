@@ -0,0 +1,174 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --expose-wasm --wasm-lazy-compilation --allow-natives-syntax
+// Flags: --concurrent-recompilation --block-concurrent-recompilation
+
+load("test/mjsunit/wasm/wasm-constants.js");
+load("test/mjsunit/wasm/wasm-module-builder.js");
+
+(function testDirectCalls() {
+  var builder = new WasmModuleBuilder();
+  var inc = builder.addFunction("inc", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprI32Const, 1, kExprI32Add])
+      .exportFunc();
+  var twice = builder.addFunction("twice", kSig_i_i)
+      .addBody([
+        kExprGetLocal, 0,
+        kExprCallFunction, kArity1, inc.index,
+        kExprCallFunction, kArity1, inc.index
+      ])
+      .exportFunc();
+  builder.addFunction("main", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprCallFunction, kArity1, twice.index])
+      .exportFunc();
+  var module = new WebAssembly.Module(builder.toBuffer());
+
+  // Each instance compiles its functions on their own.
+  for (var i = 0; i < 3; i++) {
+    var exports = new WebAssembly.Instance(module).exports;
+    assertEquals(12, exports.main(10));
+    assertEquals(13, exports.main(11));
+    assertEquals(8, exports.twice(6));
+    assertEquals(6, exports.inc(5));
+  }
+
+  // Calling a function compiles it before its callers.
+  var exports = new WebAssembly.Instance(module).exports;
+  assertEquals(2, exports.inc(1));
+  assertEquals(3, exports.twice(1));
+  assertEquals(3, exports.main(1));
+})();
+
+(function testIndirectCalls() {
+  var builder = new WasmModuleBuilder();
+  var sig_index = builder.addType(kSig_i_ii);
+  builder.addFunction("add", sig_index)
+      .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32Add]);
+  builder.addFunction("sub", sig_index)
+      .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32Sub]);
+  builder.addFunction("main", kSig_i_iii)
+      .addBody([
+        kExprGetLocal, 0,
+        kExprGetLocal, 1,
+        kExprGetLocal, 2,
+        kExprCallIndirect, kArity2, sig_index
+      ])
+      .exportFunc();
+  builder.appendToTable([0, 1, 2]);
+  var main = builder.instantiate().exports.main;
+
+  for (var i = 0; i < 2; i++) {
+    assertEquals(19, main(0, 12, 7));
+    assertEquals(5, main(1, 12, 7));
+  }
+  assertTraps(kTrapFuncSigMismatch, () => main(2, 12, 33));
+  assertTraps(kTrapFuncInvalid, () => main(3, 12, 33));
+})();
+
+(function testImportsAndStack() {
+  var stack;
+  function STACK() {
+    stack = new Error().stack;
+  }
+  var builder = new WasmModuleBuilder();
+  builder.addImport("func", kSig_v_v);
+  var callee = builder.addFunction("callee", kSig_v_v)
+      .addBody([kExprCallImport, kArity0, 0]);
+  builder.addFunction("main", kSig_v_v)
+      .addBody([kExprCallFunction, kArity0, callee.index])
+      .exportFunc();
+  var main = builder.instantiate({func: STACK}).exports.main;
+
+  // The lazy compile stubs do not show up in the stack traces.
+  for (var i = 0; i < 2; i++) {
+    main();
+    var frames = stack.split("\n").slice(1, 4);
+    assertContains("at STACK", frames[0]);
+    assertContains("at callee (<WASM>[0]+", frames[1]);
+    assertContains("at main (<WASM>[1]+", frames[2]);
+  }
+})();
+
+(function testMemory() {
+  var builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, true);
+  builder.addFunction("load", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprI32LoadMem, 0, 0])
+      .exportFunc();
+  builder.addFunction("store", kSig_i_ii)
+      .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32StoreMem, 0, 0])
+      .exportFunc();
+  builder.addFunction("grow_memory", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprGrowMemory])
+      .exportFunc();
+  var exports = builder.instantiate().exports;
+
+  // Functions compiled after the memory grew see its new size.
+  assertEquals(1, exports.grow_memory(1));
+  assertEquals(77, exports.store(0x10000, 77));
+  assertEquals(77, exports.load(0x10000));
+  assertTraps(kTrapMemOutOfBounds, () => exports.load(0x20000));
+})();
+
+(function testPrefetchedCallees() {
+  var builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, true);
+  var load = builder.addFunction("load", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprI32LoadMem, 0, 0]);
+  // main(0) returns 0 without calling load.
+  builder.addFunction("main", kSig_i_i)
+      .addBody([
+        kExprGetLocal, 0,
+        kExprI32Eqz,
+        kExprIf,
+          kExprI8Const, 0,
+          kExprReturn, kArity1,
+        kExprEnd,
+        kExprGetLocal, 0,
+        kExprCallFunction, kArity1, load.index
+      ])
+      .exportFunc();
+  builder.addFunction("store", kSig_i_ii)
+      .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32StoreMem, 0, 0])
+      .exportFunc();
+  builder.addFunction("grow_memory", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprGrowMemory])
+      .exportFunc();
+  var exports = builder.instantiate().exports;
+
+  // The first call of main queues the compilation of load in the background,
+  // where it waits until after the memory grew.
+  assertEquals(0, exports.main(0));
+  assertEquals(1, exports.grow_memory(1));
+  assertEquals(55, exports.store(0x10000, 55));
+  %UnblockConcurrentRecompilation();
+  // Whether or not the background compilation has been installed, load
+  // accesses the grown memory.
+  for (var i = 0; i < 100; i++) {
+    assertEquals(55, exports.main(0x10000));
+  }
+  assertTraps(kTrapMemOutOfBounds, () => exports.main(0x20000));
+})();
+
+(function testStartFunction() {
+  var builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, true);
+  var start = builder.addFunction("start", kSig_v_v)
+      .addBody([kExprI32Const, 0, kExprI32Const, 42, kExprI32StoreMem, 0, 0]);
+  builder.addStart(start.index);
+  var module = builder.instantiate();
+  assertEquals(42, new Int32Array(module.exports.memory)[0]);
+})();
+
+(function testInvalidFunctionFailsAtCompileTime() {
+  var builder = new WasmModuleBuilder();
+  builder.addFunction("valid", kSig_i_v)
+      .addBody([kExprI32Const, 0])
+      .exportFunc();
+  builder.addFunction("invalid", kSig_i_v)
+      .addBody([kExprF32Const, 0, 0, 0, 0])
+      .exportFunc();
+  assertThrows(() => new WebAssembly.Module(builder.toBuffer()));
+})();
@@ -2,7 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
-// Flags: --expose-wasm --wasm-num-compilation-tasks=10
+// Flags: --expose-wasm --wasm-num-compilation-tasks=10 --validate-asm
 
 load("test/mjsunit/wasm/wasm-constants.js");
 load("test/mjsunit/wasm/wasm-module-builder.js");
@@ -98,3 +98,58 @@ function assertFunction(module, func) {
     assertEquals(8888888, add(3333333, 5555555));
   }
 })();
+
+(function FunctionsOfDifferentSizesTest() {
+
+  var builder = new WasmModuleBuilder();
+
+  // The larger functions are compiled first, which must not mix up the code
+  // of the functions.
+  for (i = 0; i < 100; i++) {
+    var body = [kExprI32Const, 1];
+    for (var j = 0; j < i; j++) {
+      body.push(kExprI32Const, 1, kExprI32Add);
+    }
+    builder.addFunction("count" + i, kSig_i_v)
+      .addBody(body)
+      .exportFunc()
+  }
+  var module = builder.instantiate();
+
+  for (i = 0; i < 100; i++) {
+    var count = assertFunction(module, "count" + i);
+    assertEquals(i + 1, count());
+  }
+})();
+
+(function AsmJsTruncationTest() {
+  // The double to int conversions of asm.js call a code stub out of line,
+  // which requires assembling these functions on the main thread.
+  function Module(stdlib) {
+    "use asm";
+    function toInt(x) {
+      x = +x;
+      return ~~x;
+    }
+    function toIntSum(x, y) {
+      x = +x;
+      y = +y;
+      return (~~x + ~~y) | 0;
+    }
+    function add(a, b) {
+      a = a | 0;
+      b = b | 0;
+      return (a + b) | 0;
+    }
+    return {toInt: toInt, toIntSum: toIntSum, add: add};
+  }
+  var m = Module(this);
+  assertEquals(1, m.toInt(1.5));
+  assertEquals(-1, m.toInt(-1.5));
+  assertEquals(0, m.toInt(4294967296));
+  assertEquals(-2147483648, m.toInt(2147483648));
+  assertEquals(1, m.toInt(4294967297.5));
+  assertEquals(0, m.toInt(NaN));
+  assertEquals(1, m.toIntSum(4294967296, 1.25));
+  assertEquals(3, m.add(1, 2));
+})();
@@ -0,0 +1,182 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --expose-wasm --allow-natives-syntax --wasm-tier-up
+// Flags: --wasm-tier-up-budget=10 --block-concurrent-recompilation
+
+load("test/mjsunit/wasm/wasm-constants.js");
+load("test/mjsunit/wasm/wasm-module-builder.js");
+
+if (!%IsConcurrentRecompilationSupported()) {
+  print("Concurrent recompilation is disabled. Skipping this test.");
+  quit();
+}
+
+// The functions of these tests get hot quickly. Their optimized code is
+// installed at some point during the loops, which must not change results.
+
+// Tiers reported by %GetWasmFunctionTier.
+var kTierBaseline = 1;
+var kTierOptimized = 2;
+
+(function testDirectCalls() {
+  var builder = new WasmModuleBuilder();
+  var inc = builder.addFunction("inc", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprI32Const, 1, kExprI32Add])
+      .exportFunc();
+  builder.addFunction("main", kSig_i_i)
+      .addBody([
+        kExprGetLocal, 0,
+        kExprCallFunction, kArity1, inc.index,
+        kExprCallFunction, kArity1, inc.index
+      ])
+      .exportFunc();
+  var module = new WebAssembly.Module(builder.toBuffer());
+  var first = new WebAssembly.Instance(module).exports;
+  var second = new WebAssembly.Instance(module).exports;
+
+  for (var i = 0; i < 100; i++) {
+    assertEquals(i + 2, first.main(i));
+    assertEquals(i + 1, first.inc(i));
+  }
+  assertEquals(kTierBaseline, %GetWasmFunctionTier(first.main, "no sync"));
+  assertEquals(kTierBaseline, %GetWasmFunctionTier(first.inc, "no sync"));
+  %UnblockConcurrentRecompilation();
+  for (var i = 0; i < 1000; i++) {
+    assertEquals(i + 2, first.main(i));
+    assertEquals(i + 1, first.inc(i));
+  }
+  assertEquals(kTierOptimized, %GetWasmFunctionTier(first.main));
+  assertEquals(kTierOptimized, %GetWasmFunctionTier(first.inc));
+  assertEquals(1002, first.main(1000));
+  // Each instance tiers up on its own.
+  assertEquals(7, second.main(5));
+  assertEquals(6, second.inc(5));
+  assertEquals(kTierBaseline, %GetWasmFunctionTier(second.main));
+  assertEquals(kTierBaseline, %GetWasmFunctionTier(second.inc));
+})();
+
+(function testLoops() {
+  var builder = new WasmModuleBuilder();
+  // Sums up the numbers below the parameter.
+  builder.addFunction("sum", kSig_i_i)
+      .addLocals({i32_count: 1})
+      .addBody([
+        kExprLoop,
+          kExprGetLocal, 0,
+          kExprIf,
+            kExprGetLocal, 0,
+            kExprI32Const, 1,
+            kExprI32Sub,
+            kExprSetLocal, 0,
+            kExprGetLocal, 1,
+            kExprGetLocal, 0,
+            kExprI32Add,
+            kExprSetLocal, 1,
+            kExprBr, kArity0, 1,
+          kExprEnd,
+        kExprEnd,
+        kExprGetLocal, 1
+      ])
+      .exportFunc();
+  var sum = builder.instantiate().exports.sum;
+
+  // The first call runs out of budget in its loop.
+  assertEquals(499500, sum(1000));
+  assertEquals(kTierBaseline, %GetWasmFunctionTier(sum, "no sync"));
+  %UnblockConcurrentRecompilation();
+  for (var i = 0; i < 100; i++) {
+    assertEquals(i * (i - 1) / 2, sum(i));
+  }
+  assertEquals(kTierOptimized, %GetWasmFunctionTier(sum));
+  assertEquals(4950, sum(100));
+})();
+
+(function testIndirectCalls() {
+  var builder = new WasmModuleBuilder();
+  var sig_index = builder.addType(kSig_i_ii);
+  builder.addFunction("add", sig_index)
+      .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32Add]);
+  builder.addFunction("sub", sig_index)
+      .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32Sub]);
+  builder.addFunction("main", kSig_i_iii)
+      .addBody([
+        kExprGetLocal, 0,
+        kExprGetLocal, 1,
+        kExprGetLocal, 2,
+        kExprCallIndirect, kArity2, sig_index
+      ])
+      .exportFunc();
+  builder.appendToTable([0, 1, 2]);
+  var main = builder.instantiate().exports.main;
+
+  for (var i = 0; i < 100; i++) {
+    assertEquals(i + 7, main(0, i, 7));
+    assertEquals(i - 7, main(1, i, 7));
+  }
+  %UnblockConcurrentRecompilation();
+  for (var i = 0; i < 1000; i++) {
+    assertEquals(i + 7, main(0, i, 7));
+    assertEquals(i - 7, main(1, i, 7));
+  }
+  assertEquals(kTierOptimized, %GetWasmFunctionTier(main));
+  assertTraps(kTrapFuncSigMismatch, () => main(2, 12, 33));
+  assertTraps(kTrapFuncInvalid, () => main(3, 12, 33));
+})();
+
+(function testMemoryGrowsDuringRecompilation() {
+  var builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, true);
+  builder.addFunction("load", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprI32LoadMem, 0, 0])
+      .exportFunc();
+  builder.addFunction("store", kSig_i_ii)
+      .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32StoreMem, 0, 0])
+      .exportFunc();
+  builder.addFunction("grow_memory", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprGrowMemory])
+      .exportFunc();
+  var exports = builder.instantiate().exports;
+
+  // Queue both functions for recompilation against the initial memory.
+  for (var i = 0; i < 100; i++) {
+    assertEquals(i, exports.store(i * 4, i));
+    assertEquals(i, exports.load(i * 4));
+  }
+  assertEquals(1, exports.grow_memory(1));
+  %UnblockConcurrentRecompilation();
+  for (var i = 0; i < 1000; i++) {
+    assertEquals(i, exports.store(0x10000 + i * 4, i));
+    assertEquals(i, exports.load(0x10000 + i * 4));
+  }
+  assertEquals(kTierOptimized, %GetWasmFunctionTier(exports.load));
+  assertEquals(kTierOptimized, %GetWasmFunctionTier(exports.store));
+  assertEquals(99, exports.load(99 * 4));
+  assertTraps(kTrapMemOutOfBounds, () => exports.load(0x20000));
+})();
+
+(function testImports() {
+  var calls = 0;
+  function count(x) {
+    calls++;
+    return x;
+  }
+  var builder = new WasmModuleBuilder();
+  builder.addImport("count", kSig_i_i);
+  builder.addFunction("main", kSig_i_i)
+      .addBody([
+        kExprGetLocal, 0,
+        kExprCallImport, kArity1, 0,
+        kExprI32Const, 1,
+        kExprI32Add
+      ])
+      .exportFunc();
+  var main = builder.instantiate({count: count}).exports.main;
+
+  for (var i = 0; i < 100; i++) assertEquals(i + 1, main(i));
+  %UnblockConcurrentRecompilation();
+  for (var i = 0; i < 1000; i++) assertEquals(i + 1, main(i));
+  assertEquals(kTierOptimized, %GetWasmFunctionTier(main));
+  assertEquals(1100, calls);
+})();
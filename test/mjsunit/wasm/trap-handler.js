@@ -0,0 +1,178 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --expose-wasm --expose-gc --wasm-trap-handler
+
+load("test/mjsunit/wasm/wasm-constants.js");
+load("test/mjsunit/wasm/wasm-module-builder.js");
+
+// Where the trap handler is not supported, the flag has no effect and the
+// same behavior is provided by explicit bounds checks.
+
+var kPageSize = 0x10000;
+
+function genMemoryModule(pages) {
+  var builder = new WasmModuleBuilder();
+  if (pages > 0) builder.addMemory(pages, pages, true);
+  builder.addFunction("load", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprI32LoadMem, 0, 0])
+      .exportFunc();
+  builder.addFunction("load8", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprI32LoadMem8U, 0, 0])
+      .exportFunc();
+  // Loads with the largest offset that can be encoded.
+  builder.addFunction("load_far", kSig_i_i)
+      .addBody([
+        kExprGetLocal, 0,
+        kExprI32LoadMem, 0, 0xff, 0xff, 0xff, 0xff, 0x0f
+      ])
+      .exportFunc();
+  builder.addFunction("store", kSig_i_ii)
+      .addBody([kExprGetLocal, 0, kExprGetLocal, 1, kExprI32StoreMem, 0, 0])
+      .exportFunc();
+  builder.addFunction("grow_memory", kSig_i_i)
+      .addBody([kExprGetLocal, 0, kExprGrowMemory])
+      .exportFunc();
+  return builder.instantiate();
+}
+
+function testInBounds() {
+  var module = genMemoryModule(1);
+  var exports = module.exports;
+  for (var offset = 0; offset <= kPageSize - 4; offset += 997) {
+    exports.store(offset, offset);
+    assertEquals(offset, exports.load(offset));
+  }
+  exports.store(kPageSize - 4, 0x01020304);
+  assertEquals(0x01020304, exports.load(kPageSize - 4));
+  assertEquals(0x01, exports.load8(kPageSize - 1));
+}
+
+testInBounds();
+
+function testOutOfBounds() {
+  var module = genMemoryModule(1);
+  var exports = module.exports;
+  for (var offset = kPageSize - 3; offset < kPageSize + 4; offset++) {
+    assertTraps(kTrapMemOutOfBounds, () => exports.load(offset));
+    assertTraps(kTrapMemOutOfBounds, () => exports.store(offset, 1));
+  }
+  assertTraps(kTrapMemOutOfBounds, () => exports.load8(kPageSize));
+  assertTraps(kTrapMemOutOfBounds, () => exports.load(-1));
+  assertTraps(kTrapMemOutOfBounds, () => exports.store(-4, 1));
+  assertTraps(kTrapMemOutOfBounds, () => exports.load_far(0));
+  assertTraps(kTrapMemOutOfBounds, () => exports.load_far(-1));
+  // The module keeps working after a trap.
+  exports.store(8, 42);
+  assertEquals(42, exports.load(8));
+}
+
+testOutOfBounds();
+
+function testConstantIndices() {
+  // Constant indices are not folded into the signed 32-bit displacement of the
+  // access, where 0x80000000 and above would become negative offsets.
+  var builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, false);
+  var kSig_v_i = makeSig([kAstI32], []);
+  // Signed LEB128 encodings of the constant indices.
+  var indices = {
+    minus_one: [0x7f],                        // -1
+    min_int: [0x80, 0x80, 0x80, 0x80, 0x78],  // 0x80000000
+    mem_size: [0x80, 0x80, 0x04],             // kPageSize
+    last_word: [0xfc, 0xff, 0x03]             // kPageSize - 4
+  };
+  for (var name in indices) {
+    builder.addFunction("load_" + name, kSig_i_v)
+        .addBody([kExprI32Const].concat(indices[name],
+                                        [kExprI32LoadMem, 0, 0]))
+        .exportFunc();
+    builder.addFunction("store_" + name, kSig_v_i)
+        .addBody([kExprI32Const].concat(indices[name],
+                                        [kExprGetLocal, 0,
+                                         kExprI32StoreMem, 0, 0]))
+        .exportFunc();
+  }
+  var exports = builder.instantiate().exports;
+  for (var round = 0; round < 2; round++) {
+    assertTraps(kTrapMemOutOfBounds, () => exports.load_minus_one());
+    assertTraps(kTrapMemOutOfBounds, () => exports.store_minus_one(1));
+    assertTraps(kTrapMemOutOfBounds, () => exports.load_min_int());
+    assertTraps(kTrapMemOutOfBounds, () => exports.store_min_int(1));
+    assertTraps(kTrapMemOutOfBounds, () => exports.load_mem_size());
+    assertTraps(kTrapMemOutOfBounds, () => exports.store_mem_size(1));
+    exports.store_last_word(round + 1);
+    assertEquals(round + 1, exports.load_last_word());
+    // Traps keep working after a GC, which may move the code.
+    gc();
+  }
+}
+
+testConstantIndices();
+
+function testWithoutMemory() {
+  var exports = genMemoryModule(0).exports;
+  assertTraps(kTrapMemOutOfBounds, () => exports.load(0));
+  assertTraps(kTrapMemOutOfBounds, () => exports.store(0, 1));
+}
+
+testWithoutMemory();
+
+function testGrowMemory() {
+  var exports = genMemoryModule(1).exports;
+  exports.store(kPageSize - 4, 17);
+  assertTraps(kTrapMemOutOfBounds, () => exports.load(kPageSize));
+  try {
+    assertEquals(1, exports.grow_memory(2));
+  } catch (e) {
+    assertEquals(kTrapMsgs[kTrapMemAllocationFail], e.message);
+    return;
+  }
+  assertEquals(17, exports.load(kPageSize - 4));
+  assertEquals(0, exports.load(kPageSize));
+  exports.store(3 * kPageSize - 4, 23);
+  assertEquals(23, exports.load(3 * kPageSize - 4));
+  assertTraps(kTrapMemOutOfBounds, () => exports.load(3 * kPageSize - 3));
+}
+
+testGrowMemory();
+
+function testTrapPosition() {
+  var builder = new WasmModuleBuilder();
+  builder.addMemory(1, 1, false);
+  builder.addFunction("main", kSig_i_i)
+      .addBody([
+        kExprGetLocal, 0,
+        // offset 3
+        kExprI32LoadMem, 0, 0
+      ])
+      .exportFunc();
+  var main = builder.instantiate().exports.main;
+  var prepare = Error.prepareStackTrace;
+  Error.prepareStackTrace = (error, frames) => frames;
+  try {
+    main(kPageSize);
+    fail("expected wasm trap");
+  } catch (e) {
+    assertEquals(kTrapMsgs[kTrapMemOutOfBounds], e.message);
+    assertEquals(3, e.stack[0].getPosition());
+  } finally {
+    Error.prepareStackTrace = prepare;
+  }
+}
+
+testTrapPosition();
+
+function testMemoriesAreFreed() {
+  // Each memory reserves a large guard region, which must be released when
+  // the module dies.
+  for (var i = 0; i < 100; i++) {
+    var exports = genMemoryModule(1).exports;
+    exports.store(0, i);
+    assertEquals(i, exports.load(0));
+    if (i % 10 == 0) gc();
+  }
+}
+
+testMemoriesAreFreed();
@@ -305,6 +305,18 @@ var kExprI64Rol = 0xb9;
 var kExprSimdPrefix = 0xe5;
 var kExprI32x4Splat = 0x1b;
 var kExprI32x4ExtractLane = 0x1c;
+var kExprAtomicPrefix = 0xfe;
+var kExprI32AtomicWake = 0x00;
+var kExprI32AtomicWait = 0x01;
+var kExprI32AtomicLoad = 0x10;
+var kExprI32AtomicStore = 0x11;
+var kExprI32AtomicAdd = 0x12;
+var kExprI32AtomicSub = 0x13;
+var kExprI32AtomicAnd = 0x14;
+var kExprI32AtomicOr = 0x15;
+var kExprI32AtomicXor = 0x16;
+var kExprI32AtomicExchange = 0x17;
+var kExprI32AtomicCompareExchange = 0x18;
 
 var kExprJITSingleFunction = 0xf0;
 
@@ -318,6 +330,7 @@ var kTrapFuncInvalid          = 6;
 var kTrapFuncSigMismatch      = 7;
 var kTrapMemAllocationFail    = 8;
 var kTrapInvalidIndex         = 9;
+var kTrapUnalignedAccess      = 10;
 
 var kTrapMsgs = [
   "unreachable",
@@ -329,7 +342,8 @@ var kTrapMsgs = [
   "invalid function",
   "function signature mismatch",
   "failed to allocate memory",
-  "invalid index into function table"
+  "invalid index into function table",
+  "unaligned memory access"
 ];
 
 function assertTraps(trap, code) {
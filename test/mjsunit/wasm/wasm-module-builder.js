@@ -117,8 +117,8 @@ class WasmModuleBuilder {
     this.start_index = start_index;
   }
 
-  addMemory(min, max, exp) {
-    this.memory = {min: min, max: max, exp: exp};
+  addMemory(min, max, exp, shared) {
+    this.memory = {min: min, max: max, exp: exp, shared: shared};
     return this;
   }
 
@@ -243,7 +243,8 @@ class WasmModuleBuilder {
       binary.emit_section(kDeclMemory, section => {
         section.emit_varint(wasm.memory.min);
         section.emit_varint(wasm.memory.max);
-        section.emit_u8(wasm.memory.exp ? 1 : 0);
+        section.emit_u8((wasm.memory.exp ? 1 : 0) |
+                        (wasm.memory.shared ? 2 : 0));
       });
     }
 
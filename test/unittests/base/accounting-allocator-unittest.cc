@@ -0,0 +1,98 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/base/accounting-allocator.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+#ifdef V8_USE_ADDRESS_SANITIZER
+#include <sanitizer/asan_interface.h>
+#endif  // V8_USE_ADDRESS_SANITIZER
+
+namespace v8 {
+namespace base {
+
+namespace {
+
+const size_t kPooledSize = 8 * 1024;
+
+}  // namespace
+
+TEST(AccountingAllocator, PoolReusesFreedSegments) {
+  AccountingAllocator allocator;
+  void* first = allocator.Allocate(kPooledSize);
+  ASSERT_NE(nullptr, first);
+  EXPECT_EQ(kPooledSize, allocator.GetCurrentMemoryUsage());
+  allocator.Free(first, kPooledSize);
+  EXPECT_EQ(0u, allocator.GetCurrentMemoryUsage());
+  EXPECT_EQ(kPooledSize, allocator.GetCurrentPoolSize());
+  void* second = allocator.Allocate(kPooledSize);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(0u, allocator.GetCurrentPoolSize());
+  allocator.Free(second, kPooledSize);
+}
+
+TEST(AccountingAllocator, OddSizesAreNotPooled) {
+  AccountingAllocator allocator;
+  void* memory = allocator.Allocate(kPooledSize + 8);
+  ASSERT_NE(nullptr, memory);
+  allocator.Free(memory, kPooledSize + 8);
+  EXPECT_EQ(0u, allocator.GetCurrentPoolSize());
+  memory = allocator.Allocate(16);
+  ASSERT_NE(nullptr, memory);
+  allocator.Free(memory, 16);
+  EXPECT_EQ(0u, allocator.GetCurrentPoolSize());
+}
+
+TEST(AccountingAllocator, PoolSizeIsBounded) {
+  AccountingAllocator allocator;
+  allocator.ConfigureSegmentPool(2 * kPooledSize);
+  void* blocks[3];
+  for (int i = 0; i < 3; ++i) {
+    blocks[i] = allocator.Allocate(kPooledSize);
+    ASSERT_NE(nullptr, blocks[i]);
+  }
+  for (int i = 0; i < 3; ++i) allocator.Free(blocks[i], kPooledSize);
+  EXPECT_EQ(2 * kPooledSize, allocator.GetCurrentPoolSize());
+
+  allocator.ConfigureSegmentPool(kPooledSize);
+  EXPECT_EQ(kPooledSize, allocator.GetCurrentPoolSize());
+
+  allocator.ConfigureSegmentPool(0);
+  EXPECT_EQ(0u, allocator.GetCurrentPoolSize());
+  void* memory = allocator.Allocate(kPooledSize);
+  allocator.Free(memory, kPooledSize);
+  EXPECT_EQ(0u, allocator.GetCurrentPoolSize());
+}
+
+TEST(AccountingAllocator, ClearPool) {
+  AccountingAllocator allocator;
+  void* small = allocator.Allocate(kPooledSize);
+  void* large = allocator.Allocate(64 * kPooledSize);
+  allocator.Free(small, kPooledSize);
+  allocator.Free(large, 64 * kPooledSize);
+  EXPECT_EQ(65 * kPooledSize, allocator.GetCurrentPoolSize());
+  allocator.ClearPool();
+  EXPECT_EQ(0u, allocator.GetCurrentPoolSize());
+  EXPECT_EQ(65 * kPooledSize, allocator.GetMaxMemoryUsage());
+}
+
+#ifdef V8_USE_ADDRESS_SANITIZER
+TEST(AccountingAllocator, PooledSegmentsArePoisoned) {
+  AccountingAllocator allocator;
+  char* memory = static_cast<char*>(allocator.Allocate(kPooledSize));
+  ASSERT_NE(nullptr, memory);
+  EXPECT_FALSE(__asan_address_is_poisoned(memory + kPooledSize - 1));
+  allocator.Free(memory, kPooledSize);
+  EXPECT_EQ(kPooledSize, allocator.GetCurrentPoolSize());
+  EXPECT_TRUE(__asan_address_is_poisoned(memory));
+  EXPECT_TRUE(__asan_address_is_poisoned(memory + kPooledSize - 1));
+  memory = static_cast<char*>(allocator.Allocate(kPooledSize));
+  EXPECT_FALSE(__asan_address_is_poisoned(memory));
+  EXPECT_FALSE(__asan_address_is_poisoned(memory + kPooledSize - 1));
+  allocator.Free(memory, kPooledSize);
+}
+#endif  // V8_USE_ADDRESS_SANITIZER
+
+}  // namespace base
+}  // namespace v8
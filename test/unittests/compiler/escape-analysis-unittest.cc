@@ -514,6 +514,125 @@ TEST_F(EscapeAnalysisTest, DeoptReplacementIdentity) {
   ASSERT_EQ(object_state, object_state2);
 }
 
+
+TEST_F(EscapeAnalysisTest, ReferenceEqualSameVirtualObject) {
+  Node* object1 = Constant(1);
+  BeginRegion();
+  Node* allocation = Allocate(Constant(kPointerSize));
+  Store(FieldAccessAtIndex(0), allocation, object1);
+  Node* finish = FinishRegion(allocation);
+  Node* check = graph()->NewNode(simplified()->ReferenceEqual(Type::Any()),
+                                 finish, finish);
+  Node* result = Return(check);
+  EndGraph();
+
+  Analysis();
+
+  ExpectVirtual(allocation);
+
+  Transformation();
+
+  EXPECT_THAT(NodeProperties::GetValueInput(result, 0), IsTrueConstant());
+}
+
+
+TEST_F(EscapeAnalysisTest, ObjectIsReceiverWithKnownMap) {
+  Handle<Map> map =
+      isolate()->factory()->NewMap(JS_OBJECT_TYPE, JSObject::kHeaderSize);
+  Node* object1 = Constant(1);
+  BeginRegion();
+  Node* allocation = Allocate(Constant(kPointerSize * 2));
+  Store(FieldAccessAtIndex(HeapObject::kMapOffset), allocation,
+        HeapConstant(map));
+  Store(FieldAccessAtIndex(kPointerSize), allocation, object1);
+  Node* finish = FinishRegion(allocation);
+  Node* check = graph()->NewNode(simplified()->ObjectIsReceiver(), finish);
+  Node* result = Return(check);
+  EndGraph();
+
+  Analysis();
+
+  ExpectVirtual(allocation);
+
+  Transformation();
+
+  EXPECT_THAT(NodeProperties::GetValueInput(result, 0), IsTrueConstant());
+}
+
+
+TEST_F(EscapeAnalysisTest, ObjectIsReceiverWithUnknownMap) {
+  Node* object1 = Constant(1);
+  BeginRegion();
+  Node* allocation = Allocate(Constant(kPointerSize));
+  Store(FieldAccessAtIndex(0), allocation, object1);
+  Node* finish = FinishRegion(allocation);
+  Node* check = graph()->NewNode(simplified()->ObjectIsReceiver(), finish);
+  Node* result = Return(check);
+  EndGraph();
+
+  Analysis();
+
+  ExpectEscaped(allocation);
+
+  Transformation();
+
+  ASSERT_EQ(check, NodeProperties::GetValueInput(result, 0));
+}
+
+
+TEST_F(EscapeAnalysisTest, LoadElementWithBoundsCheck) {
+  ElementAccess access = MakeElementAccess(kPointerSize);
+  Node* object1 = Constant(1);
+  Node* object2 = Constant(2);
+  BeginRegion();
+  Node* allocation = Allocate(Constant(kPointerSize * 3));
+  Store(FieldAccessAtIndex(0), allocation, object1);
+  StoreElement(access, allocation, Constant(0), object1);
+  StoreElement(access, allocation, Constant(1), object2);
+  Node* finish = FinishRegion(allocation);
+  Node* index = graph()->NewNode(simplified()->CheckBounds(), Constant(1),
+                                 Constant(2), finish, control());
+  Node* load = graph()->NewNode(simplified()->LoadElement(access), finish,
+                                index, index, control());
+  Node* result = Return(load, index);
+  EndGraph();
+
+  Analysis();
+
+  ExpectVirtual(allocation);
+  ExpectReplacement(load, object2);
+
+  Transformation();
+
+  ASSERT_EQ(object2, NodeProperties::GetValueInput(result, 0));
+}
+
+
+TEST_F(EscapeAnalysisTest, LoadElementWithFailingBoundsCheck) {
+  ElementAccess access = MakeElementAccess(kPointerSize);
+  Node* object1 = Constant(1);
+  BeginRegion();
+  Node* allocation = Allocate(Constant(kPointerSize * 2));
+  Store(FieldAccessAtIndex(0), allocation, object1);
+  StoreElement(access, allocation, Constant(0), object1);
+  Node* finish = FinishRegion(allocation);
+  Node* index = graph()->NewNode(simplified()->CheckBounds(), Constant(1),
+                                 Constant(1), finish, control());
+  Node* load = graph()->NewNode(simplified()->LoadElement(access), finish,
+                                index, index, control());
+  Node* result = Return(load, index);
+  EndGraph();
+
+  Analysis();
+
+  ExpectEscaped(allocation);
+  ExpectReplacement(load, nullptr);
+
+  Transformation();
+
+  ASSERT_EQ(load, NodeProperties::GetValueInput(result, 0));
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
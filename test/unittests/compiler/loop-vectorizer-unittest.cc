@@ -0,0 +1,196 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <functional>
+
+#include "src/compiler/access-builder.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/loop-vectorizer.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+#include "testing/gmock-support.h"
+
+using testing::_;
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopVectorizerTest : public GraphTest {
+ public:
+  LoopVectorizerTest()
+      : GraphTest(1),
+        machine_(zone(), MachineType::PointerRepresentation(),
+                 MachineOperatorBuilder::kNoFlags),
+        simplified_(zone()),
+        javascript_(zone()),
+        jsgraph_(isolate(), graph(), common(), &javascript_, nullptr,
+                 &machine_) {}
+  ~LoopVectorizerTest() override {}
+
+ protected:
+  // The nodes of the loop
+  //
+  //   for (var i = 0; i < n; i++) dst[i] = <value(src[i])>;
+  //
+  // built by BuildLoop below.
+  struct Loop {
+    Node* loop;
+    Node* phi;
+    Node* effect_phi;
+    Node* branch;
+    Node* load;
+    Node* store;
+  };
+
+  Loop BuildLoop(Node* src, Node* dst,
+                 std::function<Node*(Node*)> value_builder) {
+    ElementAccess const access =
+        AccessBuilder::ForTypedArrayElement(kExternalFloat32Array, true);
+    Loop l;
+    l.loop = graph()->NewNode(common()->Loop(2), start(), start());
+    l.phi = graph()->NewNode(common()->Phi(MachineRepresentation::kWord32, 2),
+                             Int32Constant(0), Int32Constant(0), l.loop);
+    l.effect_phi =
+        graph()->NewNode(common()->EffectPhi(2), start(), start(), l.loop);
+    Node* cond =
+        graph()->NewNode(machine()->Int32LessThan(), l.phi, Parameter(0));
+    l.branch = graph()->NewNode(common()->Branch(), cond, l.loop);
+    Node* if_true = graph()->NewNode(common()->IfTrue(), l.branch);
+    Node* if_false = graph()->NewNode(common()->IfFalse(), l.branch);
+
+    l.load = graph()->NewNode(simplified()->LoadElement(access), src, l.phi,
+                              l.effect_phi, if_true);
+    l.store = graph()->NewNode(simplified()->StoreElement(access), dst, l.phi,
+                               value_builder(l.load), l.load, if_true);
+    Node* increment =
+        graph()->NewNode(machine()->Int32Add(), l.phi, Int32Constant(1));
+
+    l.loop->ReplaceInput(1, if_true);
+    l.phi->ReplaceInput(1, increment);
+    l.effect_phi->ReplaceInput(1, l.store);
+
+    Node* ret = graph()->NewNode(common()->Return(), l.phi, l.effect_phi,
+                                 if_false);
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+    return l;
+  }
+
+  void Vectorize() {
+    LoopVectorizer vectorizer(jsgraph(), zone());
+    vectorizer.Run();
+  }
+
+  // Builds Float32(Float64(value) <op> Float64(value)), the way JavaScript
+  // arithmetic on Float32Array elements is lowered.
+  Node* Widened(const Operator* op, Node* lhs, Node* rhs) {
+    return graph()->NewNode(
+        machine()->TruncateFloat64ToFloat32(),
+        graph()->NewNode(op, Widen(lhs), Widen(rhs)));
+  }
+
+  Node* Widen(Node* value) {
+    if (value->opcode() == IrOpcode::kFloat64Constant) return value;
+    return graph()->NewNode(machine()->ChangeFloat32ToFloat64(), value);
+  }
+
+  MachineOperatorBuilder* machine() { return &machine_; }
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+  JSGraph* jsgraph() { return &jsgraph_; }
+
+ private:
+  MachineOperatorBuilder machine_;
+  SimplifiedOperatorBuilder simplified_;
+  JSOperatorBuilder javascript_;
+  JSGraph jsgraph_;
+};
+
+TEST_F(LoopVectorizerTest, Copy) {
+  Node* src = jsgraph()->IntPtrConstant(0x1000);
+  Node* dst = jsgraph()->IntPtrConstant(0x2000);
+  Loop l = BuildLoop(src, dst, [](Node* value) { return value; });
+  Vectorize();
+
+  // The vector loop runs in front of the scalar loop.
+  Node* vector_exit = l.loop->InputAt(0);
+  ASSERT_EQ(IrOpcode::kIfFalse, vector_exit->opcode());
+  Node* vector_branch = vector_exit->InputAt(0);
+  EXPECT_NE(l.branch, vector_branch);
+  Node* vector_loop = NodeProperties::GetControlInput(vector_branch);
+  Node* vector_phi = l.phi->InputAt(0);
+  ASSERT_EQ(IrOpcode::kPhi, vector_phi->opcode());
+  EXPECT_EQ(vector_loop, NodeProperties::GetControlInput(vector_phi));
+  EXPECT_THAT(vector_phi->InputAt(1),
+              IsInt32Add(vector_phi, IsInt32Constant(4)));
+  EXPECT_THAT(vector_branch->InputAt(0),
+              IsWord32And(IsInt32LessThan(vector_phi, _),
+                          IsUint32LessThanOrEqual(
+                              IsInt32Constant(4), IsInt32Sub(_, vector_phi))));
+
+  Node* vector_store = l.effect_phi->InputAt(0)->InputAt(1);
+  EXPECT_THAT(vector_store,
+              IsStore(StoreRepresentation(MachineRepresentation::kSimd128,
+                                          kNoWriteBarrier),
+                      dst, _,
+                      IsLoad(MachineType::Simd128(), src, _, _, _), _, _));
+}
+
+TEST_F(LoopVectorizerTest, Float32Arithmetic) {
+  Node* src = jsgraph()->IntPtrConstant(0x1000);
+  Node* dst = jsgraph()->IntPtrConstant(0x2000);
+  Loop l = BuildLoop(src, dst, [this](Node* value) {
+    return Widened(machine()->Float64Mul(), value, Float64Constant(0.5));
+  });
+  Vectorize();
+
+  Node* vector_store = l.effect_phi->InputAt(0)->InputAt(1);
+  ASSERT_EQ(IrOpcode::kStore, vector_store->opcode());
+  Node* vector_value = vector_store->InputAt(2);
+  EXPECT_EQ(IrOpcode::kFloat32x4Mul, vector_value->opcode());
+  EXPECT_EQ(IrOpcode::kLoad, vector_value->InputAt(0)->opcode());
+  Node* splat = vector_value->InputAt(1);
+  ASSERT_EQ(IrOpcode::kCreateFloat32x4, splat->opcode());
+  EXPECT_THAT(splat->InputAt(0), IsFloat32Constant(0.5f));
+}
+
+TEST_F(LoopVectorizerTest, DoubleRoundingNotVectorized) {
+  // a[i] * 0.5 + 1 is computed in double precision and rounded only once.
+  Node* src = jsgraph()->IntPtrConstant(0x1000);
+  Node* dst = jsgraph()->IntPtrConstant(0x2000);
+  Loop l = BuildLoop(src, dst, [this](Node* value) {
+    Node* product = graph()->NewNode(machine()->Float64Mul(), Widen(value),
+                                     Float64Constant(0.5));
+    return graph()->NewNode(
+        machine()->TruncateFloat64ToFloat32(),
+        graph()->NewNode(machine()->Float64Add(), product,
+                         Float64Constant(1)));
+  });
+  Vectorize();
+  EXPECT_EQ(start(), l.loop->InputAt(0));
+}
+
+TEST_F(LoopVectorizerTest, OverlappingNotVectorized) {
+  // dst[i] = src[i] with dst = src + 1 element carries a value from each
+  // iteration to the next.
+  Node* src = jsgraph()->IntPtrConstant(0x1000);
+  Node* dst = jsgraph()->IntPtrConstant(0x1004);
+  Loop l = BuildLoop(src, dst, [](Node* value) { return value; });
+  Vectorize();
+  EXPECT_EQ(start(), l.loop->InputAt(0));
+}
+
+TEST_F(LoopVectorizerTest, DisjointVectorized) {
+  Node* src = jsgraph()->IntPtrConstant(0x1000);
+  Node* dst = jsgraph()->IntPtrConstant(0x1010);
+  Loop l = BuildLoop(src, dst, [](Node* value) { return value; });
+  Vectorize();
+  EXPECT_EQ(IrOpcode::kIfFalse, l.loop->InputAt(0)->opcode());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
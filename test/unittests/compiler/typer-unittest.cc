@@ -6,8 +6,10 @@
 
 #include "src/codegen.h"
 #include "src/compiler/js-operator.h"
+#include "src/compiler/machine-operator.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/operator-properties.h"
+#include "src/type-cache.h"
 #include "test/cctest/types-fuzz.h"
 #include "test/unittests/compiler/graph-unittest.h"
 
@@ -387,6 +389,29 @@ TEST_F(TyperTest, TypeRegressInt32Constant) {
   }
 }
 
+TEST_F(TyperTest, TypeSimd128Payload) {
+  // The unboxed payload of SIMD values must not be confused with the boxed
+  // values, see RepresentationSelector::GetOutputInfoForPhi.
+  MachineOperatorBuilder machine(zone());
+  Type* const simd128 = TypeCache::Get().kSimd128;
+  Node* a = Parameter(simd128, 0);
+  Node* b = Parameter(simd128, 1);
+  Node* sum = graph()->NewNode(machine.Float32x4Add(), a, b);
+  EXPECT_TRUE(NodeProperties::GetType(sum)->Is(simd128));
+  EXPECT_FALSE(NodeProperties::GetType(sum)->Maybe(Type::Simd()));
+
+  Node* merge = graph()->NewNode(common()->Merge(2), graph()->start(),
+                                 graph()->start());
+  Node* phi = graph()->NewNode(
+      common()->Phi(MachineRepresentation::kTagged, 2), sum, a, merge);
+  EXPECT_TRUE(NodeProperties::GetType(phi)->Is(simd128));
+
+  Node* boxed = Parameter(Type::Simd(), 2);
+  Node* mixed = graph()->NewNode(
+      common()->Phi(MachineRepresentation::kTagged, 2), sum, boxed, merge);
+  EXPECT_FALSE(NodeProperties::GetType(mixed)->Is(simd128));
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -7,6 +7,7 @@
 #include "src/v8.h"
 
 #include "src/interpreter/bytecode-register.h"
+#include "src/interpreter/bytecode-superinstructions.h"
 #include "src/interpreter/bytecodes.h"
 #include "test/unittests/test-utils.h"
 
@@ -161,6 +162,32 @@ TEST(Bytecodes, PrefixMappings) {
   }
 }
 
+TEST(Bytecodes, SuperinstructionsAreWellFormed) {
+#define CHECK_SUPERINSTRUCTION(First, Second)                           \
+  {                                                                     \
+    Bytecode first = Bytecode::k##First;                                \
+    CHECK_EQ(Bytecode::k##Second, Bytecodes::GetSuperinstructionSuffix( \
+                                      first, OperandScale::kSingle));   \
+    CHECK(Bytecodes::IsSuperinstructionSuffix(Bytecode::k##Second));    \
+    CHECK(!Bytecodes::IsStarLookahead(first, OperandScale::kSingle));   \
+    CHECK(!Bytecodes::IsJumpOrReturn(first));                           \
+    CHECK(!Bytecodes::IsDebugBreak(first));                             \
+    CHECK(!Bytecodes::IsPrefixScalingBytecode(first));                  \
+    CHECK_EQ(Bytecode::kIllegal, Bytecodes::GetSuperinstructionSuffix(  \
+                                     first, OperandScale::kDouble));    \
+  }
+  SUPERINSTRUCTION_LIST(CHECK_SUPERINSTRUCTION)
+#undef CHECK_SUPERINSTRUCTION
+  CHECK_EQ(Bytecode::kIllegal,
+           Bytecodes::GetSuperinstructionSuffix(Bytecode::kReturn,
+                                                OperandScale::kSingle));
+  CHECK(Bytecodes::IsSuperinstructionSuffix(Bytecode::kAdd));
+  CHECK(Bytecodes::IsSuperinstructionSuffix(Bytecode::kReturn));
+  CHECK(!Bytecodes::IsSuperinstructionSuffix(Bytecode::kWide));
+  CHECK(!Bytecodes::IsSuperinstructionSuffix(Bytecode::kDebugBreak0));
+  CHECK(!Bytecodes::IsSuperinstructionSuffix(Bytecode::kIllegal));
+}
+
 TEST(Bytecodes, SizesForSignedOperands) {
   CHECK(Bytecodes::SizeForSignedOperand(0) == OperandSize::kByte);
   CHECK(Bytecodes::SizeForSignedOperand(kMaxInt8) == OperandSize::kByte);
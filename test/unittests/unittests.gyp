@@ -8,6 +8,7 @@
   'variables': {
     'v8_code': 1,
     'unittests_sources': [  ### gcmole(all) ###
+      'base/accounting-allocator-unittest.cc',
       'base/atomic-utils-unittest.cc',
       'base/bits-unittest.cc',
       'base/cpu-unittest.cc',
@@ -57,6 +58,7 @@
       'compiler/live-range-unittest.cc',
       'compiler/load-elimination-unittest.cc',
       'compiler/loop-peeling-unittest.cc',
+      'compiler/loop-vectorizer-unittest.cc',
       'compiler/machine-operator-reducer-unittest.cc',
       'compiler/machine-operator-unittest.cc',
       'compiler/move-optimizer-unittest.cc',
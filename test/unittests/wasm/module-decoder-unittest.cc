@@ -1208,6 +1208,75 @@ TEST_F(WasmModuleVerifyTest, Names_two_empty) {
   EXPECT_VERIFIES(data);
 }
 
+class WasmModuleStreamDecoderTest : public TestWithIsolateAndZone {};
+
+#define STREAMED_MODULE                                  \
+  WASM_MODULE_HEADER,                                    \
+      SIGNATURES_SECTION(1, SIG_ENTRY_v_v),              \
+      FUNCTION_SIGNATURES_SECTION(2, 0, 0),              \
+      SECTION(FUNCTION_BODIES, 1 + 2 * SIZEOF_NOP_BODY), \
+      2, NOP_BODY, NOP_BODY, SECTION(NAMES, 1 + 10), 2,  \
+      FOO_STRING, NO_LOCAL_NAMES, FOO_STRING, NO_LOCAL_NAMES
+
+TEST_F(WasmModuleStreamDecoderTest, FunctionBodiesAsTheyArrive) {
+  static const byte data[] = {STREAMED_MODULE};
+  ModuleResult expected = DecodeWasmModule(
+      isolate(), zone(), data, data + sizeof(data), false, kWasmOrigin);
+  EXPECT_OK(expected);
+  std::unique_ptr<const WasmModule> expected_module(expected.val);
+
+  ModuleStreamDecoder decoder(isolate(), zone(), sizeof(data), kWasmOrigin);
+  for (size_t i = 0; i < sizeof(data); ++i) {
+    decoder.OnBytesReceived(data + i, 1);
+    uint32_t complete_bodies = 0;
+    for (const WasmFunction& function : expected_module->functions) {
+      if (function.code_end_offset <= i + 1) ++complete_bodies;
+    }
+    EXPECT_EQ(complete_bodies, decoder.functions_received());
+  }
+
+  ModuleResult result = decoder.Finish(true);
+  EXPECT_OK(result);
+  std::unique_ptr<const WasmModule> module(result.val);
+  EXPECT_EQ(2, module->functions.size());
+  for (size_t i = 0; i < module->functions.size(); ++i) {
+    const WasmFunction& function = module->functions[i];
+    const WasmFunction& expected_function = expected_module->functions[i];
+    EXPECT_EQ(expected_function.code_start_offset, function.code_start_offset);
+    EXPECT_EQ(expected_function.code_end_offset, function.code_end_offset);
+    EXPECT_EQ(expected_function.name_offset, function.name_offset);
+  }
+}
+
+TEST_F(WasmModuleStreamDecoderTest, OutgrownBuffer) {
+  static const byte data[] = {STREAMED_MODULE};
+  // Reserve just enough for the first function body. Bodies are no longer
+  // passed on once the buffer had to grow.
+  static const size_t kReservedSize = sizeof(data) - 20;
+  ModuleStreamDecoder decoder(isolate(), zone(), kReservedSize, kWasmOrigin);
+  for (size_t i = 0; i < sizeof(data); ++i) {
+    decoder.OnBytesReceived(data + i, 1);
+  }
+  EXPECT_EQ(1, decoder.functions_received());
+
+  ModuleResult result = decoder.Finish(true);
+  EXPECT_OK(result);
+  EXPECT_EQ(2, result.val->functions.size());
+  delete result.val;
+}
+
+TEST_F(WasmModuleStreamDecoderTest, Truncated) {
+  static const byte data[] = {STREAMED_MODULE};
+  ModuleStreamDecoder decoder(isolate(), zone(), sizeof(data), kWasmOrigin);
+  decoder.OnBytesReceived(data, sizeof(data) - 12);
+  EXPECT_EQ(2, decoder.functions_received());
+  ModuleResult result = decoder.Finish(true);
+  EXPECT_FALSE(result.ok());
+  if (result.val) delete result.val;
+}
+
+#undef STREAMED_MODULE
+
 }  // namespace wasm
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,345 @@
+#! /usr/bin/python
+#
+# Copyright 2016 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+#
+
+import argparse
+import heapq
+import json
+import re
+import sys
+
+
+__DESCRIPTION = """
+Rank bytecode dispatch pairs as superinstruction candidates, reading one or
+more v8.ignition_dispatches_counters.json profiles (as written by
+--trace-ignition-dispatches) collected from different workloads.
+
+Each candidate is reported with the number of dispatches fusing it would
+save, the share of dispatches from its first bytecode that go to the second
+one, and its share of all dispatches. Pairs whose first bytecode does not
+fall through to the next one (jumps, returns, prefixes) are skipped.
+
+The peephole optimizer already rewrites some pairs, but only under some
+conditions (e.g. when no source position is attached). Pass the pairs table
+that mkpeephole writes next to the generated peephole table (-t) to mark the
+pairs that have a rewrite.
+
+With -o, the best candidates that the interpreter can fuse are written as
+src/interpreter/bytecode-superinstructions.h instead. The handlers for them
+are generated when the interpreter is initialized.
+
+With -g, the inputs are bytecode expectation files from
+test/cctest/interpreter/bytecode_expectations instead of profiles. Each
+snippet counts as one workload, and each bytecode as one dispatch to the
+bytecode listed after it. These static counts are only a stand-in for
+profiles, as they do not account for loops.
+"""
+
+
+__HELP_EPILOGUE = """
+examples:
+  # Print the 20 best candidates from a single profile
+  $ tools/ignition/superinstruction_candidates.py -n 20 octane.json
+
+  # Merge several workloads, giving each the same weight, and mark pairs that
+  # the peephole optimizer can already rewrite
+  $ tools/ignition/superinstruction_candidates.py -w \\
+      -t out/x64.release/v8.ignition_peephole_pairs.json \\
+      octane.json top25.json
+
+  # Write the candidates as JSON for further processing
+  $ tools/ignition/superinstruction_candidates.py -j candidates.json a.json
+
+  # Fuse the 8 best candidates into superinstructions
+  $ tools/ignition/superinstruction_candidates.py -n 8 -w \\
+      -t out/x64.release/v8.ignition_peephole_pairs.json \\
+      -o src/interpreter/bytecode-superinstructions.h octane.json top25.json
+
+  # Rank pairs by how often they appear in the bytecode expectations
+  $ tools/ignition/superinstruction_candidates.py -g -w \\
+      test/cctest/interpreter/bytecode_expectations/*.golden
+"""
+
+
+# Bytecodes that never fall through to the next bytecode in the array, or
+# that only exist to carry prefixes or source positions.
+__NON_FUSIBLE_PREFIXES = (
+  "Jump",
+  "Return",
+  "Throw",
+  "ReThrow",
+  "Wide",
+  "ExtraWide",
+  "Debugger",
+  "DebugBreak",
+  "Illegal",
+  "Nop",
+)
+
+
+# Bytecodes whose handlers already look ahead for a Star, see
+# Bytecodes::IsStarLookahead.
+__STAR_LOOKAHEAD_BYTECODES = frozenset([
+  "LdaZero", "LdaSmi", "LdaNull", "LdaTheHole", "LdaConstant", "Add", "Sub",
+  "Mul", "AddSmi", "SubSmi", "Inc", "Dec", "TypeOf", "Call", "New",
+])
+
+
+# Bytecodes whose handlers cannot be inlined into another one, see
+# Bytecodes::IsSuperinstructionSuffix.
+__NON_FUSIBLE_SUFFIX_PREFIXES = (
+  "Wide",
+  "ExtraWide",
+  "DebugBreak",
+  "Illegal",
+)
+
+
+__GOLDEN_BYTECODE_RE = re.compile(r"\bB\((\w+)\)")
+
+
+__HEADER_TEMPLATE = """\
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_INTERPRETER_BYTECODE_SUPERINSTRUCTIONS_H_
+#define V8_INTERPRETER_BYTECODE_SUPERINSTRUCTIONS_H_
+
+// Pairs of bytecodes whose handlers are fused. The handler for the first
+// bytecode checks whether the next bytecode is the second one and, if so,
+// runs the inlined handler for it instead of dispatching to it. The bytecode
+// array itself is unchanged. Each first bytecode may appear only once, the
+// second one has to satisfy Bytecodes::IsSuperinstructionSuffix().
+//
+// Regenerate from dispatch profiles with
+//   tools/ignition/superinstruction_candidates.py -o <this file> <profiles>
+// or from the bytecode expectations with
+//   tools/ignition/superinstruction_candidates.py -g -w -o <this file>
+//       test/cctest/interpreter/bytecode_expectations/*.golden
+//
+// V(First, Second)
+{list}
+
+#endif  // V8_INTERPRETER_BYTECODE_SUPERINSTRUCTIONS_H_
+"""
+
+
+def is_fusible_source(bytecode):
+  return not bytecode.startswith(__NON_FUSIBLE_PREFIXES)
+
+
+def is_fusible_suffix(bytecode):
+  return not bytecode.startswith(__NON_FUSIBLE_SUFFIX_PREFIXES)
+
+
+def is_fusible_pair(source, destination):
+  return (is_fusible_source(source) and
+          source not in __STAR_LOOKAHEAD_BYTECODES and
+          is_fusible_suffix(destination))
+
+
+def read_golden_dispatch_tables(stream):
+  # One table per snippet, counting each bytecode in the listing as a
+  # dispatch to the one after it.
+  dispatches_tables = []
+  dispatches_table = None
+  previous = None
+  for line in stream:
+    line = line.strip()
+    if line == "bytecodes: [":
+      dispatches_table = {}
+      previous = None
+    elif dispatches_table is not None and line == "]":
+      dispatches_tables.append(dispatches_table)
+      dispatches_table = None
+    elif dispatches_table is not None:
+      match = __GOLDEN_BYTECODE_RE.search(line)
+      if not match:
+        continue
+      bytecode = match.group(1)
+      if previous is not None:
+        row = dispatches_table.setdefault(previous, {})
+        row[bytecode] = row.get(bytecode, 0) + 1
+      previous = bytecode
+  return dispatches_tables
+
+
+def merge_dispatch_tables(dispatches_tables, weigh_equally):
+  merged_table = {}
+  for dispatches_table in dispatches_tables:
+    scale = 1
+    if weigh_equally:
+      total = sum(sum(itervalues(counters))
+                  for counters in itervalues(dispatches_table))
+      scale = 1.0 / total if total else 0
+    for source, counters_from_source in iteritems(dispatches_table):
+      merged_row = merged_table.setdefault(source, {})
+      for destination, counter in iteritems(counters_from_source):
+        merged_row[destination] = (merged_row.get(destination, 0) +
+                                   counter * scale)
+  return merged_table
+
+
+def find_superinstruction_candidates(dispatches_table, top_count,
+                                     rewritten_pairs=None):
+  total = float(sum(sum(itervalues(counters))
+                    for counters in itervalues(dispatches_table)))
+
+  def candidates_generator():
+    for source, counters_from_source in iteritems(dispatches_table):
+      if not is_fusible_source(source):
+        continue
+      source_total = float(sum(itervalues(counters_from_source)))
+      for destination, counter in iteritems(counters_from_source):
+        rewritten = (rewritten_pairs is not None and
+                     destination in rewritten_pairs.get(source, {}))
+        yield (source, destination, counter, counter / source_total,
+               counter / total, rewritten)
+
+  return heapq.nlargest(top_count, candidates_generator(), key=lambda x: x[2])
+
+
+def select_superinstructions(candidates):
+  # The handler of a bytecode can only look ahead for one suffix, so keep
+  # the most frequent one. Pairs with a peephole rewrite are left to it.
+  selected = []
+  sources = set()
+  for source, destination, _, _, _, rewritten in candidates:
+    if (rewritten or source in sources or
+        not is_fusible_pair(source, destination)):
+      continue
+    sources.add(source)
+    selected.append((source, destination))
+  return selected
+
+
+def write_superinstructions_header(superinstructions, stream):
+  lines = ["#define SUPERINSTRUCTION_LIST(V)"]
+  lines += ["  V({}, {})".format(source, destination)
+            for source, destination in superinstructions]
+  width = max(len(line) for line in lines)
+  list_macro = "".join(line.ljust(width) + " \\\n" for line in lines[:-1])
+  list_macro += lines[-1]
+  stream.write(__HEADER_TEMPLATE.format(list=list_macro))
+
+
+def print_superinstruction_candidates(candidates):
+  print("Top {} superinstruction candidates:".format(len(candidates)))
+  for source, destination, counter, source_ratio, ratio, rewritten in (
+      candidates):
+    print("{:>14.0f}\t{:>5.1f}%\t{:>5.1f}%\t{} -> {}{}".format(
+        counter, ratio * 100, source_ratio * 100, source, destination,
+        " (peephole rewrite)" if rewritten else ""))
+
+
+def write_superinstruction_candidates(candidates, stream):
+  json.dump([{
+      "first": source,
+      "second": destination,
+      "dispatches": counter,
+      "share_of_first": source_ratio,
+      "share_of_total": ratio,
+      "peephole_rewrite": rewritten
+    } for source, destination, counter, source_ratio, ratio, rewritten in
+    candidates], stream, indent=2, sort_keys=True)
+
+
+def parse_command_line():
+  command_line_parser = argparse.ArgumentParser(
+    formatter_class=argparse.RawDescriptionHelpFormatter,
+    description=__DESCRIPTION,
+    epilog=__HELP_EPILOGUE
+  )
+  command_line_parser.add_argument(
+    "--top-entries-count", "-n",
+    metavar="N",
+    type=int,
+    default=10,
+    help="report the N best candidates (default 10)"
+  )
+  command_line_parser.add_argument(
+    "--weigh-equally", "-w",
+    action="store_true",
+    help="normalize each profile to its total dispatches before merging"
+  )
+  command_line_parser.add_argument(
+    "--golden", "-g",
+    action="store_true",
+    help="read bytecode expectation files instead of profiles"
+  )
+  command_line_parser.add_argument(
+    "--peephole-pairs", "-t",
+    metavar="<pairs filename>",
+    help="bytecode pairs with peephole rewrites, as written by mkpeephole"
+  )
+  command_line_parser.add_argument(
+    "--json-output", "-j",
+    metavar="<output filename>",
+    help="write the candidates to the given file as JSON instead of printing"
+  )
+  command_line_parser.add_argument(
+    "--header-output", "-o",
+    metavar="<header filename>",
+    help="write the best fusible candidates as a bytecode-superinstructions.h"
+  )
+  command_line_parser.add_argument(
+    "input_filenames",
+    metavar="<input filename>",
+    default=["v8.ignition_dispatches_table.json"],
+    nargs="*",
+    help="Ignition counters JSON files, or .golden files with -g"
+  )
+
+  return command_line_parser.parse_args()
+
+
+def itervalues(d):
+  return d.values() if sys.version_info[0] > 2 else d.itervalues()
+
+
+def iteritems(d):
+  return d.items() if sys.version_info[0] > 2 else d.iteritems()
+
+
+def main():
+  program_options = parse_command_line()
+
+  dispatches_tables = []
+  for input_filename in program_options.input_filenames:
+    with open(input_filename) as stream:
+      if program_options.golden:
+        dispatches_tables += read_golden_dispatch_tables(stream)
+      else:
+        dispatches_tables.append(json.load(stream))
+  dispatches_table = merge_dispatch_tables(dispatches_tables,
+                                           program_options.weigh_equally)
+
+  rewritten_pairs = None
+  if program_options.peephole_pairs:
+    with open(program_options.peephole_pairs) as stream:
+      rewritten_pairs = json.load(stream)
+
+  candidates = find_superinstruction_candidates(
+    dispatches_table, program_options.top_entries_count, rewritten_pairs)
+
+  if program_options.header_output:
+    # Look at all pairs so that N counts the superinstructions written.
+    all_candidates = find_superinstruction_candidates(
+      dispatches_table, sys.maxsize, rewritten_pairs)
+    superinstructions = select_superinstructions(
+      all_candidates)[:program_options.top_entries_count]
+    with open(program_options.header_output, "w") as stream:
+      write_superinstructions_header(superinstructions, stream)
+  elif program_options.json_output:
+    with open(program_options.json_output, "w") as stream:
+      write_superinstruction_candidates(candidates, stream)
+  else:
+    print_superinstruction_candidates(candidates)
+
+
+if __name__ == "__main__":
+  main()
@@ -0,0 +1,105 @@
+# Copyright 2016 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+try:
+  from StringIO import StringIO
+except ImportError:
+  from io import StringIO
+import superinstruction_candidates as sic
+import unittest
+
+
+class SuperinstructionCandidatesTest(unittest.TestCase):
+  def test_merge_dispatch_tables(self):
+    merged = sic.merge_dispatch_tables([
+      {"a": {"a": 10, "b": 30}, "b": {}},
+      {"a": {"b": 2}, "b": {"a": 2}}], False)
+    self.assertDictEqual(merged, {
+      "a": {"a": 10, "b": 32},
+      "b": {"a": 2}})
+
+  def test_merge_dispatch_tables_weigh_equally(self):
+    merged = sic.merge_dispatch_tables([
+      {"a": {"a": 10, "b": 30}},
+      {"a": {"b": 1}, "b": {"a": 3}}], True)
+    self.assertDictEqual(merged, {
+      "a": {"a": 0.25, "b": 1.0},
+      "b": {"a": 0.75}})
+
+  def test_find_candidates_skips_non_fusible_sources(self):
+    candidates = sic.find_superinstruction_candidates({
+      "Ldar": {"Add": 20, "Star": 10},
+      "Jump": {"Ldar": 50},
+      "Wide": {"Ldar": 40},
+      "Return": {"Ldar": 30}}, 5)
+    self.assertListEqual([(c[0], c[1], c[2]) for c in candidates], [
+      ("Ldar", "Add", 20),
+      ("Ldar", "Star", 10)])
+
+  def test_find_candidates_ratios(self):
+    candidates = sic.find_superinstruction_candidates({
+      "Ldar": {"Add": 30, "Star": 10},
+      "Add": {"Star": 60}}, 2)
+    self.assertListEqual(candidates, [
+      ("Add", "Star", 60, 1.0, 0.6, False),
+      ("Ldar", "Add", 30, 0.75, 0.3, False)])
+
+  def test_find_candidates_marks_peephole_rewrites(self):
+    candidates = sic.find_superinstruction_candidates({
+      "LdaNamedProperty": {"Star": 8, "Add": 4}}, 2,
+      {"LdaNamedProperty": {"Star": "kTransformLdaStarToLdrLdarAction"}})
+    self.assertListEqual([(c[1], c[5]) for c in candidates], [
+      ("Star", True),
+      ("Add", False)])
+
+  def test_select_superinstructions(self):
+    superinstructions = sic.select_superinstructions([
+      ("Star", "Ldar", 50, 0.5, 0.5, False),
+      ("Star", "LdaZero", 40, 0.4, 0.4, False),
+      ("LdaNamedProperty", "Star", 30, 1.0, 0.3, True),
+      ("Mov", "Wide", 25, 0.8, 0.25, False),
+      ("Ldar", "Add", 20, 1.0, 0.2, False),
+      ("LdaZero", "Ldar", 10, 1.0, 0.1, False),
+      ("Mov", "Ldar", 5, 0.2, 0.05, False)])
+    self.assertListEqual(superinstructions, [
+      ("Star", "Ldar"),
+      ("Ldar", "Add"),
+      ("Mov", "Ldar")])
+
+  def test_read_golden_dispatch_tables(self):
+    tables = sic.read_golden_dispatch_tables(StringIO(
+      "snippet: \"\n"
+      "  return 1;\n"
+      "\"\n"
+      "bytecodes: [\n"
+      "  /*   30 E> */ B(StackCheck),\n"
+      "  /*   34 S> */ B(LdaSmi), U8(1),\n"
+      "                B(Star), R(0),\n"
+      "                B(LdaSmi), U8(1),\n"
+      "  /*   44 S> */ B(Return),\n"
+      "]\n"
+      "constant pool: [\n"
+      "]\n"
+      "bytecodes: [\n"
+      "                B(LdaUndefined),\n"
+      "                B(Return),\n"
+      "]\n"))
+    self.assertListEqual(tables, [
+      {"StackCheck": {"LdaSmi": 1},
+       "LdaSmi": {"Star": 1, "Return": 1},
+       "Star": {"LdaSmi": 1}},
+      {"LdaUndefined": {"Return": 1}}])
+
+  def test_write_superinstructions_header(self):
+    stream = StringIO()
+    sic.write_superinstructions_header([("Star", "Ldar"), ("Mov", "Ldar")],
+                                       stream)
+    self.assertIn(
+      "#define SUPERINSTRUCTION_LIST(V) \\\n"
+      "  V(Star, Ldar)                  \\\n"
+      "  V(Mov, Ldar)\n", stream.getvalue())
+
+
+if __name__ == "__main__":
+  unittest.main()